@@ -4,8 +4,9 @@ import attr
 import numpy as np
 
 from habitat_sim import errors, scene
-from habitat_sim.agent.agent import Agent
+from habitat_sim.agent.agent import Agent, AgentState
 from habitat_sim.agent.controls.controls import ActuationSpec
+from habitat_sim.bindings import RigidState
 from habitat_sim.nav import (  # type: ignore
     GreedyFollowerCodes,
     GreedyGeodesicFollowerImpl,
@@ -50,6 +51,7 @@ class GreedyGeodesicFollower(object):
         right_key: Optional[Any] = None,
         fix_thrashing: bool = True,
         thrashing_threshold: int = 16,
+        use_distance_field: bool = False,
     ) -> None:
         r"""Constructor
 
@@ -79,6 +81,10 @@ class GreedyGeodesicFollower(object):
         :param fix_thrashing: Whether or not to attempt to fix thrashing
         :param thrashing_threshold: The number of actions in a left -> right -> left -> ..
                                        sequence needed to be considered thrashing
+        :param use_distance_field: Whether to score candidate actions against a
+            single cached geodesic distance field to the goal instead of
+            planning a path for each of them. Much faster, at the cost of using
+            a (tight) upper bound on the geodesic distance
         """
 
         self.pathfinder = pathfinder
@@ -120,6 +126,7 @@ class GreedyGeodesicFollower(object):
             np.deg2rad(self.left_spec.amount),
             fix_thrashing,
             thrashing_threshold,
+            use_distance_field,
         )
 
     def _find_action(self, name: str) -> Tuple[str, ActuationSpec]:
@@ -196,6 +203,36 @@ class GreedyGeodesicFollower(object):
 
         return path
 
+    def find_paths(
+        self, starts: List[AgentState], goal_positions: List[np.ndarray]
+    ) -> List[Optional[List[Any]]]:
+        r"""Batched version of :ref:`find_path` which finds the sequence of
+        actions from each of the start states to the corresponding goal
+
+        :param starts: The states to start from
+        :param goal_positions: The position of the goal of each start
+        :return: For each start, the list of actions to take, ending with
+            :py:`None`, or :py:`None` if no path was found
+
+        The actions of all paths are scored against one cached geodesic
+        distance field per goal, as with :py:`use_distance_field`, and the
+        scoring is spread across :ref:`PathFinder.num_threads` threads.
+        """
+        paths = self.impl.find_paths(
+            [
+                RigidState(quat_to_magnum(state.rotation), state.position)
+                for state in starts
+            ],
+            goal_positions,
+        )
+
+        return [
+            list(map(lambda v: self.action_mapping[v], path))
+            if len(path) > 0
+            else None
+            for path in paths
+        ]
+
     def reset(self) -> None:
         self.impl.reset()
         self.last_goal = None
@@ -254,9 +254,32 @@ class Simulator(SimulatorBackend):
         self._last_state = agent.state
         return agent
 
-    def get_sensor_observations(self) -> Dict[str, Union[ndarray, "Tensor"]]:
+    def get_sensor_observations(
+        self, previous_frame: bool = False
+    ) -> Dict[str, Union[ndarray, "Tensor"]]:
+        r"""Draw and read back the observations of the default agent's sensors
+
+        :param previous_frame: Return the observations drawn by the previous
+            call instead of waiting for the ones just drawn, so rendering
+            overlaps the work done until the next call. The first call returns
+            the observations it draws. Not supported with gpu2gpu_transfer.
+        """
+        if previous_frame:
+            return self._get_previous_sensor_observations()
+
+        # sensors drawing the active scene graph share their render passes
+        shared_sensors = []
         for _, sensor in self._sensors.items():
-            sensor.draw_observation()
+            if sensor.draws_active_scene_graph():
+                shared_sensors.append(sensor)
+            else:
+                sensor.draw_observation()
+        if shared_sensors:
+            self._draw_shared_observations(shared_sensors)
+
+        for _, sensor in self._sensors.items():
+            # start reading back before any observation is retrieved
+            sensor.queue_observation()
 
         observations = {}
         for sensor_uuid, sensor in self._sensors.items():
@@ -264,6 +287,42 @@ class Simulator(SimulatorBackend):
 
         return observations
 
+    def _get_previous_sensor_observations(self) -> Dict[str, ndarray]:
+        scene = self.get_active_scene_graph()
+        for sensor in self._sensors.values():
+            if sensor._spec.gpu2gpu_transfer:
+                raise ValueError(
+                    "previous_frame is not supported with gpu2gpu_transfer"
+                )
+            sensor.check_drawable()
+            sensor._agent.scene_node.parent = scene.get_root_node()
+
+        frames = self.get_agent_observations_async(
+            self.config.sim_cfg.default_agent_id, previous_frame=True
+        )
+        observations = {}
+        for sensor_uuid, sensor in self._sensors.items():
+            observations[sensor_uuid] = sensor._noise_model(
+                np.flip(frames[sensor_uuid], axis=0)
+            )
+        return observations
+
+    def _draw_shared_observations(self, sensors: List["Sensor"]) -> None:
+        for sensor in sensors:
+            sensor.check_drawable()
+
+        scene = self.get_active_scene_graph()
+        for sensor in sensors:
+            sensor._agent.scene_node.parent = scene.get_root_node()
+
+        render_flags = habitat_sim.gfx.Camera.Flags.NONE
+        if self.frustum_culling:
+            render_flags |= habitat_sim.gfx.Camera.Flags.FRUSTUM_CULLING
+
+        self.renderer.draw_sensors(
+            [sensor._sensor_object for sensor in sensors], scene, render_flags
+        )
+
     def last_state(self):
         return self._last_state
 
@@ -399,9 +458,8 @@ class Sensor:
             self._spec.noise_model, self._spec.uuid
         )
 
-    def draw_observation(self) -> None:
-        # sanity check:
-
+    def check_drawable(self) -> None:
+        r"""Raise if the sensor cannot make any observation"""
         # see if the sensor is attached to a scene graph, otherwise it is invalid,
         # and cannot make any observation
         if not self._sensor_object.object:
@@ -410,12 +468,30 @@ class Sensor:
                  (has it been detached from a scene node?)"
             )
 
+        if (
+            self._spec.sensor_type == SensorType.SEMANTIC
+            and self._sim.semantic_scene is None
+        ):
+            raise RuntimeError(
+                "SemanticSensor observation requested but no SemanticScene is loaded"
+            )
+
+    def draws_active_scene_graph(self) -> bool:
+        r"""Whether the observation is a single render pass of the active scene
+        graph, which sensors with the same view can share
+        """
+        return (
+            self._spec.sensor_type != SensorType.SEMANTIC
+            or self._sim.get_active_scene_graph()
+            is self._sim.get_active_semantic_scene_graph()
+        )
+
+    def draw_observation(self) -> None:
+        # sanity check:
+        self.check_drawable()
+
         # get the correct scene graph based on application
         if self._spec.sensor_type == SensorType.SEMANTIC:
-            if self._sim.semantic_scene is None:
-                raise RuntimeError(
-                    "SemanticSensor observation requested but no SemanticScene is loaded"
-                )
             scene = self._sim.get_active_semantic_scene_graph()
         else:  # SensorType is DEPTH or any other type
             scene = self._sim.get_active_scene_graph()
@@ -450,6 +526,21 @@ class Sensor:
                 self._sensor_object, self._sim.get_active_scene_graph(), render_flags
             )
 
+    def queue_observation(self) -> None:
+        r"""Queue an asynchronous readback of the drawn observation, which
+        get_observation then retrieves
+        """
+        if self._spec.gpu2gpu_transfer:
+            return
+
+        tgt = self._sensor_object.render_target
+        if self._spec.sensor_type == SensorType.SEMANTIC:
+            tgt.queue_read_frame_object_id()
+        elif self._spec.sensor_type == SensorType.DEPTH:
+            tgt.queue_read_frame_depth()
+        else:
+            tgt.queue_read_frame_rgba()
+
     def get_observation(self) -> Union[ndarray, "Tensor"]:
 
         tgt = self._sensor_object.render_target
@@ -468,22 +559,29 @@ class Sensor:
             size = self._sensor_object.framebuffer_size
 
             if self._spec.sensor_type == SensorType.SEMANTIC:
-                tgt.read_frame_object_id(
-                    mn.MutableImageView2D(mn.PixelFormat.R32UI, size, self._buffer)
-                )
+                img = mn.MutableImageView2D(mn.PixelFormat.R32UI, size, self._buffer)
             elif self._spec.sensor_type == SensorType.DEPTH:
-                tgt.read_frame_depth(
-                    mn.MutableImageView2D(mn.PixelFormat.R32F, size, self._buffer)
-                )
+                img = mn.MutableImageView2D(mn.PixelFormat.R32F, size, self._buffer)
             else:
-                tgt.read_frame_rgba(
-                    mn.MutableImageView2D(
-                        mn.PixelFormat.RGBA8_UNORM,
-                        size,
-                        self._buffer.reshape(self._spec.resolution[0], -1),
-                    )
+                img = mn.MutableImageView2D(
+                    mn.PixelFormat.RGBA8_UNORM,
+                    size,
+                    self._buffer.reshape(self._spec.resolution[0], -1),
                 )
 
+            # retrieve the readback queued by queue_observation, if any, after
+            # older ones left in flight by get_sensor_observations(previous_frame)
+            while tgt.num_queued_reads > 1:
+                tgt.retrieve_queued_frame(img)
+            if tgt.num_queued_reads > 0:
+                tgt.retrieve_queued_frame(img)
+            elif self._spec.sensor_type == SensorType.SEMANTIC:
+                tgt.read_frame_object_id(img)
+            elif self._spec.sensor_type == SensorType.DEPTH:
+                tgt.read_frame_depth(img)
+            else:
+                tgt.read_frame_rgba(img)
+
             obs = np.flip(self._buffer, axis=0)
 
         return self._noise_model(obs)
@@ -0,0 +1,658 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "CollisionMeshPreprocessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <tuple>
+
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Mesh.h>
+
+#include "esp/io/io.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace assets {
+
+namespace {
+
+const int HULLSET_MAGIC = 'H' << 24 | 'U' << 16 | 'L' << 8 | 'L';  //'HULL';
+const int HULLSET_VERSION = 2;
+const char* HULLSET_EXTENSION = ".hulls";
+
+struct HullSetHeader {
+  int magic;
+  int version;
+  uint64_t sourceFileSize;
+  // 64-bit FNV-1a of the source asset's contents
+  uint64_t sourceFileHash;
+  uint32_t sourceNameLength;
+  uint32_t numHulls;
+};
+
+// Number of directions used to rank hull points and to measure concavity.
+// More directions find smaller concavities at a linear cost.
+const int MIN_HULL_DIRECTIONS = 64;
+const int CONCAVITY_DIRECTIONS = 128;
+// Facet normals closer than about 1/FACET_NORMAL_RESOLUTION are merged, and at
+// most MAX_FACET_DIRECTIONS of them bound the hull when measuring concavity.
+const float FACET_NORMAL_RESOLUTION = 64.0f;
+const size_t MAX_FACET_DIRECTIONS = 256;
+
+// A part is not split further if the cut would land this close to one end of
+// it, along the cut axis.
+const float MIN_SPLIT_FRACTION = 0.05f;
+
+// Roughly evenly distributed unit directions on the sphere (Fibonacci
+// lattice), deterministic so cached hulls are reproducible
+std::vector<Mn::Vector3> sphereDirections(int count) {
+  std::vector<Mn::Vector3> directions;
+  directions.reserve(count);
+  const float goldenAngle = Mn::Constants::pi() * (3.0f - std::sqrt(5.0f));
+  for (int i = 0; i < count; ++i) {
+    const float y = 1.0f - 2.0f * (i + 0.5f) / count;
+    const float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+    const float phi = goldenAngle * i;
+    directions.emplace_back(r * std::cos(phi), y, r * std::sin(phi));
+  }
+  return directions;
+}
+
+// Remove exact duplicates, keeping the first occurrence of each point
+std::vector<Mn::Vector3> uniquePoints(const std::vector<Mn::Vector3>& points) {
+  std::vector<size_t> order(points.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  auto less = [&](size_t a, size_t b) {
+    const Mn::Vector3& pa = points[a];
+    const Mn::Vector3& pb = points[b];
+    if (pa.x() != pb.x())
+      return pa.x() < pb.x();
+    if (pa.y() != pb.y())
+      return pa.y() < pb.y();
+    if (pa.z() != pb.z())
+      return pa.z() < pb.z();
+    return a < b;
+  };
+  std::sort(order.begin(), order.end(), less);
+
+  std::vector<bool> keep(points.size(), false);
+  for (size_t i = 0; i < order.size(); ++i) {
+    keep[order[i]] = i == 0 || points[order[i]] != points[order[i - 1]];
+  }
+  std::vector<Mn::Vector3> unique;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (keep[i]) {
+      unique.push_back(points[i]);
+    }
+  }
+  return unique;
+}
+
+// Directions of the planes bounding the hull of a triangle soup: the distinct
+// facet normals of its largest triangles, which are exact for convex soups,
+// plus evenly spread directions to bound the rest
+std::vector<Mn::Vector3> hullPlaneDirections(
+    const std::vector<Mn::Vector3>& triangles,
+    const std::vector<Mn::Vector3>& sphere) {
+  // quantized normal -> (area, normal) of the largest triangle facing there
+  std::map<std::tuple<int, int, int>, std::pair<float, Mn::Vector3>> facets;
+  for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+    const Mn::Vector3 normal =
+        Mn::Math::cross(triangles[i + 1] - triangles[i],
+                        triangles[i + 2] - triangles[i]);
+    const float area = normal.length();
+    if (area == 0.0f) {
+      continue;
+    }
+    const Mn::Vector3 unit = normal / area;
+    const Mn::Vector3i key{Mn::Math::round(unit * FACET_NORMAL_RESOLUTION)};
+    auto& facet = facets[std::make_tuple(key.x(), key.y(), key.z())];
+    if (area > facet.first) {
+      facet = std::make_pair(area, unit);
+    }
+  }
+
+  std::vector<std::pair<float, Mn::Vector3>> byArea;
+  byArea.reserve(facets.size());
+  for (const auto& facet : facets) {
+    byArea.push_back(facet.second);
+  }
+  std::sort(byArea.begin(), byArea.end(),
+            [](const std::pair<float, Mn::Vector3>& a,
+               const std::pair<float, Mn::Vector3>& b) {
+              return a.first > b.first;
+            });
+  if (byArea.size() > MAX_FACET_DIRECTIONS) {
+    byArea.resize(MAX_FACET_DIRECTIONS);
+  }
+
+  std::vector<Mn::Vector3> directions = sphere;
+  for (const auto& facet : byArea) {
+    directions.push_back(facet.second);
+  }
+  return directions;
+}
+
+// The deepest point of a triangle soup's surface below the hull of the soup,
+// where the hull is approximated by its supporting planes along a set of
+// directions. The surface is sampled at triangle vertices and centroids.
+// Returns the depth.
+float deepestPoint(const std::vector<Mn::Vector3>& triangles,
+                   const std::vector<Mn::Vector3>& directions,
+                   Mn::Vector3& deepest) {
+  std::vector<Mn::Vector3> points = uniquePoints(triangles);
+  std::vector<float> support(directions.size(),
+                             -std::numeric_limits<float>::max());
+  for (const Mn::Vector3& point : points) {
+    for (size_t j = 0; j < directions.size(); ++j) {
+      support[j] = std::max(support[j], Mn::Math::dot(directions[j], point));
+    }
+  }
+  for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+    points.push_back((triangles[i] + triangles[i + 1] + triangles[i + 2]) /
+                     3.0f);
+  }
+
+  float maxDepth = 0.0f;
+  for (const Mn::Vector3& point : points) {
+    float depth = std::numeric_limits<float>::max();
+    for (size_t j = 0; j < directions.size() && depth > maxDepth; ++j) {
+      depth = std::min(depth, support[j] - Mn::Math::dot(directions[j], point));
+    }
+    if (depth > maxDepth) {
+      maxDepth = depth;
+      deepest = point;
+    }
+  }
+  return maxDepth;
+}
+
+// Clip a convex polygon to one side of the plane x[axis] = position and fan
+// triangulate the result into out
+void clipPolygon(const Mn::Vector3 (&polygon)[3],
+                 int axis,
+                 float position,
+                 bool below,
+                 std::vector<Mn::Vector3>& out) {
+  // triangles lying in the plane belong to the side they face away from, so
+  // they are not duplicated
+  if (polygon[0][axis] == position && polygon[1][axis] == position &&
+      polygon[2][axis] == position) {
+    const float normal = Mn::Math::cross(polygon[1] - polygon[0],
+                                         polygon[2] - polygon[0])[axis];
+    if ((normal >= 0.0f) == below) {
+      out.insert(out.end(), polygon, polygon + 3);
+    }
+    return;
+  }
+
+  // neither are triangles only touching the plane from the other side
+  auto strictlyInside = [&](const Mn::Vector3& p) {
+    return below ? p[axis] < position : p[axis] > position;
+  };
+  if (!strictlyInside(polygon[0]) && !strictlyInside(polygon[1]) &&
+      !strictlyInside(polygon[2])) {
+    return;
+  }
+
+  auto inside = [&](const Mn::Vector3& p) {
+    return below ? p[axis] <= position : p[axis] >= position;
+  };
+
+  Mn::Vector3 clipped[4];
+  int numClipped = 0;
+  for (int i = 0; i < 3; ++i) {
+    const Mn::Vector3& p = polygon[i];
+    const Mn::Vector3& q = polygon[(i + 1) % 3];
+    if (inside(p)) {
+      clipped[numClipped++] = p;
+    }
+    if (inside(p) != inside(q)) {
+      const float t = (position - p[axis]) / (q[axis] - p[axis]);
+      Mn::Vector3 intersection = Mn::Math::lerp(p, q, t);
+      // avoid rounding off the plane
+      intersection[axis] = position;
+      clipped[numClipped++] = intersection;
+    }
+  }
+
+  for (int i = 1; i + 1 < numClipped; ++i) {
+    out.push_back(clipped[0]);
+    out.push_back(clipped[i]);
+    out.push_back(clipped[i + 1]);
+  }
+}
+
+// recursively gather the triangles (or points, for non-triangle meshes) of
+// every mesh of the tree in asset-local space, one soup per mesh
+void gatherMeshes(const Mn::Matrix4& transformFromParentToWorld,
+                  const std::vector<CollisionMeshData>& meshGroup,
+                  const MeshTransformNode& node,
+                  std::vector<std::vector<Mn::Vector3>>& soups,
+                  std::vector<bool>& isTriangleSoup) {
+  const Mn::Matrix4 transformFromLocalToWorld =
+      transformFromParentToWorld * node.transformFromLocalToParent;
+  if (node.meshIDLocal != ID_UNDEFINED) {
+    const CollisionMeshData& mesh = meshGroup[node.meshIDLocal];
+    std::vector<Mn::Vector3> soup;
+    const bool triangles = mesh.primitive == Mn::MeshPrimitive::Triangles &&
+                           !mesh.indices.empty();
+    if (triangles) {
+      soup.reserve(mesh.indices.size());
+      for (Mn::UnsignedInt index : mesh.indices) {
+        soup.push_back(
+            transformFromLocalToWorld.transformPoint(mesh.positions[index]));
+      }
+    } else {
+      soup.reserve(mesh.positions.size());
+      for (const Mn::Vector3& v : mesh.positions) {
+        soup.push_back(transformFromLocalToWorld.transformPoint(v));
+      }
+    }
+    soups.emplace_back(std::move(soup));
+    isTriangleSoup.push_back(triangles);
+  }
+
+  for (const MeshTransformNode& child : node.children) {
+    gatherMeshes(transformFromLocalToWorld, meshGroup, child, soups,
+                 isTriangleSoup);
+  }
+}
+
+uint64_t fileSize(FILE* fp) {
+  const long pos = ftell(fp);
+  fseek(fp, 0, SEEK_END);
+  const long size = ftell(fp);
+  fseek(fp, pos, SEEK_SET);
+  return size > 0 ? size : 0;
+}
+
+// Size and 64-bit FNV-1a hash of a file's contents, zero if it can't be read
+std::pair<uint64_t, uint64_t> fileSizeAndHash(const std::string& filename) {
+  FILE* fp = fopen(filename.c_str(), "rb");
+  if (!fp)
+    return {0, 0};
+  uint64_t size = 0;
+  uint64_t hash = 14695981039346656037ull;
+  unsigned char buffer[1 << 16];
+  size_t read = 0;
+  while ((read = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+    for (size_t i = 0; i < read; ++i) {
+      hash = (hash ^ buffer[i]) * 1099511628211ull;
+    }
+    size += read;
+  }
+  fclose(fp);
+  return {size, hash};
+}
+
+}  // namespace
+
+std::vector<Mn::Vector3> CollisionMeshPreprocessor::reduceHullVertices(
+    const std::vector<Mn::Vector3>& points,
+    int maxVertices) {
+  std::vector<Mn::Vector3> unique = uniquePoints(points);
+  if (maxVertices <= 0 || unique.size() <= static_cast<size_t>(maxVertices)) {
+    return unique;
+  }
+
+  // hull vertices, as the farthest points along many directions, with the
+  // number of directions each of them was found in
+  const std::vector<Mn::Vector3> directions =
+      sphereDirections(std::max(MIN_HULL_DIRECTIONS, 4 * maxVertices));
+  std::map<size_t, int> votes;
+  for (const Mn::Vector3& direction : directions) {
+    size_t best = 0;
+    float bestDot = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < unique.size(); ++i) {
+      const float d = Mn::Math::dot(direction, unique[i]);
+      if (d > bestDot) {
+        bestDot = d;
+        best = i;
+      }
+    }
+    ++votes[best];
+  }
+  std::vector<size_t> candidates;
+  candidates.reserve(votes.size());
+  size_t first = 0;
+  int firstVotes = 0;
+  for (const auto& vote : votes) {
+    if (vote.second > firstVotes) {
+      first = candidates.size();
+      firstVotes = vote.second;
+    }
+    candidates.push_back(vote.first);
+  }
+  if (candidates.size() <= static_cast<size_t>(maxVertices)) {
+    std::vector<Mn::Vector3> reduced;
+    for (size_t i : candidates) {
+      reduced.push_back(unique[i]);
+    }
+    return reduced;
+  }
+
+  // spread the kept vertices over the hull with farthest point sampling,
+  // starting from the most dominant vertex
+  std::vector<float> distance(candidates.size(),
+                              std::numeric_limits<float>::max());
+  std::vector<bool> kept(candidates.size(), false);
+  size_t next = first;
+  for (int iVertex = 0; iVertex < maxVertices; ++iVertex) {
+    kept[next] = true;
+    const Mn::Vector3& keptPoint = unique[candidates[next]];
+    size_t farthest = next;
+    float farthestDistance = -1.0f;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      distance[i] = std::min(distance[i],
+                             (unique[candidates[i]] - keptPoint).dot());
+      if (!kept[i] && distance[i] > farthestDistance) {
+        farthestDistance = distance[i];
+        farthest = i;
+      }
+    }
+    next = farthest;
+  }
+
+  std::vector<Mn::Vector3> reduced;
+  reduced.reserve(maxVertices);
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (kept[i]) {
+      reduced.push_back(unique[candidates[i]]);
+    }
+  }
+  return reduced;
+}  // reduceHullVertices
+
+std::vector<std::vector<Mn::Vector3>> CollisionMeshPreprocessor::decompose(
+    std::vector<Mn::Vector3> triangles,
+    int maxParts,
+    float maxConcavity) {
+  struct Part {
+    std::vector<Mn::Vector3> triangles;
+    float concavity = 0.0f;
+    Mn::Vector3 deepest;
+    bool splittable = true;
+  };
+
+  const std::vector<Mn::Vector3> sphere =
+      sphereDirections(CONCAVITY_DIRECTIONS);
+  auto measure = [&](Part& part) {
+    part.concavity =
+        deepestPoint(part.triangles,
+                     hullPlaneDirections(part.triangles, sphere), part.deepest);
+  };
+
+  std::vector<Part> parts(1);
+  parts[0].triangles = std::move(triangles);
+  measure(parts[0]);
+
+  while (static_cast<int>(parts.size()) < maxParts) {
+    // split the most concave part first
+    int worst = ID_UNDEFINED;
+    for (int i = 0; i < static_cast<int>(parts.size()); ++i) {
+      if (parts[i].splittable && parts[i].concavity > maxConcavity &&
+          (worst == ID_UNDEFINED ||
+           parts[i].concavity > parts[worst].concavity)) {
+        worst = i;
+      }
+    }
+    if (worst == ID_UNDEFINED) {
+      break;
+    }
+    Part& part = parts[worst];
+
+    // cut across the longest extent, through the deepest point unless that
+    // would leave a sliver
+    Mn::Range3D bounds{part.triangles.front(), part.triangles.front()};
+    for (const Mn::Vector3& v : part.triangles) {
+      bounds.min() = Mn::Math::min(bounds.min(), v);
+      bounds.max() = Mn::Math::max(bounds.max(), v);
+    }
+    const Mn::Vector3 size = bounds.size();
+    int axis = 0;
+    if (size.y() > size[axis])
+      axis = 1;
+    if (size.z() > size[axis])
+      axis = 2;
+    float position = part.deepest[axis];
+    const float margin = MIN_SPLIT_FRACTION * size[axis];
+    if (position - bounds.min()[axis] < margin ||
+        bounds.max()[axis] - position < margin) {
+      position = bounds.center()[axis];
+    }
+
+    Part below, above;
+    for (size_t i = 0; i + 2 < part.triangles.size(); i += 3) {
+      const Mn::Vector3 triangle[3]{part.triangles[i], part.triangles[i + 1],
+                                    part.triangles[i + 2]};
+      clipPolygon(triangle, axis, position, true, below.triangles);
+      clipPolygon(triangle, axis, position, false, above.triangles);
+    }
+    if (below.triangles.empty() || above.triangles.empty()) {
+      part.splittable = false;
+      continue;
+    }
+    measure(below);
+    measure(above);
+    part = std::move(below);
+    parts.emplace_back(std::move(above));
+  }
+
+  std::vector<std::vector<Mn::Vector3>> soups;
+  soups.reserve(parts.size());
+  for (Part& part : parts) {
+    soups.emplace_back(std::move(part.triangles));
+  }
+  return soups;
+}  // decompose
+
+CollisionMeshPreprocessor::Hulls CollisionMeshPreprocessor::computeHulls(
+    const std::vector<CollisionMeshData>& meshGroup,
+    const MeshTransformNode& root,
+    const Options& options) {
+  std::vector<std::vector<Mn::Vector3>> soups;
+  std::vector<bool> isTriangleSoup;
+  gatherMeshes(Mn::Matrix4{}, meshGroup, root, soups, isTriangleSoup);
+
+  if (options.join && soups.size() > 1) {
+    std::vector<Mn::Vector3> joined;
+    bool allTriangles = true;
+    for (size_t i = 0; i < soups.size(); ++i) {
+      joined.insert(joined.end(), soups[i].begin(), soups[i].end());
+      allTriangles = allTriangles && isTriangleSoup[i];
+    }
+    soups.assign(1, std::move(joined));
+    isTriangleSoup.assign(1, allTriangles);
+  }
+
+  // concavity tolerance relative to the size of the whole asset
+  Mn::Vector3 minCorner{std::numeric_limits<float>::max()};
+  Mn::Vector3 maxCorner{-std::numeric_limits<float>::max()};
+  for (const auto& soup : soups) {
+    for (const Mn::Vector3& v : soup) {
+      minCorner = Mn::Math::min(minCorner, v);
+      maxCorner = Mn::Math::max(maxCorner, v);
+    }
+  }
+  // no points leaves the corners inverted
+  const Mn::Vector3 extent = maxCorner - minCorner;
+  const float diagonal = extent.min() >= 0.0f ? extent.length() : 0.0f;
+  const float maxConcavity = options.maxConcavity * diagonal;
+
+  Hulls hulls;
+  for (size_t i = 0; i < soups.size(); ++i) {
+    if (soups[i].empty()) {
+      continue;
+    }
+    std::vector<std::vector<Mn::Vector3>> parts;
+    if (options.decompose && isTriangleSoup[i]) {
+      parts = decompose(std::move(soups[i]), options.maxConvexParts,
+                        maxConcavity);
+    } else {
+      parts.emplace_back(std::move(soups[i]));
+    }
+    for (const auto& part : parts) {
+      hulls.emplace_back(reduceHullVertices(part, options.maxHullVertices));
+    }
+  }
+  return hulls;
+}  // computeHulls
+
+std::string CollisionMeshPreprocessor::getCacheFilename(
+    const std::string& collisionAssetFilename,
+    const Options& options) {
+  std::string variant = options.join ? "joined" : "split";
+  variant += "_v" + std::to_string(options.maxHullVertices);
+  if (options.decompose) {
+    variant += "_acd" + std::to_string(options.maxConvexParts);
+  }
+  // keep the extension, so chair.glb and chair.obj get different caches
+  return collisionAssetFilename + ".collision_" + variant + HULLSET_EXTENSION;
+}
+
+bool CollisionMeshPreprocessor::isCacheFilename(const std::string& filename) {
+  return Cr::Utility::String::endsWith(filename, HULLSET_EXTENSION);
+}
+
+bool CollisionMeshPreprocessor::saveHulls(const std::string& cacheFilename,
+                                          const std::string& sourceFilename,
+                                          const Hulls& hulls) {
+  // Write to a temporary file first and then move it in place so concurrent
+  // readers never see a partially written cache
+  const std::string tmpFilename = io::uniqueTemporaryFilename(cacheFilename);
+  FILE* fp = fopen(tmpFilename.c_str(), "wb");
+  if (!fp)
+    return false;
+
+  const std::string sourceName =
+      Cr::Utility::Directory::filename(sourceFilename);
+  HullSetHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = HULLSET_MAGIC;
+  header.version = HULLSET_VERSION;
+  std::tie(header.sourceFileSize, header.sourceFileHash) =
+      fileSizeAndHash(sourceFilename);
+  header.sourceNameLength = sourceName.size();
+  header.numHulls = hulls.size();
+  bool written = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                 fwrite(sourceName.data(), 1, sourceName.size(), fp) ==
+                     sourceName.size();
+  for (const auto& hull : hulls) {
+    const uint32_t numPoints = hull.size();
+    written = written && fwrite(&numPoints, sizeof(numPoints), 1, fp) == 1 &&
+              fwrite(hull.data(), sizeof(Mn::Vector3), numPoints, fp) ==
+                  numPoints;
+  }
+  written = fclose(fp) == 0 && written;
+
+  if (!written || !io::replaceFile(tmpFilename, cacheFilename)) {
+    std::remove(tmpFilename.c_str());
+    return false;
+  }
+  return true;
+}  // saveHulls
+
+bool CollisionMeshPreprocessor::loadHulls(const std::string& cacheFilename,
+                                          Hulls& hulls) {
+  FILE* fp = fopen(cacheFilename.c_str(), "rb");
+  if (!fp)
+    return false;
+
+  HullSetHeader header;
+  if (fread(&header, sizeof(header), 1, fp) != 1 ||
+      header.magic != HULLSET_MAGIC || header.version != HULLSET_VERSION) {
+    LOG(WARNING) << "Ignoring collision hull cache " << cacheFilename
+                 << " : unsupported format";
+    fclose(fp);
+    return false;
+  }
+
+  // Every count is bounded by what is left of the file before allocating
+  uint64_t remaining = fileSize(fp) - sizeof(header);
+  if (header.sourceNameLength > remaining) {
+    LOG(WARNING) << "Ignoring collision hull cache " << cacheFilename
+                 << " : file is truncated";
+    fclose(fp);
+    return false;
+  }
+  std::string sourceName(header.sourceNameLength, '\0');
+  if (fread(&sourceName[0], 1, sourceName.size(), fp) != sourceName.size()) {
+    fclose(fp);
+    return false;
+  }
+  remaining -= sourceName.size();
+  // The cache must belong to the asset whose name it carries, see
+  // getCacheFilename()
+  if (sourceName.empty() ||
+      !Cr::Utility::String::beginsWith(
+          Cr::Utility::Directory::filename(cacheFilename),
+          sourceName + ".collision_")) {
+    LOG(WARNING) << "Ignoring collision hull cache " << cacheFilename
+                 << " : it was built from " << sourceName;
+    fclose(fp);
+    return false;
+  }
+  // A cache shipped without its source asset is used as is
+  const std::string sourceFilename = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::path(cacheFilename), sourceName);
+  if (Cr::Utility::Directory::exists(sourceFilename) &&
+      fileSizeAndHash(sourceFilename) !=
+          std::make_pair(header.sourceFileSize, header.sourceFileHash)) {
+    LOG(INFO) << "Collision hull cache " << cacheFilename
+              << " is out of date with " << sourceFilename;
+    fclose(fp);
+    return false;
+  }
+
+  bool read = header.numHulls <= remaining / sizeof(uint32_t);
+  Hulls loaded(read ? header.numHulls : 0);
+  for (auto& hull : loaded) {
+    uint32_t numPoints = 0;
+    read = remaining >= sizeof(numPoints) &&
+           fread(&numPoints, sizeof(numPoints), 1, fp) == 1;
+    if (!read) {
+      break;
+    }
+    remaining -= sizeof(numPoints);
+    read = numPoints <= remaining / sizeof(Mn::Vector3);
+    if (!read) {
+      break;
+    }
+    hull.resize(numPoints);
+    read = fread(hull.data(), sizeof(Mn::Vector3), numPoints, fp) == numPoints;
+    if (!read) {
+      break;
+    }
+    remaining -= numPoints * sizeof(Mn::Vector3);
+  }
+  fclose(fp);
+  if (!read) {
+    LOG(WARNING) << "Ignoring collision hull cache " << cacheFilename
+                 << " : file is truncated";
+    return false;
+  }
+
+  hulls = std::move(loaded);
+  return true;
+}  // loadHulls
+
+}  // namespace assets
+}  // namespace esp
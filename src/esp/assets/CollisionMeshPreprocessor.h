@@ -0,0 +1,181 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_ASSETS_COLLISIONMESHPREPROCESSOR_H_
+#define ESP_ASSETS_COLLISIONMESHPREPROCESSOR_H_
+
+/** @file
+ * @brief Class @ref esp::assets::CollisionMeshPreprocessor
+ */
+
+#include <string>
+#include <vector>
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Vector3.h>
+
+#include "esp/assets/CollisionMeshData.h"
+#include "esp/assets/MeshMetaData.h"
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+
+/**
+ * @brief Turns object collision meshes into a small set of bounded convex
+ * hulls, and reads/writes them to a cache file stored next to the collision
+ * asset.
+ *
+ * Convex collision queries are linear in the number of hull points, so hulls
+ * wrapping render-resolution meshes make narrowphase collision detection
+ * needlessly expensive. Each hull is reduced to at most @ref
+ * Options::maxHullVertices of its vertices, spread over its surface. Concave
+ * meshes can optionally be split into several convex parts first: the part
+ * with the deepest surface point below its hull is cut by an axis-aligned
+ * plane through that point until every part is close enough to convex or @ref
+ * Options::maxConvexParts is reached.
+ *
+ * See @ref ResourceManager::loadObjectMeshDataFromFile.
+ */
+class CollisionMeshPreprocessor {
+ public:
+  /**
+   * @brief Point sets of convex hulls, in the local space of the asset.
+   */
+  typedef std::vector<std::vector<Magnum::Vector3>> Hulls;
+
+  /**
+   * @brief Parameters of the preprocessing. Hulls built with different
+   * options are cached in different files.
+   */
+  struct Options {
+    /**
+     * @brief Upper bound on the number of points of each hull. 0 keeps every
+     * point.
+     */
+    int maxHullVertices = 0;
+
+    /**
+     * @brief Whether all meshes of the asset are wrapped in (or decomposed
+     * as) a single shape, rather than one per mesh.
+     */
+    bool join = true;
+
+    /**
+     * @brief Whether to split concave meshes into several convex parts.
+     */
+    bool decompose = false;
+
+    /**
+     * @brief The maximum number of parts a mesh is split into when
+     * decomposing.
+     */
+    int maxConvexParts = 16;
+
+    /**
+     * @brief Decomposition stops splitting a part once none of its surface
+     * points is deeper than this fraction of the asset's bounding box
+     * diagonal below its hull.
+     */
+    float maxConcavity = 0.05f;
+
+    /**
+     * @brief Whether these options change anything compared to wrapping
+     * the raw meshes in hulls.
+     */
+    bool enabled() const { return maxHullVertices > 0 || decompose; }
+  };
+
+  /**
+   * @brief Build the hulls for the meshes of a collision asset.
+   *
+   * @param meshGroup The collision meshes of the asset.
+   * @param root The root of the asset's transformation hierarchy. Points are
+   * transformed to the asset's local space by accumulating transformations
+   * down the tree.
+   * @param options The preprocessing parameters.
+   * @return The hulls. Meshes without points produce no hull.
+   */
+  static Hulls computeHulls(const std::vector<CollisionMeshData>& meshGroup,
+                            const MeshTransformNode& root,
+                            const Options& options);
+
+  /**
+   * @brief Reduce a point set to at most @p maxVertices points of its convex
+   * hull.
+   *
+   * Hull vertices are found as the farthest points of the set along evenly
+   * distributed directions, then subsampled by farthest point sampling so the
+   * kept points are spread over the whole hull.
+   *
+   * @param points The point set, duplicates are allowed.
+   * @param maxVertices The maximum number of points to keep, 0 for no limit.
+   * @return The kept points, in the order of their first occurrence in @p
+   * points.
+   */
+  static std::vector<Magnum::Vector3> reduceHullVertices(
+      const std::vector<Magnum::Vector3>& points,
+      int maxVertices);
+
+  /**
+   * @brief Split a triangle soup into approximately convex parts.
+   *
+   * @param triangles Triangle vertices, three consecutive points per
+   * triangle.
+   * @param maxParts The maximum number of parts.
+   * @param maxConcavity The absolute depth below a part's hull at which a
+   * surface point is considered concave.
+   * @return The triangle soups of the parts.
+   */
+  static std::vector<std::vector<Magnum::Vector3>> decompose(
+      std::vector<Magnum::Vector3> triangles,
+      int maxParts,
+      float maxConcavity);
+
+  /**
+   * @brief The name of the cache file holding the hulls of a collision asset
+   * built with given options. The file is placed next to the asset and its
+   * name starts with the asset's full filename, e.g.
+   * chair.glb.collision_joined_v32.hulls.
+   */
+  static std::string getCacheFilename(const std::string& collisionAssetFilename,
+                                      const Options& options);
+
+  /**
+   * @brief Whether a filename names a hull cache file.
+   */
+  static bool isCacheFilename(const std::string& filename);
+
+  /**
+   * @brief Write hulls to a cache file.
+   *
+   * @param cacheFilename The file to write.
+   * @param sourceFilename The collision asset the hulls were built from. Its
+   * size and a hash of its contents are recorded to detect when the cache
+   * becomes stale.
+   * @param hulls The hulls to write.
+   * @return Whether the file was written.
+   */
+  static bool saveHulls(const std::string& cacheFilename,
+                        const std::string& sourceFilename,
+                        const Hulls& hulls);
+
+  /**
+   * @brief Read hulls from a cache file.
+   *
+   * Fails if the file is missing, malformed or of an older format, if it was
+   * built from an asset other than the one named by @p cacheFilename, or if
+   * that asset has changed since.
+   *
+   * @param cacheFilename The file to read.
+   * @param hulls The read hulls.
+   * @return Whether valid hulls were read.
+   */
+  static bool loadHulls(const std::string& cacheFilename, Hulls& hulls);
+};
+
+}  // namespace assets
+}  // namespace esp
+
+#endif  // ESP_ASSETS_COLLISIONMESHPREPROCESSOR_H_
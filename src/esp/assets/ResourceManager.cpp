@@ -4,7 +4,13 @@
 
 #include "ResourceManager.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/PointerStl.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/PluginManager/PluginMetadata.h>
@@ -16,6 +22,7 @@
 #include <Corrade/Utility/String.h>
 #include <Magnum/EigenIntegration/GeometryIntegration.h>
 #include <Magnum/EigenIntegration/Integration.h>
+#include <Magnum/FileCallback.h>
 #include <Magnum/GL/Context.h>
 #include <Magnum/GL/Extensions.h>
 #include <Magnum/ImageView.h>
@@ -83,6 +90,7 @@ constexpr char ResourceManager::DEFAULT_LIGHTING_KEY[];
 constexpr char ResourceManager::DEFAULT_MATERIAL_KEY[];
 constexpr char ResourceManager::WHITE_MATERIAL_KEY[];
 constexpr char ResourceManager::PER_VERTEX_OBJECT_ID_MATERIAL_KEY[];
+constexpr size_t ResourceManager::DEFAULT_NUM_LOADER_THREADS;
 ResourceManager::ResourceManager(
     metadata::MetadataMediator::ptr& _metadataMediator,
     Flags _flags)
@@ -503,7 +511,15 @@ bool ResourceManager::loadObjectMeshDataFromFile(
     const std::string& meshType,
     const bool requiresLighting) {
   bool success = false;
-  if (!filename.empty()) {
+  if (CollisionMeshPreprocessor::isCacheFilename(filename)) {
+    // preprocessed collision hulls, see loadObjectCollisionHulls
+    CollisionMeshPreprocessor::Hulls hulls;
+    success = CollisionMeshPreprocessor::loadHulls(filename, hulls) &&
+              !hulls.empty();
+    if (success) {
+      registerCollisionHulls(filename, hulls);
+    }
+  } else if (!filename.empty()) {
     AssetInfo meshInfo{AssetType::UNKNOWN, filename};
     meshInfo.requiresLighting = requiresLighting;
     success = loadGeneralMeshData(meshInfo);
@@ -515,6 +531,138 @@ bool ResourceManager::loadObjectMeshDataFromFile(
   return success;
 }  // loadObjectMeshDataFromFile
 
+namespace {
+CollisionMeshPreprocessor::Options getCollisionHullOptions(
+    const ObjectAttributes& objectAttributes) {
+  CollisionMeshPreprocessor::Options options;
+  options.maxHullVertices = objectAttributes.getCollisionHullMaxVertices();
+  options.join = objectAttributes.getJoinCollisionMeshes();
+  options.decompose = objectAttributes.getConvexDecomposition();
+  options.maxConvexParts = objectAttributes.getMaxConvexParts();
+  return options;
+}
+}  // namespace
+
+std::string ResourceManager::getObjectCollisionMeshHandle(
+    const ObjectAttributes& objectAttributes) const {
+  const std::string collisionAssetHandle =
+      objectAttributes.getCollisionAssetHandle();
+  const CollisionMeshPreprocessor::Options options =
+      getCollisionHullOptions(objectAttributes);
+  if (options.enabled()) {
+    const std::string hullsHandle = CollisionMeshPreprocessor::getCacheFilename(
+        collisionAssetHandle, options);
+    if (collisionMeshGroups_.count(hullsHandle) > 0) {
+      return hullsHandle;
+    }
+  }
+  return collisionAssetHandle;
+}  // getObjectCollisionMeshHandle
+
+bool ResourceManager::loadObjectCollisionHulls(
+    const ObjectAttributes& objectAttributes,
+    const std::string& objectTemplateHandle,
+    const bool requiresLighting) {
+  const std::string collisionAssetHandle =
+      objectAttributes.getCollisionAssetHandle();
+  const CollisionMeshPreprocessor::Options options =
+      getCollisionHullOptions(objectAttributes);
+  const std::string hullsHandle = CollisionMeshPreprocessor::getCacheFilename(
+      collisionAssetHandle, options);
+  if (collisionMeshGroups_.count(hullsHandle) > 0) {
+    return true;
+  }
+
+  // pick up hulls preprocessed offline or by an earlier run, without loading
+  // the collision asset at all
+  if (Cr::Utility::Directory::exists(hullsHandle) &&
+      loadObjectMeshDataFromFile(hullsHandle, objectTemplateHandle,
+                                 "collision", false)) {
+    return true;
+  }
+
+  if (resourceDict_.count(collisionAssetHandle) == 0 &&
+      !loadObjectMeshDataFromFile(collisionAssetHandle, objectTemplateHandle,
+                                  "collision", requiresLighting)) {
+    return false;
+  }
+
+  const MeshMetaData& meshMetaData = getMeshMetaData(collisionAssetHandle);
+  std::vector<CollisionMeshData> meshGroup;
+  for (int mesh_i = meshMetaData.meshIndex.first;
+       mesh_i <= meshMetaData.meshIndex.second; ++mesh_i) {
+    GenericMeshData* meshData =
+        dynamic_cast<GenericMeshData*>(meshes_[mesh_i].get());
+    if (meshData == nullptr) {
+      LOG(ERROR) << "ResourceManager::loadObjectCollisionHulls : "
+                 << collisionAssetHandle
+                 << " is not a general mesh asset, unable to build hulls.";
+      return false;
+    }
+    meshGroup.push_back(meshData->getCollisionMeshData());
+  }
+
+  const CollisionMeshPreprocessor::Hulls hulls =
+      CollisionMeshPreprocessor::computeHulls(meshGroup, meshMetaData.root,
+                                              options);
+  if (hulls.empty()) {
+    LOG(ERROR) << "ResourceManager::loadObjectCollisionHulls : "
+               << collisionAssetHandle << " has no collision geometry.";
+    return false;
+  }
+  if (!CollisionMeshPreprocessor::saveHulls(hullsHandle, collisionAssetHandle,
+                                            hulls)) {
+    LOG(WARNING) << "ResourceManager::loadObjectCollisionHulls : Unable to "
+                    "write collision hull cache "
+                 << hullsHandle << ", hulls will be rebuilt on next load.";
+  }
+  registerCollisionHulls(hullsHandle, hulls);
+  return true;
+}  // loadObjectCollisionHulls
+
+void ResourceManager::registerCollisionHulls(
+    const std::string& hullsHandle,
+    const CollisionMeshPreprocessor::Hulls& hulls) {
+  const int meshStart = meshes_.size();
+  const int meshEnd = meshStart + hulls.size() - 1;
+  MeshMetaData meshMetaData{meshStart, meshEnd};
+
+  std::vector<CollisionMeshData> meshGroup;
+  for (size_t iHull = 0; iHull < hulls.size(); ++iHull) {
+    const std::vector<Mn::Vector3>& positions = hulls[iHull];
+    std::vector<Mn::UnsignedInt> indices(positions.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      indices[i] = i;
+    }
+
+    // create a temporary mesh object referencing the above data, the hull
+    // mesh copies it
+    Mn::Trade::MeshData hullMesh{
+        Mn::MeshPrimitive::Points,
+        {},
+        indices,
+        Mn::Trade::MeshIndexData{indices},
+        {},
+        positions,
+        {Mn::Trade::MeshAttributeData{Mn::Trade::MeshAttribute::Position,
+                                      Cr::Containers::arrayView(positions)}}};
+    auto hullMeshData = std::make_unique<GenericMeshData>(false);
+    hullMeshData->setMeshData(std::move(hullMesh));
+    hullMeshData->BB = computeMeshBB(hullMeshData.get());
+    meshGroup.push_back(hullMeshData->getCollisionMeshData());
+    meshes_.emplace_back(std::move(hullMeshData));
+
+    MeshTransformNode node;
+    node.meshIDLocal = iHull;
+    node.componentID = iHull;
+    meshMetaData.root.children.push_back(node);
+  }
+
+  AssetInfo info{AssetType::UNKNOWN, hullsHandle};
+  resourceDict_.emplace(hullsHandle, LoadedAssetData{info, meshMetaData});
+  collisionMeshGroups_.emplace(hullsHandle, std::move(meshGroup));
+}  // registerCollisionHulls
+
 Magnum::Range3D ResourceManager::computeMeshBB(BaseMesh* meshDataGL) {
   CollisionMeshData& meshData = meshDataGL->getCollisionMeshData();
   return Mn::Math::minmax(meshData.positions);
@@ -1015,11 +1163,15 @@ bool ResourceManager::loadGeneralMeshData(
 
     // if this is a new file, load it and add it to the dictionary
     LoadedAssetData loadedAssetData{info};
+    // decode and prepare the data on the loader threads, then upload it here,
+    // on the thread owning the GL context
+    std::vector<std::unique_ptr<GenericMeshData>> meshes;
+    importAssetData(*fileImporter_, loadedAssetData, meshes);
     if (requiresTextures_) {
-      loadTextures(*fileImporter_, loadedAssetData);
+      loadTextures(filename, *fileImporter_, loadedAssetData);
       loadMaterials(*fileImporter_, loadedAssetData);
     }
-    loadMeshes(*fileImporter_, loadedAssetData);
+    uploadMeshes(meshes, loadedAssetData);
     auto inserted = resourceDict_.emplace(filename, std::move(loadedAssetData));
     MeshMetaData& meshMetaData = inserted.first->second.meshMetaData;
 
@@ -1391,24 +1543,224 @@ gfx::PbrMaterialData::uptr ResourceManager::buildPbrShadedMaterialData(
   return finalMaterial;
 }
 
-void ResourceManager::loadMeshes(Importer& importer,
-                                 LoadedAssetData& loadedAssetData) {
+void ResourceManager::importAssetData(
+    Importer& importer,
+    const LoadedAssetData& loadedAssetData,
+    std::vector<std::unique_ptr<GenericMeshData>>& meshes) {
+  std::vector<Cr::Containers::Optional<Mn::Trade::MeshData>> meshData;
+  meshData.reserve(importer.meshCount());
+  for (int iMesh = 0; iMesh < importer.meshCount(); ++iMesh) {
+    meshData.emplace_back(importer.mesh(iMesh));
+    CORRADE_INTERNAL_ASSERT(meshData.back());
+  }
+
+  meshes.clear();
+  meshes.resize(meshData.size());
+
+  // every job only touches its own mesh
+  const bool requiresLighting = loadedAssetData.assetInfo.requiresLighting;
+  loaderThreadPool().parallelFor(
+      meshes.size(), [&](const size_t iMesh, size_t) {
+        // don't need normals if we aren't using lighting
+        auto mesh = std::make_unique<GenericMeshData>(requiresLighting);
+        mesh->setMeshData(*std::move(meshData[iMesh]));
+
+        // compute the mesh bounding box
+        mesh->BB = computeMeshBB(mesh.get());
+        meshes[iMesh] = std::move(mesh);
+      });
+}
+
+struct ResourceManager::LoaderFileCache {
+  // the importers may read files referenced by the asset, e.g. images, from
+  // the loader threads
+  std::mutex mutex;
+  std::map<std::string, Cr::Containers::Array<char>> files;
+};
+
+void ResourceManager::loadTextures(const std::string& filename,
+                                   Importer& importer,
+                                   LoadedAssetData& loadedAssetData) {
+  const size_t numTextures = importer.textureCount();
+  int textureStart = textures_.size();
+  int textureEnd = textureStart + numTextures - 1;
+  loadedAssetData.meshMetaData.setTextureIndices(textureStart, textureEnd);
+  if (numTextures == 0) {
+    return;
+  }
+
+  // a single texture is decoded right here, without reopening the file
+  core::ThreadPool& threadPool = loaderThreadPool();
+  const size_t numImporters =
+      numTextures > 1 ? threadPool.numThreads() : size_t{1};
+  LoaderFileCache fileCache;
+  std::vector<Importer*> importers =
+      openLoaderImporters(filename, importer, numImporters, fileCache);
+
+  // decode a few textures per thread, then upload them and release their
+  // images before decoding the next batch
+  std::vector<ImportedTexture> batch;
+  const size_t batchSize = 2 * importers.size();
+  for (size_t batchStart = 0; batchStart < numTextures;
+       batchStart += batchSize) {
+    batch.clear();
+    batch.resize(std::min(batchSize, numTextures - batchStart));
+    if (importers.size() == 1) {
+      for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i] = importTexture(importer, batchStart + i);
+      }
+    } else {
+      threadPool.parallelFor(
+          batch.size(), [&](const size_t i, const size_t workerId) {
+            batch[i] = importTexture(*importers[workerId], batchStart + i);
+          });
+    }
+    for (ImportedTexture& importedTexture : batch) {
+      uploadTexture(importedTexture);
+    }
+  }
+
+  // don't keep the file data of the loader importers around
+  for (Importer* loaderImporter : importers) {
+    if (loaderImporter != &importer) {
+      loaderImporter->close();
+      loaderImporter->setFileCallback(nullptr);
+    }
+  }
+}
+
+std::vector<Importer*> ResourceManager::openLoaderImporters(
+    const std::string& filename,
+    Importer& importer,
+    const size_t numImporters,
+    LoaderFileCache& fileCache) {
+  // every file is read once and shared by all the importers, which only
+  // parse it
+  auto fileCallback = +[](const std::string& file,
+                          Mn::InputFileCallbackPolicy policy,
+                          LoaderFileCache& cache)
+      -> Cr::Containers::Optional<Cr::Containers::ArrayView<const char>> {
+    // the data is kept until all the importers are closed
+    if (policy == Mn::InputFileCallbackPolicy::Close) {
+      return {};
+    }
+    std::lock_guard<std::mutex> lock{cache.mutex};
+    auto found = cache.files.find(file);
+    if (found == cache.files.end()) {
+      if (!Cr::Utility::Directory::exists(file)) {
+        return {};
+      }
+      found = cache.files.emplace(file, Cr::Utility::Directory::read(file))
+                  .first;
+    }
+    return Cr::Containers::ArrayView<const char>{found->second};
+  };
+
+  std::vector<Importer*> importers;
+  if (numImporters > 1) {
+    std::string basisFormat;
+    if (Cr::PluginManager::PluginMetadata* const metadata =
+            importerManager_.metadata("BasisImporter")) {
+      basisFormat = metadata->configuration().value("format");
+    }
+    for (size_t i = 0; i + 1 < numImporters; ++i) {
+      if (i == loaderImporters_.size()) {
+        LoaderImporter loaderImporter;
+#ifdef MAGNUM_BUILD_STATIC
+        loaderImporter.manager =
+            std::make_unique<Cr::PluginManager::Manager<Importer>>(
+                "nonexistent");
+#else
+        loaderImporter.manager =
+            std::make_unique<Cr::PluginManager::Manager<Importer>>();
+#endif
+        loaderImporter.manager->setPreferredPlugins("GltfImporter",
+                                                    {"TinyGltfImporter"});
+#ifdef ESP_BUILD_ASSIMP_SUPPORT
+        loaderImporter.manager->setPreferredPlugins("ObjImporter",
+                                                    {"AssimpImporter"});
+#endif
+        // load the image importers here, the loader threads then only
+        // instantiate them through their own manager
+        for (const char* plugin : {"AnyImageImporter", "BasisImporter",
+                                   "JpegImporter", "PngImporter"}) {
+          if (loaderImporter.manager->loadState(plugin) ==
+              Cr::PluginManager::LoadState::NotLoaded) {
+            loaderImporter.manager->load(plugin);
+          }
+        }
+        loaderImporter.importer =
+            loaderImporter.manager->loadAndInstantiate("AnySceneImporter");
+        if (!loaderImporter.importer) {
+          break;
+        }
+        loaderImporters_.emplace_back(std::move(loaderImporter));
+      }
+      LoaderImporter& loaderImporter = loaderImporters_[i];
+      if (!basisFormat.empty()) {
+        if (Cr::PluginManager::PluginMetadata* const metadata =
+                loaderImporter.manager->metadata("BasisImporter")) {
+          metadata->configuration().setValue("format", basisFormat);
+        }
+      }
+      loaderImporter.importer->setFileCallback(fileCallback, fileCache);
+      if (!loaderImporter.importer->openFile(filename)) {
+        loaderImporter.importer->setFileCallback(nullptr);
+        break;
+      }
+      importers.push_back(loaderImporter.importer.get());
+    }
+    if (importers.size() + 1 < numImporters) {
+      LOG(WARNING) << "ResourceManager::openLoaderImporters : Cannot open "
+                   << filename << " on the loader threads, decoding its "
+                   << "textures on the calling thread only.";
+      for (Importer* loaderImporter : importers) {
+        loaderImporter->close();
+        loaderImporter->setFileCallback(nullptr);
+      }
+      importers.clear();
+    }
+  }
+  // the calling thread has the last worker id of the pool
+  importers.push_back(&importer);
+  return importers;
+}
+
+void ResourceManager::uploadMeshes(
+    std::vector<std::unique_ptr<GenericMeshData>>& meshes,
+    LoadedAssetData& loadedAssetData) {
   int meshStart = meshes_.size();
-  int meshEnd = meshStart + importer.meshCount() - 1;
+  int meshEnd = meshStart + meshes.size() - 1;
   loadedAssetData.meshMetaData.setMeshIndices(meshStart, meshEnd);
 
-  for (int iMesh = 0; iMesh < importer.meshCount(); ++iMesh) {
-    // don't need normals if we aren't using lighting
-    auto gltfMeshData = std::make_unique<GenericMeshData>(
-        loadedAssetData.assetInfo.requiresLighting);
-    gltfMeshData->importAndSetMeshData(importer, iMesh);
+  for (auto& mesh : meshes) {
+    mesh->uploadBuffersToGPU(false);
+    meshes_.emplace_back(std::move(mesh));
+  }
+  meshes.clear();
+}
 
-    // compute the mesh bounding box
-    gltfMeshData->BB = computeMeshBB(gltfMeshData.get());
+void ResourceManager::setNumLoaderThreads(size_t numThreads) {
+  if (numThreads == numLoaderThreads_) {
+    return;
+  }
+  numLoaderThreads_ = numThreads;
+  loaderThreadPool_.reset();
+}
 
-    gltfMeshData->uploadBuffersToGPU(false);
-    meshes_.emplace_back(std::move(gltfMeshData));
+size_t ResourceManager::getNumLoaderThreads() const {
+  if (loaderThreadPool_) {
+    return loaderThreadPool_->numThreads();
   }
+  return numLoaderThreads_ > 0 ? numLoaderThreads_
+                               : core::ThreadPool::hardwareConcurrency();
+}
+
+core::ThreadPool& ResourceManager::loaderThreadPool() {
+  if (!loaderThreadPool_) {
+    loaderThreadPool_ = std::make_unique<core::ThreadPool>(numLoaderThreads_);
+  }
+  return *loaderThreadPool_;
 }
 
 //! Recursively load the transformation chain specified by the mesh file
@@ -1450,81 +1802,90 @@ void ResourceManager::loadMeshHierarchy(Importer& importer,
   }
 }
 
-void ResourceManager::loadTextures(Importer& importer,
-                                   LoadedAssetData& loadedAssetData) {
-  int textureStart = textures_.size();
-  int textureEnd = textureStart + importer.textureCount() - 1;
-  loadedAssetData.meshMetaData.setTextureIndices(textureStart, textureEnd);
-
-  for (int iTexture = 0; iTexture < importer.textureCount(); ++iTexture) {
-    textures_.emplace_back(std::make_shared<Magnum::GL::Texture2D>());
-    auto& currentTexture = textures_.back();
+ResourceManager::ImportedTexture ResourceManager::importTexture(
+    Importer& importer,
+    int textureID) {
+  ImportedTexture texture;
+  texture.textureData = importer.texture(textureID);
+  if (!texture.textureData || texture.textureData->type() !=
+                                  Magnum::Trade::TextureData::Type::Texture2D) {
+    LOG(ERROR) << "Cannot load texture " << textureID << " skipping";
+    texture.textureData = Cr::Containers::NullOpt;
+    return texture;
+  }
 
-    auto textureData = importer.texture(iTexture);
-    if (!textureData ||
-        textureData->type() != Magnum::Trade::TextureData::Type::Texture2D) {
-      LOG(ERROR) << "Cannot load texture " << iTexture << " skipping";
-      currentTexture = nullptr;
-      continue;
+  // Load all mip levels
+  const std::uint32_t levelCount =
+      importer.image2DLevelCount(texture.textureData->image());
+  for (std::uint32_t level = 0; level != levelCount; ++level) {
+    // TODO:
+    // it seems we have a way to just load the image once in this case,
+    // as long as the image2DName include the full path to the image
+    Cr::Containers::Optional<Mn::Trade::ImageData2D> image =
+        importer.image2D(texture.textureData->image(), level);
+    if (!image) {
+      // Mip level loading failed, fail the whole texture
+      LOG(ERROR) << "Cannot load texture image, skipping";
+      texture.textureData = Cr::Containers::NullOpt;
+      texture.levels.clear();
+      break;
     }
+    texture.levels.emplace_back(*std::move(image));
+  }
+  return texture;
+}  // ResourceManager::importTexture
 
-    // Configure the texture
-    Mn::GL::Texture2D& texture = *(textures_[textureStart + iTexture].get());
-    texture.setMagnificationFilter(textureData->magnificationFilter())
-        .setMinificationFilter(textureData->minificationFilter(),
-                               textureData->mipmapFilter())
-        .setWrapping(textureData->wrapping().xy());
-
-    // Load all mip levels
-    const std::uint32_t levelCount =
-        importer.image2DLevelCount(textureData->image());
-    bool generateMipmap = false;
-    for (std::uint32_t level = 0; level != levelCount; ++level) {
-      // TODO:
-      // it seems we have a way to just load the image once in this case,
-      // as long as the image2DName include the full path to the image
-      Cr::Containers::Optional<Mn::Trade::ImageData2D> image =
-          importer.image2D(textureData->image(), level);
-      if (!image) {
-        LOG(ERROR) << "Cannot load texture image, skipping";
-        currentTexture = nullptr;
-        break;
-      }
-
-      Mn::GL::TextureFormat format;
-      if (image->isCompressed()) {
-        format = Mn::GL::textureFormat(image->compressedFormat());
-      } else {
-        format = Mn::GL::textureFormat(image->format());
-      }
-
-      // For the very first level, allocate the texture
-      if (level == 0) {
-        // If there is just one level and the image is not compressed, we'll
-        // generate mips ourselves
-        if (levelCount == 1 && !image->isCompressed()) {
-          texture.setStorage(Mn::Math::log2(image->size().max()) + 1, format,
-                             image->size());
-          generateMipmap = true;
-        } else
-          texture.setStorage(levelCount, format, image->size());
-      }
-
-      if (image->isCompressed())
-        texture.setCompressedSubImage(level, {}, *image);
-      else
-        texture.setSubImage(level, {}, *image);
+void ResourceManager::uploadTexture(ImportedTexture& importedTexture) {
+  if (!importedTexture.textureData) {
+    textures_.emplace_back(nullptr);
+    return;
+  }
+  const Mn::Trade::TextureData& textureData = *importedTexture.textureData;
+
+  // Configure the texture
+  auto texture = std::make_shared<Magnum::GL::Texture2D>();
+  texture->setMagnificationFilter(textureData.magnificationFilter())
+      .setMinificationFilter(textureData.minificationFilter(),
+                             textureData.mipmapFilter())
+      .setWrapping(textureData.wrapping().xy());
+
+  const std::uint32_t levelCount = importedTexture.levels.size();
+  bool generateMipmap = false;
+  for (std::uint32_t level = 0; level != levelCount; ++level) {
+    const Mn::Trade::ImageData2D& image = importedTexture.levels[level];
+
+    Mn::GL::TextureFormat format;
+    if (image.isCompressed()) {
+      format = Mn::GL::textureFormat(image.compressedFormat());
+    } else {
+      format = Mn::GL::textureFormat(image.format());
     }
 
-    // Mip level loading failed, fail the whole texture
-    if (currentTexture == nullptr)
-      continue;
+    // For the very first level, allocate the texture
+    if (level == 0) {
+      // If there is just one level and the image is not compressed, we'll
+      // generate mips ourselves
+      if (levelCount == 1 && !image.isCompressed()) {
+        texture->setStorage(Mn::Math::log2(image.size().max()) + 1, format,
+                            image.size());
+        generateMipmap = true;
+      } else
+        texture->setStorage(levelCount, format, image.size());
+    }
 
-    // Generate a mipmap if requested
-    if (generateMipmap)
-      texture.generateMipmap();
+    if (image.isCompressed())
+      texture->setCompressedSubImage(level, {}, image);
+    else
+      texture->setSubImage(level, {}, image);
   }
-}  // ResourceManager::loadTextures
+
+  // Generate a mipmap if requested
+  if (generateMipmap)
+    texture->generateMipmap();
+
+  textures_.emplace_back(std::move(texture));
+  importedTexture.levels.clear();
+}  // ResourceManager::uploadTexture
 
 bool ResourceManager::instantiateAssetsOnDemand(
     const std::string& objectTemplateHandle) {
@@ -1584,6 +1945,17 @@ bool ResourceManager::instantiateAssetsOnDemand(
   if (!ObjectAttributes->getCollisionAssetIsPrimitive()) {
     const auto collisionAssetHandle =
         ObjectAttributes->getCollisionAssetHandle();
+    // preprocessed hulls replace the collision asset when requested, fall
+    // back to the collision asset itself if they cannot be built
+    if (getCollisionHullOptions(*ObjectAttributes).enabled()) {
+      if (loadObjectCollisionHulls(*ObjectAttributes, objectTemplateHandle,
+                                   !renderMeshSuccess && requiresLighting)) {
+        return true;
+      }
+      LOG(WARNING) << "Unable to preprocess collision asset "
+                   << collisionAssetHandle << " for " << objectTemplateHandle
+                   << ", using it as is.";
+    }
     if (resourceDict_.count(collisionAssetHandle) == 0) {
       bool collisionMeshSuccess = loadObjectMeshDataFromFile(
           collisionAssetHandle, objectTemplateHandle, "collision",
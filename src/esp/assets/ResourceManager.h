@@ -23,13 +23,17 @@
 #include <Magnum/MeshTools/Compile.h>
 #include <Magnum/MeshTools/Transform.h>
 #include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/Trade/ImageData.h>
+#include <Magnum/Trade/TextureData.h>
 
 #include "Asset.h"
 #include "BaseMesh.h"
 #include "CollisionMeshData.h"
+#include "CollisionMeshPreprocessor.h"
 #include "GenericMeshData.h"
 #include "MeshData.h"
 #include "MeshMetaData.h"
+#include "esp/core/ThreadPool.h"
 #include "esp/gfx/Drawable.h"
 #include "esp/gfx/DrawableGroup.h"
 #include "esp/gfx/MaterialData.h"
@@ -108,6 +112,12 @@ class ResourceManager {
   static constexpr char PER_VERTEX_OBJECT_ID_MATERIAL_KEY[] =
       "per_vertex_object_id";
 
+  /**
+   * @brief The default number of loader threads, see @ref
+   * setNumLoaderThreads.
+   */
+  static constexpr size_t DEFAULT_NUM_LOADER_THREADS = 4;
+
   /**
    * @brief Flag
    *
@@ -231,6 +241,22 @@ class ResourceManager {
     return collisionMeshGroups_.at(collisionAssetHandle);
   }
 
+  /**
+   * @brief Get the key of the collision meshes to build an object's mesh
+   * collision shape from, in @ref collisionMeshGroups_ and @ref
+   * resourceDict_.
+   *
+   * This is the handle of the preprocessed collision hulls if the object's
+   * attributes request them and they were built by @ref
+   * instantiateAssetsOnDemand, otherwise the object's collision asset handle.
+   * The preprocessed hulls already reflect the attributes' join setting.
+   *
+   * @param objectAttributes The attributes of the object.
+   * @return The collision mesh key.
+   */
+  std::string getObjectCollisionMeshHandle(
+      const metadata::attributes::ObjectAttributes& objectAttributes) const;
+
   /**
    * @brief Return manager for construction and access to asset attributes.
    */
@@ -464,10 +490,30 @@ class ResourceManager {
    */
   inline void setRequiresTextures(bool newVal) { requiresTextures_ = newVal; }
 
+  /**
+   * @brief Set the number of threads importing and preparing the meshes and
+   * textures of an asset before they are uploaded to the GPU, see @ref
+   * loadGeneralMeshData.
+   *
+   * Every ResourceManager owns its pool, hence the default of @ref
+   * DEFAULT_NUM_LOADER_THREADS rather than one thread per core.
+   *
+   * @param numThreads The number of threads, including the calling thread. 0
+   * uses the number of hardware threads.
+   */
+  void setNumLoaderThreads(size_t numThreads);
+
+  /**
+   * @return The number of threads preparing asset data.
+   */
+  size_t getNumLoaderThreads() const;
+
  private:
   /**
    * @brief Load the requested mesh info into @ref meshInfo corresponding to
-   * specified @ref meshType used by @ref objectTemplateHandle
+   * specified @ref meshType used by @ref objectTemplateHandle. Collision hull
+   * cache files written by @ref CollisionMeshPreprocessor are registered as
+   * collision-only assets, see @ref loadObjectCollisionHulls.
    *
    * @param filename the name of the file describing this mesh
    * @param objectTemplateHandle the handle for the object attributes owning
@@ -482,6 +528,35 @@ class ResourceManager {
                                   const std::string& meshType,
                                   const bool requiresLighting);
 
+  /**
+   * @brief Load or build the preprocessed collision hulls of an object's
+   * collision asset, as requested by its attributes. A valid hull cache next to
+   * the collision asset is used as is, otherwise the hulls are built from the
+   * collision asset and the cache is (re)written.
+   *
+   * @param objectAttributes The attributes of the object.
+   * @param objectTemplateHandle the handle for the object attributes (for
+   * error log output)
+   * @param requiresLighting whether or not the collision asset responds to
+   * lighting, if it has to be loaded
+   * @return whether or not the hulls are available
+   */
+  bool loadObjectCollisionHulls(
+      const metadata::attributes::ObjectAttributes& objectAttributes,
+      const std::string& objectTemplateHandle,
+      bool requiresLighting);
+
+  /**
+   * @brief Register convex hulls as a collision-only asset in @ref
+   * resourceDict_, @ref meshes_ and @ref collisionMeshGroups_. Each hull is a
+   * separate point mesh under the root of a flat hierarchy.
+   *
+   * @param hullsHandle The key of the asset.
+   * @param hulls The hull point sets, in the local space of the asset.
+   */
+  void registerCollisionHulls(const std::string& hullsHandle,
+                              const CollisionMeshPreprocessor::Hulls& hulls);
+
   /**
    * @brief Build a primitive asset based on passed template parameters.  If
    * exists already, does nothing.  Will use primitiveImporter_ to call
@@ -503,6 +578,23 @@ class ResourceManager {
     MeshMetaData meshMetaData;
   };
 
+  /**
+   * @brief A texture decoded by @ref importTexture, waiting to be uploaded by
+   * @ref uploadTexture.
+   */
+  struct ImportedTexture {
+    /**
+     * @brief The sampler settings and image reference of the texture, empty
+     * if the texture or any of its images could not be imported.
+     */
+    Corrade::Containers::Optional<Mn::Trade::TextureData> textureData;
+
+    /**
+     * @brief The decoded image levels, starting with the base level.
+     */
+    std::vector<Mn::Trade::ImageData2D> levels;
+  };
+
   /**
    * node: drawable's scene node
    *
@@ -552,25 +644,100 @@ class ResourceManager {
                     std::vector<StaticDrawableInfo>& staticDrawableInfo);
 
   /**
-   * @brief Load textures from importer into assets, and update metaData for
-   * an asset to link textures to that asset.
+   * @brief Import and prepare the meshes of an asset, without touching the
+   * GPU.
+   *
+   * The meshes are extracted by the importer first, as it is not thread-safe,
+   * then the loader threads interleave them, unpack their collision data and
+   * compute their bounding boxes. See @ref setNumLoaderThreads.
    *
    * @param importer The importer already loaded with information for the
    * asset.
    * @param loadedAssetData The asset's @ref LoadedAssetData object.
+   * @param meshes The prepared meshes, not uploaded yet.
+   */
+  void importAssetData(Importer& importer,
+                       const LoadedAssetData& loadedAssetData,
+                       std::vector<std::unique_ptr<GenericMeshData>>& meshes);
+
+  /**
+   * @brief Decode the textures of an asset on the loader threads and upload
+   * them into assets, and update metaData for an asset to link textures to
+   * that asset. Must be called on the thread owning the GL context.
+   *
+   * Every loader thread decodes through its own importer, see @ref
+   * openLoaderImporters. The textures are decoded and uploaded in batches of
+   * a few per thread, so the decoded images of the whole asset are never
+   * held at once.
+   *
+   * @param filename The file of the asset.
+   * @param importer The importer already loaded with information for the
+   * asset, used by the calling thread.
+   * @param loadedAssetData The asset's @ref LoadedAssetData object.
    */
-  void loadTextures(Importer& importer, LoadedAssetData& loadedAssetData);
+  void loadTextures(const std::string& filename,
+                    Importer& importer,
+                    LoadedAssetData& loadedAssetData);
+
+  //! The files shared by the importers of the loader threads, see @ref
+  //! openLoaderImporters
+  struct LoaderFileCache;
 
   /**
-   * @brief Load meshes from importer into assets.
+   * @brief Open a file in the importers of the loader threads.
+   *
+   * Magnum importers are not thread-safe, and neither is the plugin manager
+   * they instantiate image importers through, so every loader thread gets an
+   * importer created by its own plugin manager, with the configuration of
+   * @ref importerManager_. They are created on first use and kept, and are
+   * opened here, on the calling thread. They read the file, and the files it
+   * references, through @p fileCache, so each is read from disk only once.
+   *
+   * @param filename The file to open.
+   * @param importer The importer of the calling thread, already loaded with
+   * the file.
+   * @param numImporters The number of importers needed.
+   * @param fileCache The data of the files read by the importers, which must
+   * outlive their use.
+   * @return One importer per worker id of @ref loaderThreadPool, the last one
+   * being @p importer. Only @p importer if the file could not be opened
+   * again.
+   */
+  std::vector<Importer*> openLoaderImporters(const std::string& filename,
+                                             Importer& importer,
+                                             size_t numImporters,
+                                             LoaderFileCache& fileCache);
+
+  /**
+   * @brief Import a texture and decode all its image levels.
    *
-   * Compute bounding boxes, upload mesh data to GPU, and update metaData for
-   * an asset to link meshes to that asset.
    * @param importer The importer already loaded with information for the
    * asset.
+   * @param textureID The local identifier of the texture in the asset.
+   * @return The texture, with empty @ref ImportedTexture::textureData on
+   * failure.
+   */
+  ImportedTexture importTexture(Importer& importer, int textureID);
+
+  /**
+   * @brief Upload a texture decoded by @ref importTexture and append it to
+   * @ref textures_. Must be called on the thread owning the GL context.
+   *
+   * @param importedTexture The imported texture. The images are released
+   * once uploaded.
+   */
+  void uploadTexture(ImportedTexture& importedTexture);
+
+  /**
+   * @brief Upload meshes prepared by @ref importAssetData to the GPU, move
+   * them into assets and update metaData for an asset to link meshes to that
+   * asset. Must be called on the thread owning the GL context.
+   *
+   * @param meshes The prepared meshes, moved from.
    * @param loadedAssetData The asset's @ref LoadedAssetData object.
    */
-  void loadMeshes(Importer& importer, LoadedAssetData& loadedAssetData);
+  void uploadMeshes(std::vector<std::unique_ptr<GenericMeshData>>& meshes,
+                    LoadedAssetData& loadedAssetData);
 
   /**
    * @brief Recursively parse the mesh component transformation heirarchy for
@@ -956,6 +1123,25 @@ class ResourceManager {
    * @brief Flag to load textures of meshes
    */
   bool requiresTextures_ = true;
+
+  //! Number of threads preparing asset data, 0 means hardware concurrency
+  size_t numLoaderThreads_ = DEFAULT_NUM_LOADER_THREADS;
+  //! Created on first use, see loaderThreadPool()
+  std::unique_ptr<core::ThreadPool> loaderThreadPool_ = nullptr;
+
+  //! An importer of a loader thread, see @ref openLoaderImporters
+  struct LoaderImporter {
+    std::unique_ptr<Corrade::PluginManager::Manager<Importer>> manager;
+    Corrade::Containers::Pointer<Importer> importer;
+  };
+  //! The importers of the loader threads besides the calling one
+  std::vector<LoaderImporter> loaderImporters_;
+
+  /**
+   * @brief The pool running @ref importAssetData, created on first use with
+   * @ref getNumLoaderThreads threads.
+   */
+  core::ThreadPool& loaderThreadPool();
 };
 
 CORRADE_ENUMSET_OPERATORS(ResourceManager::Flags)
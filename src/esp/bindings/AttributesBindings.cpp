@@ -195,6 +195,22 @@ void initAttributesBindings(py::module& m) {
           &ObjectAttributes::setJoinCollisionMeshes,
           R"(Whether collision meshes for objects constructed from this
           template should be joined into a convex hull or kept separate.)")
+      .def_property(
+          "collision_hull_max_vertices",
+          &ObjectAttributes::getCollisionHullMaxVertices,
+          &ObjectAttributes::setCollisionHullMaxVertices,
+          R"(The maximum number of vertices of each convex collision hull for
+          objects constructed from this template. 0 keeps every hull vertex.)")
+      .def_property(
+          "convex_decomposition", &ObjectAttributes::getConvexDecomposition,
+          &ObjectAttributes::setConvexDecomposition,
+          R"(Whether concave collision meshes for objects constructed from
+          this template should be split into several convex parts.)")
+      .def_property(
+          "max_convex_parts", &ObjectAttributes::getMaxConvexParts,
+          &ObjectAttributes::setMaxConvexParts,
+          R"(The maximum number of convex parts a collision mesh is split into
+          by the convex decomposition.)")
       .def_property(
           "is_visibile", &ObjectAttributes::getIsVisible,
           &ObjectAttributes::setIsVisible,
@@ -300,8 +316,20 @@ void initAttributesBindings(py::module& m) {
                     R"(The timestep to use for forward simulation.)")
       .def_property("max_substeps", &PhysicsManagerAttributes::getMaxSubsteps,
                     &PhysicsManagerAttributes::setMaxSubsteps,
-                    R"(Maximum simulation steps between each rendering step.
-                    (Not currently implemented).)")
+                    R"(Maximum number of fixed timesteps simulated by a single
+                    step. Time beyond this budget is dropped. 0 for no limit.)")
+      .def_property(
+          "substep_interpolation",
+          &PhysicsManagerAttributes::getSubstepInterpolation,
+          &PhysicsManagerAttributes::setSubstepInterpolation,
+          R"(Whether poses are interpolated over the time left after the last
+          fixed timestep of a step. If false, only whole timesteps are
+          simulated and the remaining time is carried over to the next step,
+          making the simulation independent of how time is split into steps.)")
+      .def_property("solver_seed", &PhysicsManagerAttributes::getSolverSeed,
+                    &PhysicsManagerAttributes::setSolverSeed,
+                    R"(Seed of the random number generator of the constraint
+                    solver.)")
       .def_property(
           "gravity", &PhysicsManagerAttributes::getGravity,
           &PhysicsManagerAttributes::setGravity,
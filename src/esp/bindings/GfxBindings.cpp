@@ -14,6 +14,7 @@
 #include "python/corrade/EnumOperators.h"
 
 #include "esp/assets/ResourceManager.h"
+#include "esp/gfx/BatchRenderer.h"
 #include "esp/gfx/LightSetup.h"
 #include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/RenderTarget.h"
@@ -90,8 +91,55 @@ void initGfxBindings(py::module& m) {
           },
           R"(Draw given scene using the camera)", "camera"_a, "scene"_a,
           "flags"_a = RenderCamera::Flag{RenderCamera::Flag::FrustumCulling})
+      .def(
+          "draw_sensors",
+          [](Renderer& self,
+             const std::vector<sensor::VisualSensor*>& visualSensors,
+             scene::SceneGraph& sceneGraph, RenderCamera::Flag flags) {
+            self.drawSensors(visualSensors, sceneGraph,
+                             RenderCamera::Flags{flags});
+          },
+          R"(Draw given scene into the render targets of several visual
+          sensors, sharing the render pass of sensors with the same view)",
+          "visualSensors"_a, "scene"_a,
+          "flags"_a = RenderCamera::Flag{RenderCamera::Flag::FrustumCulling})
       .def("bind_render_target", &Renderer::bindRenderTarget);
 
+  py::class_<BatchRenderer, BatchRenderer::ptr>(
+      m, "BatchRenderer",
+      R"(Renders the sensors of many scenes into the tiles of a single atlas
+      framebuffer, read back at once as a [N, H, W, C] buffer.)")
+      .def(py::init(&BatchRenderer::create<const Magnum::Vector2i&, int>),
+           "tile_size"_a, "num_tiles"_a)
+      .def_property_readonly("tile_size", &BatchRenderer::tileSize)
+      .def_property_readonly("num_tiles", &BatchRenderer::numTiles)
+      .def_property_readonly("atlas_size", &BatchRenderer::atlasSize)
+      .def("tile_viewport", &BatchRenderer::tileViewport, "tile"_a)
+      .def("__enter__",
+           [](BatchRenderer& self) {
+             self.renderEnter();
+             return &self;
+           })
+      .def("__exit__",
+           [](BatchRenderer& self, py::object exc_type, py::object exc_value,
+              py::object traceback) { self.renderExit(); })
+      .def(
+          "draw",
+          [](BatchRenderer& self, int tile, sensor::VisualSensor& visualSensor,
+             scene::SceneGraph& sceneGraph, RenderCamera::Flag flags) {
+            return self.draw(tile, visualSensor, sceneGraph,
+                             RenderCamera::Flags{flags});
+          },
+          R"(Draw given scene into a tile using the visual sensor, whose
+          resolution must match the tile size. Returns whether it was drawn.)",
+          "tile"_a, "visualSensor"_a, "scene"_a,
+          "flags"_a = RenderCamera::Flag{RenderCamera::Flag::FrustumCulling})
+      .def("read_frame_rgba", &BatchRenderer::readFrameRgba,
+           R"(Reads the RGBA frames of all the tiles into passed img, of size
+           (W, H, N), in uint8 byte format.)")
+      .def("read_frame_depth", &BatchRenderer::readFrameDepth)
+      .def("read_frame_object_id", &BatchRenderer::readFrameObjectId);
+
   py::class_<RenderTarget>(m, "RenderTarget")
       .def("__enter__",
            [](RenderTarget& self) {
@@ -105,7 +153,22 @@ void initGfxBindings(py::module& m) {
            "Reads RGBA frame into passed img in uint8 byte format.")
       .def("read_frame_depth", &RenderTarget::readFrameDepth)
       .def("read_frame_object_id", &RenderTarget::readFrameObjectId)
+      .def("queue_read_frame_rgba", &RenderTarget::queueReadFrameRgba,
+           R"(Queue an asynchronous read of the RGBA frame into a pixel pack
+           buffer, to be retrieved with retrieve_queued_frame.)")
+      .def("queue_read_frame_depth", &RenderTarget::queueReadFrameDepth)
+      .def("queue_read_frame_object_id",
+           &RenderTarget::queueReadFrameObjectId)
+      .def_property_readonly("num_queued_reads",
+                             &RenderTarget::numQueuedReads)
+      .def("retrieve_queued_frame", &RenderTarget::retrieveQueuedFrame,
+           R"(Retrieve the oldest queued read into passed img, waiting for the
+           GPU unless wait is False. Returns whether img was written.)",
+           "img"_a, "wait"_a = true)
       .def("blit_rgba_to_default", &RenderTarget::blitRgbaToDefault)
+      .def("copy_from", &RenderTarget::copyFrom,
+           R"(Copy the frame of another render target of the same size.)",
+           "source"_a)
 #ifdef ESP_BUILD_WITH_CUDA
       .def("read_frame_rgba_gpu",
            [](RenderTarget& self, size_t devPtr) {
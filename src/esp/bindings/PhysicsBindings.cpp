@@ -1,6 +1,8 @@
 #include "esp/bindings/bindings.h"
 #include "esp/physics/PhysicsManager.h"
+#include "esp/physics/PhysicsWorldBatch.h"
 #include "esp/physics/RigidObject.h"
+#include "esp/sim/Simulator.h"
 
 namespace py = pybind11;
 using py::literals::operator""_a;
@@ -48,6 +50,109 @@ void initPhysicsBindings(py::module& m) {
       .def_readonly("hits", &RaycastResults::hits)
       .def_readonly("ray", &RaycastResults::ray)
       .def("has_hits", &RaycastResults::hasHits);
+
+  // ==== struct object BatchedRaycastResults ====
+  py::class_<BatchedRaycastResults, BatchedRaycastResults::ptr>(
+      m, "BatchedRaycastResults",
+      R"(Hits of a batch of ray casts as flat arrays with one row per hit. The
+      hits of ray i are rows hit_offsets[i]:hit_offsets[i + 1], sorted by
+      distance. The arrays are read-only views, valid as long as the results
+      object is alive.)")
+      .def(py::init(&BatchedRaycastResults::create<>))
+      .def_readonly("hit_offsets", &BatchedRaycastResults::hitOffsets)
+      .def_readonly("object_ids", &BatchedRaycastResults::objectIds)
+      .def_readonly("points", &BatchedRaycastResults::points)
+      .def_readonly("normals", &BatchedRaycastResults::normals)
+      .def_readonly("ray_distances", &BatchedRaycastResults::rayDistances)
+      .def_property_readonly("num_rays", &BatchedRaycastResults::numRays)
+      .def("num_hits", &BatchedRaycastResults::numHits, "ray_index"_a);
+
+  // ==== enum object ContactEventType ====
+  py::enum_<ContactEventType>(m, "ContactEventType")
+      .value("BEGIN", ContactEventType::BEGIN)
+      .value("PERSIST", ContactEventType::PERSIST)
+      .value("END", ContactEventType::END);
+
+  // ==== struct object ContactEvents ====
+  py::class_<ContactEvents, ContactEvents::ptr>(
+      m, "ContactEvents",
+      R"(Contact events of the last physics step as flat arrays with one row
+      per pair of objects, see Simulator.get_contact_events. types holds
+      ContactEventType values. Stage contacts use the object id -1.)")
+      .def(py::init(&ContactEvents::create<>))
+      .def_readonly("types", &ContactEvents::types)
+      .def_readonly("object_ids_a", &ContactEvents::objectIdsA)
+      .def_readonly("object_ids_b", &ContactEvents::objectIdsB)
+      .def_readonly("points", &ContactEvents::points)
+      .def_readonly("impulses", &ContactEvents::impulses)
+      .def("__len__", &ContactEvents::size);
+
+  // ==== struct object PhysicsStepStats ====
+  py::class_<PhysicsStepStats, PhysicsStepStats::ptr>(
+      m, "PhysicsStepStats",
+      R"(Counters of the work done by step_physics, see
+      Simulator.get_physics_step_stats. Durations are in seconds.)")
+      .def(py::init(&PhysicsStepStats::create<>))
+      .def_readonly("num_steps", &PhysicsStepStats::numSteps)
+      .def_readonly("num_substeps", &PhysicsStepStats::numSubsteps)
+      .def_readonly("last_num_substeps", &PhysicsStepStats::lastNumSubsteps)
+      .def_readonly("num_dropped_substeps",
+                    &PhysicsStepStats::numDroppedSubsteps)
+      .def_readonly("last_step_duration", &PhysicsStepStats::lastStepDuration)
+      .def_readonly("max_step_duration", &PhysicsStepStats::maxStepDuration)
+      .def_readonly("total_step_duration",
+                    &PhysicsStepStats::totalStepDuration);
+
+  // ==== struct object PhysicsState ====
+  py::class_<PhysicsState, PhysicsState::ptr>(
+      m, "PhysicsState",
+      R"(Snapshot of the dynamic state of a physical world, see
+      Simulator.save_physics_state.)")
+      .def(py::init(&PhysicsState::create<>))
+      .def_readonly("world_time", &PhysicsState::worldTime)
+      .def_property_readonly(
+          "num_objects",
+          [](const PhysicsState& self) { return self.objects.size(); });
+
+  // ==== class object PhysicsWorldBatch ====
+  // Worlds are added through their simulators and never handed to Python, a
+  // strong reference there would keep a world alive past Simulator.close(),
+  // which destroys the resources it depends on.
+  py::class_<PhysicsWorldBatch, PhysicsWorldBatch::ptr>(
+      m, "PhysicsWorldBatch",
+      R"(A set of physical worlds of several simulators, which are stepped
+      concurrently by step_physics. Worlds are referenced weakly, a simulator
+      which is closed or reconfigured drops out of the batch.)")
+      .def(py::init(&PhysicsWorldBatch::create<>))
+      .def(py::init(&PhysicsWorldBatch::create<size_t>), "num_threads"_a)
+      .def(
+          "add_world",
+          [](PhysicsWorldBatch& self, esp::sim::Simulator& sim) {
+            if (!sim.getPhysicsManager()) {
+              throw std::invalid_argument(
+                  "PhysicsWorldBatch.add_world: the simulator has no scene "
+                  "loaded");
+            }
+            return self.addWorld(sim.getPhysicsManager());
+          },
+          R"(Adds the physical world of a simulator and returns its index in
+          the batch. Raises ValueError if it is already in the batch.)",
+          "sim"_a)
+      .def("has_world", &PhysicsWorldBatch::hasWorld,
+           R"(Whether the world at index is still alive, i.e. its simulator
+          was not closed or reconfigured since it was added.)",
+           "index"_a)
+      .def("clear", &PhysicsWorldBatch::clear)
+      .def_property_readonly("num_worlds", &PhysicsWorldBatch::getNumWorlds)
+      .def_property("num_threads", &PhysicsWorldBatch::getNumThreads,
+                    &PhysicsWorldBatch::setNumThreads,
+                    R"(The number of threads stepping worlds. Setting 0 uses
+          the number of hardware threads.)")
+      .def("step_physics", &PhysicsWorldBatch::stepPhysics,
+           R"(Steps every world by dt concurrently and returns their world
+          times, 0 for closed worlds. The simulators must not be used by
+          other threads meanwhile.)",
+           "dt"_a = 1.0 / 60.0, py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace physics
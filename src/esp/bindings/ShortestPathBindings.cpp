@@ -47,6 +47,11 @@ void initShortestPathBindings(py::module& m) {
       .def_readwrite("geodesic_distance",
                      &MultiGoalShortestPath::geodesicDistance);
 
+  py::class_<NavMeshIsland>(m, "NavMeshIsland")
+      .def_readonly("id", &NavMeshIsland::id)
+      .def_readonly("radius", &NavMeshIsland::radius)
+      .def_readonly("num_polygons", &NavMeshIsland::numPolygons);
+
   py::class_<NavMeshSettings, NavMeshSettings::ptr>(m, "NavMeshSettings")
       .def(py::init(&NavMeshSettings::create<>))
       .def_readwrite("cell_size", &NavMeshSettings::cellSize)
@@ -68,6 +73,7 @@ void initShortestPathBindings(py::module& m) {
       .def_readwrite("filter_ledge_spans", &NavMeshSettings::filterLedgeSpans)
       .def_readwrite("filter_walkable_low_height_spans",
                      &NavMeshSettings::filterWalkableLowHeightSpans)
+      .def_readwrite("tile_size", &NavMeshSettings::tileSize)
       .def("set_defaults", &NavMeshSettings::setDefaults);
 
   py::class_<PathFinder, PathFinder::ptr>(m, "PathFinder")
@@ -78,11 +84,47 @@ void initShortestPathBindings(py::module& m) {
            R"(Returns the topdown view of the PathFinder's navmesh.)",
            "meters_per_pixel"_a, "height"_a)
       .def("get_random_navigable_point", &PathFinder::getRandomNavigablePoint)
+      .def("get_random_navigable_points", &PathFinder::getRandomNavigablePoints,
+           R"(Returns num_points random navigable points as an Nx3 array,
+          distributed uniformly by area over the navmesh or the island with
+          index island_index. The result only depends on the seed, not on
+          num_threads.)",
+           "num_points"_a, "island_index"_a = ID_UNDEFINED,
+           py::call_guard<py::gil_scoped_release>())
       .def("find_path", py::overload_cast<ShortestPath&>(&PathFinder::findPath),
            "path"_a)
       .def("find_path",
            py::overload_cast<MultiGoalShortestPath&>(&PathFinder::findPath),
            "path"_a)
+      .def("find_path_from_distance_field",
+           &PathFinder::findPathFromDistanceField,
+           R"(Same as find_path for a MultiGoalShortestPath, but answers from a
+          geodesic distance field to the requested ends which is computed once
+          and cached in the path.)",
+           "path"_a, "compute_points"_a = false)
+      .def("geodesic_distances_from_distance_fields",
+           &PathFinder::geodesicDistancesFromDistanceFields,
+           R"(Geodesic distance from every row of an Nx3 float32 array of starts
+          to the ends of fields[field_ids[i]], using the same cached distance
+          fields as find_path_from_distance_field.)",
+           "fields"_a, "starts"_a, "field_ids"_a,
+           py::call_guard<py::gil_scoped_release>())
+      .def("find_paths",
+           py::overload_cast<const std::vector<ShortestPath::ptr>&>(
+               &PathFinder::findPaths),
+           R"(Finds the shortest path for every path in paths, distributing the
+          queries across num_threads threads. Returns whether or not each
+          path was found.)",
+           "paths"_a, py::call_guard<py::gil_scoped_release>())
+      .def("find_paths",
+           py::overload_cast<const std::vector<MultiGoalShortestPath::ptr>&>(
+               &PathFinder::findPaths),
+           "paths"_a, py::call_guard<py::gil_scoped_release>())
+      .def_property("num_threads", &PathFinder::getNumThreads,
+                    &PathFinder::setNumThreads,
+                    R"(The number of threads used by batched queries such as
+          find_paths or snap_points. Setting 0 uses the number of hardware
+          threads.)")
       .def("try_step", &PathFinder::tryStep<Magnum::Vector3>, "start"_a,
            "end"_a)
       .def("try_step", &PathFinder::tryStep<vec3f>, "start"_a, "end"_a)
@@ -92,11 +134,35 @@ void initShortestPathBindings(py::module& m) {
            "start"_a, "end"_a)
       .def("snap_point", &PathFinder::snapPoint<Magnum::Vector3>)
       .def("snap_point", &PathFinder::snapPoint<vec3f>)
+      .def("snap_points", &PathFinder::snapPoints,
+           R"(Snaps every row of an Nx3 float32 array to the navmesh, NaN for
+          points which could not be snapped. C-contiguous arrays are passed
+          without copying.)",
+           "points"_a, py::call_guard<py::gil_scoped_release>())
+      .def("is_navigable_batch", &PathFinder::isNavigableBatch,
+           R"(Checks is_navigable for every row of an Nx3 float32 array.)",
+           "points"_a, "max_y_delta"_a = 0.5,
+           py::call_guard<py::gil_scoped_release>())
+      .def("try_step_batch", &PathFinder::tryStepBatch,
+           R"(Takes try_step from every row of starts to the same row of ends,
+          both Nx3 float32 arrays.)",
+           "starts"_a, "ends"_a, py::call_guard<py::gil_scoped_release>())
+      .def("try_step_no_sliding_batch", &PathFinder::tryStepNoSlidingBatch,
+           "starts"_a, "ends"_a, py::call_guard<py::gil_scoped_release>())
       .def("island_radius", &PathFinder::islandRadius, "pt"_a)
+      .def("island_id", &PathFinder::islandId,
+           R"(Returns the index of the connected component the point belongs
+          to, or -1 if it is not on the navmesh.)",
+           "pt"_a)
+      .def("get_islands", &PathFinder::getIslands,
+           R"(Returns all connected components of the navmesh.)")
       .def_property_readonly("is_loaded", &PathFinder::isLoaded)
       .def_property_readonly("navigable_area", &PathFinder::getNavigableArea)
       .def("load_nav_mesh", &PathFinder::loadNavMesh)
-      .def("save_nav_mesh", &PathFinder::saveNavMesh, "path"_a)
+      .def("save_nav_mesh", &PathFinder::saveNavMesh,
+           R"(Saves the navmesh in the memory-mappable format, which older
+          versions of habitat-sim cannot load.)",
+           "path"_a)
       .def("distance_to_closest_obstacle",
            &PathFinder::distanceToClosestObstacle,
            R"(Returns the distance to the closest obstacle.)", "pt"_a,
@@ -106,6 +172,12 @@ void initShortestPathBindings(py::module& m) {
            R"(Returns the hit_pos, hit_normal and hit_dist of the surface point
           on the closest obstacle.)",
            "pt"_a, "max_search_radius"_a = 2.0)
+      .def("distances_to_closest_obstacle",
+           &PathFinder::distancesToClosestObstacle,
+           R"(Checks distance_to_closest_obstacle for every row of an Nx3
+          float32 array.)",
+           "points"_a, "max_search_radius"_a = 2.0,
+           py::call_guard<py::gil_scoped_release>())
       .def("is_navigable", &PathFinder::isNavigable,
            R"(Checks to see if the agent can stand at the specified point.)",
            "pt"_a, "max_y_delta"_a = 0.5);
@@ -128,7 +200,7 @@ void initShortestPathBindings(py::module& m) {
                     PathFinder::ptr&, GreedyGeodesicFollowerImpl::MoveFn&,
                     GreedyGeodesicFollowerImpl::MoveFn&,
                     GreedyGeodesicFollowerImpl::MoveFn&, double, double, double,
-                    bool, int>))
+                    bool, int, bool>))
       .def("next_action_along",
            py::overload_cast<const Mn::Quaternion&, const Mn::Vector3&,
                              const Mn::Vector3&>(
@@ -147,6 +219,8 @@ void initShortestPathBindings(py::module& m) {
            py::overload_cast<const core::RigidState&, const Mn::Vector3&>(
                &GreedyGeodesicFollowerImpl::findPath),
            py::return_value_policy::move)
+      .def("find_paths", &GreedyGeodesicFollowerImpl::findPaths,
+           py::return_value_policy::move)
       .def("reset", &GreedyGeodesicFollowerImpl::reset);
 }
 
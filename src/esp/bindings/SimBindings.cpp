@@ -10,7 +10,9 @@
 
 #include <Magnum/PythonBindings.h>
 #include <Magnum/SceneGraph/PythonBindings.h>
+#include <pybind11/numpy.h>
 
+#include "esp/core/Buffer.h"
 #include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/Renderer.h"
 #include "esp/scene/SemanticScene.h"
@@ -23,6 +25,31 @@ using py::literals::operator""_a;
 namespace esp {
 namespace sim {
 
+namespace {
+// copies the observation, as sensors reuse their buffers
+py::array observationToArray(const sensor::Observation& observation) {
+  const core::Buffer& buffer = *observation.buffer;
+  std::vector<size_t> shape = buffer.shape;
+  py::dtype dtype;
+  switch (buffer.dataType) {
+    case core::DataType::DT_UINT32:
+      dtype = py::dtype::of<uint32_t>();
+      break;
+    case core::DataType::DT_FLOAT:
+      dtype = py::dtype::of<float>();
+      break;
+    default:
+      dtype = py::dtype::of<uint8_t>();
+      break;
+  }
+  // depth and semantic frames are read back as a single channel
+  if (buffer.dataType != core::DataType::DT_UINT8 && shape.size() == 3) {
+    shape.pop_back();
+  }
+  return py::array(dtype, shape, buffer.data.data());
+}
+}  // namespace
+
 void initSimBindings(py::module& m) {
   // ==== SimulatorConfiguration ====
   py::class_<SimulatorConfiguration, SimulatorConfiguration::ptr>(
@@ -241,6 +268,18 @@ void initSimBindings(py::module& m) {
           "cast_ray", &Simulator::castRay, "ray"_a, "max_distance"_a = 100.0,
           "scene_id"_a = 0,
           R"(Cast a ray into the collidable scene and return hit results. Physics must be enabled. max_distance in units of ray length.)")
+      .def(
+          "save_physics_state", &Simulator::savePhysicsState, "scene_id"_a = 0,
+          R"(Take a snapshot of the transformations, velocities, motion types and activation states of all objects, and of the world time. Physics must be enabled.)")
+      .def(
+          "restore_physics_state", &Simulator::restorePhysicsState, "state"_a,
+          "scene_id"_a = 0,
+          R"(Restore the objects and world time to a snapshot taken by save_physics_state, in place. Objects added since are left untouched. Returns False if objects of the snapshot were removed.)")
+      .def(
+          "cast_rays", &Simulator::castRays, "rays"_a,
+          "max_distance"_a = 100.0, "closest_only"_a = false, "scene_id"_a = 0,
+          py::call_guard<py::gil_scoped_release>(),
+          R"(Cast a batch of rays into the collidable scene, distributing them across threads, and return the hits of all rays as flat arrays. Physics must be enabled. max_distance in units of ray length. With closest_only, only the closest hit of each ray is reported.)")
       .def("set_object_bb_draw", &Simulator::setObjectBBDraw, "draw_bb"_a,
            "object_id"_a, "scene_id"_a = 0,
            R"(Enable or disable bounding box visualization for an object.)")
@@ -252,6 +291,10 @@ void initSimBindings(py::module& m) {
           "recompute_navmesh", &Simulator::recomputeNavMesh, "pathfinder"_a,
           "navmesh_settings"_a, "include_static_objects"_a = false,
           R"(Recompute the NavMesh for a given PathFinder instance using configured NavMeshSettings. Optionally include all MotionType::STATIC objects in the navigability constraints.)")
+      .def(
+          "update_navmesh", &Simulator::updateNavMesh, "pathfinder"_a,
+          "region"_a, "include_static_objects"_a = false,
+          R"(Update the NavMesh of a given PathFinder instance after the scene changed within region, e.g. the union of the old and new bounds of a moved object. Only the NavMesh tiles overlapping region are rebuilt, which requires recompute_navmesh to have been called with NavMeshSettings.tile_size > 0.)")
       .def("get_light_setup", &Simulator::getLightSetup,
            "key"_a = assets::ResourceManager::DEFAULT_LIGHTING_KEY,
            R"(Get a copy of the LightSetup registered with a specific key.)")
@@ -264,10 +307,39 @@ void initSimBindings(py::module& m) {
           "object_id"_a, "light_setup_key"_a, "scene_id"_a = 0,
           R"(Modify the LightSetup used to the render all components of an object by setting the LightSetup key referenced by all Drawables attached to the object's visual SceneNodes.)")
 
+      .def(
+          "get_agent_observations_async",
+          [](Simulator& self, int agentId, bool previousFrame) {
+            std::map<std::string, sensor::Observation> observations;
+            self.getAgentObservationsAsync(agentId, observations,
+                                           previousFrame);
+            py::dict arrays;
+            for (const auto& observation : observations) {
+              arrays[py::str(observation.first)] =
+                  observationToArray(observation.second);
+            }
+            return arrays;
+          },
+          "agent_id"_a, "previous_frame"_a = false,
+          R"(Draw the observations of all sensors of an agent and read them back asynchronously, by sensor uuid. The images are bottom-up, as read from the framebuffer. With previous_frame, returns the observations drawn by the previous call instead of waiting for the ones just drawn, so rendering overlaps the work done until the next call. The first call returns the observations it draws.)")
       .def(
           "get_num_active_contact_points",
           &Simulator::getNumActiveContactPoints,
-          R"(The number of contact points that were active during the last step. An object resting on another object will involve several active contact points. Once both objects are asleep, the contact points are inactive. This count can be used as a metric for the complexity/cost of collision-handling in the current scene.)");
+          R"(The number of contact points that were active during the last step. An object resting on another object will involve several active contact points. Once both objects are asleep, the contact points are inactive. This count can be used as a metric for the complexity/cost of collision-handling in the current scene.)")
+      .def(
+          "get_contact_events", &Simulator::getContactEvents,
+          "scene_id"_a = 0,
+          R"(The pairs of objects which began, kept or ended touching during the last step, collected once per step. Cheaper than contact_test for querying the contacts of many objects. Empty unless enabled with set_contact_events_enabled.)")
+      .def("set_contact_events_enabled", &Simulator::setContactEventsEnabled,
+           "enabled"_a, "scene_id"_a = 0,
+           R"(Enable or disable collecting the contact events of each step, see get_contact_events. Disabled by default.)")
+      .def(
+          "get_physics_step_stats", &Simulator::getPhysicsStepStats,
+          "scene_id"_a = 0,
+          R"(The number of fixed substeps simulated and dropped and the wall clock time spent by step_physics since the physics were initialized or reset_physics_step_stats was called.)")
+      .def("reset_physics_step_stats", &Simulator::resetPhysicsStepStats,
+           "scene_id"_a = 0,
+           R"(Reset the counters of get_physics_step_stats.)");
   ;
 }
 
@@ -0,0 +1,72 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "MappedFile.h"
+
+#include <cstdio>
+
+#include <Corrade/Corrade.h>
+
+#if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace esp {
+namespace core {
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return;
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+    void* mapped = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      data_ = static_cast<unsigned char*>(mapped);
+      size_ = fileStat.st_size;
+      mapped_ = true;
+    }
+  }
+  close(fd);
+  if (mapped_)
+    return;
+#endif
+
+  // Fall back to reading the whole file into memory
+  FILE* fp = fopen(path.c_str(), "rb");
+  if (!fp)
+    return;
+  fseek(fp, 0, SEEK_END);
+  const long size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if (size > 0) {
+    data_ = new unsigned char[size];
+    size_ = size;
+    if (fread(data_, size_, 1, fp) != 1) {
+      delete[] data_;
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+  fclose(fp);
+}
+
+MappedFile::~MappedFile() {
+#if defined(CORRADE_TARGET_UNIX) || defined(CORRADE_TARGET_EMSCRIPTEN)
+  if (mapped_) {
+    munmap(data_, size_);
+    return;
+  }
+#endif
+  delete[] data_;
+}
+
+}  // namespace core
+}  // namespace esp
@@ -0,0 +1,53 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_CORE_MAPPEDFILE_H_
+#define ESP_CORE_MAPPEDFILE_H_
+
+/** @file */
+
+#include <cstddef>
+#include <string>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace core {
+
+/**
+ * @brief Contents of a file, memory mapped copy-on-write where supported.
+ *
+ * Pages which are only read stay shared between all processes mapping the
+ * same file, while writes (e.g. Detour linking the polygons of a tile, or
+ * Bullet fixing up the pointers of an in-place deserialized BVH) stay private
+ * to the process and never reach the file. Where mapping is not supported the
+ * file is read into memory instead. The data is page-aligned when mapped.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Map a file. On failure @ref data() is nullptr.
+   */
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  inline unsigned char* data() const { return data_; }
+  inline size_t size() const { return size_; }
+  inline bool isMapped() const { return mapped_; }
+
+ private:
+  unsigned char* data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+
+  ESP_SMART_POINTERS(MappedFile)
+};
+
+}  // namespace core
+}  // namespace esp
+
+#endif  // ESP_CORE_MAPPEDFILE_H_
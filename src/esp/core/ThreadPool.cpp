@@ -0,0 +1,119 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "ThreadPool.h"
+
+namespace esp {
+namespace core {
+
+size_t ThreadPool::hardwareConcurrency() {
+  const size_t numThreads = std::thread::hardware_concurrency();
+  return numThreads > 0 ? numThreads : 1;
+}
+
+ThreadPool::ThreadPool(size_t numThreads) {
+  if (numThreads == 0) {
+    numThreads = hardwareConcurrency();
+  }
+
+  // The calling thread is the last worker, so only spawn numThreads - 1
+  workers_.reserve(numThreads - 1);
+  for (size_t iWorker = 0; iWorker + 1 < numThreads; ++iWorker) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this, iWorker);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wakeWorkers_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::runJobs(size_t workerId) {
+  for (size_t i = nextIndex_.fetch_add(1); i < jobCount_;
+       i = nextIndex_.fetch_add(1)) {
+    try {
+      (*job_)(i, workerId);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_) {
+        exception_ = std::current_exception();
+      }
+      // Stop handing out the remaining indices
+      nextIndex_ = jobCount_;
+    }
+  }
+}
+
+void ThreadPool::workerLoop(size_t workerId) {
+  uint64_t lastGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wakeWorkers_.wait(lock, [&]() {
+        return stopping_ || generation_ != lastGeneration;
+      });
+      if (stopping_) {
+        return;
+      }
+      lastGeneration = generation_;
+    }
+
+    runJobs(workerId);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--activeWorkers_ == 0) {
+        jobsDone_.notify_one();
+      }
+    }
+  }
+}
+
+void ThreadPool::parallelFor(size_t count, const JobFn& job) {
+  if (count == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> callLock(callMutex_);
+
+  // Nothing to distribute, skip the synchronization entirely
+  if (workers_.empty() || count == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      job(i, workers_.size());
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    jobCount_ = count;
+    nextIndex_ = 0;
+    activeWorkers_ = workers_.size();
+    ++generation_;
+  }
+  wakeWorkers_.notify_all();
+
+  runJobs(workers_.size());
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobsDone_.wait(lock, [&]() { return activeWorkers_ == 0; });
+    job_ = nullptr;
+    std::swap(exception, exception_);
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace core
+}  // namespace esp
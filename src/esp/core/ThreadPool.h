@@ -0,0 +1,113 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_CORE_THREADPOOL_H_
+#define ESP_CORE_THREADPOOL_H_
+
+/** @file */
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace core {
+
+/**
+ * @brief A fixed-size pool of persistent worker threads used to fan
+ * independent jobs out across cores.
+ *
+ * Jobs are handed out dynamically: every participating thread claims the next
+ * unprocessed index from a shared atomic counter, so threads which finish
+ * their work early keep pulling work instead of idling. The calling thread
+ * participates as one of the workers, so a pool of size 1 runs everything
+ * inline without any synchronization.
+ *
+ * Each invocation of the job receives the id of the worker running it, in
+ * [0, @ref numThreads()), which lets callers keep per-worker scratch state
+ * (e.g. query objects which are not thread-safe) without locking.
+ *
+ * @note @ref parallelFor is not reentrant: a job must not call back into the
+ * same pool.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief The signature of a job. Called once per index with the id of the
+   * worker executing it.
+   */
+  typedef std::function<void(size_t index, size_t workerId)> JobFn;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param numThreads The total number of threads participating in a @ref
+   * parallelFor, including the calling thread. 0 picks the number of hardware
+   * threads.
+   */
+  explicit ThreadPool(size_t numThreads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @return The number of workers, including the calling thread.
+   */
+  size_t numThreads() const { return workers_.size() + 1; }
+
+  /**
+   * @brief Runs @p job for every index in [0, @p count) and blocks until all
+   * of them have completed.
+   *
+   * If a job throws, the indices not yet claimed are skipped and the first
+   * exception is rethrown in the calling thread once all workers are done.
+   *
+   * @param count The number of jobs
+   * @param job The job to run
+   */
+  void parallelFor(size_t count, const JobFn& job);
+
+  /**
+   * @brief The number of hardware threads, never less than 1.
+   */
+  static size_t hardwareConcurrency();
+
+ private:
+  void workerLoop(size_t workerId);
+  void runJobs(size_t workerId);
+
+  std::vector<std::thread> workers_;
+
+  //! Serializes concurrent callers of @ref parallelFor
+  std::mutex callMutex_;
+
+  std::mutex mutex_;
+  std::condition_variable wakeWorkers_;
+  std::condition_variable jobsDone_;
+
+  const JobFn* job_ = nullptr;
+  size_t jobCount_ = 0;
+  std::atomic<size_t> nextIndex_{0};
+  //! Incremented for every @ref parallelFor so sleeping workers can tell a new
+  //! batch apart from a spurious wakeup
+  uint64_t generation_ = 0;
+  size_t activeWorkers_ = 0;
+  //! The first exception thrown by a job of the current batch
+  std::exception_ptr exception_;
+  bool stopping_ = false;
+
+  ESP_SMART_POINTERS(ThreadPool)
+};
+
+}  // namespace core
+}  // namespace esp
+
+#endif  // ESP_CORE_THREADPOOL_H_
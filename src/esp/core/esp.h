@@ -33,6 +33,7 @@ typedef Matrix<uint32_t, 4, 1> Vector4ui;
 typedef Matrix<uint64_t, 4, 1> Vector4ul;
 
 typedef Matrix<float, Dynamic, Dynamic, RowMajor> RowMatrixXf;
+typedef Matrix<float, Dynamic, 3, RowMajor> RowMatrixX3f;
 
 //! Eigen JSON string format specification
 static const IOFormat kJsonFormat(StreamPrecision,
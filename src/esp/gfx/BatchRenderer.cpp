@@ -0,0 +1,281 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "BatchRenderer.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/PixelFormat.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/PixelFormat.h>
+
+#include "esp/gfx/DepthUnprojection.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+
+namespace {
+const Mn::GL::Framebuffer::ColorAttachment RgbaBuffer =
+    Mn::GL::Framebuffer::ColorAttachment{0};
+const Mn::GL::Framebuffer::ColorAttachment ObjectIdBuffer =
+    Mn::GL::Framebuffer::ColorAttachment{1};
+
+// validated before any member is sized by it
+int checkNumTiles(int numTiles) {
+  if (numTiles <= 0) {
+    throw std::runtime_error("BatchRenderer: expected at least one tile, got " +
+                             std::to_string(numTiles));
+  }
+  return numTiles;
+}
+
+std::string sizeToString(const Mn::Vector3i& size) {
+  return "{" + std::to_string(size.x()) + ", " + std::to_string(size.y()) +
+         ", " + std::to_string(size.z()) + "}";
+}
+}  // namespace
+
+struct BatchRenderer::Impl {
+  Impl(const Mn::Vector2i& tileSize, int numTiles, Renderer::Flags flags)
+      : tileSize_{tileSize},
+        numTiles_{checkNumTiles(numTiles)},
+        depthUnprojections_(numTiles_),
+        framebuffer_{Mn::NoCreate},
+        renderer_{Renderer::create(flags)},
+        rendererFlags_{flags} {
+    // pick the number of columns which makes the atlas about square
+    numColumns_ = Mn::Math::clamp(
+        int(std::ceil(std::sqrt(float(numTiles_) * tileSize_.y() /
+                                float(tileSize_.x())))),
+        1, numTiles_);
+    const int numRows = (numTiles_ + numColumns_ - 1) / numColumns_;
+    const Mn::Vector2i size = tileSize_ * Mn::Vector2i{numColumns_, numRows};
+    if (size.max() > Mn::GL::Renderbuffer::maxSize()) {
+      throw std::runtime_error(
+          "BatchRenderer: the atlas exceeds the maximum framebuffer size");
+    }
+
+    colorBuffer_.setStorage(Mn::GL::RenderbufferFormat::SRGB8Alpha8, size);
+    objectIdBuffer_.setStorage(Mn::GL::RenderbufferFormat::R32UI, size);
+    depthRenderTexture_.setMinificationFilter(Mn::GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(Mn::GL::SamplerFilter::Nearest)
+        .setWrapping(Mn::GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, Mn::GL::TextureFormat::DepthComponent32F, size);
+
+    framebuffer_ = Mn::GL::Framebuffer{{{}, size}};
+    framebuffer_.attachRenderbuffer(RgbaBuffer, colorBuffer_)
+        .attachRenderbuffer(ObjectIdBuffer, objectIdBuffer_)
+        .attachTexture(Mn::GL::Framebuffer::BufferAttachment::Depth,
+                       depthRenderTexture_, 0)
+        .mapForDraw({{0, RgbaBuffer}, {1, ObjectIdBuffer}});
+    CORRADE_INTERNAL_ASSERT(
+        framebuffer_.checkStatus(Mn::GL::FramebufferTarget::Draw) ==
+        Mn::GL::Framebuffer::Status::Complete);
+  }
+
+  Mn::Vector2i tileSize() const { return tileSize_; }
+
+  int numTiles() const { return numTiles_; }
+
+  Mn::Vector2i atlasSize() const {
+    return tileSize_ *
+           Mn::Vector2i{numColumns_, (numTiles_ + numColumns_ - 1) /
+                                         numColumns_};
+  }
+
+  Mn::Range2Di tileViewport(int tile) const {
+    const Mn::Vector2i min =
+        tileSize_ * Mn::Vector2i{tile % numColumns_, tile / numColumns_};
+    return {min, min + tileSize_};
+  }
+
+  void renderEnter() {
+    framebuffer_.setViewport({{}, atlasSize()});
+    framebuffer_.clearDepth(1.0);
+    framebuffer_.clearColor(0, Mn::Color4{0, 0, 0, 1});
+    framebuffer_.clearColor(1, Mn::Vector4ui{});
+    framebuffer_.bind();
+  }
+
+  void renderExit() {}
+
+  bool draw(int tile,
+            sensor::VisualSensor& sensor,
+            scene::SceneGraph& sceneGraph,
+            RenderCamera::Flags flags) {
+    if (tile < 0 || tile >= numTiles_) {
+      LOG(ERROR) << "BatchRenderer::draw: tile " << tile
+                 << " is out of range, the batch has " << numTiles_
+                 << " tiles";
+      return false;
+    }
+    if (sensor.framebufferSize() != tileSize_) {
+      LOG(ERROR) << "BatchRenderer::draw: the sensor framebuffer size does "
+                    "not match the tile size";
+      return false;
+    }
+    auto depthUnprojection = sensor.depthUnprojection();
+    if (!depthUnprojection) {
+      LOG(ERROR) << "BatchRenderer::draw: the sensor does not have a "
+                    "depthUnprojection matrix";
+      return false;
+    }
+    depthUnprojections_[tile] = *depthUnprojection;
+
+    // the viewport of a bound framebuffer is applied immediately
+    framebuffer_.setViewport(tileViewport(tile));
+    framebuffer_.bind();
+    renderer_->draw(sensor, sceneGraph, flags);
+    return true;
+  }
+
+  void readFrameRgba(const Mn::MutableImageView3D& view) {
+    if (rendererFlags_ & Renderer::Flag::NoTextures)
+      throw std::runtime_error(
+          "Simulator was initialized with requiresTextures = false");
+
+    framebuffer_.mapForRead(RgbaBuffer);
+    readAtlas(view, view.format(), view.formatExtra());
+  }
+
+  void readFrameDepth(const Mn::MutableImageView3D& view) {
+    if (view.pixelSize() != sizeof(Mn::Float)) {
+      throw std::runtime_error(
+          "BatchRenderer: expected a depth view of 4-byte float pixels, got " +
+          std::to_string(view.pixelSize()) + "-byte pixels");
+    }
+    readAtlas(view, Mn::pixelFormatWrap(Mn::GL::PixelFormat::DepthComponent),
+              Mn::UnsignedInt(Mn::GL::PixelType::Float));
+    const size_t tileLength = view.data().size() / numTiles_;
+    for (int tile = 0; tile < numTiles_; ++tile) {
+      unprojectDepth(depthUnprojections_[tile],
+                     Cr::Containers::arrayCast<Mn::Float>(view.data().slice(
+                         tile * tileLength, (tile + 1) * tileLength)));
+    }
+  }
+
+  void readFrameObjectId(const Mn::MutableImageView3D& view) {
+    framebuffer_.mapForRead(ObjectIdBuffer);
+    readAtlas(view, view.format(), view.formatExtra());
+  }
+
+ private:
+  // reads the whole atlas at once, then copies each tile to its slice of the
+  // view
+  void readAtlas(const Mn::MutableImageView3D& view,
+                 Mn::PixelFormat format,
+                 Mn::UnsignedInt formatExtra) {
+    const Mn::Vector3i expectedSize{tileSize_, numTiles_};
+    if (view.size() != expectedSize) {
+      throw std::runtime_error("BatchRenderer: expected a view of size " +
+                               sizeToString(expectedSize) + ", got " +
+                               sizeToString(view.size()));
+    }
+
+    const size_t atlasDataSize =
+        size_t(atlasSize().product()) * view.pixelSize();
+    if (atlasData_.size() != atlasDataSize) {
+      atlasData_ = Cr::Containers::Array<char>{Cr::Containers::NoInit,
+                                               atlasDataSize};
+    }
+    const Mn::MutableImageView2D atlas{format, formatExtra,
+                                       view.pixelSize(), atlasSize(),
+                                       atlasData_};
+    framebuffer_.read({{}, atlasSize()}, atlas);
+
+    const Cr::Containers::StridedArrayView3D<const char> atlasPixels =
+        atlas.pixels();
+    const Cr::Containers::StridedArrayView4D<char> tilePixels = view.pixels();
+    for (int tile = 0; tile < numTiles_; ++tile) {
+      const Mn::Range2Di viewport = tileViewport(tile);
+      Cr::Utility::copy(
+          atlasPixels.slice(
+              {size_t(viewport.bottom()), size_t(viewport.left()), 0},
+              {size_t(viewport.top()), size_t(viewport.right()),
+               view.pixelSize()}),
+          tilePixels[tile]);
+    }
+  }
+
+  const Mn::Vector2i tileSize_;
+  const int numTiles_;
+  int numColumns_ = 1;
+  std::vector<Mn::Vector2> depthUnprojections_;
+
+  Mn::GL::Renderbuffer colorBuffer_;
+  Mn::GL::Renderbuffer objectIdBuffer_;
+  Mn::GL::Texture2D depthRenderTexture_;
+  Mn::GL::Framebuffer framebuffer_;
+  Cr::Containers::Array<char> atlasData_;
+
+  Renderer::ptr renderer_;
+  const Renderer::Flags rendererFlags_;
+};
+
+BatchRenderer::BatchRenderer(const Mn::Vector2i& tileSize,
+                             int numTiles,
+                             Renderer::Flags flags)
+    : pimpl_(spimpl::make_unique_impl<Impl>(tileSize, numTiles, flags)) {}
+
+Mn::Vector2i BatchRenderer::tileSize() const {
+  return pimpl_->tileSize();
+}
+
+int BatchRenderer::numTiles() const {
+  return pimpl_->numTiles();
+}
+
+Mn::Vector2i BatchRenderer::atlasSize() const {
+  return pimpl_->atlasSize();
+}
+
+Mn::Range2Di BatchRenderer::tileViewport(int tile) const {
+  return pimpl_->tileViewport(tile);
+}
+
+void BatchRenderer::renderEnter() {
+  pimpl_->renderEnter();
+}
+
+void BatchRenderer::renderExit() {
+  pimpl_->renderExit();
+}
+
+bool BatchRenderer::draw(int tile,
+                         sensor::VisualSensor& sensor,
+                         scene::SceneGraph& sceneGraph,
+                         RenderCamera::Flags flags) {
+  return pimpl_->draw(tile, sensor, sceneGraph, flags);
+}
+
+void BatchRenderer::readFrameRgba(const Mn::MutableImageView3D& view) {
+  pimpl_->readFrameRgba(view);
+}
+
+void BatchRenderer::readFrameDepth(const Mn::MutableImageView3D& view) {
+  pimpl_->readFrameDepth(view);
+}
+
+void BatchRenderer::readFrameObjectId(const Mn::MutableImageView3D& view) {
+  pimpl_->readFrameObjectId(view);
+}
+
+}  // namespace gfx
+}  // namespace esp
@@ -0,0 +1,143 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_GFX_BATCHRENDERER_H_
+#define ESP_GFX_BATCHRENDERER_H_
+
+/** @file
+ * @brief Class @ref esp::gfx::BatchRenderer
+ */
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Range.h>
+
+#include "esp/core/esp.h"
+#include "esp/gfx/RenderCamera.h"
+#include "esp/gfx/Renderer.h"
+#include "esp/scene/SceneGraph.h"
+#include "esp/sensor/VisualSensor.h"
+
+namespace esp {
+namespace gfx {
+
+/**
+ * @brief Renders the sensors of many scenes, e.g. those of the simulators of
+ * a vectorized environment, into the tiles of a single atlas framebuffer.
+ *
+ * Each tile has the framebuffer size of the sensors drawn into it. Drawing a
+ * tile only changes the viewport, and the whole atlas is read back at once
+ * into a buffer of @ref numTiles images, laid out as [N, H, W, C].
+ *
+ * The scenes must belong to the current GL context. Simulators created from
+ * the same thread share the context of the first one, see @ref
+ * sim::Simulator::reconfigure.
+ */
+class BatchRenderer {
+ public:
+  /**
+   * @brief Constructor
+   * @param tileSize  The size of each tile in WxH
+   * @param numTiles  The number of tiles of the atlas, at least one
+   * @param flags     The flags of the renderer drawing the tiles. See @ref
+   *                  Renderer
+   *
+   * Throws std::runtime_error if there are no tiles or the atlas exceeds the
+   * maximum framebuffer size.
+   */
+  BatchRenderer(const Magnum::Vector2i& tileSize,
+                int numTiles,
+                Renderer::Flags flags = {});
+
+  /**
+   * @brief The size of each tile in WxH
+   */
+  Magnum::Vector2i tileSize() const;
+
+  /**
+   * @brief The number of tiles
+   */
+  int numTiles() const;
+
+  /**
+   * @brief The size of the atlas framebuffer in WxH. Tiles are laid out row
+   * by row, in a grid which is about as wide as it is high.
+   */
+  Magnum::Vector2i atlasSize() const;
+
+  /**
+   * @brief The area of a tile in the atlas framebuffer
+   */
+  Magnum::Range2Di tileViewport(int tile) const;
+
+  /**
+   * @brief Called before the tiles are drawn. Clears all the tiles.
+   */
+  void renderEnter();
+
+  /**
+   * @brief Called after the tiles are drawn
+   */
+  void renderExit();
+
+  /**
+   * @brief Draw a scene graph with a visual sensor into a tile.
+   *
+   * The tile is not cleared, so several passes can be drawn into it, e.g. the
+   * OBJECT only pass over a separate semantic scene graph.
+   *
+   * @param tile        The tile to draw into
+   * @param sensor      The sensor to draw with. Its framebuffer size must be
+   *                    @ref tileSize
+   * @param sceneGraph  The scene graph to draw
+   * @param flags       The rendering flags
+   * @return Whether the tile was drawn
+   */
+  bool draw(int tile,
+            sensor::VisualSensor& sensor,
+            scene::SceneGraph& sceneGraph,
+            RenderCamera::Flags flags = {RenderCamera::Flag::FrustumCulling});
+
+  /**
+   * @brief Retrieve the RGBA rendering results of all the tiles.
+   *
+   * @param[in, out] view Preallocated memory that will be populated with the
+   * result, of size {W, H, @ref numTiles}. The result will be read as the
+   * pixel format of this view. Throws std::runtime_error if the size
+   * mismatches.
+   */
+  void readFrameRgba(const Magnum::MutableImageView3D& view);
+
+  /**
+   * @brief Retrieve the depth rendering results of all the tiles, unprojected
+   * with the parameters of the sensor last drawn into each tile.
+   *
+   * @param[in, out] view Preallocated memory that will be populated with the
+   * result, of size {W, H, @ref numTiles} and of pixel format @ref
+   * Magnum::PixelFormat::R32F. Throws std::runtime_error if the size or the
+   * pixel size mismatches.
+   */
+  void readFrameDepth(const Magnum::MutableImageView3D& view);
+
+  /**
+   * @brief Retrieve the ObjectID rendering results of all the tiles.
+   *
+   * @param[in, out] view Preallocated memory that will be populated with the
+   * result, of size {W, H, @ref numTiles}. See @ref
+   * RenderTarget::readFrameObjectId for the pixel formats. Throws
+   * std::runtime_error if the size mismatches.
+   */
+  void readFrameObjectId(const Magnum::MutableImageView3D& view);
+
+  // @brief Delete copy Constructor
+  BatchRenderer(const BatchRenderer&) = delete;
+  // @brief Delete copy operator
+  BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+  ESP_SMART_POINTERS_WITH_UNIQUE_PIMPL(BatchRenderer)
+};
+
+}  // namespace gfx
+}  // namespace esp
+
+#endif  // ESP_GFX_BATCHRENDERER_H_
@@ -0,0 +1,146 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "CullingBvh.h"
+
+#include <algorithm>
+
+#include <Magnum/Math/Functions.h>
+
+#include "esp/scene/SceneNode.h"
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+
+namespace {
+// leaves hold at most this many drawables
+constexpr uint32_t MaxLeafSize = 4;
+
+constexpr uint8_t AllPlanes = 0x3f;
+
+// classify an aabb against the frustum planes of the mask: returns false if
+// it is outside of one of them, otherwise clears from the mask the planes it
+// is entirely inside of
+bool rangeFrustumPlanes(const Mn::Range3D& range,
+                        const Mn::Frustum& frustum,
+                        uint8_t& planeMask) {
+  const Mn::Vector3 center = range.center();
+  const Mn::Vector3 halfExtent = range.size() * 0.5f;
+  for (int iPlane = 0; iPlane < 6; ++iPlane) {
+    if (!(planeMask & (1 << iPlane))) {
+      continue;
+    }
+    const Mn::Vector4& plane = frustum[iPlane];
+    const float d = Mn::Math::dot(center, plane.xyz()) + plane.w();
+    const float r = Mn::Math::dot(halfExtent, Mn::Math::abs(plane.xyz()));
+    if (d + r < 0.0f) {
+      return false;
+    }
+    if (d - r >= 0.0f) {
+      planeMask &= ~(1 << iPlane);
+    }
+  }
+  return true;
+}
+}  // namespace
+
+void CullingBvh::build(MagnumDrawableGroup& drawables) {
+  nodes_.clear();
+  items_.clear();
+  dynamicDrawables_.clear();
+  numDrawables_ = drawables.size();
+
+  for (size_t i = 0; i < drawables.size(); ++i) {
+    const auto& node =
+        static_cast<const scene::SceneNode&>(drawables[i].object());
+    Corrade::Containers::Optional<Mn::Range3D> aabb = node.getAbsoluteAABB();
+    if (aabb) {
+      items_.push_back({*aabb, i});
+    } else {
+      dynamicDrawables_.push_back(i);
+    }
+  }
+
+  if (!items_.empty()) {
+    nodes_.reserve(2 * items_.size() / MaxLeafSize + 1);
+    buildNode(0, items_.size());
+  }
+}
+
+uint32_t CullingBvh::buildNode(uint32_t begin, uint32_t end) {
+  const uint32_t nodeIndex = nodes_.size();
+  nodes_.push_back({items_[begin].aabb, begin, end, 0});
+
+  Mn::Range3D centers{items_[begin].aabb.center(),
+                      items_[begin].aabb.center()};
+  for (uint32_t i = begin; i < end; ++i) {
+    nodes_[nodeIndex].aabb = Mn::Math::join(nodes_[nodeIndex].aabb,
+                                            items_[i].aabb);
+    centers = Mn::Math::join(
+        centers, Mn::Range3D{items_[i].aabb.center(), items_[i].aabb.center()});
+  }
+
+  // split at the median along the axis in which the centers spread the most
+  const Mn::Vector3 spread = centers.size();
+  if (end - begin <= MaxLeafSize || spread.max() <= 0.0f) {
+    return nodeIndex;
+  }
+  const int axis = spread.x() >= spread.y()
+                       ? (spread.x() >= spread.z() ? 0 : 2)
+                       : (spread.y() >= spread.z() ? 1 : 2);
+  const uint32_t middle = begin + (end - begin) / 2;
+  std::nth_element(items_.begin() + begin, items_.begin() + middle,
+                   items_.begin() + end, [axis](const Item& a, const Item& b) {
+                     return a.aabb.center()[axis] < b.aabb.center()[axis];
+                   });
+
+  buildNode(begin, middle);
+  const uint32_t secondChild = buildNode(middle, end);
+  nodes_[nodeIndex].secondChild = secondChild;
+  return nodeIndex;
+}
+
+void CullingBvh::cull(const Mn::Frustum& frustum,
+                      std::vector<size_t>& visible) const {
+  visible.assign(dynamicDrawables_.begin(), dynamicDrawables_.end());
+  if (nodes_.empty()) {
+    return;
+  }
+
+  std::vector<std::pair<uint32_t, uint8_t>> stack{{0, AllPlanes}};
+  while (!stack.empty()) {
+    const uint32_t nodeIndex = stack.back().first;
+    uint8_t planeMask = stack.back().second;
+    stack.pop_back();
+
+    const Node& node = nodes_[nodeIndex];
+    if (!rangeFrustumPlanes(node.aabb, frustum, planeMask)) {
+      continue;
+    }
+    if (planeMask == 0) {
+      // entirely inside of the frustum
+      for (uint32_t i = node.begin; i < node.end; ++i) {
+        visible.push_back(items_[i].index);
+      }
+    } else if (node.secondChild == 0) {
+      for (uint32_t i = node.begin; i < node.end; ++i) {
+        uint8_t itemPlaneMask = planeMask;
+        if (rangeFrustumPlanes(items_[i].aabb, frustum, itemPlaneMask)) {
+          visible.push_back(items_[i].index);
+        }
+      }
+    } else {
+      stack.emplace_back(node.secondChild, planeMask);
+      stack.emplace_back(nodeIndex + 1, planeMask);
+    }
+  }
+
+  // keep the order of the group, which is the drawing order
+  std::sort(visible.begin(), visible.end());
+}
+
+}  // namespace gfx
+}  // namespace esp
@@ -0,0 +1,91 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_GFX_CULLINGBVH_H_
+#define ESP_GFX_CULLINGBVH_H_
+
+/** @file
+ * @brief Class @ref esp::gfx::CullingBvh
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Frustum.h>
+#include <Magnum/Math/Range.h>
+
+#include "esp/core/esp.h"
+#include "esp/gfx/magnum.h"
+
+namespace esp {
+namespace gfx {
+
+/**
+ * @brief Bounding volume hierarchy over the absolute AABBs of the static
+ * drawables of a drawable group, for hierarchical frustum culling.
+ *
+ * Static drawables are those whose @ref scene::SceneNode has an absolute
+ * AABB, see @ref scene::SceneNode::getAbsoluteAABB. The other, dynamic,
+ * drawables are never culled. Subtrees outside of the frustum are skipped as
+ * a whole, and subtrees inside of it are accepted without testing their
+ * drawables, so culling a large stage does not test each of its sub-meshes.
+ */
+class CullingBvh {
+ public:
+  /**
+   * @brief Build the hierarchy over the drawables of a group.
+   *
+   * Drawables are referred to by their index in the group, so the hierarchy
+   * must be rebuilt whenever drawables are added to or removed from the group.
+   */
+  void build(MagnumDrawableGroup& drawables);
+
+  /**
+   * @brief Collect the drawables which may be visible in a frustum.
+   * @param frustum The frustum, relative to the world origin
+   * @param[out] visible The indices in the group of the static drawables
+   * whose AABB intersects the frustum, and of all the dynamic drawables, in
+   * increasing order
+   */
+  void cull(const Magnum::Frustum& frustum, std::vector<size_t>& visible) const;
+
+  /**
+   * @brief The number of drawables of the group the hierarchy was built over
+   */
+  size_t getNumDrawables() const { return numDrawables_; }
+
+  /**
+   * @brief The number of static drawables in the hierarchy
+   */
+  size_t getNumStaticDrawables() const { return items_.size(); }
+
+ private:
+  struct Node {
+    Magnum::Range3D aabb;
+    // range of the node's drawables in items_
+    uint32_t begin, end;
+    // the first child immediately follows its parent, 0 for leaves
+    uint32_t secondChild;
+  };
+
+  struct Item {
+    Magnum::Range3D aabb;
+    size_t index;
+  };
+
+  uint32_t buildNode(uint32_t begin, uint32_t end);
+
+  std::vector<Node> nodes_;
+  std::vector<Item> items_;
+  std::vector<size_t> dynamicDrawables_;
+  size_t numDrawables_ = 0;
+
+  ESP_SMART_POINTERS(CullingBvh)
+};
+
+}  // namespace gfx
+}  // namespace esp
+
+#endif  // ESP_GFX_CULLINGBVH_H_
@@ -17,6 +17,7 @@ class SceneNode;
 namespace gfx {
 
 class DrawableGroup;
+struct MaterialData;
 
 /**
  * @brief Drawable for use with @ref DrawableGroup.
@@ -86,6 +87,25 @@ class Drawable : public Magnum::SceneGraph::Drawable3D {
    */
   virtual Magnum::GL::Mesh& getVisualizerMesh() { return mesh_; }
 
+  /**
+   * @brief Prepare the drawable to be drawn, e.g. resolve its shader, so that
+   * it is not looked up while drawing. Called by @ref
+   * DrawableGroup::beginDraw on the drawables which survived culling.
+   */
+  virtual void prepareForDraw() {}
+
+  /**
+   * @brief The shader the drawable was last prepared with, nullptr if the
+   * drawable does not track it. Used to sort the drawables by state.
+   */
+  MagnumShaderProgram* getShaderProgram() const { return shaderProgram_; }
+
+  /**
+   * @brief The material the drawable is drawn with, nullptr if the drawable
+   * does not track it. Used to sort the drawables by state.
+   */
+  const MaterialData* getMaterial() const { return material_; }
+
  protected:
   /**
    * @brief Draw the object using given camera
@@ -104,6 +124,12 @@ class Drawable : public Magnum::SceneGraph::Drawable3D {
 
   scene::SceneNode& node_;
   Magnum::GL::Mesh& mesh_;
+
+  // state the drawables of a group are sorted by, set by the sub-classes
+  // which skip binding the state shared with the previous drawable, see
+  // DrawableGroup::bindShader() and DrawableGroup::bindMaterial()
+  MagnumShaderProgram* shaderProgram_ = nullptr;
+  const MaterialData* material_ = nullptr;
 };
 
 CORRADE_ENUMSET_OPERATORS(Drawable::Flags)
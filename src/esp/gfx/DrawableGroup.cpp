@@ -2,6 +2,10 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 #include "DrawableGroup.h"
+
+#include <algorithm>
+#include <functional>
+
 #include "Drawable.h"
 
 namespace esp {
@@ -37,9 +41,96 @@ Drawable* DrawableGroup::getDrawable(uint64_t id) const {
   return nullptr;
 }
 
+const CullingBvh& DrawableGroup::getCullingBvh() {
+  // the size check catches drawables added through the Magnum API
+  if (cullingBvhDirty_ || cullingBvh_.getNumDrawables() != size()) {
+    cullingBvh_.build(*this);
+    cullingBvhDirty_ = false;
+  }
+  return cullingBvh_;
+}
+
+bool DrawableGroup::prepareForDraw(const RenderCamera&) {
+  drawStatistics_ = DrawStatistics{};
+  return true;
+}
+
+namespace {
+// orders drawables by shader, then material, then mesh. Drawables not
+// tracking their state have no shader and no material, so they are drawn
+// first, in their original order, and never in between two drawables sharing
+// state. Pointers are ordered with std::less, as operator< is unspecified on
+// unrelated pointers.
+bool drawsBefore(Drawable& a, Drawable& b) {
+  const bool trackedA = a.getShaderProgram() != nullptr;
+  const bool trackedB = b.getShaderProgram() != nullptr;
+  if (!trackedA || !trackedB) {
+    return trackedA < trackedB;
+  }
+  const std::less<const void*> less;
+  if (a.getShaderProgram() != b.getShaderProgram()) {
+    return less(a.getShaderProgram(), b.getShaderProgram());
+  }
+  if (a.getMaterial() != b.getMaterial()) {
+    return less(a.getMaterial(), b.getMaterial());
+  }
+  return less(&a.getMesh(), &b.getMesh());
+}
+}  // namespace
+
+void DrawableGroup::beginDraw(
+    RenderCamera::DrawableTransforms& drawableTransforms) {
+  // only the drawables which survived culling resolve their shader
+  for (auto& drawableTransform : drawableTransforms) {
+    static_cast<Drawable&>(drawableTransform.first.get()).prepareForDraw();
+  }
+  std::stable_sort(
+      drawableTransforms.begin(), drawableTransforms.end(),
+      [](const RenderCamera::DrawableTransforms::value_type& a,
+         const RenderCamera::DrawableTransforms::value_type& b) {
+        return drawsBefore(static_cast<Drawable&>(a.first.get()),
+                           static_cast<Drawable&>(b.first.get()));
+      });
+
+  drawing_ = true;
+  boundShader_ = nullptr;
+  boundMaterial_ = nullptr;
+  boundLightSetup_ = nullptr;
+}
+
+void DrawableGroup::endDraw() {
+  drawing_ = false;
+}
+
+bool DrawableGroup::bindShader(const MagnumShaderProgram& shader) {
+  if (drawing_ && boundShader_ == &shader) {
+    ++drawStatistics_.shaderBindsAvoided;
+    return false;
+  }
+  boundShader_ = &shader;
+  boundMaterial_ = nullptr;
+  boundLightSetup_ = nullptr;
+  ++drawStatistics_.shaderBinds;
+  return true;
+}
+
+bool DrawableGroup::bindMaterial(const MaterialData& material,
+                                 const std::vector<LightInfo>& lightSetup) {
+  if (drawing_ && boundMaterial_ == &material &&
+      boundLightSetup_ == &lightSetup) {
+    ++drawStatistics_.materialBindsAvoided;
+    return false;
+  }
+  boundMaterial_ = &material;
+  boundLightSetup_ = &lightSetup;
+  ++drawStatistics_.materialBinds;
+  return true;
+}
+
 bool DrawableGroup::registerDrawable(Drawable& drawable) {
   // if it is already registered, emplace will do nothing
   if (idToDrawable_.emplace(drawable.getDrawableId(), &drawable).second) {
+    cullingBvhDirty_ = true;
     return true;
   }
   return false;
@@ -49,6 +140,7 @@ bool DrawableGroup::unregisterDrawable(Drawable& drawable) {
   if (idToDrawable_.erase(drawable.getDrawableId()) == 0) {
     return false;
   }
+  cullingBvhDirty_ = true;
   return true;
 }
 
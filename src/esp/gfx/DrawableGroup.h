@@ -11,13 +11,17 @@
 #include <unordered_map>
 
 #include <functional>
+#include <vector>
 #include "esp/core/esp.h"
+#include "esp/gfx/CullingBvh.h"
+#include "esp/gfx/RenderCamera.h"
 
 namespace esp {
 namespace gfx {
 
-class RenderCamera;
 class Drawable;
+struct LightInfo;
+struct MaterialData;
 
 /**
  * @brief Group of drawables, and shared group parameters.
@@ -57,12 +61,78 @@ class DrawableGroup : public Magnum::SceneGraph::DrawableGroup3D {
    */
   Drawable* getDrawable(uint64_t id) const;
 
+  /**
+   * @brief Statistics of the state bound by the drawables of the group since
+   * it was last prepared for drawing
+   */
+  struct DrawStatistics {
+    /** @brief Number of shader changes */
+    uint32_t shaderBinds = 0;
+    /** @brief Number of draws which kept the shader of the previous one */
+    uint32_t shaderBindsAvoided = 0;
+    /** @brief Number of material (and lights) changes */
+    uint32_t materialBinds = 0;
+    /** @brief Number of draws which kept the material of the previous one */
+    uint32_t materialBindsAvoided = 0;
+  };
+
   /**
    * @brief Prepare to draw group with given @ref RenderCamera
    *
+   * Resets the @ref DrawStatistics.
    * @return Whether the @ref DrawableGroup is in a valid state to be drawn
    */
-  virtual bool prepareForDraw(const RenderCamera&) { return true; }
+  virtual bool prepareForDraw(const RenderCamera&);
+
+  /**
+   * @brief Start drawing drawables of the group.
+   *
+   * Resolves the shaders of the drawables about to be drawn, then sorts them
+   * by shader, then material, then mesh, so that those sharing state are
+   * drawn one after another. Until @ref endDraw, @ref bindShader and @ref
+   * bindMaterial skip the state the previous drawable already bound. Called
+   * by @ref RenderCamera::draw.
+   * @param drawableTransforms, drawables of the group with their
+   * transformation relative to the camera
+   */
+  void beginDraw(RenderCamera::DrawableTransforms& drawableTransforms);
+
+  /**
+   * @brief Finish drawing drawables of the group. Other drawing may change
+   * the state of the shaders, so from now on all state is bound.
+   */
+  void endDraw();
+
+  /**
+   * @brief Called by a drawable of the group before it binds a shader
+   * @return Whether the shader's per-camera state, e.g. the projection
+   * matrix, needs to be set, i.e. whether the previous drawable was not
+   * drawn with it
+   */
+  bool bindShader(const MagnumShaderProgram& shader);
+
+  /**
+   * @brief Called by a drawable of the group after @ref bindShader, before it
+   * binds its material and lights
+   * @return Whether the material uniforms and textures and the light colors
+   * need to be set, i.e. whether the previous drawable was not drawn with the
+   * same shader, material and lights
+   */
+  bool bindMaterial(const MaterialData& material,
+                    const std::vector<LightInfo>& lightSetup);
+
+  /**
+   * @brief The statistics of the state bound since the group was last
+   * prepared for drawing
+   */
+  const DrawStatistics& getDrawStatistics() const { return drawStatistics_; }
+
+  /**
+   * @brief The bounding volume hierarchy over the static drawables of the
+   * group, used for frustum culling. Rebuilt on first use after drawables
+   * were added or removed.
+   */
+  const CullingBvh& getCullingBvh();
 
  protected:
   /**
@@ -87,6 +157,20 @@ class DrawableGroup : public Magnum::SceneGraph::DrawableGroup3D {
    * a lookup table, that maps a drawable id to the drawable object
    */
   std::unordered_map<uint64_t, Drawable*> idToDrawable_;
+  /**
+   * the culling hierarchy, and whether drawables changed since it was built
+   */
+  CullingBvh cullingBvh_;
+  bool cullingBvhDirty_ = true;
+  /**
+   * the state bound by the previous drawable, valid between beginDraw() and
+   * endDraw() only
+   */
+  bool drawing_ = false;
+  const MagnumShaderProgram* boundShader_ = nullptr;
+  const MaterialData* boundMaterial_ = nullptr;
+  const std::vector<LightInfo>* boundLightSetup_ = nullptr;
+  DrawStatistics drawStatistics_;
   ESP_SMART_POINTERS(DrawableGroup)
 };
 
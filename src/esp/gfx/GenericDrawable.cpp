@@ -9,6 +9,7 @@
 #include <Magnum/Math/Color.h>
 #include <Magnum/Math/Matrix3.h>
 
+#include "esp/gfx/DrawableGroup.h"
 #include "esp/scene/SceneNode.h"
 
 namespace Mn = Magnum;
@@ -59,6 +60,8 @@ GenericDrawable::GenericDrawable(scene::SceneNode& node,
     flags_ |= Mn::Shaders::Phong::Flag::VertexColor;
   }
 
+  material_ = &*materialData_;
+
   // update the shader early here to to avoid doing it during the render loop
   updateShader();
 }
@@ -70,34 +73,19 @@ void GenericDrawable::setLightSetup(const Mn::ResourceKey& resourceKey) {
   updateShader();
 }
 
-void GenericDrawable::updateShaderLightingParameters(
-    const Mn::Matrix4& transformationMatrix,
-    Mn::SceneGraph::Camera3D& camera) {
-  const Mn::Matrix4 cameraMatrix = camera.cameraMatrix();
+void GenericDrawable::prepareForDraw() {
+  updateShader();
+}
 
-  std::vector<Mn::Vector4> lightPositions;
-  lightPositions.reserve(lightSetup_->size());
+void GenericDrawable::updateShaderMaterialParameters() {
   std::vector<Mn::Color3> lightColors;
   lightColors.reserve(lightSetup_->size());
-  std::vector<Mn::Color3> lightSpecularColors;
-  lightSpecularColors.reserve(lightSetup_->size());
   constexpr float dummyRange = Mn::Constants::inf();
   std::vector<float> lightRanges(lightSetup_->size(), dummyRange);
   const Mn::Color4 ambientLightColor = getAmbientLightColor(*lightSetup_);
 
   for (Mn::UnsignedInt i = 0; i < lightSetup_->size(); ++i) {
-    const auto& lightInfo = (*lightSetup_)[i];
-    lightPositions.emplace_back(Mn::Vector4(getLightPositionRelativeToCamera(
-        lightInfo, transformationMatrix, cameraMatrix)));
-
-    const auto& lightColor = (*lightSetup_)[i].color;
-    lightColors.emplace_back(lightColor);
-
-    // In general, a light's specular color should match its base color.
-    // However, negative lights have zero (black) specular.
-    constexpr Mn::Color3 blackColor(0.0, 0.0, 0.0);
-    bool isNegativeLight = lightColor.x() < 0;
-    lightSpecularColors.emplace_back(isNegativeLight ? blackColor : lightColor);
+    lightColors.emplace_back((*lightSetup_)[i].color);
   }
 
   // See documentation in src/deps/magnum/src/Magnum/Shaders/Phong.h
@@ -106,28 +94,8 @@ void GenericDrawable::updateShaderLightingParameters(
       .setDiffuseColor(materialData_->diffuseColor)
       .setSpecularColor(materialData_->specularColor)
       .setShininess(materialData_->shininess)
-      .setLightPositions(lightPositions)
       .setLightColors(lightColors)
       .setLightRanges(lightRanges);
-}
-
-void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
-                           Mn::SceneGraph::Camera3D& camera) {
-  updateShader();
-
-  updateShaderLightingParameters(transformationMatrix, camera);
-
-  (*shader_)
-      // e.g., semantic mesh has its own per vertex annotation, which has been
-      // uploaded to GPU so simply pass 0 to the uniform "objectId" in the
-      // fragment shader
-      .setObjectId(
-          static_cast<RenderCamera&>(camera).useDrawableIds()
-              ? drawableId_
-              : (materialData_->perVertexObjectId ? 0 : node_.getSemanticId()))
-      .setTransformationMatrix(transformationMatrix)
-      .setProjectionMatrix(camera.projectionMatrix())
-      .setNormalMatrix(transformationMatrix.normalMatrix());
 
   if ((flags_ & Mn::Shaders::Phong::Flag::TextureTransformation) &&
       materialData_->textureMatrix != Mn::Matrix3{}) {
@@ -146,6 +114,51 @@ void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
   if (flags_ & Mn::Shaders::Phong::Flag::NormalTexture) {
     shader_->bindNormalTexture(*(materialData_->normalTexture));
   }
+}
+
+void GenericDrawable::updateShaderLightingParameters(
+    const Mn::Matrix4& transformationMatrix,
+    Mn::SceneGraph::Camera3D& camera) {
+  const Mn::Matrix4 cameraMatrix = camera.cameraMatrix();
+
+  std::vector<Mn::Vector4> lightPositions;
+  lightPositions.reserve(lightSetup_->size());
+
+  for (Mn::UnsignedInt i = 0; i < lightSetup_->size(); ++i) {
+    const auto& lightInfo = (*lightSetup_)[i];
+    lightPositions.emplace_back(Mn::Vector4(getLightPositionRelativeToCamera(
+        lightInfo, transformationMatrix, cameraMatrix)));
+  }
+
+  shader_->setLightPositions(lightPositions);
+}
+
+void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
+                           Mn::SceneGraph::Camera3D& camera) {
+  updateShader();
+
+  // skip the state the previous drawable of the group already set
+  DrawableGroup* group = drawables();
+  const bool bindShader = !group || group->bindShader(*shader_);
+  if (!group || group->bindMaterial(*materialData_, *lightSetup_)) {
+    updateShaderMaterialParameters();
+  }
+  if (bindShader) {
+    shader_->setProjectionMatrix(camera.projectionMatrix());
+  }
+
+  updateShaderLightingParameters(transformationMatrix, camera);
+
+  (*shader_)
+      // e.g., semantic mesh has its own per vertex annotation, which has been
+      // uploaded to GPU so simply pass 0 to the uniform "objectId" in the
+      // fragment shader
+      .setObjectId(
+          static_cast<RenderCamera&>(camera).useDrawableIds()
+              ? drawableId_
+              : (materialData_->perVertexObjectId ? 0 : node_.getSemanticId()))
+      .setTransformationMatrix(transformationMatrix)
+      .setNormalMatrix(transformationMatrix.normalMatrix());
 
   shader_->draw(mesh_);
 }
@@ -170,6 +183,7 @@ void GenericDrawable::updateShader() {
 
     CORRADE_INTERNAL_ASSERT(shader_ && shader_->lightCount() == lightCount &&
                             shader_->flags() == flags_);
+    shaderProgram_ = &*shader_;
   }
 }
 
@@ -27,6 +27,7 @@ class GenericDrawable : public Drawable {
                            DrawableGroup* group = nullptr);
 
   void setLightSetup(const Magnum::ResourceKey& lightSetupKey) override;
+  void prepareForDraw() override;
   static constexpr const char* SHADER_KEY_TEMPLATE = "Phong-lights={}-flags={}";
 
  protected:
@@ -34,6 +35,7 @@ class GenericDrawable : public Drawable {
                     Magnum::SceneGraph::Camera3D& camera) override;
 
   void updateShader();
+  void updateShaderMaterialParameters();
   void updateShaderLightingParameters(
       const Magnum::Matrix4& transformationMatrix,
       Magnum::SceneGraph::Camera3D& camera);
@@ -7,6 +7,8 @@
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Utility/FormatStl.h>
 
+#include "esp/gfx/DrawableGroup.h"
+
 namespace Mn = Magnum;
 
 namespace esp {
@@ -64,6 +66,7 @@ PbrDrawable::PbrDrawable(scene::SceneNode& node,
   }
 
   flags_ = PbrShader::generateCorrectFlags(flags_);
+  material_ = &*materialData_;
 
   // Defer the shader initialization because at this point, the lightSetup may
   // not be done in the Simulator. Simulator itself is currently under
@@ -75,11 +78,25 @@ void PbrDrawable::setLightSetup(const Mn::ResourceKey& lightSetupKey) {
   lightSetup_ = shaderManager_.get<LightSetup>(lightSetupKey);
 }
 
+void PbrDrawable::prepareForDraw() {
+  updateShader();
+}
+
 void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
                        Mn::SceneGraph::Camera3D& camera) {
-  updateShader()
-      .updateShaderLightParameters()
-      .updateShaderLightDirectionParameters(transformationMatrix, camera);
+  updateShader();
+
+  // skip the state the previous drawable of the group already set
+  DrawableGroup* group = drawables();
+  const bool bindShader = !group || group->bindShader(*shader_);
+  if (!group || group->bindMaterial(*materialData_, *lightSetup_)) {
+    updateShaderLightParameters().updateShaderMaterialParameters();
+  }
+  if (bindShader) {
+    shader_->setProjectionMatrix(camera.projectionMatrix());
+  }
+
+  updateShaderLightDirectionParameters(transformationMatrix, camera);
 
   (*shader_)
       // e.g., semantic mesh has its own per vertex annotation, which has been
@@ -90,8 +107,46 @@ void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
               ? drawableId_
               : (materialData_->perVertexObjectId ? 0 : node_.getSemanticId()))
       .setTransformationMatrix(transformationMatrix)  // modelview matrix
-      .setProjectionMatrix(camera.projectionMatrix())
-      .setNormalMatrix(transformationMatrix.normalMatrix())
+      .setNormalMatrix(transformationMatrix.normalMatrix());
+
+  shader_->draw(mesh_);
+}
+
+Mn::ResourceKey PbrDrawable::getShaderKey(Mn::UnsignedInt lightCount,
+                                          PbrShader::Flags flags) const {
+  return Corrade::Utility::formatString(
+      SHADER_KEY_TEMPLATE, lightCount,
+      static_cast<PbrShader::Flags::UnderlyingType>(
+          PbrShader::generateCorrectFlags(flags)));
+}
+
+PbrDrawable& PbrDrawable::updateShader() {
+  unsigned int lightCount = lightSetup_->size();
+  if (!shader_ || shader_->lightCount() != lightCount ||
+      shader_->flags() != flags_) {
+    // if the number of lights or flags have changed, we need to fetch a
+    // compatible shader
+    shader_ = shaderManager_.get<Mn::GL::AbstractShaderProgram, PbrShader>(
+        getShaderKey(lightCount, flags_));
+
+    // if no shader with desired number of lights and flags exists, create one
+    if (!shader_) {
+      shaderManager_.set<Mn::GL::AbstractShaderProgram>(
+          shader_.key(), new PbrShader{flags_, lightCount},
+          Mn::ResourceDataState::Final, Mn::ResourcePolicy::ReferenceCounted);
+    }
+
+    CORRADE_INTERNAL_ASSERT(shader_ && shader_->lightCount() == lightCount &&
+                            shader_->flags() == flags_);
+    shaderProgram_ = &*shader_;
+  }
+
+  return *this;
+}
+
+// update the material uniforms and bind the material textures
+PbrDrawable& PbrDrawable::updateShaderMaterialParameters() {
+  (*shader_)
       .setBaseColor(materialData_->baseColor)
       .setRoughness(materialData_->roughness)
       .setMetallic(materialData_->metallic)
@@ -139,37 +194,6 @@ void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
     shader_->setTextureMatrix(materialData_->textureMatrix);
   }
 
-  shader_->draw(mesh_);
-}
-
-Mn::ResourceKey PbrDrawable::getShaderKey(Mn::UnsignedInt lightCount,
-                                          PbrShader::Flags flags) const {
-  return Corrade::Utility::formatString(
-      SHADER_KEY_TEMPLATE, lightCount,
-      static_cast<PbrShader::Flags::UnderlyingType>(
-          PbrShader::generateCorrectFlags(flags)));
-}
-
-PbrDrawable& PbrDrawable::updateShader() {
-  unsigned int lightCount = lightSetup_->size();
-  if (!shader_ || shader_->lightCount() != lightCount ||
-      shader_->flags() != flags_) {
-    // if the number of lights or flags have changed, we need to fetch a
-    // compatible shader
-    shader_ = shaderManager_.get<Mn::GL::AbstractShaderProgram, PbrShader>(
-        getShaderKey(lightCount, flags_));
-
-    // if no shader with desired number of lights and flags exists, create one
-    if (!shader_) {
-      shaderManager_.set<Mn::GL::AbstractShaderProgram>(
-          shader_.key(), new PbrShader{flags_, lightCount},
-          Mn::ResourceDataState::Final, Mn::ResourcePolicy::ReferenceCounted);
-    }
-
-    CORRADE_INTERNAL_ASSERT(shader_ && shader_->lightCount() == lightCount &&
-                            shader_->flags() == flags_);
-  }
-
   return *this;
 }
 
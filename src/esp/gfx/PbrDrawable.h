@@ -34,6 +34,11 @@ class PbrDrawable : public Drawable {
    */
   void setLightSetup(const Magnum::ResourceKey& lightSetupkey) override;
 
+  /**
+   *  @brief Resolve the shader, so that it is not looked up while drawing
+   */
+  void prepareForDraw() override;
+
   static constexpr const char* SHADER_KEY_TEMPLATE = "PBR-lights={}-flags={}";
 
  protected:
@@ -60,6 +65,12 @@ class PbrDrawable : public Drawable {
    */
   PbrDrawable& updateShaderLightParameters();
 
+  /**
+   *  @brief Update the material uniforms and bind the material textures
+   *  @return Reference to self (for method chaining)
+   */
+  PbrDrawable& updateShaderMaterialParameters();
+
   /**
    *  @brief Update light direction (or position) in *camera* space to the
    * shader
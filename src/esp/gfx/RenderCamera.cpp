@@ -76,17 +76,17 @@ RenderCamera& RenderCamera::setProjectionMatrix(int width,
   return *this;
 }
 
-size_t RenderCamera::cull(
-    std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
-                          Mn::Matrix4>>& drawableTransforms) {
+Mn::Frustum RenderCamera::frustum() {
   // camera frustum relative to world origin
-  const Mn::Frustum frustum =
-      Mn::Frustum::fromMatrix(projectionMatrix() * cameraMatrix());
+  return Mn::Frustum::fromMatrix(projectionMatrix() * cameraMatrix());
+}
+
+size_t RenderCamera::cull(DrawableTransforms& drawableTransforms) {
+  const Mn::Frustum frustum = this->frustum();
 
   auto newEndIter = std::remove_if(
       drawableTransforms.begin(), drawableTransforms.end(),
-      [&](const std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
-                          Mn::Matrix4>& a) {
+      [&](const DrawableTransforms::value_type& a) {
         // obtain the absolute aabb
         auto& node = static_cast<scene::SceneNode&>(a.first.get().object());
         Corrade::Containers::Optional<Mn::Range3D> aabb =
@@ -109,13 +109,10 @@ size_t RenderCamera::cull(
   return (newEndIter - drawableTransforms.begin());
 }
 
-size_t RenderCamera::removeNonObjects(
-    std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
-                          Mn::Matrix4>>& drawableTransforms) {
+size_t RenderCamera::removeNonObjects(DrawableTransforms& drawableTransforms) {
   auto newEndIter = std::remove_if(
       drawableTransforms.begin(), drawableTransforms.end(),
-      [&](const std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
-                          Mn::Matrix4>& a) {
+      [&](const DrawableTransforms::value_type& a) {
         auto& node = static_cast<scene::SceneNode&>(a.first.get().object());
         if (node.getType() == scene::SceneNodeType::OBJECT) {
           // don't remove OBJECT types
@@ -127,20 +124,53 @@ size_t RenderCamera::removeNonObjects(
 }
 
 uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
-  previousNumVisibleDrawables_ = drawables.size();
-  if (flags == Flags()) {  // empty set
+  // drawable groups sort their drawables by state, even without flags
+  auto* group = dynamic_cast<DrawableGroup*>(&drawables);
+  if (flags == Flags() && !group) {  // empty set
+    previousNumVisibleDrawables_ = drawables.size();
     MagnumCamera::draw(drawables);
     return drawables.size();
   }
 
+  if ((flags & Flag::FrustumCulling) && group) {
+    // cull with the hierarchy of the group, and compute the transformations
+    // of the visible drawables only
+    std::vector<size_t> visible;
+    group->getCullingBvh().cull(frustum(), visible);
+
+    std::vector<std::reference_wrapper<Mn::SceneGraph::AbstractObject3D>>
+        objects;
+    objects.reserve(visible.size());
+    for (size_t index : visible) {
+      objects.push_back(drawables[index].object());
+    }
+    std::vector<Mn::Matrix4> transformations =
+        object().scene()->transformationMatrices(objects, cameraMatrix());
+
+    DrawableTransforms drawableTransforms;
+    drawableTransforms.reserve(visible.size());
+    for (size_t i = 0; i < visible.size(); ++i) {
+      drawableTransforms.emplace_back(drawables[visible[i]],
+                                      transformations[i]);
+    }
+    previousNumVisibleDrawables_ =
+        draw(drawableTransforms, flags & ~Flags{Flag::FrustumCulling}, group);
+    return previousNumVisibleDrawables_;
+  }
+
+  DrawableTransforms drawableTransforms = drawableTransformations(drawables);
+  return draw(drawableTransforms, flags, group);
+}
+
+uint32_t RenderCamera::draw(DrawableTransforms& drawableTransforms,
+                            Flags flags,
+                            DrawableGroup* group) {
+  previousNumVisibleDrawables_ = drawableTransforms.size();
+
   if (flags & Flag::UseDrawableIdAsObjectId) {
     useDrawableIds_ = true;
   }
 
-  std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
-                        Mn::Matrix4>>
-      drawableTransforms = drawableTransformations(drawables);
-
   if (flags & Flag::ObjectsOnly) {
     // draw just the OBJECTS
     size_t numObjects = removeNonObjects(drawableTransforms);
@@ -157,7 +187,13 @@ uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
         drawableTransforms.end());
   }
 
+  if (group) {
+    group->beginDraw(drawableTransforms);
+  }
   MagnumCamera::draw(drawableTransforms);
+  if (group) {
+    group->endDraw();
+  }
 
   // reset
   if (useDrawableIds_) {
@@ -5,6 +5,8 @@
 #ifndef ESP_GFX_RENDERCAMERA_H_
 #define ESP_GFX_RENDERCAMERA_H_
 
+#include <Magnum/Math/Frustum.h>
+
 #include "magnum.h"
 
 #include "esp/core/esp.h"
@@ -14,6 +16,8 @@
 namespace esp {
 namespace gfx {
 
+class DrawableGroup;
+
 class RenderCamera : public MagnumCamera {
  public:
   /**
@@ -43,6 +47,15 @@ class RenderCamera : public MagnumCamera {
   typedef Corrade::Containers::EnumSet<Flag> Flags;
   CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+  /**
+   * @brief Drawables paired with their transformation, as computed by @ref
+   * drawableTransformations
+   */
+  typedef std::vector<
+      std::pair<std::reference_wrapper<Magnum::SceneGraph::Drawable3D>,
+                Magnum::Matrix4>>
+      DrawableTransforms;
+
   RenderCamera(scene::SceneNode& node);
   RenderCamera(scene::SceneNode& node,
                const vec3f& eye,
@@ -72,12 +85,39 @@ class RenderCamera : public MagnumCamera {
 
   /**
    * @brief Overload function to render the drawables
+   *
+   * With @ref Flag::FrustumCulling, a @ref DrawableGroup is culled with its
+   * @ref CullingBvh, and only the transformations of the visible drawables
+   * are computed. The drawables of a @ref DrawableGroup are sorted by state,
+   * whatever the flags.
    * @param drawables, a drawable group containing all the drawables
    * @param frustumCulling, whether do frustum culling or not, default: false
    * @return the number of drawables that are drawn
    */
   uint32_t draw(MagnumDrawableGroup& drawables, Flags flags = {});
 
+  /**
+   * @brief Overload function to render drawables whose transformations
+   * relative to the camera were already computed, e.g. shared between several
+   * cameras. See @ref Renderer::drawSensors.
+   * @param drawableTransforms, a vector of pairs of Drawable3D object and its
+   * transformation relative to the camera. Culled drawables are removed from
+   * it.
+   * @param flags, the rendering flags
+   * @param group, the group the drawables belong to, if any. They are then
+   * sorted by state and drawn without rebinding the state they share, see
+   * @ref DrawableGroup::beginDraw
+   * @return the number of drawables that are drawn
+   */
+  uint32_t draw(DrawableTransforms& drawableTransforms,
+                Flags flags = {},
+                DrawableGroup* group = nullptr);
+
+  /**
+   * @brief The camera frustum, relative to the world origin
+   */
+  Magnum::Frustum frustum();
+
   /**
    * @brief performs the frustum culling
    * @param drawableTransforms, a vector of pairs of Drawable3D object and its
@@ -88,9 +128,7 @@ class RenderCamera : public MagnumCamera {
    * The preferred way is to enable the frustum culling by calling @ref
    * setFrustumCullingEnabled and then call @ref draw
    */
-  size_t cull(std::vector<
-              std::pair<std::reference_wrapper<Magnum::SceneGraph::Drawable3D>,
-                        Magnum::Matrix4>>& drawableTransforms);
+  size_t cull(DrawableTransforms& drawableTransforms);
 
   /**
    * @brief Cull Drawables for SceneNodes which are not OBJECT type.
@@ -99,10 +137,7 @@ class RenderCamera : public MagnumCamera {
    * absolute transformation
    * @return the number of drawables that are not culled
    */
-  size_t removeNonObjects(
-      std::vector<
-          std::pair<std::reference_wrapper<Magnum::SceneGraph::Drawable3D>,
-                    Magnum::Matrix4>>& drawableTransforms);
+  size_t removeNonObjects(DrawableTransforms& drawableTransforms);
 
   /**
    * @brief if the "immediate" following rendering pass is to use drawable ids
@@ -2,10 +2,15 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <cstring>
+#include <deque>
+#include <vector>
+
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/BufferImage.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGL.h>
 #include <Magnum/GL/PixelFormat.h>
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
@@ -135,6 +140,29 @@ struct RenderTarget::Impl {
         Mn::GL::FramebufferBlitFilter::Nearest);
   }
 
+  void copyFrom(Impl& source) {
+    CORRADE_INTERNAL_ASSERT(source.framebufferSize() == framebufferSize());
+    const Mn::Range2Di rectangle = framebuffer_.viewport();
+
+    // a blit writes the read color buffer into every draw buffer, so the two
+    // color attachments are copied separately
+    source.framebuffer_.mapForRead(RgbaBuffer);
+    framebuffer_.mapForDraw(RgbaBuffer);
+    Mn::GL::AbstractFramebuffer::blit(
+        source.framebuffer_, framebuffer_, rectangle, rectangle,
+        Mn::GL::FramebufferBlit::Color | Mn::GL::FramebufferBlit::Depth,
+        Mn::GL::FramebufferBlitFilter::Nearest);
+
+    source.framebuffer_.mapForRead(ObjectIdBuffer);
+    framebuffer_.mapForDraw(ObjectIdBuffer);
+    Mn::GL::AbstractFramebuffer::blit(source.framebuffer_, framebuffer_,
+                                      rectangle, rectangle,
+                                      Mn::GL::FramebufferBlit::Color,
+                                      Mn::GL::FramebufferBlitFilter::Nearest);
+
+    framebuffer_.mapForDraw({{0, RgbaBuffer}, {1, ObjectIdBuffer}});
+  }
+
   void readFrameRgba(const Mn::MutableImageView2D& view) {
     if (rendererFlags_ & Renderer::Flag::NoTextures)
       throw std::runtime_error(
@@ -166,6 +194,88 @@ struct RenderTarget::Impl {
     return framebuffer_.viewport().size();
   }
 
+  void queueReadFrameRgba() {
+    if (rendererFlags_ & Renderer::Flag::NoTextures)
+      throw std::runtime_error(
+          "Simulator was initialized with requiresTextures = false");
+
+    framebuffer_.mapForRead(RgbaBuffer);
+    queueRead(framebuffer_, Mn::GL::PixelFormat::RGBA,
+              Mn::GL::PixelType::UnsignedByte, false);
+  }
+
+  void queueReadFrameDepth() {
+    if (depthShader_) {
+      unprojectDepthGPU();
+      depthUnprojectionFrameBuffer_.mapForRead(UnprojectedDepthBuffer);
+      queueRead(depthUnprojectionFrameBuffer_, Mn::GL::PixelFormat::Red,
+                Mn::GL::PixelType::Float, false);
+    } else {
+      queueRead(framebuffer_, Mn::GL::PixelFormat::DepthComponent,
+                Mn::GL::PixelType::Float, true);
+    }
+  }
+
+  void queueReadFrameObjectId() {
+    framebuffer_.mapForRead(ObjectIdBuffer);
+    queueRead(framebuffer_, Mn::GL::PixelFormat::RedInteger,
+              Mn::GL::PixelType::UnsignedInt, false);
+  }
+
+  size_t numQueuedReads() const { return queuedReads_.size(); }
+
+  bool retrieveQueuedFrame(const Mn::MutableImageView2D& view, bool wait) {
+    if (queuedReads_.empty()) {
+      LOG(ERROR) << "RenderTarget::retrieveQueuedFrame : No read was queued.";
+      return false;
+    }
+    QueuedRead& read = queuedReads_.front();
+#ifndef MAGNUM_TARGET_WEBGL
+    const size_t readSize = read.image.dataSize();
+#else
+    const size_t readSize = read.image.data().size();
+#endif
+    if (view.size() != read.image.size() || view.data().size() != readSize) {
+      LOG(ERROR) << "RenderTarget::retrieveQueuedFrame : The view does not "
+                    "match the format or size of the queued read.";
+      return false;
+    }
+
+#ifndef MAGNUM_TARGET_WEBGL
+    // wait in slices as the timeout of glClientWaitSync is bounded
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    do {
+      status = glClientWaitSync(read.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                wait ? 1000000000 : 0);
+    } while (wait && status == GL_TIMEOUT_EXPIRED);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      return false;
+    }
+    if (status == GL_WAIT_FAILED) {
+      // mapping the buffer below synchronizes anyway
+      LOG(WARNING) << "RenderTarget::retrieveQueuedFrame : Waiting for the "
+                      "read failed, mapping the buffer synchronously.";
+    }
+
+    Cr::Containers::ArrayView<char> data = read.image.buffer().map(
+        0, readSize, Mn::GL::Buffer::MapFlag::Read);
+    CORRADE_INTERNAL_ASSERT(data.size() == readSize);
+    std::memcpy(view.data().data(), data.data(), readSize);
+    read.image.buffer().unmap();
+    glDeleteSync(read.fence);
+#else
+    std::memcpy(view.data().data(), read.image.data().data(), readSize);
+#endif
+    if (read.unprojectDepth) {
+      unprojectDepth(depthUnprojection_,
+                     Cr::Containers::arrayCast<Mn::Float>(view.data()));
+    }
+
+    freeReadImages_.emplace_back(std::move(read.image));
+    queuedReads_.pop_front();
+    return true;
+  }
+
 #ifdef ESP_BUILD_WITH_CUDA
   void readFrameRgbaGPU(uint8_t* devPtr) {
     // TODO: Consider implementing the GPU read functions with EGLImage
@@ -236,6 +346,11 @@ struct RenderTarget::Impl {
 #endif
 
   ~Impl() {
+#ifndef MAGNUM_TARGET_WEBGL
+    for (QueuedRead& read : queuedReads_) {
+      glDeleteSync(read.fence);
+    }
+#endif
 #ifdef ESP_BUILD_WITH_CUDA
     if (colorBufferCugl_ != nullptr)
       checkCudaErrors(cudaGraphicsUnregisterResource(colorBufferCugl_));
@@ -247,6 +362,51 @@ struct RenderTarget::Impl {
   }
 
  private:
+  // A read in flight, see queueRead(). WebGL can neither map buffers nor
+  // block on fences, so reads are synchronous there.
+#ifndef MAGNUM_TARGET_WEBGL
+  typedef Mn::GL::BufferImage2D ReadImage;
+#else
+  typedef Mn::Image2D ReadImage;
+#endif
+  struct QueuedRead {
+#ifndef MAGNUM_TARGET_WEBGL
+    ReadImage image{Mn::NoCreate};
+    GLsync fence = nullptr;
+#else
+    ReadImage image{Mn::PixelFormat::RGBA8Unorm};
+#endif
+    // Whether depth has to be unprojected on the CPU once retrieved
+    bool unprojectDepth = false;
+  };
+
+  void queueRead(Mn::GL::AbstractFramebuffer& framebuffer,
+                 Mn::GL::PixelFormat format,
+                 Mn::GL::PixelType type,
+                 bool unprojectDepth) {
+    QueuedRead read;
+    if (!freeReadImages_.empty()) {
+      read.image = std::move(freeReadImages_.back());
+      freeReadImages_.pop_back();
+    }
+#ifndef MAGNUM_TARGET_WEBGL
+    // keep the buffer, whose storage is reused when large enough, unless the
+    // format changed
+    if (read.image.buffer().id() == 0 || read.image.format() != format ||
+        read.image.type() != type) {
+      read.image = ReadImage{format, type};
+    }
+    framebuffer.read(framebuffer_.viewport(), read.image,
+                     Mn::GL::BufferUsage::StreamRead);
+    read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#else
+    read.image = ReadImage{format, type};
+    framebuffer.read(framebuffer_.viewport(), read.image);
+#endif
+    read.unprojectDepth = unprojectDepth;
+    queuedReads_.emplace_back(std::move(read));
+  }
+
   Mn::GL::Renderbuffer colorBuffer_;
   Mn::GL::Renderbuffer objectIdBuffer_;
   Mn::GL::Texture2D depthRenderTexture_;
@@ -260,6 +420,10 @@ struct RenderTarget::Impl {
 
   const Renderer::Flags rendererFlags_;
 
+  std::deque<QueuedRead> queuedReads_;
+  // Pixel pack buffers of retrieved reads, recycled by queueRead()
+  std::vector<ReadImage> freeReadImages_;
+
 #ifdef ESP_BUILD_WITH_CUDA
   cudaGraphicsResource_t colorBufferCugl_ = nullptr;
   cudaGraphicsResource_t objecIdBufferCugl_ = nullptr;
@@ -300,10 +464,35 @@ void RenderTarget::readFrameObjectId(const Mn::MutableImageView2D& view) {
   pimpl_->readFrameObjectId(view);
 }
 
+void RenderTarget::queueReadFrameRgba() {
+  pimpl_->queueReadFrameRgba();
+}
+
+void RenderTarget::queueReadFrameDepth() {
+  pimpl_->queueReadFrameDepth();
+}
+
+void RenderTarget::queueReadFrameObjectId() {
+  pimpl_->queueReadFrameObjectId();
+}
+
+size_t RenderTarget::numQueuedReads() const {
+  return pimpl_->numQueuedReads();
+}
+
+bool RenderTarget::retrieveQueuedFrame(const Mn::MutableImageView2D& view,
+                                       bool wait) {
+  return pimpl_->retrieveQueuedFrame(view, wait);
+}
+
 void RenderTarget::blitRgbaToDefault() {
   pimpl_->blitRgbaToDefault();
 }
 
+void RenderTarget::copyFrom(RenderTarget& source) {
+  pimpl_->copyFrom(*source.pimpl_);
+}
+
 Mn::Vector2i RenderTarget::framebufferSize() const {
   return pimpl_->framebufferSize();
 }
@@ -110,12 +110,62 @@ class RenderTarget {
    */
   void readFrameObjectId(const Magnum::MutableImageView2D& view);
 
+  /**
+   * @brief Queue an asynchronous read of the RGBA rendering results, to be
+   * retrieved with @ref retrieveQueuedFrame.
+   *
+   * The read is issued into a pixel pack buffer guarded by a fence, so it
+   * does not wait for rendering to finish. Buffers are recycled once
+   * retrieved. Several reads, of this or other render targets, can be in
+   * flight at the same time.
+   */
+  void queueReadFrameRgba();
+
+  /**
+   * @brief Queue an asynchronous read of the depth rendering results. See
+   * @ref queueReadFrameRgba and @ref readFrameDepth.
+   */
+  void queueReadFrameDepth();
+
+  /**
+   * @brief Queue an asynchronous read of the ObjectID rendering results. See
+   * @ref queueReadFrameRgba and @ref readFrameObjectId.
+   */
+  void queueReadFrameObjectId();
+
+  /**
+   * @brief The number of reads queued and not retrieved yet.
+   */
+  size_t numQueuedReads() const;
+
+  /**
+   * @brief Retrieve the oldest queued read.
+   *
+   * @param[in, out] view Preallocated memory that will be populated with the
+   * result. Must have the pixel format and size of the read, see @ref
+   * readFrameRgba, @ref readFrameDepth and @ref readFrameObjectId.
+   * @param wait Whether to wait for the GPU to finish the read. If false and
+   * the read is not finished, nothing is retrieved.
+   * @return Whether the read was retrieved into @p view.
+   */
+  bool retrieveQueuedFrame(const Magnum::MutableImageView2D& view,
+                           bool wait = true);
+
   /**
    * @brief Blits the rgba buffer from internal FBO to default frame buffer
    * which in case of EmscriptenApplication will be a canvas element.
    */
   void blitRgbaToDefault();
 
+  /**
+   * @brief Copies the RGBA, ObjectID and depth buffers of another render
+   * target of the same size into this one.
+   *
+   * Lets sensors sharing the same view reuse a single render pass, see @ref
+   * Renderer::drawSensors.
+   */
+  void copyFrom(RenderTarget& source);
+
   // @brief Delete copy Constructor
   RenderTarget(const RenderTarget&) = delete;
   // @brief Delete copy operator
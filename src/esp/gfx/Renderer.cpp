@@ -4,6 +4,8 @@
 
 #include "Renderer.h"
 
+#include <algorithm>
+
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
@@ -16,6 +18,8 @@
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/Image.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/SceneGraph/AbstractObject.h>
+#include <Magnum/SceneGraph/Drawable.h>
 
 #include "esp/gfx/DepthUnprojection.h"
 #include "esp/gfx/RenderTarget.h"
@@ -26,6 +30,33 @@ namespace Mn = Magnum;
 namespace esp {
 namespace gfx {
 
+namespace {
+// the transformations relative to the world, which do not depend on the
+// camera, of the drawables of a group at the given indices
+RenderCamera::DrawableTransforms worldTransformations(
+    MagnumDrawableGroup& drawables,
+    const std::vector<size_t>& indices) {
+  if (indices.empty()) {
+    return {};
+  }
+  std::vector<std::reference_wrapper<Mn::SceneGraph::AbstractObject3D>>
+      objects;
+  objects.reserve(indices.size());
+  for (size_t index : indices) {
+    objects.push_back(drawables[index].object());
+  }
+  std::vector<Mn::Matrix4> transformations =
+      drawables[0].object().scene()->transformationMatrices(objects);
+
+  RenderCamera::DrawableTransforms drawableTransforms;
+  drawableTransforms.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    drawableTransforms.emplace_back(drawables[indices[i]], transformations[i]);
+  }
+  return drawableTransforms;
+}
+}  // namespace
+
 struct Renderer::Impl {
   explicit Impl(Flags flags) : depthShader_{nullptr}, flags_{flags} {
     Mn::GL::Renderer::enable(Mn::GL::Renderer::Feature::DepthTest);
@@ -55,6 +86,118 @@ struct Renderer::Impl {
     draw(sceneGraph.getDefaultRenderCamera(), sceneGraph, flags);
   }
 
+  void drawSensors(const std::vector<sensor::VisualSensor*>& visualSensors,
+                   scene::SceneGraph& sceneGraph,
+                   RenderCamera::Flags flags) {
+    RenderCamera& camera = sceneGraph.getDefaultRenderCamera();
+
+    // sensors with the same pose, projection and framebuffer size see the
+    // same image, only the first sensor of such a view is drawn
+    struct View {
+      Mn::Matrix4 cameraMatrix;
+      Mn::Matrix4 projectionMatrix;
+      Mn::Vector2i viewport;
+      std::vector<sensor::VisualSensor*> sensors;
+    };
+    std::vector<View> views;
+    for (sensor::VisualSensor* visualSensor : visualSensors) {
+      ASSERT(visualSensor->isVisualSensor());
+      sceneGraph.setDefaultRenderCamera(*visualSensor);
+      auto view = std::find_if(views.begin(), views.end(), [&](const View& v) {
+        return v.cameraMatrix == camera.cameraMatrix() &&
+               v.projectionMatrix == camera.projectionMatrix() &&
+               v.viewport == camera.viewport();
+      });
+      if (view == views.end()) {
+        views.push_back({camera.cameraMatrix(), camera.projectionMatrix(),
+                         camera.viewport(), {}});
+        view = views.end() - 1;
+      }
+      view->sensors.push_back(visualSensor);
+    }
+
+    // the views are culled with the hierarchies of the groups instead
+    const bool frustumCulling =
+        bool(flags & RenderCamera::Flag::FrustumCulling);
+    flags &= ~RenderCamera::Flags{RenderCamera::Flag::FrustumCulling};
+
+    // cull all the views first, so that the scene graph is walked once, and
+    // only for the drawables visible in at least one of them
+    struct Group {
+      DrawableGroup* drawables;
+      // visible[i] holds the indices in the group of the drawables visible
+      // in views[i]
+      std::vector<std::vector<size_t>> visible;
+      // the union of the visible drawables, and their world transformations
+      std::vector<size_t> indices;
+      RenderCamera::DrawableTransforms transforms;
+      // the position in indices of each drawable of the group
+      std::vector<size_t> positions;
+    };
+    std::vector<Group> groups;
+    for (auto& it : sceneGraph.getDrawableGroups()) {
+      groups.push_back({&it.second, {}, {}, {}, {}});
+    }
+    for (Group& group : groups) {
+      const size_t numDrawables = group.drawables->size();
+      if (!frustumCulling) {
+        group.indices.resize(numDrawables);
+        for (size_t i = 0; i < numDrawables; ++i) {
+          group.indices[i] = i;
+        }
+        group.visible.assign(views.size(), group.indices);
+      } else {
+        group.visible.resize(views.size());
+        std::vector<bool> isVisible(numDrawables, false);
+        for (size_t iView = 0; iView < views.size(); ++iView) {
+          sceneGraph.setDefaultRenderCamera(*views[iView].sensors.front());
+          group.drawables->getCullingBvh().cull(camera.frustum(),
+                                                group.visible[iView]);
+          for (size_t index : group.visible[iView]) {
+            isVisible[index] = true;
+          }
+        }
+        for (size_t i = 0; i < numDrawables; ++i) {
+          if (isVisible[i]) {
+            group.indices.push_back(i);
+          }
+        }
+      }
+      group.transforms = worldTransformations(*group.drawables, group.indices);
+      group.positions.resize(numDrawables);
+      for (size_t i = 0; i < group.indices.size(); ++i) {
+        group.positions[group.indices[i]] = i;
+      }
+    }
+
+    for (size_t iView = 0; iView < views.size(); ++iView) {
+      View& view = views[iView];
+      sensor::VisualSensor& drawnSensor = *view.sensors.front();
+      sceneGraph.setDefaultRenderCamera(drawnSensor);
+
+      drawnSensor.renderTarget().renderEnter();
+      for (Group& group : groups) {
+        // as in draw(), the group is drawn whatever its state
+        group.drawables->prepareForDraw(camera);
+        RenderCamera::DrawableTransforms drawableTransforms;
+        drawableTransforms.reserve(group.visible[iView].size());
+        for (size_t index : group.visible[iView]) {
+          const auto& drawableTransform =
+              group.transforms[group.positions[index]];
+          drawableTransforms.emplace_back(
+              drawableTransform.first,
+              view.cameraMatrix * drawableTransform.second);
+        }
+        camera.draw(drawableTransforms, flags, group.drawables);
+      }
+      drawnSensor.renderTarget().renderExit();
+
+      for (size_t i = 1; i < view.sensors.size(); ++i) {
+        view.sensors[i]->renderTarget().copyFrom(drawnSensor.renderTarget());
+      }
+    }
+  }
+
   void bindRenderTarget(sensor::VisualSensor& sensor) {
     auto depthUnprojection = sensor.depthUnprojection();
     if (!depthUnprojection) {
@@ -92,6 +235,13 @@ void Renderer::draw(sensor::VisualSensor& visualSensor,
   pimpl_->draw(visualSensor, sceneGraph, flags);
 }
 
+void Renderer::drawSensors(
+    const std::vector<sensor::VisualSensor*>& visualSensors,
+    scene::SceneGraph& sceneGraph,
+    RenderCamera::Flags flags) {
+  pimpl_->drawSensors(visualSensors, sceneGraph, flags);
+}
+
 void Renderer::bindRenderTarget(sensor::VisualSensor& sensor) {
   pimpl_->bindRenderTarget(sensor);
 }
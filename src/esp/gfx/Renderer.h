@@ -5,6 +5,8 @@
 #ifndef ESP_GFX_RENDERER_H_
 #define ESP_GFX_RENDERER_H_
 
+#include <vector>
+
 #include "esp/core/esp.h"
 #include "esp/gfx/RenderCamera.h"
 #include "esp/scene/SceneGraph.h"
@@ -37,6 +39,25 @@ class Renderer {
             scene::SceneGraph& sceneGraph,
             RenderCamera::Flags flags = {RenderCamera::Flag::FrustumCulling});
 
+  /**
+   * @brief Draw the scene graph into the render targets of several visual
+   * sensors, e.g. all the sensors of an agent.
+   *
+   * The transformations of the drawables are computed once for all the
+   * sensors, and the drawables are culled once per distinct view. Sensors
+   * sharing a pose, projection and framebuffer size, such as co-located
+   * color, depth and semantic sensors, are rendered in a single pass whose
+   * result is copied to the others.
+   *
+   * Unlike @ref draw(sensor::VisualSensor&, scene::SceneGraph&,
+   * RenderCamera::Flags), it enters and exits the render targets itself. All
+   * the sensors must have one, see @ref bindRenderTarget.
+   */
+  void drawSensors(
+      const std::vector<sensor::VisualSensor*>& visualSensors,
+      scene::SceneGraph& sceneGraph,
+      RenderCamera::Flags flags = {RenderCamera::Flag::FrustumCulling});
+
   /**
    * @brief Binds a @ref RenderTarget to the sensor
    */
@@ -3,9 +3,17 @@
 // LICENSE file in the root directory of this source tree.
 
 #include "io.h"
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <set>
 
+#ifdef _WIN32
+#include <process.h>
+#include <windows.h>
+#define getpid _getpid
+#endif
+
 namespace esp {
 namespace io {
 
@@ -84,6 +92,20 @@ std::string removeExtension(const std::string& filename) {
   return changeExtension(filename, "");
 }
 
+std::string uniqueTemporaryFilename(const std::string& filename) {
+  static std::atomic<unsigned> counter{0};
+  return filename + "." + std::to_string(getpid()) + "." +
+         std::to_string(counter++) + ".tmp";
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 /* The following implementation requires the support of C++17
 
 // #include <filesystem>
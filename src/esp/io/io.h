@@ -19,6 +19,21 @@ std::string removeExtension(const std::string& file);
 
 std::string changeExtension(const std::string& file, const std::string& ext);
 
+/**
+ * @brief A temporary filename next to @p file, unique to this process and
+ * call, so that concurrent writers of the same file never share it.
+ *
+ * Write to it, then move it in place with @ref replaceFile.
+ */
+std::string uniqueTemporaryFilename(const std::string& file);
+
+/**
+ * @brief Atomically move @p from to @p to, replacing @p to if it exists
+ * (which std::rename does not do on Windows).
+ * @return Whether the file was moved
+ */
+bool replaceFile(const std::string& from, const std::string& to);
+
 /** @brief Tokenize input string by any delimiter char in delimiterCharList.
  *
  * @param delimiterCharList string containing all delimiter chars
@@ -52,6 +52,9 @@ ObjectAttributes::ObjectAttributes(const std::string& handle)
 
   setBoundingBoxCollisions(false);
   setJoinCollisionMeshes(true);
+  setCollisionHullMaxVertices(0);
+  setConvexDecomposition(false);
+  setMaxConvexParts(16);
   setRequiresLighting(true);
   setIsVisible(true);
   setSemanticId(0);
@@ -224,6 +224,39 @@ class ObjectAttributes : public AbstractObjectAttributes {
     return getBool("join_collision_meshes");
   }
 
+  /**
+   * @brief Upper bound on the number of vertices of each convex collision hull
+   * built from the collision mesh. 0 keeps every hull vertex. Reduced hulls are
+   * cached next to the collision asset, see @ref
+   * esp::assets::CollisionMeshPreprocessor.
+   */
+  void setCollisionHullMaxVertices(int collisionHullMaxVertices) {
+    setInt("collision_hull_max_vertices", collisionHullMaxVertices);
+  }
+  int getCollisionHullMaxVertices() const {
+    return getInt("collision_hull_max_vertices");
+  }
+
+  /**
+   * @brief If true split concave collision meshes into several convex parts
+   * instead of wrapping each of them in a single hull.
+   */
+  void setConvexDecomposition(bool convexDecomposition) {
+    setBool("convex_decomposition", convexDecomposition);
+  }
+  bool getConvexDecomposition() const {
+    return getBool("convex_decomposition");
+  }
+
+  /**
+   * @brief The maximum number of convex parts a collision mesh is split into
+   * by the convex decomposition.
+   */
+  void setMaxConvexParts(int maxConvexParts) {
+    setInt("max_convex_parts", maxConvexParts);
+  }
+  int getMaxConvexParts() const { return getInt("max_convex_parts"); }
+
   /**
    * @brief If not visible can add dynamic non-rendered object into a scene
    * object.  If is not visible then should not add object to drawables.
@@ -12,7 +12,9 @@ PhysicsManagerAttributes::PhysicsManagerAttributes(const std::string& handle)
     : AbstractAttributes("PhysicsManagerAttributes", handle) {
   setSimulator("none");
   setTimestep(0.01);
-  setMaxSubsteps(10);
+  setMaxSubsteps(10000);
+  setSubstepInterpolation(true);
+  setSolverSeed(0);
 }  // PhysicsManagerAttributes ctor
 
 }  // namespace attributes
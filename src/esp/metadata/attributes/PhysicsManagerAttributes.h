@@ -24,9 +24,34 @@ class PhysicsManagerAttributes : public AbstractAttributes {
   void setTimestep(double timestep) { setDouble("timestep", timestep); }
   double getTimestep() const { return getDouble("timestep"); }
 
+  /**
+   * @brief Set the maximum number of fixed substeps of a single step. Time
+   * beyond this budget is dropped rather than simulated. 0 for no limit.
+   * Defaults to 10000, the budget Bullet was always stepped with.
+   */
   void setMaxSubsteps(int maxSubsteps) { setInt("max_substeps", maxSubsteps); }
   int getMaxSubsteps() const { return getInt("max_substeps"); }
 
+  /**
+   * @brief Set whether poses are interpolated over the time left after the
+   * last fixed substep of a step. Without interpolation, every step simulates
+   * whole substeps only and carries the remaining time over to the next step,
+   * so the simulation only depends on the sequence of substeps.
+   */
+  void setSubstepInterpolation(bool substepInterpolation) {
+    setBool("substep_interpolation", substepInterpolation);
+  }
+  bool getSubstepInterpolation() const {
+    return getBool("substep_interpolation");
+  }
+
+  /**
+   * @brief Set the seed of the random number generator used by the
+   * constraint solver, e.g. to randomize the constraint order.
+   */
+  void setSolverSeed(int solverSeed) { setInt("solver_seed", solverSeed); }
+  int getSolverSeed() const { return getInt("solver_seed"); }
+
   void setGravity(const Magnum::Vector3& gravity) {
     setVec3("gravity", gravity);
   }
@@ -102,6 +102,20 @@ void ObjectAttributesManager::setValsFromJSONDoc(
       jsonConfig, "join_collision_meshes",
       std::bind(&ObjectAttributes::setJoinCollisionMeshes, objAttributes, _1));
 
+  // Bound the number of vertices of collision hulls
+  io::jsonIntoSetter<int>(
+      jsonConfig, "collision_hull_max_vertices",
+      std::bind(&ObjectAttributes::setCollisionHullMaxVertices, objAttributes,
+                _1));
+
+  // Split concave collision meshes into convex parts
+  io::jsonIntoSetter<bool>(
+      jsonConfig, "convex_decomposition",
+      std::bind(&ObjectAttributes::setConvexDecomposition, objAttributes, _1));
+  io::jsonIntoSetter<int>(
+      jsonConfig, "max_convex_parts",
+      std::bind(&ObjectAttributes::setMaxConvexParts, objAttributes, _1));
+
   // The object's interia matrix diagonal
   io::jsonIntoConstSetter<Magnum::Vector3>(
       jsonConfig, "inertia",
@@ -50,6 +50,18 @@ void PhysicsAttributesManager::setValsFromJSONDoc(
   io::jsonIntoSetter<int>(jsonConfig, "max_substeps",
                           std::bind(&PhysicsManagerAttributes::setMaxSubsteps,
                                     physicsManagerAttributes, _1));
+
+  // load whether to interpolate poses between substeps
+  io::jsonIntoSetter<bool>(
+      jsonConfig, "substep_interpolation",
+      std::bind(&PhysicsManagerAttributes::setSubstepInterpolation,
+                physicsManagerAttributes, _1));
+
+  // load the constraint solver seed
+  io::jsonIntoSetter<int>(jsonConfig, "solver_seed",
+                          std::bind(&PhysicsManagerAttributes::setSolverSeed,
+                                    physicsManagerAttributes, _1));
+
   // load the friction coefficient
   io::jsonIntoSetter<double>(
       jsonConfig, "friction_coefficient",
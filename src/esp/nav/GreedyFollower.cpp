@@ -1,5 +1,9 @@
 #include "esp/nav/GreedyFollower.h"
 
+#include <map>
+#include <numeric>
+#include <tuple>
+
 #include <Magnum/EigenIntegration/GeometryIntegration.h>
 #include <Magnum/EigenIntegration/Integration.h>
 
@@ -12,6 +16,11 @@ using Mn::EigenIntegration::cast;
 namespace esp {
 namespace nav {
 
+namespace {
+// Paths longer than this are considered failures
+constexpr int maxActions = 5e3;
+}  // namespace
+
 GreedyGeodesicFollowerImpl::GreedyGeodesicFollowerImpl(
     PathFinder::ptr& pathfinder,
     MoveFn& moveForward,
@@ -21,7 +30,8 @@ GreedyGeodesicFollowerImpl::GreedyGeodesicFollowerImpl(
     double forwardAmount,
     double turnAmount,
     bool fixThrashing,
-    int thrashingThreshold)
+    int thrashingThreshold,
+    bool useDistanceField)
     : pathfinder_{pathfinder},
       moveForward_{moveForward},
       turnLeft_{turnLeft},
@@ -30,16 +40,42 @@ GreedyGeodesicFollowerImpl::GreedyGeodesicFollowerImpl(
       goalDist_{goalDist},
       turnAmount_{turnAmount},
       fixThrashing_{fixThrashing},
-      thrashingThreshold_{thrashingThreshold} {};
+      thrashingThreshold_{thrashingThreshold},
+      useDistanceField_{useDistanceField} {};
 
 float GreedyGeodesicFollowerImpl::geoDist(const Mn::Vector3& start,
                                           const Mn::Vector3& end) {
+  if (useDistanceField_) {
+    // The field stays valid for as long as the goal does
+    if (!hasFieldGoal_ || fieldGoal_ != end) {
+      fieldPath_.setRequestedEnds({cast<vec3f>(end)});
+      fieldGoal_ = end;
+      hasFieldGoal_ = true;
+    }
+    fieldPath_.requestedStart = cast<vec3f>(start);
+    pathfinder_->findPathFromDistanceField(fieldPath_);
+    return fieldPath_.geodesicDistance;
+  }
+
   geoDistPath_.requestedStart = cast<vec3f>(start);
   geoDistPath_.requestedEnd = cast<vec3f>(end);
   pathfinder_->findPath(geoDistPath_);
   return geoDistPath_.geodesicDistance;
 }
 
+ShortestPath GreedyGeodesicFollowerImpl::pathTo(const Mn::Vector3& start,
+                                                const Mn::Vector3& end) {
+  ShortestPath path;
+  path.requestedStart = cast<vec3f>(start);
+  path.requestedEnd = cast<vec3f>(end);
+  if (useDistanceField_) {
+    path.geodesicDistance = geoDist(start, end);
+  } else {
+    pathfinder_->findPath(path);
+  }
+  return path;
+}
+
 GreedyGeodesicFollowerImpl::TryStepResult GreedyGeodesicFollowerImpl::tryStep(
     const scene::SceneNode& node,
     const Mn::Vector3& end) {
@@ -60,11 +96,17 @@ float GreedyGeodesicFollowerImpl::computeReward(const scene::SceneNode& node,
                                                 const ShortestPath& path,
                                                 const size_t primLen) {
   const auto tryStepRes = tryStep(node, Mn::Vector3{path.requestedEnd});
+  return computeReward(path.geodesicDistance, tryStepRes, primLen);
+}
 
+float GreedyGeodesicFollowerImpl::computeReward(
+    const float geodesicDistance,
+    const TryStepResult& tryStepRes,
+    const size_t primLen) const {
   // Try to minimize geodesic distance to target
   // Divide by forwardAmount_ to make the reward structure independent of step
   // size
-  return (path.geodesicDistance - tryStepRes.postGeodesicDistance) /
+  return (geodesicDistance - tryStepRes.postGeodesicDistance) /
              forwardAmount_ +
          (
              // Prefer shortest primitives
@@ -88,35 +130,49 @@ GreedyGeodesicFollowerImpl::nextBestPrimAlong(const core::RigidState& state,
     return {CODES::STOP};
   }
 
-  // Intialize bestReward to the minumum acceptable reward -- we are just
-  // constantly colliding
-  float bestReward = -collisionCost_;
-  std::vector<CODES> bestPrim, leftPrim, rightPrim;
-
   leftDummyNode_.setTranslation(state.translation);
   leftDummyNode_.setRotation(state.rotation);
 
   rightDummyNode_.setTranslation(state.translation);
   rightDummyNode_.setRotation(state.rotation);
 
-  // Plan over all primitives of the form [LEFT] * n + [FORWARD]
-  // or [RIGHT] * n + [FORWARD]
-  for (float angle = 0; angle < M_PI; angle += turnAmount_) {
-    {
-      const float reward = computeReward(leftDummyNode_, path, leftPrim.size());
-      if (reward > bestReward) {
-        bestReward = reward;
-        bestPrim = leftPrim;
-        bestPrim.emplace_back(CODES::FORWARD);
-      }
+  // The dummy nodes are turned lazily as selectPrim asks for primitives with
+  // more turns
+  return selectPrim([&](const CODES turn, const size_t numTurns) {
+    const bool isLeft = turn == CODES::LEFT;
+    scene::SceneNode& node = isLeft ? leftDummyNode_ : rightDummyNode_;
+    if (numTurns > 0) {
+      (isLeft ? turnLeft_ : turnRight_)(&node);
     }
+    return computeReward(node, path, numTurns);
+  });
+}
+
+int GreedyGeodesicFollowerImpl::numPrimTurns() const {
+  int numTurns = 0;
+  for (float angle = 0; angle < M_PI; angle += turnAmount_) {
+    ++numTurns;
+  }
+  return numTurns;
+}
+
+template <typename RewardFn>
+std::vector<GreedyGeodesicFollowerImpl::CODES>
+GreedyGeodesicFollowerImpl::selectPrim(RewardFn&& rewardFn) const {
+  // Intialize bestReward to the minumum acceptable reward -- we are just
+  // constantly colliding
+  float bestReward = -collisionCost_;
+  std::vector<CODES> bestPrim;
 
-    {
-      const float reward =
-          computeReward(rightDummyNode_, path, rightPrim.size());
+  // Plan over all primitives of the form [LEFT] * n + [FORWARD]
+  // or [RIGHT] * n + [FORWARD]
+  const int numTurns = numPrimTurns();
+  for (int n = 0; n < numTurns; ++n) {
+    for (const CODES turn : {CODES::LEFT, CODES::RIGHT}) {
+      const float reward = rewardFn(turn, n);
       if (reward > bestReward) {
         bestReward = reward;
-        bestPrim = rightPrim;
+        bestPrim.assign(n, turn);
         bestPrim.emplace_back(CODES::FORWARD);
       }
     }
@@ -125,17 +181,31 @@ GreedyGeodesicFollowerImpl::nextBestPrimAlong(const core::RigidState& state,
     constexpr float goodEnoughRewardThresh = 0.99f;
     if (bestReward > goodEnoughRewardThresh)
       break;
-
-    leftPrim.emplace_back(CODES::LEFT);
-    turnLeft_(&leftDummyNode_);
-
-    rightPrim.emplace_back(CODES::RIGHT);
-    turnRight_(&rightDummyNode_);
   }
 
   return bestPrim;
 }
 
+void GreedyGeodesicFollowerImpl::applyAction(scene::SceneNode& node,
+                                             const CODES action) {
+  switch (action) {
+    case CODES::FORWARD:
+      moveForward_(&node);
+      break;
+
+    case CODES::RIGHT:
+      turnRight_(&node);
+      break;
+
+    case CODES::LEFT:
+      turnLeft_(&node);
+      break;
+
+    default:
+      break;
+  }
+}
+
 bool GreedyGeodesicFollowerImpl::isThrashing() {
   if (actions_.size() < thrashingThreshold_)
     return false;
@@ -157,10 +227,7 @@ bool GreedyGeodesicFollowerImpl::isThrashing() {
 GreedyGeodesicFollowerImpl::CODES GreedyGeodesicFollowerImpl::nextActionAlong(
     const core::RigidState& start,
     const Mn::Vector3& end) {
-  ShortestPath path;
-  path.requestedStart = cast<vec3f>(start.translation);
-  path.requestedEnd = cast<vec3f>(end);
-  pathfinder_->findPath(path);
+  const ShortestPath path = pathTo(start.translation, end);
 
   CODES nextAction;
   if (fixThrashing_ && thrashingActions_.size() > 0) {
@@ -187,39 +254,19 @@ GreedyGeodesicFollowerImpl::CODES GreedyGeodesicFollowerImpl::nextActionAlong(
 std::vector<GreedyGeodesicFollowerImpl::CODES>
 GreedyGeodesicFollowerImpl::findPath(const core::RigidState& start,
                                      const Mn::Vector3& end) {
-  constexpr int maxActions = 5e3;
   findPathDummyNode_.setTranslation(Mn::Vector3{start.translation});
   findPathDummyNode_.setRotation(Mn::Quaternion{start.rotation});
 
   do {
     core::RigidState state{findPathDummyNode_.rotation(),
                            findPathDummyNode_.MagnumObject::translation()};
-    ShortestPath path;
-    path.requestedStart = cast<vec3f>(state.translation);
-    path.requestedEnd = cast<vec3f>(end);
-    pathfinder_->findPath(path);
+    const ShortestPath path = pathTo(state.translation, end);
     const auto nextPrim = nextBestPrimAlong(state, path);
     if (nextPrim.size() == 0) {
       actions_.emplace_back(CODES::ERROR);
     } else {
       for (const auto nextAction : nextPrim) {
-        switch (nextAction) {
-          case CODES::FORWARD:
-            moveForward_(&findPathDummyNode_);
-            break;
-
-          case CODES::RIGHT:
-            turnRight_(&findPathDummyNode_);
-            break;
-
-          case CODES::LEFT:
-            turnLeft_(&findPathDummyNode_);
-            break;
-
-          default:
-            break;
-        }
-
+        applyAction(findPathDummyNode_, nextAction);
         actions_.emplace_back(nextAction);
       }
     }
@@ -250,6 +297,142 @@ GreedyGeodesicFollowerImpl::findPath(const Mn::Quaternion& currentRot,
   return findPath({currentRot, currentPos}, end);
 }
 
+std::vector<std::vector<GreedyGeodesicFollowerImpl::CODES>>
+GreedyGeodesicFollowerImpl::findPaths(
+    const std::vector<core::RigidState>& starts,
+    const std::vector<Mn::Vector3>& ends) {
+  std::vector<std::vector<CODES>> paths(starts.size());
+  if (starts.size() != ends.size()) {
+    LOG(ERROR) << "GreedyGeodesicFollowerImpl::findPaths : Expected one end "
+                  "per start";
+    return paths;
+  }
+
+  // One distance field per distinct end
+  std::vector<MultiGoalShortestPath::ptr> fields;
+  std::vector<int> fieldIds(starts.size());
+  std::map<std::tuple<float, float, float>, int> endFields;
+  for (size_t i = 0; i < ends.size(); ++i) {
+    const auto inserted = endFields.emplace(
+        std::make_tuple(ends[i].x(), ends[i].y(), ends[i].z()), fields.size());
+    if (inserted.second) {
+      fields.emplace_back(MultiGoalShortestPath::create());
+      fields.back()->setRequestedEnds({cast<vec3f>(ends[i])});
+    }
+    fieldIds[i] = inserted.first->second;
+  }
+
+  scene::SceneGraph batchScene;
+  std::vector<scene::SceneNode*> nodes;
+  nodes.reserve(starts.size());
+  for (const core::RigidState& start : starts) {
+    nodes.push_back(&batchScene.getRootNode().createChild());
+    nodes.back()->setTranslation(start.translation);
+    nodes.back()->setRotation(start.rotation);
+  }
+
+  // Each trajectory queries its current location followed by where each of
+  // its primitives ends up, in the order selectPrim asks for them
+  const int numTurns = numPrimTurns();
+  const size_t queriesPerPath = 1 + 2 * numTurns;
+
+  std::vector<size_t> active(starts.size());
+  std::iota(active.begin(), active.end(), 0);
+  Eigen::RowMatrixX3f positions;
+  std::vector<int> queryFieldIds;
+  std::vector<uint8_t> collided;
+  while (!active.empty()) {
+    const size_t numQueries = active.size() * queriesPerPath;
+    positions.resize(numQueries, 3);
+    queryFieldIds.resize(numQueries);
+    collided.assign(numQueries, 0);
+
+    for (size_t iActive = 0; iActive < active.size(); ++iActive) {
+      const size_t iPath = active[iActive];
+      const scene::SceneNode& node = *nodes[iPath];
+      size_t iQuery = iActive * queriesPerPath;
+      std::fill_n(queryFieldIds.begin() + iQuery, queriesPerPath,
+                  fieldIds[iPath]);
+      positions.row(iQuery++) =
+          cast<vec3f>(node.MagnumObject::translation()).transpose();
+
+      leftDummyNode_.MagnumObject::setTransformation(
+          node.MagnumObject::transformation());
+      rightDummyNode_.MagnumObject::setTransformation(
+          node.MagnumObject::transformation());
+      for (int n = 0; n < numTurns; ++n) {
+        if (n > 0) {
+          turnLeft_(&leftDummyNode_);
+          turnRight_(&rightDummyNode_);
+        }
+
+        for (const scene::SceneNode* turned :
+             {&leftDummyNode_, &rightDummyNode_}) {
+          tryStepDummyNode_.MagnumObject::setTransformation(
+              turned->MagnumObject::transformation());
+          collided[iQuery] = moveForward_(&tryStepDummyNode_);
+          positions.row(iQuery++) =
+              cast<vec3f>(tryStepDummyNode_.MagnumObject::translation())
+                  .transpose();
+        }
+      }
+    }
+
+    const Eigen::VectorXf geodesicDistances =
+        pathfinder_->geodesicDistancesFromDistanceFields(fields, positions,
+                                                         queryFieldIds);
+    const Eigen::VectorXf obstacleDistances =
+        pathfinder_->distancesToClosestObstacle(positions,
+                                                1.1 * closeToObsThreshold_);
+
+    std::vector<size_t> stillActive;
+    for (size_t iActive = 0; iActive < active.size(); ++iActive) {
+      const size_t iPath = active[iActive];
+      const size_t iQuery = iActive * queriesPerPath;
+      const float geodesicDistance = geodesicDistances[iQuery];
+
+      std::vector<CODES> nextPrim;
+      if (geodesicDistance == std::numeric_limits<float>::infinity()) {
+        nextPrim = {CODES::ERROR};
+      } else if (geodesicDistance < goalDist_) {
+        nextPrim = {CODES::STOP};
+      } else {
+        nextPrim = selectPrim([&](const CODES turn, const size_t primTurns) {
+          const size_t iPrim =
+              iQuery + 1 + 2 * primTurns + (turn == CODES::RIGHT ? 1 : 0);
+          return computeReward(
+              geodesicDistance,
+              {geodesicDistances[iPrim], obstacleDistances[iPrim],
+               collided[iPrim] != 0},
+              primTurns);
+        });
+      }
+
+      std::vector<CODES>& actions = paths[iPath];
+      if (nextPrim.size() == 0) {
+        actions.emplace_back(CODES::ERROR);
+      } else {
+        for (const auto nextAction : nextPrim) {
+          applyAction(*nodes[iPath], nextAction);
+          actions.emplace_back(nextAction);
+        }
+      }
+
+      // Same termination as findPath
+      if (actions.back() != CODES::STOP && actions.back() != CODES::ERROR &&
+          actions.size() < maxActions) {
+        stillActive.push_back(iPath);
+      } else if (actions.back() == CODES::ERROR ||
+                 actions.size() == maxActions) {
+        actions.clear();
+      }
+    }
+    active = std::move(stillActive);
+  }
+
+  return paths;
+}
+
 void GreedyGeodesicFollowerImpl::reset() {
   actions_.clear();
   thrashingActions_.clear();
@@ -27,6 +27,11 @@ namespace nav {
  *
  * Once a primitive is selected, the first action in that primitives is selected
  * as the next action to take and this process is repeated
+ *
+ * By default every primitive is scored by planning a path from where it ends
+ * up. With `useDistanceField`, a single geodesic distance field to the goal
+ * is computed once (see @ref PathFinder::findPathFromDistanceField) and all
+ * primitives are scored against it without any re-planning.
  */
 class GreedyGeodesicFollowerImpl {
  public:
@@ -70,6 +75,9 @@ class GreedyGeodesicFollowerImpl {
    * @param[in] fixThrashing Whether or not to fix thrashing
    * @param[in] thrashingThreshold The length of left, right, left, right
    *                                actions needed to be considered thrashing
+   * @param[in] useDistanceField Whether to score primitives against a cached
+   *                             geodesic distance field to the goal instead
+   *                             of planning a path for each of them
    */
   GreedyGeodesicFollowerImpl(PathFinder::ptr& pathfinder,
                              MoveFn& moveForward,
@@ -79,7 +87,8 @@ class GreedyGeodesicFollowerImpl {
                              double forwardAmount,
                              double turnAmount,
                              bool fixThrashing = true,
-                             int thrashingThreshold = 16);
+                             int thrashingThreshold = 16,
+                             bool useDistanceField = false);
 
   /**
    * @brief Calculates the next action to follow the path
@@ -112,6 +121,26 @@ class GreedyGeodesicFollowerImpl {
   std::vector<CODES> findPath(const core::RigidState& start,
                               const Magnum::Vector3& end);
 
+  /**
+   * @brief Finds the full paths for many (start, end) pairs, as @ref findPath
+   * with `useDistanceField` would for each of them
+   *
+   * The trajectories are advanced in lockstep. Each step, all primitives of
+   * all unfinished trajectories are simulated with the move functions and
+   * then scored with a single batched query against one distance field per
+   * distinct end, which the pathfinder distributes across its threads, see
+   * @ref PathFinder::geodesicDistancesFromDistanceFields. Does not change the
+   * state of the planner.
+   *
+   * @param[in] starts The starting states
+   * @param[in] ends The end location of each path
+   *
+   * @return The actions of each path, empty for pairs where no path was found
+   */
+  std::vector<std::vector<CODES>> findPaths(
+      const std::vector<core::RigidState>& starts,
+      const std::vector<Magnum::Vector3>& ends);
+
   /**
    * @brief Reset the planner.
    *
@@ -126,6 +155,7 @@ class GreedyGeodesicFollowerImpl {
   const double forwardAmount_, goalDist_, turnAmount_;
   const bool fixThrashing_;
   const int thrashingThreshold_;
+  const bool useDistanceField_;
   const float closeToObsThreshold_ = 0.2f;
   const float collisionCost_ = 0.25f;
 
@@ -141,6 +171,13 @@ class GreedyGeodesicFollowerImpl {
   ShortestPath geoDistPath_;
   float geoDist(const Magnum::Vector3& start, const Magnum::Vector3& end);
 
+  //! Holds the distance field to fieldGoal_ when using useDistanceField_
+  MultiGoalShortestPath fieldPath_;
+  Magnum::Vector3 fieldGoal_;
+  bool hasFieldGoal_ = false;
+
+  ShortestPath pathTo(const Magnum::Vector3& start, const Magnum::Vector3& end);
+
   struct TryStepResult {
     float postGeodesicDistance, postDistanceToClosestObstacle;
     bool didCollide;
@@ -153,6 +190,18 @@ class GreedyGeodesicFollowerImpl {
                       const nav::ShortestPath& path,
                       const size_t primLen);
 
+  float computeReward(float geodesicDistance,
+                      const TryStepResult& tryStepRes,
+                      const size_t primLen) const;
+
+  //! The number of turns after which primitives start turning around
+  int numPrimTurns() const;
+
+  template <typename RewardFn>
+  std::vector<CODES> selectPrim(RewardFn&& rewardFn) const;
+
+  void applyAction(scene::SceneNode& node, CODES action);
+
   bool isThrashing();
 
   std::vector<nav::GreedyGeodesicFollowerImpl::CODES> nextBestPrimAlong(
@@ -3,9 +3,13 @@
 // LICENSE file in the root directory of this source tree.
 
 #include "PathFinder.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <numeric>
-#include <stack>
-#include <unordered_map>
+#include <queue>
+#include <stdexcept>
+#include <string>
 
 #include <Magnum/Magnum.h>
 #include <Magnum/Math/Vector3.h>
@@ -21,8 +25,13 @@
 #include <limits>
 
 #include "esp/assets/MeshData.h"
+#include "esp/core/MappedFile.h"
+#include "esp/core/ThreadPool.h"
 #include "esp/core/esp.h"
+#include "esp/core/random.h"
+#include "esp/io/io.h"
 
+#include "DetourCommon.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshBuilder.h"
 #include "DetourNavMeshQuery.h"
@@ -43,6 +52,14 @@ struct MultiGoalShortestPath::Impl {
 
   std::vector<float> minTheoreticalDist;
   vec3f prevRequestedStart = vec3f::Zero();
+
+  //! Geodesic distance field to the requested ends over the navmesh vertex
+  //! graph, see PathFinder::findPathFromDistanceField
+  std::vector<float> fieldDistances;
+  //! The index of the closest requested end for every vertex
+  std::vector<uint32_t> fieldGoals;
+  //! The navmesh the field was computed on, 0 if there is no field
+  size_t fieldNavMeshVersion = 0;
 };
 
 MultiGoalShortestPath::MultiGoalShortestPath()
@@ -55,6 +72,10 @@ void MultiGoalShortestPath::setRequestedEnds(
   pimpl_->requestedEnds = newEnds;
 
   pimpl_->minTheoreticalDist.assign(newEnds.size(), 0);
+
+  pimpl_->fieldDistances.clear();
+  pimpl_->fieldGoals.clear();
+  pimpl_->fieldNavMeshVersion = 0;
 }
 
 const std::vector<vec3f>& MultiGoalShortestPath::getRequestedEnds() const {
@@ -62,6 +83,11 @@ const std::vector<vec3f>& MultiGoalShortestPath::getRequestedEnds() const {
 }
 
 namespace {
+//! Source of navmesh versions. Shared by all PathFinders so that a version
+//! identifies a navmesh of one PathFinder only, and a distance field cached
+//! for one PathFinder is never considered valid by another.
+std::atomic<size_t> lastNavMeshVersion{0};
+
 template <typename T>
 std::tuple<dtStatus, dtPolyRef, vec3f> projectToPoly(
     const T& pt,
@@ -88,99 +114,254 @@ std::tuple<dtStatus, dtPolyRef, vec3f> projectToPoly(
 
 namespace impl {
 
+// Calls fn(tileIndex, tile) for every tile of the navmesh holding data, in the
+// order they are stored in a saved navmesh
+template <typename Fn>
+void forEachTile(const dtNavMesh* navMesh, Fn&& fn) {
+  for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
+    const dtMeshTile* tile = navMesh->getTile(iTile);
+    if (!tile || !tile->header || !tile->dataSize)
+      continue;
+
+    fn(iTile, tile);
+  }
+}
+
 // Runs connected component analysis on the navmesh to figure out which polygons
 // are connected This gives O(1) lookup for if a path between two polygons
 // exists or not
+// Islands are stored in a flat array indexed by the tile and polygon index
+// decoded from the polygon ref, so lookups neither hash nor allocate.
 // Takes O(npolys) to construct
 class IslandSystem {
  public:
-  IslandSystem(const dtNavMesh* navMesh, const dtQueryFilter* filter) {
-    std::vector<vec3f> islandVerts;
+  static constexpr uint32_t NO_ISLAND = std::numeric_limits<uint32_t>::max();
 
-    // Iterate over all tiles
-    for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
-      const dtMeshTile* tile = navMesh->getTile(iTile);
-      if (!tile)
-        continue;
+  IslandSystem(const dtNavMesh* navMesh, const dtQueryFilter* filter)
+      : navMesh_{navMesh} {
+    initPolyIndices();
+    floodFillIslands(filter);
+    countIslandPolys();
+  }
 
-      // Iterate over all polygons in a tile
-      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
-        // Get the polygon reference from the tile and polygon id
-        dtPolyRef startRef = navMesh->encodePolyId(tile->salt, iTile, jPoly);
-
-        // If the polygon ref is valid, and we haven't seen it yet,
-        // start connected component analysis from this polygon
-        if (navMesh->isValidPolyRef(startRef) &&
-            (polyToIsland_.find(startRef) == polyToIsland_.end())) {
-          uint32_t newIslandId = islandRadius_.size();
-          expandFrom(navMesh, filter, newIslandId, startRef, islandVerts);
-
-          // The radius is calculated as the max deviation from the mean for all
-          // points in the island
-          vec3f centroid = vec3f::Zero();
-          for (auto& v : islandVerts) {
-            centroid += v;
-          }
-          centroid /= islandVerts.size();
+  // Restores the islands saved with polyIslands() and islandRadii() for the
+  // same navmesh
+  IslandSystem(const dtNavMesh* navMesh,
+               const std::vector<uint32_t>& polyIslands,
+               std::vector<float> islandRadius)
+      : navMesh_{navMesh}, islandRadius_{std::move(islandRadius)} {
+    initPolyIndices();
+    CORRADE_INTERNAL_ASSERT(polyIslands.size() == polyIsland_.size());
+    polyIsland_ = polyIslands;
+    countIslandPolys();
+  }
 
-          float maxRadius = 0.0;
-          for (auto& v : islandVerts) {
-            maxRadius = std::max(maxRadius, (v - centroid).norm());
-          }
+  // Updates the islands after the tiles with the given indices were added,
+  // removed or replaced. Islands which neither had polygons in those tiles nor
+  // are linked to the new ones are kept as they are, only the polygons of the
+  // others are flood filled again.
+  void updateTiles(const dtQueryFilter* filter,
+                   const std::vector<int>& changedTiles) {
+    std::vector<bool> tileChanged(navMesh_->getMaxTiles(), false);
+    for (const int iTile : changedTiles) {
+      tileChanged[iTile] = true;
+    }
 
-          islandRadius_.emplace_back(maxRadius);
+    // Islands which had polygons in a changed tile may have been split
+    std::vector<bool> islandDirty(islandRadius_.size(), false);
+    for (const int iTile : changedTiles) {
+      for (uint32_t i = tilePolyOffset_[iTile]; i < tilePolyOffset_[iTile + 1];
+           ++i) {
+        if (polyIsland_[i] != NO_ISLAND)
+          islandDirty[polyIsland_[i]] = true;
+      }
+    }
+
+    // Move the islands of the unchanged tiles to the new polygon layout
+    const std::vector<uint32_t> oldTilePolyOffset = std::move(tilePolyOffset_);
+    const std::vector<uint32_t> oldPolyIsland = std::move(polyIsland_);
+    initPolyIndices();
+    for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+      if (tileChanged[iTile])
+        continue;
+      CORRADE_INTERNAL_ASSERT(
+          oldTilePolyOffset[iTile + 1] - oldTilePolyOffset[iTile] ==
+          tilePolyOffset_[iTile + 1] - tilePolyOffset_[iTile]);
+      std::copy(oldPolyIsland.begin() + oldTilePolyOffset[iTile],
+                oldPolyIsland.begin() + oldTilePolyOffset[iTile + 1],
+                polyIsland_.begin() + tilePolyOffset_[iTile]);
+    }
+
+    // Islands the changed tiles are linked to may have been merged
+    for (const int iTile : changedTiles) {
+      const dtMeshTile* tile = navMesh_->getTile(iTile);
+      if (!tile->header || !tile->dataSize)
+        continue;
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        const dtPoly& poly = tile->polys[jPoly];
+        for (unsigned int iLink = poly.firstLink; iLink != DT_NULL_LINK;
+             iLink = tile->links[iLink].next) {
+          const dtPolyRef neighbourRef = tile->links[iLink].ref;
+          if (tileChanged[navMesh_->decodePolyIdTile(neighbourRef)])
+            continue;
+          const uint32_t island = polyIsland_[polyIndex(neighbourRef)];
+          if (island != NO_ISLAND)
+            islandDirty[island] = true;
         }
       }
     }
+
+    // Drop the dirty islands and compact the ids of the remaining ones
+    std::vector<uint32_t> islandRemap(islandRadius_.size(), NO_ISLAND);
+    std::vector<float> oldIslandRadius = std::move(islandRadius_);
+    islandRadius_.clear();
+    for (uint32_t island = 0; island < oldIslandRadius.size(); ++island) {
+      if (!islandDirty[island]) {
+        islandRemap[island] = islandRadius_.size();
+        islandRadius_.push_back(oldIslandRadius[island]);
+      }
+    }
+    for (uint32_t& island : polyIsland_) {
+      if (island != NO_ISLAND)
+        island = islandRemap[island];
+    }
+
+    floodFillIslands(filter);
+    countIslandPolys();
+  }
+
+  inline uint32_t islandId(dtPolyRef ref) const {
+    if (!ref)
+      return NO_ISLAND;
+
+    const unsigned int iTile = navMesh_->decodePolyIdTile(ref);
+    if (iTile + 1 >= tilePolyOffset_.size())
+      return NO_ISLAND;
+
+    const uint32_t iPoly =
+        tilePolyOffset_[iTile] + navMesh_->decodePolyIdPoly(ref);
+    if (iPoly >= tilePolyOffset_[iTile + 1])
+      return NO_ISLAND;
+
+    return polyIsland_[iPoly];
   }
 
   inline bool hasConnection(dtPolyRef startRef, dtPolyRef endRef) const {
     // If both polygons are on the same island, there must be a path between
     // them
-    auto itStart = polyToIsland_.find(startRef);
-    if (itStart == polyToIsland_.end())
-      return false;
-
-    auto itEnd = polyToIsland_.find(endRef);
-    if (itEnd == polyToIsland_.end())
-      return false;
-
-    return itStart->second == itEnd->second;
+    const uint32_t startIsland = islandId(startRef);
+    return startIsland != NO_ISLAND && startIsland == islandId(endRef);
   }
 
   inline float islandRadius(dtPolyRef ref) const {
-    auto itRef = polyToIsland_.find(ref);
-    if (itRef == polyToIsland_.end())
+    const uint32_t island = islandId(ref);
+    if (island == NO_ISLAND)
       return 0.0;
 
-    return islandRadius_[itRef->second];
+    return islandRadius_[island];
+  }
+
+  inline uint32_t numIslands() const { return islandRadius_.size(); }
+
+  inline uint32_t islandNumPolys(uint32_t island) const {
+    return islandNumPolys_[island];
+  }
+
+  // The island of every polygon in the order of forEachTile, NO_ISLAND for
+  // polygons which are not navigable
+  inline const std::vector<uint32_t>& polyIslands() const {
+    return polyIsland_;
+  }
+
+  inline const std::vector<float>& islandRadii() const {
+    return islandRadius_;
   }
 
  private:
-  std::unordered_map<dtPolyRef, uint32_t> polyToIsland_;
+  const dtNavMesh* navMesh_;
+
+  // Offset of the first polygon of each tile in polyIsland_, with one extra
+  // entry holding the total number of polygons
+  std::vector<uint32_t> tilePolyOffset_;
+  std::vector<uint32_t> polyIsland_;
   std::vector<float> islandRadius_;
+  std::vector<uint32_t> islandNumPolys_;
 
-  void expandFrom(const dtNavMesh* navMesh,
-                  const dtQueryFilter* filter,
+  void initPolyIndices() {
+    tilePolyOffset_.assign(navMesh_->getMaxTiles() + 1, 0);
+    for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+      const dtMeshTile* tile = navMesh_->getTile(iTile);
+      const bool hasData = tile && tile->header && tile->dataSize;
+      tilePolyOffset_[iTile + 1] =
+          tilePolyOffset_[iTile] + (hasData ? tile->header->polyCount : 0);
+    }
+    polyIsland_.assign(tilePolyOffset_.back(), NO_ISLAND);
+  }
+
+  // Assigns new islands to all walkable polygons which have none yet
+  void floodFillIslands(const dtQueryFilter* filter) {
+    std::vector<vec3f> islandVerts;
+    std::vector<dtPolyRef> stack;
+
+    forEachTile(navMesh_, [&](const int iTile, const dtMeshTile* tile) {
+      // Iterate over all polygons in a tile
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        // Get the polygon reference from the tile and polygon id
+        dtPolyRef startRef = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
+
+        // If the polygon is walkable, and we haven't seen it yet, start
+        // connected component analysis from this polygon
+        if (polyIsland_[tilePolyOffset_[iTile] + jPoly] != NO_ISLAND ||
+            !filter->passFilter(startRef, tile, &tile->polys[jPoly]))
+          continue;
+
+        uint32_t newIslandId = islandRadius_.size();
+        expandFrom(filter, newIslandId, startRef, stack, islandVerts);
+
+        // The radius is calculated as the max deviation from the mean for all
+        // points in the island
+        vec3f centroid = vec3f::Zero();
+        for (auto& v : islandVerts) {
+          centroid += v;
+        }
+        centroid /= islandVerts.size();
+
+        float maxRadius = 0.0;
+        for (auto& v : islandVerts) {
+          maxRadius = std::max(maxRadius, (v - centroid).norm());
+        }
+
+        islandRadius_.emplace_back(maxRadius);
+      }
+    });
+  }
+
+  void countIslandPolys() {
+    islandNumPolys_.assign(islandRadius_.size(), 0);
+    for (const uint32_t island : polyIsland_) {
+      if (island != NO_ISLAND)
+        ++islandNumPolys_[island];
+    }
+  }
+
+  void expandFrom(const dtQueryFilter* filter,
                   const uint32_t newIslandId,
                   const dtPolyRef& startRef,
+                  std::vector<dtPolyRef>& stack,
                   std::vector<vec3f>& islandVerts) {
-    polyToIsland_.emplace(startRef, newIslandId);
+    polyIsland_[polyIndex(startRef)] = newIslandId;
     islandVerts.clear();
 
-    // Force std::stack to be implemented via an std::vector as linked
-    // lists are gross
-    std::stack<dtPolyRef, std::vector<dtPolyRef>> stack;
-
     // Add the start ref to the stack
-    stack.push(startRef);
+    stack.clear();
+    stack.push_back(startRef);
     while (!stack.empty()) {
-      dtPolyRef ref = stack.top();
-      stack.pop();
+      dtPolyRef ref = stack.back();
+      stack.pop_back();
 
       const dtMeshTile* tile = 0;
       const dtPoly* poly = 0;
-      navMesh->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
+      navMesh_->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
 
       for (int iVert = 0; iVert < poly->vertCount; ++iVert) {
         islandVerts.emplace_back(
@@ -192,24 +373,351 @@ class IslandSystem {
            iLink = tile->links[iLink].next) {
         dtPolyRef neighbourRef = tile->links[iLink].ref;
         // If we've already visited this poly, skip it!
-        if (polyToIsland_.find(neighbourRef) != polyToIsland_.end())
+        const uint32_t neighbourIndex = polyIndex(neighbourRef);
+        if (polyIsland_[neighbourIndex] != NO_ISLAND)
           continue;
 
         const dtMeshTile* neighbourTile = 0;
         const dtPoly* neighbourPoly = 0;
-        navMesh->getTileAndPolyByRefUnsafe(neighbourRef, &neighbourTile,
-                                           &neighbourPoly);
+        navMesh_->getTileAndPolyByRefUnsafe(neighbourRef, &neighbourTile,
+                                            &neighbourPoly);
 
         // If a neighbour isn't walkable, don't add it
         if (!filter->passFilter(neighbourRef, neighbourTile, neighbourPoly))
           continue;
 
-        polyToIsland_.emplace(neighbourRef, newIslandId);
-        stack.push(neighbourRef);
+        polyIsland_[neighbourIndex] = newIslandId;
+        stack.push_back(neighbourRef);
+      }
+    }
+  }
+
+  // Index into polyIsland_ of a valid polygon ref
+  inline uint32_t polyIndex(dtPolyRef ref) const {
+    return tilePolyOffset_[navMesh_->decodePolyIdTile(ref)] +
+           navMesh_->decodePolyIdPoly(ref);
+  }
+};
+
+constexpr uint32_t IslandSystem::NO_ISLAND;
+
+// Graph over the vertices of the navmesh polygons used to compute geodesic
+// distance fields.  Two vertices are connected if they belong to the same
+// (convex) polygon or if they belong to neighbouring polygons and can see each
+// other.  Shortest paths on the navmesh only bend at polygon vertices, so
+// running Dijkstra on this graph gives a tight upper bound on the geodesic
+// distance without any per-query search.
+// Takes O(npolys) raycasts to construct
+class NavMeshGraph {
+ public:
+  static constexpr uint32_t NO_SOURCE = std::numeric_limits<uint32_t>::max();
+
+  NavMeshGraph(const dtNavMesh* navMesh,
+               const dtNavMeshQuery* navQuery,
+               const dtQueryFilter* filter)
+      : navMesh_{navMesh}, filter_{filter} {
+    tileNodeOffset_.assign(navMesh->getMaxTiles(), 0);
+    for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
+      const dtMeshTile* tile = navMesh->getTile(iTile);
+      tileNodeOffset_[iTile] = nodePositions_.size();
+      if (!tile || !tile->header)
+        continue;
+
+      for (int iVert = 0; iVert < tile->header->vertCount; ++iVert) {
+        nodePositions_.emplace_back(
+            Eigen::Map<const vec3f>(&tile->verts[iVert * 3]));
+      }
+    }
+
+    std::vector<std::vector<std::pair<uint32_t, float>>> adjacency(
+        nodePositions_.size());
+    const auto addEdge = [&](uint32_t a, uint32_t b, float weight) {
+      adjacency[a].emplace_back(b, weight);
+      adjacency[b].emplace_back(a, weight);
+    };
+
+    for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
+      const dtMeshTile* tile = navMesh->getTile(iTile);
+      if (!tile || !tile->header)
+        continue;
+
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        const dtPolyRef ref = navMesh->encodePolyId(tile->salt, iTile, jPoly);
+        const dtPoly* poly = &tile->polys[jPoly];
+        if (!filter->passFilter(ref, tile, poly))
+          continue;
+
+        // All vertices of a convex polygon can see each other
+        for (int a = 0; a < poly->vertCount; ++a) {
+          for (int b = a + 1; b < poly->vertCount; ++b) {
+            const uint32_t nodeA = nodeIndex(iTile, poly->verts[a]);
+            const uint32_t nodeB = nodeIndex(iTile, poly->verts[b]);
+            addEdge(nodeA, nodeB,
+                    (nodePositions_[nodeA] - nodePositions_[nodeB]).norm());
+          }
+        }
+
+        // Vertices of neighbouring polygons need a line of sight check.
+        // Every pair gets checked from both sides, so only add the edge from
+        // the side with the smaller ref
+        forEachNeighbour(ref, [&](const dtPolyRef neighbourRef) {
+          if (neighbourRef < ref)
+            return;
+
+          for (int a = 0; a < poly->vertCount; ++a) {
+            const uint32_t nodeA = nodeIndex(iTile, poly->verts[a]);
+            const vec3f start = nudgeIntoPoly(ref, nodePositions_[nodeA]);
+            forEachPolyNode(neighbourRef, [&](const uint32_t nodeB) {
+              if (nodeA == nodeB)
+                return;
+
+              const float dist =
+                  (nodePositions_[nodeA] - nodePositions_[nodeB]).norm();
+              // Vertices shared across a tile border
+              if (dist < 1e-4) {
+                addEdge(nodeA, nodeB, 0);
+              } else if (isVisible(navQuery, ref, start, nodeB,
+                                   neighbourRef)) {
+                addEdge(nodeA, nodeB, dist);
+              }
+            });
+          }
+        });
+      }
+    }
+
+    // Flatten into CSR
+    edgeOffsets_.reserve(nodePositions_.size() + 1);
+    edgeOffsets_.push_back(0);
+    for (const auto& edges : adjacency) {
+      for (const auto& edge : edges) {
+        edgeTargets_.push_back(edge.first);
+        edgeWeights_.push_back(edge.second);
+      }
+      edgeOffsets_.push_back(edgeTargets_.size());
+    }
+  }
+
+  inline uint32_t numNodes() const { return nodePositions_.size(); }
+
+  inline const vec3f& nodePosition(uint32_t node) const {
+    return nodePositions_[node];
+  }
+
+  // Calls fn(node) for all vertices of the polygon
+  template <typename Fn>
+  void forEachPolyNode(dtPolyRef ref, Fn&& fn) const {
+    const dtMeshTile* tile = 0;
+    const dtPoly* poly = 0;
+    navMesh_->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
+    const unsigned int iTile = navMesh_->decodePolyIdTile(ref);
+    for (int iVert = 0; iVert < poly->vertCount; ++iVert) {
+      fn(nodeIndex(iTile, poly->verts[iVert]));
+    }
+  }
+
+  // Calls fn(neighbourRef) for all walkable polygons adjacent to the polygon
+  template <typename Fn>
+  void forEachNeighbour(dtPolyRef ref, Fn&& fn) const {
+    const dtMeshTile* tile = 0;
+    const dtPoly* poly = 0;
+    navMesh_->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
+    for (unsigned int iLink = poly->firstLink; iLink != DT_NULL_LINK;
+         iLink = tile->links[iLink].next) {
+      const dtPolyRef neighbourRef = tile->links[iLink].ref;
+      if (!neighbourRef)
+        continue;
+
+      const dtMeshTile* neighbourTile = 0;
+      const dtPoly* neighbourPoly = 0;
+      navMesh_->getTileAndPolyByRefUnsafe(neighbourRef, &neighbourTile,
+                                          &neighbourPoly);
+      if (filter_->passFilter(neighbourRef, neighbourTile, neighbourPoly))
+        fn(neighbourRef);
+    }
+  }
+
+  // Whether the straight line from pos, which is inside polygon ref, to the
+  // node, which is a vertex of polygon nodeRef, stays on the navmesh
+  bool isVisible(const dtNavMeshQuery* navQuery,
+                 dtPolyRef ref,
+                 const vec3f& pos,
+                 uint32_t node,
+                 dtPolyRef nodeRef) const {
+    return isVisible(navQuery, ref, pos,
+                     nudgeIntoPoly(nodeRef, nodePositions_[node]));
+  }
+
+  bool isVisible(const dtNavMeshQuery* navQuery,
+                 dtPolyRef ref,
+                 const vec3f& pos,
+                 const vec3f& target) const {
+    static const int MAX_POLYS = 16;
+    dtPolyRef polys[MAX_POLYS];
+    int numPolys = 0;
+    float t = 0;
+    vec3f hitNormal;
+    dtStatus status =
+        navQuery->raycast(ref, pos.data(), target.data(), filter_, &t,
+                          hitNormal.data(), polys, &numPolys, MAX_POLYS);
+    // t is FLT_MAX if the ray reached target without hitting a wall
+    return dtStatusSucceed(status) && t > 1.0f;
+  }
+
+  // Runs a multi-source Dijkstra from the seeds, given as (node, distance,
+  // source) triplets. Writes the distance to the closest source and the index
+  // of that source for every node.
+  void computeDistanceField(
+      const std::vector<std::tuple<uint32_t, float, uint32_t>>& seeds,
+      std::vector<float>& distances,
+      std::vector<uint32_t>& sources) const {
+    distances.assign(numNodes(), std::numeric_limits<float>::infinity());
+    sources.assign(numNodes(), NO_SOURCE);
+
+    typedef std::pair<float, uint32_t> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                        std::greater<QueueEntry>>
+        queue;
+    for (const auto& seed : seeds) {
+      const uint32_t node = std::get<0>(seed);
+      if (std::get<1>(seed) < distances[node]) {
+        distances[node] = std::get<1>(seed);
+        sources[node] = std::get<2>(seed);
+        queue.emplace(distances[node], node);
+      }
+    }
+
+    while (!queue.empty()) {
+      const QueueEntry top = queue.top();
+      queue.pop();
+      const uint32_t node = top.second;
+      // Stale entry, node was already settled with a shorter distance
+      if (top.first > distances[node])
+        continue;
+
+      for (uint32_t iEdge = edgeOffsets_[node]; iEdge < edgeOffsets_[node + 1];
+           ++iEdge) {
+        const uint32_t neighbour = edgeTargets_[iEdge];
+        const float dist = top.first + edgeWeights_[iEdge];
+        if (dist < distances[neighbour]) {
+          distances[neighbour] = dist;
+          sources[neighbour] = sources[node];
+          queue.emplace(dist, neighbour);
+        }
+      }
+    }
+  }
+
+ private:
+  const dtNavMesh* navMesh_;
+  const dtQueryFilter* filter_;
+
+  std::vector<uint32_t> tileNodeOffset_;
+  std::vector<vec3f> nodePositions_;
+
+  std::vector<uint32_t> edgeOffsets_;
+  std::vector<uint32_t> edgeTargets_;
+  std::vector<float> edgeWeights_;
+
+  inline uint32_t nodeIndex(unsigned int iTile, unsigned short iVert) const {
+    return tileNodeOffset_[iTile] + iVert;
+  }
+
+  // Raycasts starting or ending exactly on a polygon vertex are degenerate,
+  // so move the point ever so slightly towards the polygon center
+  vec3f nudgeIntoPoly(dtPolyRef ref, const vec3f& pt) const {
+    vec3f polyCenter = vec3f::Zero();
+    int vertCount = 0;
+    forEachPolyNode(ref, [&](const uint32_t node) {
+      polyCenter += nodePositions_[node];
+      ++vertCount;
+    });
+    polyCenter /= vertCount;
+
+    constexpr float nudgeDistance = 1e-3;  // 1mm
+    return pt + nudgeDistance * (polyCenter - pt).normalized();
+  }
+};
+
+constexpr uint32_t NavMeshGraph::NO_SOURCE;
+
+// Seed of the random generator of a PathFinder until seed() is called. rand()
+// behaves as if seeded with 1 until srand() is called.
+constexpr unsigned int DEFAULT_RANDOM_SEED = 1;
+// How the bounds of a tiled build are split into tiles. Kept around so single
+// tiles can be rebuilt with the same parameters later.
+struct NavMeshTiling {
+  NavMeshSettings settings;
+  // Build config shared by all tiles, tile bounds excluded
+  rcConfig cfg;
+  // Bounds of the tile grid. The y range is fixed by the initial build, with
+  // some headroom above it, and clips the geometry of later tile rebuilds.
+  vec3f bmin;
+  vec3f bmax;
+  int numTilesX;
+  int numTilesZ;
+  int polyBits;
+
+  inline float tileWorldSize() const { return cfg.tileSize * cfg.cs; }
+  inline float borderWorldSize() const { return cfg.borderSize * cfg.cs; }
+
+  // Bounds of tile tx, tz padded by the border, the tile is built from the
+  // geometry within them
+  void tileBounds(const int tx,
+                  const int tz,
+                  float* tbmin,
+                  float* tbmax) const {
+    tbmin[0] = bmin[0] + tx * tileWorldSize() - borderWorldSize();
+    tbmin[1] = bmin[1];
+    tbmin[2] = bmin[2] + tz * tileWorldSize() - borderWorldSize();
+    tbmax[0] = bmin[0] + (tx + 1) * tileWorldSize() + borderWorldSize();
+    tbmax[1] = bmax[1];
+    tbmax[2] = bmin[2] + (tz + 1) * tileWorldSize() + borderWorldSize();
+  }
+
+  // Calls fn(tileIndex) for every tile whose padded xz bounds overlap the
+  // given xz bounds, with tileIndex = tz * numTilesX + tx
+  template <typename Fn>
+  void forEachTileOverlapping(float minX,
+                              float minZ,
+                              float maxX,
+                              float maxZ,
+                              Fn&& fn) const {
+    if (maxX + borderWorldSize() < bmin[0] ||
+        maxZ + borderWorldSize() < bmin[2] ||
+        minX - borderWorldSize() > bmin[0] + numTilesX * tileWorldSize() ||
+        minZ - borderWorldSize() > bmin[2] + numTilesZ * tileWorldSize())
+      return;
+
+    auto tileIndex = [&](const float x, const float origin, const int n) {
+      const int i =
+          static_cast<int>(std::floor((x - origin) / tileWorldSize()));
+      return std::max(0, std::min(i, n - 1));
+    };
+    const int x0 = tileIndex(minX - borderWorldSize(), bmin[0], numTilesX);
+    const int x1 = tileIndex(maxX + borderWorldSize(), bmin[0], numTilesX);
+    const int z0 = tileIndex(minZ - borderWorldSize(), bmin[2], numTilesZ);
+    const int z1 = tileIndex(maxZ + borderWorldSize(), bmin[2], numTilesZ);
+    for (int tz = z0; tz <= z1; ++tz) {
+      for (int tx = x0; tx <= x1; ++tx) {
+        fn(tz * numTilesX + tx);
       }
     }
   }
 };
+
+// Detour data of a single built tile, freed unless handed over to a navmesh
+struct TileData {
+  unsigned char* data = nullptr;
+  int dataSize = 0;
+  bool failed = false;
+
+  TileData() = default;
+  TileData(const TileData&) = delete;
+  TileData& operator=(const TileData&) = delete;
+  ~TileData() { dtFree(data); }
+};
+
 }  // namespace impl
 
 struct PathFinder::Impl {
@@ -225,16 +733,57 @@ struct PathFinder::Impl {
              const float* bmax);
   bool build(const NavMeshSettings& bs, const esp::assets::MeshData& mesh);
 
+  bool rebuildTiles(const esp::assets::MeshData& mesh,
+                    const vec3f& regionMin,
+                    const vec3f& regionMax);
+
+  std::pair<vec3f, vec3f> getTileRebuildBounds(const vec3f& regionMin,
+                                               const vec3f& regionMax) const;
+
   vec3f getRandomNavigablePoint();
 
-  bool findPath(ShortestPath& path);
-  bool findPath(MultiGoalShortestPath& path);
+  Eigen::RowMatrixX3f getRandomNavigablePoints(int numPoints, int islandIndex);
+
+  bool findPath(ShortestPath& path) { return findPath(path, navQuery_.get()); }
+  bool findPath(MultiGoalShortestPath& path) {
+    return findPath(path, navQuery_.get());
+  }
+
+  template <typename PathT>
+  std::vector<bool> findPaths(const std::vector<PathT*>& paths);
+
+  bool findPathFromDistanceField(MultiGoalShortestPath& path,
+                                 bool computePoints);
+
+  Eigen::VectorXf geodesicDistancesFromDistanceFields(
+      const std::vector<MultiGoalShortestPath::ptr>& fields,
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+      const std::vector<int>& fieldIds);
+
+  void setNumThreads(size_t numThreads);
+  size_t getNumThreads() const;
 
   template <typename T>
-  T tryStep(const T& start, const T& end, bool allowSliding);
+  T tryStep(const T& start, const T& end, bool allowSliding) {
+    return tryStep(start, end, allowSliding, navQuery_.get());
+  }
 
   template <typename T>
-  T snapPoint(const T& pt);
+  T snapPoint(const T& pt) {
+    return snapPoint(pt, navQuery_.get());
+  }
+
+  Eigen::RowMatrixX3f snapPoints(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& points);
+
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> isNavigableBatch(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+      float maxYDelta);
+
+  Eigen::RowMatrixX3f tryStepBatch(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& ends,
+      bool allowSliding);
 
   bool loadNavMesh(const std::string& path);
 
@@ -248,13 +797,25 @@ struct PathFinder::Impl {
 
   float islandRadius(const vec3f& pt) const;
 
+  int islandId(const vec3f& pt) const;
+
+  std::vector<NavMeshIsland> getIslands() const;
+
   float distanceToClosestObstacle(const vec3f& pt,
                                   const float maxSearchRadius = 2.0) const;
   HitRecord closestObstacleSurfacePoint(
       const vec3f& pt,
-      const float maxSearchRadius = 2.0) const;
+      const float maxSearchRadius = 2.0) const {
+    return closestObstacleSurfacePoint(pt, maxSearchRadius, navQuery_.get());
+  }
+
+  Eigen::VectorXf distancesToClosestObstacle(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+      float maxSearchRadius);
 
-  bool isNavigable(const vec3f& pt, const float maxYDelta = 0.5) const;
+  bool isNavigable(const vec3f& pt, const float maxYDelta = 0.5) const {
+    return isNavigable(pt, maxYDelta, navQuery_.get());
+  }
 
   std::pair<vec3f, vec3f> bounds() const { return bounds_; };
 
@@ -262,6 +823,10 @@ struct PathFinder::Impl {
       const float metersPerPixel,
       const float height);
 
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> rasterizeTopDownView(
+      const float metersPerPixel,
+      const float height);
+
   const assets::MeshData::ptr getNavMeshData();
 
  private:
@@ -272,24 +837,147 @@ struct PathFinder::Impl {
     void operator()(dtNavMeshQuery* query) { dtFreeNavMeshQuery(query); }
   };
 
+  //! Backing storage of navMesh_ tiles loaded in place from a saved navmesh.
+  //! Declared before navMesh_ so it is destroyed after it.
+  std::unique_ptr<core::MappedFile> mappedNavMesh_ = nullptr;
   std::unique_ptr<dtNavMesh, NavMeshDeleter> navMesh_ = nullptr;
   std::unique_ptr<dtNavMeshQuery, NavQueryDeleter> navQuery_ = nullptr;
   std::unique_ptr<dtQueryFilter> filter_ = nullptr;
   std::unique_ptr<impl::IslandSystem> islandSystem_ = nullptr;
+  //! Generated when a distance field is first queried. Reset with navQuery_.
+  std::unique_ptr<impl::NavMeshGraph> navMeshGraph_ = nullptr;
+  //! Changed to a new, process-wide unique, value every time the navmesh
+  //! changes so cached distance fields can be invalidated
+  size_t navMeshVersion_ = 0;
+
+  //! Number of threads used for batched queries and tiled builds, 0 means
+  //! hardware concurrency
+  size_t numThreads_ = 0;
+  //! Guards threadPool_ and workerQueries_, and is held for the whole of a
+  //! batched query or tiled build. The bindings release the GIL, so batches
+  //! can come from several threads at once.
+  mutable std::mutex parallelMutex_;
+  //! Created on first use, see threadPool()
+  std::unique_ptr<core::ThreadPool> threadPool_ = nullptr;
+  //! One query per thread pool worker as dtNavMeshQuery is not thread-safe.
+  //! Reset with navQuery_.
+  std::vector<std::unique_ptr<dtNavMeshQuery, NavQueryDeleter>> workerQueries_;
 
   //! Holds triangulated geom/topo. Generated when queried. Reset with
   //! navQuery_.
   assets::MeshData::ptr meshData_ = nullptr;
+  //! Offset of the first vertex of each tile in meshData_, with one extra
+  //! entry holding the total, so rebuilt tiles can be patched in
+  std::vector<uint32_t> meshDataTileOffset_;
+
+  //! The most recent top-down view, rendered with (metersPerPixel, height)
+  //! topDownViewCacheKey_ for the navmesh version topDownViewCacheVersion_.
+  //! Only one is kept as a full-resolution view can be large.
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> topDownViewCache_;
+  std::pair<float, float> topDownViewCacheKey_;
+  size_t topDownViewCacheVersion_ = 0;
+
+  //! Set by a tiled build so tiles can be rebuilt. Reset with navQuery_.
+  std::unique_ptr<impl::NavMeshTiling> tiling_ = nullptr;
 
   //! Sum of all NavMesh polygons. Computed on NavMesh load/recompute. See
   //! removeZeroAreaPolys.
   float navMeshArea_ = 0;
+  //! Walkable area of each tile slot summing up to navMeshArea_, so a tile
+  //! rebuild only needs to process the changed tiles. Empty if not computed
+  //! by removeZeroAreaPolys.
+  std::vector<float> tileNavigableAreas_;
 
   std::pair<vec3f, vec3f> bounds_;
 
+  //! Seeded with a fixed value so an unseeded PathFinder is deterministic,
+  //! like the unseeded rand() used before, see seed()
+  core::Random random_{impl::DEFAULT_RANDOM_SEED};
+
+  //! Guards random_ and the sampling state below. The batched sampling
+  //! binding releases the GIL, so points can be drawn from several threads at
+  //! once. Taken before parallelMutex_, never while holding it.
+  std::mutex samplingMutex_;
+
+  //! Walkable polygons grouped by island, with the cumulative polygon area in
+  //! that order, to sample points uniformly by area. Built on first use for
+  //! the navmesh version samplingVersion_.
+  std::vector<dtPolyRef> samplePolys_;
+  std::vector<float> samplePolyAreaCdf_;
+  //! Range of each island in samplePolys_, with one extra entry holding the
+  //! total
+  std::vector<uint32_t> islandSampleOffset_;
+  size_t samplingVersion_ = 0;
+
+  //! Requires samplingMutex_ to be held
+  void initSampling();
+
   void removeZeroAreaPolys();
+  //! Only processes the given tile slots, reusing the area of the others
+  void removeZeroAreaPolys(const std::vector<int>& tiles);
+  //! Returns the walkable area of the tile
+  float removeZeroAreaPolys(int iTile);
+
+  bool initNavQuery(
+      std::unique_ptr<impl::IslandSystem> islandSystem = nullptr);
+
+  bool initWorkerQueries();
+
+  //! Makes sure there is a worker query for every thread pool worker.
+  //! Requires parallelMutex_ to be held.
+  bool prepareWorkerQueries();
+
+  template <typename Fn>
+  bool forEachPointParallel(size_t numPoints, Fn&& fn);
+
+  //! Same as forEachPointParallel, for callers already holding
+  //! parallelMutex_
+  template <typename Fn>
+  bool forEachPointParallelLocked(size_t numPoints, Fn&& fn);
+
+  template <typename T>
+  T tryStep(const T& start,
+            const T& end,
+            bool allowSliding,
+            dtNavMeshQuery* navQuery);
+
+  template <typename T>
+  T snapPoint(const T& pt, const dtNavMeshQuery* navQuery);
+
+  bool isNavigable(const vec3f& pt,
+                   float maxYDelta,
+                   const dtNavMeshQuery* navQuery) const;
+
+  HitRecord closestObstacleSurfacePoint(const vec3f& pt,
+                                        float maxSearchRadius,
+                                        const dtNavMeshQuery* navQuery) const;
+
+  //! Requires parallelMutex_ to be held
+  core::ThreadPool& threadPool();
+
+  bool buildTiled(const NavMeshSettings& bs,
+                  rcConfig cfg,
+                  const float* verts,
+                  const int nverts,
+                  const int* tris,
+                  const int ntris,
+                  const float* bmin,
+                  const float* bmax);
+
+  bool buildTileData(const impl::NavMeshTiling& tiling,
+                     const float* verts,
+                     const int nverts,
+                     const int* tris,
+                     const int ntris,
+                     const std::vector<int>& tileIds,
+                     std::vector<impl::TileData>& tiles);
 
-  bool initNavQuery();
+  assets::MeshData::ptr triangulateTiles(const std::vector<bool>& tileChanged);
+
+  bool loadMappedNavMesh(const std::string& path);
+
+  bool findPath(ShortestPath& path, dtNavMeshQuery* navQuery);
+  bool findPath(MultiGoalShortestPath& path, dtNavMeshQuery* navQuery);
 
   Cr::Containers::Optional<std::tuple<float, std::vector<vec3f>>>
   findPathInternal(const vec3f& start,
@@ -297,11 +985,26 @@ struct PathFinder::Impl {
                    const vec3f& pathStart,
                    const vec3f& end,
                    dtPolyRef endRef,
-                   const vec3f& pathEnd);
+                   const vec3f& pathEnd,
+                   dtNavMeshQuery* navQuery);
 
   bool findPathSetup(MultiGoalShortestPath& path,
                      dtPolyRef& startRef,
-                     vec3f& pathStart);
+                     vec3f& pathStart,
+                     const dtNavMeshQuery* navQuery);
+
+  bool setupPathEnds(MultiGoalShortestPath& path,
+                     const dtNavMeshQuery* navQuery);
+
+  //! Requires parallelMutex_ to be held, as it builds navMeshGraph_ on first
+  //! use
+  void computeDistanceField(MultiGoalShortestPath& path);
+
+  float distanceFromField(const MultiGoalShortestPath& path,
+                          dtPolyRef startRef,
+                          const vec3f& pathStart,
+                          const dtNavMeshQuery* navQuery,
+                          uint32_t& bestEnd) const;
 };
 
 namespace {
@@ -339,20 +1042,9 @@ PathFinder::Impl::Impl() {
   filter_->setExcludeFlags(0);
 }
 
-bool PathFinder::Impl::build(const NavMeshSettings& bs,
-                             const float* verts,
-                             const int nverts,
-                             const int* tris,
-                             const int ntris,
-                             const float* bmin,
-                             const float* bmax) {
-  Workspace ws;
-  rcContext ctx;
-
-  //
-  // Step 1. Initialize build config.
-  //
-
+namespace {
+// Step 1 of the build, everything in the config but the area to build
+rcConfig makeBuildConfig(const NavMeshSettings& bs) {
   // Init build configuration from GUI
   rcConfig cfg;
   memset(&cfg, 0, sizeof(cfg));
@@ -372,16 +1064,21 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
   cfg.detailSampleDist =
       bs.detailSampleDist < 0.9f ? 0 : bs.cellSize * bs.detailSampleDist;
   cfg.detailSampleMaxError = bs.cellHeight * bs.detailSampleMaxError;
+  return cfg;
+}
 
-  // Set the area where the navigation will be build.
-  // Here the bounds of the input mesh are used, but the
-  // area could be specified by an user defined box, etc.
-  rcVcopy(cfg.bmin, bmin);
-  rcVcopy(cfg.bmax, bmax);
-  rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
-  LOG(INFO) << "Building navmesh with " << cfg.width << "x" << cfg.height
-            << " cells";
-
+// Steps 2 to 7 of the build: rasterizes the triangles into the area described
+// by cfg and builds the polygon and detail meshes in ws. Shared by the single
+// tile and the tiled builds, in the latter case it is run concurrently for
+// every tile with its own context.
+bool buildPolyMesh(rcContext& ctx,
+                   const rcConfig& cfg,
+                   const NavMeshSettings& bs,
+                   const float* verts,
+                   const int nverts,
+                   const int* tris,
+                   const int ntris,
+                   Workspace& ws) {
   //
   // Step 2. Rasterize input polygon soup.
   //
@@ -504,7 +1201,7 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
     return false;
   }
   // Partition the walkable surface into simple regions without holes.
-  if (!rcBuildRegions(&ctx, *ws.chf, 0, cfg.minRegionArea,
+  if (!rcBuildRegions(&ctx, *ws.chf, cfg.borderSize, cfg.minRegionArea,
                       cfg.mergeRegionArea)) {
     LOG(ERROR) << "Could not build watershed regions";
     return false;
@@ -568,6 +1265,102 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
   // ws.pmesh. See duDebugDrawPolyMesh or dtCreateNavMeshData as examples how to
   // access the data.
 
+  return true;
+}
+
+// Step 8 of the build: creates the Detour data of the tile at (tileX, tileY)
+// from the meshes built into ws. The caller owns the returned data.
+bool createNavMeshData(const rcConfig& cfg,
+                       const NavMeshSettings& bs,
+                       const int tileX,
+                       const int tileY,
+                       Workspace& ws,
+                       unsigned char** navData,
+                       int* navDataSize) {
+  // Update poly flags from areas.
+  for (int i = 0; i < ws.pmesh->npolys; ++i) {
+    if (ws.pmesh->areas[i] == RC_WALKABLE_AREA) {
+      ws.pmesh->areas[i] = POLYAREA_GROUND;
+    }
+    if (ws.pmesh->areas[i] == POLYAREA_GROUND) {
+      ws.pmesh->flags[i] = POLYFLAGS_WALK;
+    } else if (ws.pmesh->areas[i] == POLYAREA_DOOR) {
+      ws.pmesh->flags[i] = POLYFLAGS_WALK | POLYFLAGS_DOOR;
+    }
+  }
+
+  dtNavMeshCreateParams params;
+  memset(&params, 0, sizeof(params));
+  params.verts = ws.pmesh->verts;
+  params.vertCount = ws.pmesh->nverts;
+  params.polys = ws.pmesh->polys;
+  params.polyAreas = ws.pmesh->areas;
+  params.polyFlags = ws.pmesh->flags;
+  params.polyCount = ws.pmesh->npolys;
+  params.nvp = ws.pmesh->nvp;
+  params.detailMeshes = ws.dmesh->meshes;
+  params.detailVerts = ws.dmesh->verts;
+  params.detailVertsCount = ws.dmesh->nverts;
+  params.detailTris = ws.dmesh->tris;
+  params.detailTriCount = ws.dmesh->ntris;
+  // params.offMeshConVerts = geom->getOffMeshConnectionVerts();
+  // params.offMeshConRad = geom->getOffMeshConnectionRads();
+  // params.offMeshConDir = geom->getOffMeshConnectionDirs();
+  // params.offMeshConAreas = geom->getOffMeshConnectionAreas();
+  // params.offMeshConFlags = geom->getOffMeshConnectionFlags();
+  // params.offMeshConUserID = geom->getOffMeshConnectionId();
+  // params.offMeshConCount = geom->getOffMeshConnectionCount();
+  params.walkableHeight = bs.agentHeight;
+  params.walkableRadius = bs.agentRadius;
+  params.walkableClimb = bs.agentMaxClimb;
+  rcVcopy(params.bmin, ws.pmesh->bmin);
+  rcVcopy(params.bmax, ws.pmesh->bmax);
+  params.cs = cfg.cs;
+  params.ch = cfg.ch;
+  params.tileX = tileX;
+  params.tileY = tileY;
+  params.buildBvTree = true;
+
+  if (!dtCreateNavMeshData(&params, navData, navDataSize)) {
+    LOG(ERROR) << "Could not build Detour navmesh";
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+bool PathFinder::Impl::build(const NavMeshSettings& bs,
+                             const float* verts,
+                             const int nverts,
+                             const int* tris,
+                             const int ntris,
+                             const float* bmin,
+                             const float* bmax) {
+  //
+  // Step 1. Initialize build config.
+  //
+  rcConfig cfg = makeBuildConfig(bs);
+
+  if (bs.tileSize > 0) {
+    return buildTiled(bs, cfg, verts, nverts, tris, ntris, bmin, bmax);
+  }
+
+  Workspace ws;
+  rcContext ctx;
+
+  // Set the area where the navigation will be build.
+  // Here the bounds of the input mesh are used, but the
+  // area could be specified by an user defined box, etc.
+  rcVcopy(cfg.bmin, bmin);
+  rcVcopy(cfg.bmax, bmax);
+  rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+  LOG(INFO) << "Building navmesh with " << cfg.width << "x" << cfg.height
+            << " cells";
+
+  if (!buildPolyMesh(ctx, cfg, bs, verts, nverts, tris, ntris, ws)) {
+    return false;
+  }
+
   //
   // (Optional) Step 8. Create Detour data from Recast poly mesh.
   //
@@ -577,55 +1370,12 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
   if (cfg.maxVertsPerPoly <= DT_VERTS_PER_POLYGON) {
     unsigned char* navData = 0;
     int navDataSize = 0;
-
-    // Update poly flags from areas.
-    for (int i = 0; i < ws.pmesh->npolys; ++i) {
-      if (ws.pmesh->areas[i] == RC_WALKABLE_AREA) {
-        ws.pmesh->areas[i] = POLYAREA_GROUND;
-      }
-      if (ws.pmesh->areas[i] == POLYAREA_GROUND) {
-        ws.pmesh->flags[i] = POLYFLAGS_WALK;
-      } else if (ws.pmesh->areas[i] == POLYAREA_DOOR) {
-        ws.pmesh->flags[i] = POLYFLAGS_WALK | POLYFLAGS_DOOR;
-      }
-    }
-
-    dtNavMeshCreateParams params;
-    memset(&params, 0, sizeof(params));
-    params.verts = ws.pmesh->verts;
-    params.vertCount = ws.pmesh->nverts;
-    params.polys = ws.pmesh->polys;
-    params.polyAreas = ws.pmesh->areas;
-    params.polyFlags = ws.pmesh->flags;
-    params.polyCount = ws.pmesh->npolys;
-    params.nvp = ws.pmesh->nvp;
-    params.detailMeshes = ws.dmesh->meshes;
-    params.detailVerts = ws.dmesh->verts;
-    params.detailVertsCount = ws.dmesh->nverts;
-    params.detailTris = ws.dmesh->tris;
-    params.detailTriCount = ws.dmesh->ntris;
-    // params.offMeshConVerts = geom->getOffMeshConnectionVerts();
-    // params.offMeshConRad = geom->getOffMeshConnectionRads();
-    // params.offMeshConDir = geom->getOffMeshConnectionDirs();
-    // params.offMeshConAreas = geom->getOffMeshConnectionAreas();
-    // params.offMeshConFlags = geom->getOffMeshConnectionFlags();
-    // params.offMeshConUserID = geom->getOffMeshConnectionId();
-    // params.offMeshConCount = geom->getOffMeshConnectionCount();
-    params.walkableHeight = bs.agentHeight;
-    params.walkableRadius = bs.agentRadius;
-    params.walkableClimb = bs.agentMaxClimb;
-    rcVcopy(params.bmin, ws.pmesh->bmin);
-    rcVcopy(params.bmax, ws.pmesh->bmax);
-    params.cs = cfg.cs;
-    params.ch = cfg.ch;
-    params.buildBvTree = true;
-
-    if (!dtCreateNavMeshData(&params, &navData, &navDataSize)) {
-      LOG(ERROR) << "Could not build Detour navmesh";
+    if (!createNavMeshData(cfg, bs, 0, 0, ws, &navData, &navDataSize)) {
       return false;
     }
 
     navMesh_.reset(dtAllocNavMesh());
+    mappedNavMesh_.reset();
     if (!navMesh_) {
       dtFree(navData);
       LOG(ERROR) << "Could not allocate Detour navmesh";
@@ -653,9 +1403,230 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
   return true;
 }
 
-bool PathFinder::Impl::initNavQuery() {
+bool PathFinder::Impl::buildTiled(const NavMeshSettings& bs,
+                                  rcConfig cfg,
+                                  const float* verts,
+                                  const int nverts,
+                                  const int* tris,
+                                  const int ntris,
+                                  const float* bmin,
+                                  const float* bmax) {
+  if (cfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON) {
+    LOG(ERROR) << "Tiled navmeshes support at most " << DT_VERTS_PER_POLYGON
+               << " vertices per polygon";
+    return false;
+  }
+
+  int gridWidth = 0;
+  int gridHeight = 0;
+  rcCalcGridSize(bmin, bmax, cfg.cs, &gridWidth, &gridHeight);
+  const int tileSize = bs.tileSize;
+  const int numTilesX = (gridWidth + tileSize - 1) / tileSize;
+  const int numTilesZ = (gridHeight + tileSize - 1) / tileSize;
+  const int numTiles = numTilesX * numTilesZ;
+  if (numTiles == 0) {
+    LOG(ERROR) << "Cannot build a navmesh over empty bounds";
+    return false;
+  }
+
+  // Detour encodes the tile and polygon index of a polygon ref in 22 bits
+  const int tileBits =
+      std::min(static_cast<int>(dtIlog2(dtNextPow2(numTiles))), 14);
+  if (numTiles > (1 << tileBits)) {
+    LOG(ERROR) << "Navmesh would need " << numTiles
+               << " tiles, use a larger tile size";
+    return false;
+  }
+
+  // Tiles are padded with a border so the polygons on both sides of a tile
+  // edge line up. The border is trimmed away again when building contours.
+  cfg.tileSize = tileSize;
+  cfg.borderSize = cfg.walkableRadius + 3;
+  cfg.width = tileSize + 2 * cfg.borderSize;
+  cfg.height = tileSize + 2 * cfg.borderSize;
+  LOG(INFO) << "Building navmesh with " << gridWidth << "x" << gridHeight
+            << " cells in " << numTilesX << "x" << numTilesZ << " tiles";
+
+  auto tiling = std::make_unique<impl::NavMeshTiling>();
+  tiling->settings = bs;
+  tiling->cfg = cfg;
+  tiling->bmin = vec3f(bmin);
+  tiling->bmax = vec3f(bmax);
+  // Leave headroom for objects later placed on top of the highest surface
+  tiling->bmax[1] += bs.agentHeight;
+  tiling->numTilesX = numTilesX;
+  tiling->numTilesZ = numTilesZ;
+  tiling->polyBits = 22 - tileBits;
+
+  std::vector<int> tileIds(numTiles);
+  std::iota(tileIds.begin(), tileIds.end(), 0);
+  std::vector<impl::TileData> tiles(numTiles);
+  if (!buildTileData(*tiling, verts, nverts, tris, ntris, tileIds, tiles)) {
+    return false;
+  }
+
+  std::unique_ptr<dtNavMesh, NavMeshDeleter> navMesh{dtAllocNavMesh()};
+  if (!navMesh) {
+    LOG(ERROR) << "Could not allocate Detour navmesh";
+    return false;
+  }
+  dtNavMeshParams params;
+  memset(&params, 0, sizeof(params));
+  rcVcopy(params.orig, bmin);
+  params.tileWidth = tiling->tileWorldSize();
+  params.tileHeight = tiling->tileWorldSize();
+  params.maxTiles = numTiles;
+  params.maxPolys = 1 << tiling->polyBits;
+  if (dtStatusFailed(navMesh->init(&params))) {
+    LOG(ERROR) << "Could not init Detour navmesh";
+    return false;
+  }
+  // Tiles are added serially as dtNavMesh::addTile links them to their
+  // neighbours
+  for (impl::TileData& tile : tiles) {
+    if (!tile.data) {
+      continue;
+    }
+    dtStatus status = navMesh->addTile(tile.data, tile.dataSize,
+                                       DT_TILE_FREE_DATA, 0, nullptr);
+    if (dtStatusFailed(status)) {
+      LOG(ERROR) << "Could not add tile to Detour navmesh";
+      return false;
+    }
+    tile.data = nullptr;
+  }
+
+  navMesh_ = std::move(navMesh);
+  mappedNavMesh_.reset();
+  if (!initNavQuery()) {
+    return false;
+  }
+  tiling_ = std::move(tiling);
+
+  // Added as we also need to remove these on navmesh recomputation
+  removeZeroAreaPolys();
+
+  int numTilesBuilt = 0;
+  int numVerts = 0;
+  int numPolys = 0;
+  impl::forEachTile(navMesh_.get(), [&](int, const dtMeshTile* tile) {
+    ++numTilesBuilt;
+    numVerts += tile->header->vertCount;
+    numPolys += tile->header->polyCount;
+  });
+  LOG(INFO) << "Created navmesh with " << numTilesBuilt << " tiles "
+            << numVerts << " vertices " << numPolys << " polygons";
+
+  return true;
+}
+
+bool PathFinder::Impl::buildTileData(const impl::NavMeshTiling& tiling,
+                                     const float* verts,
+                                     const int nverts,
+                                     const int* tris,
+                                     const int ntris,
+                                     const std::vector<int>& tileIds,
+                                     std::vector<impl::TileData>& tiles) {
+  const float tileWorldSize = tiling.tileWorldSize();
+  const float borderWorldSize = tiling.borderWorldSize();
+
+  // Position of every tile of the grid in tileIds, -1 if it is not built
+  std::vector<int> tileSlot(tiling.numTilesX * tiling.numTilesZ, -1);
+  for (size_t i = 0; i < tileIds.size(); ++i) {
+    tileSlot[tileIds[i]] = i;
+  }
+
+  // Bucket the triangles by the padded tiles their xz bounds overlap,
+  // tileTris[tileTriOffsets[i]..tileTriOffsets[i + 1]) are the triangles of
+  // tileIds[i]
+  std::vector<int> tileTriOffsets(tileIds.size() + 1, 0);
+  std::vector<int> tileTris;
+  auto forEachTriangleTile = [&](const int iTri, auto&& fn) {
+    float minX = std::numeric_limits<float>::max();
+    float minZ = minX;
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxZ = maxX;
+    for (int k = 0; k < 3; ++k) {
+      const float* v = &verts[tris[iTri * 3 + k] * 3];
+      minX = std::min(minX, v[0]);
+      maxX = std::max(maxX, v[0]);
+      minZ = std::min(minZ, v[2]);
+      maxZ = std::max(maxZ, v[2]);
+    }
+    tiling.forEachTileOverlapping(minX, minZ, maxX, maxZ, [&](const int iTile) {
+      if (tileSlot[iTile] != -1) {
+        fn(tileSlot[iTile]);
+      }
+    });
+  };
+  for (int iTri = 0; iTri < ntris; ++iTri) {
+    forEachTriangleTile(iTri, [&](const int slot) { ++tileTriOffsets[slot]; });
+  }
+  std::partial_sum(tileTriOffsets.begin(), tileTriOffsets.end(),
+                   tileTriOffsets.begin());
+  tileTris.resize(tileTriOffsets.back() * 3);
+  for (int iTri = ntris - 1; iTri >= 0; --iTri) {
+    forEachTriangleTile(iTri, [&](const int slot) {
+      const int iTileTri = --tileTriOffsets[slot];
+      std::copy(&tris[iTri * 3], &tris[iTri * 3 + 3], &tileTris[iTileTri * 3]);
+    });
+  }
+
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  threadPool().parallelFor(tileIds.size(), [&](const size_t slot, size_t) {
+    const int begin = tileTriOffsets[slot];
+    const int end = tileTriOffsets[slot + 1];
+    if (begin == end) {
+      return;
+    }
+    const int tx = tileIds[slot] % tiling.numTilesX;
+    const int tz = tileIds[slot] / tiling.numTilesX;
+
+    rcConfig cfg = tiling.cfg;
+    tiling.tileBounds(tx, tz, cfg.bmin, cfg.bmax);
+
+    Workspace ws;
+    rcContext ctx;
+    impl::TileData& tile = tiles[slot];
+    if (!buildPolyMesh(ctx, cfg, tiling.settings, verts, nverts,
+                       &tileTris[begin * 3], end - begin, ws)) {
+      tile.failed = true;
+      return;
+    }
+    // Nothing walkable in this tile
+    if (ws.pmesh->npolys == 0) {
+      return;
+    }
+    if (ws.pmesh->npolys > (1 << tiling.polyBits)) {
+      LOG(ERROR) << "Navmesh tile " << tx << "," << tz << " has "
+                 << ws.pmesh->npolys << " polygons, use a smaller tile size";
+      tile.failed = true;
+      return;
+    }
+    tile.failed = !createNavMeshData(cfg, tiling.settings, tx, tz, ws,
+                                     &tile.data, &tile.dataSize);
+  });
+
+  for (const impl::TileData& tile : tiles) {
+    if (tile.failed) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PathFinder::Impl::initNavQuery(
+    std::unique_ptr<impl::IslandSystem> islandSystem /*= nullptr*/) {
   // if we are reinitializing the NavQuery, then also reset the MeshData
   meshData_.reset();
+  // worker queries are bound to the old navmesh, recreate them lazily
+  {
+    std::lock_guard<std::mutex> lock{parallelMutex_};
+    workerQueries_.clear();
+  }
+  navMeshGraph_.reset();
+  tiling_.reset();
+  navMeshVersion_ = ++lastNavMeshVersion;
 
   navQuery_.reset(dtAllocNavMeshQuery());
   dtStatus status = navQuery_->init(navMesh_.get(), 2048);
@@ -664,12 +1635,65 @@ bool PathFinder::Impl::initNavQuery() {
     return false;
   }
 
-  islandSystem_ =
-      std::make_unique<impl::IslandSystem>(navMesh_.get(), filter_.get());
+  if (islandSystem) {
+    islandSystem_ = std::move(islandSystem);
+  } else {
+    islandSystem_ =
+        std::make_unique<impl::IslandSystem>(navMesh_.get(), filter_.get());
+  }
 
   return true;
 }
 
+bool PathFinder::Impl::initWorkerQueries() {
+  workerQueries_.clear();
+  for (size_t iWorker = 0; iWorker < threadPool_->numThreads(); ++iWorker) {
+    workerQueries_.emplace_back(dtAllocNavMeshQuery());
+    dtStatus status = workerQueries_.back()->init(navMesh_.get(), 2048);
+    if (dtStatusFailed(status)) {
+      LOG(ERROR) << "Could not init Detour navmesh query for worker "
+                 << iWorker;
+      workerQueries_.clear();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool PathFinder::Impl::prepareWorkerQueries() {
+  if (workerQueries_.size() == threadPool().numThreads()) {
+    return true;
+  }
+  return initWorkerQueries();
+}
+
+void PathFinder::Impl::setNumThreads(size_t numThreads) {
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  if (numThreads == numThreads_) {
+    return;
+  }
+  numThreads_ = numThreads;
+  threadPool_.reset();
+  workerQueries_.clear();
+}
+
+core::ThreadPool& PathFinder::Impl::threadPool() {
+  if (!threadPool_) {
+    threadPool_ = std::make_unique<core::ThreadPool>(numThreads_);
+  }
+  return *threadPool_;
+}
+
+size_t PathFinder::Impl::getNumThreads() const {
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  if (threadPool_) {
+    return threadPool_->numThreads();
+  }
+  return numThreads_ > 0 ? numThreads_
+                         : core::ThreadPool::hardwareConcurrency();
+}
+
 bool PathFinder::Impl::build(const NavMeshSettings& bs,
                              const esp::assets::MeshData& mesh) {
   const int numVerts = mesh.vbo.size();
@@ -695,9 +1719,94 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
   return success;
 }
 
+bool PathFinder::Impl::rebuildTiles(const esp::assets::MeshData& mesh,
+                                    const vec3f& regionMin,
+                                    const vec3f& regionMax) {
+  if (!tiling_) {
+    LOG(ERROR) << "Only navmeshes built with NavMeshSettings::tileSize > 0 "
+                  "can be rebuilt tile by tile";
+    return false;
+  }
+
+  std::vector<int> tileIds;
+  tiling_->forEachTileOverlapping(
+      regionMin[0], regionMin[2], regionMax[0], regionMax[2],
+      [&](const int iTile) { tileIds.push_back(iTile); });
+  if (tileIds.empty()) {
+    return true;
+  }
+
+  // The vertical bounds are kept from the initial build, heights are
+  // quantized relative to them so changing them would let the rebuilt tiles
+  // mismatch their neighbours. Geometry outside of them is clipped.
+  std::vector<int> indices(mesh.ibo.begin(), mesh.ibo.end());
+
+  std::vector<impl::TileData> tiles(tileIds.size());
+  const float* verts = mesh.vbo.empty() ? nullptr : mesh.vbo[0].data();
+  if (!buildTileData(*tiling_, verts, mesh.vbo.size(), indices.data(),
+                     indices.size() / 3, tileIds, tiles)) {
+    return false;
+  }
+
+  // Replace the tiles and remember which tile slots changed. dtNavMesh hands
+  // the slot of a removed tile to the next added one, but it may also pick up
+  // a slot which was free before.
+  std::vector<int> changedTiles;
+  bool success = true;
+  for (size_t i = 0; i < tileIds.size(); ++i) {
+    const int tx = tileIds[i] % tiling_->numTilesX;
+    const int tz = tileIds[i] / tiling_->numTilesX;
+    const dtTileRef oldTileRef = navMesh_->getTileRefAt(tx, tz, 0);
+    if (oldTileRef) {
+      navMesh_->removeTile(oldTileRef, nullptr, nullptr);
+      changedTiles.push_back(navMesh_->decodePolyIdTile(oldTileRef));
+    }
+
+    impl::TileData& tile = tiles[i];
+    if (!tile.data) {
+      continue;
+    }
+    dtTileRef tileRef = 0;
+    dtStatus status = navMesh_->addTile(tile.data, tile.dataSize,
+                                        DT_TILE_FREE_DATA, 0, &tileRef);
+    if (dtStatusFailed(status)) {
+      LOG(ERROR) << "Could not add tile " << tx << "," << tz
+                 << " to Detour navmesh";
+      success = false;
+      continue;
+    }
+    tile.data = nullptr;
+    changedTiles.push_back(navMesh_->decodePolyIdTile(tileRef));
+  }
+  std::sort(changedTiles.begin(), changedTiles.end());
+  changedTiles.erase(std::unique(changedTiles.begin(), changedTiles.end()),
+                     changedTiles.end());
+
+  // The queries stay bound to the same dtNavMesh, so only what was derived
+  // from the replaced tiles needs updating
+  navMeshGraph_.reset();
+  navMeshVersion_ = ++lastNavMeshVersion;
+  // Same order as a full build, see initNavQuery() in buildTiled()
+  islandSystem_->updateTiles(filter_.get(), changedTiles);
+  removeZeroAreaPolys(changedTiles);
+  if (meshData_) {
+    std::vector<bool> tileChanged(navMesh_->getMaxTiles(), false);
+    for (const int iTile : changedTiles) {
+      tileChanged[iTile] = true;
+    }
+    meshData_ = triangulateTiles(tileChanged);
+  }
+
+  return success;
+}
+
 namespace {
 const int NAVMESHSET_MAGIC = 'M' << 24 | 'S' << 16 | 'E' << 8 | 'T';  //'MSET';
 const int NAVMESHSET_VERSION = 1;
+// Version which can be memory mapped and handed to Detour without copying
+const int NAVMESHSET_MAPPED_VERSION = 2;
+// Alignment of the tile data in a mapped navmesh file
+const size_t NAVMESHSET_TILE_ALIGNMENT = 16;
 
 struct NavMeshSetHeader {
   int magic;
@@ -706,11 +1815,36 @@ struct NavMeshSetHeader {
   dtNavMeshParams params;
 };
 
+// Follows NavMeshSetHeader in NAVMESHSET_MAPPED_VERSION files. It is followed
+// by numIslands island radii, numPolys polygon island ids (see
+// IslandSystem::polyIslands()) and, starting at tilesOffset, by one
+// NavMeshTileHeader and the tile data per tile, each aligned to
+// NAVMESHSET_TILE_ALIGNMENT.
+struct NavMeshSetMappedHeader {
+  float navMeshArea;
+  int numIslands;
+  int numPolys;
+  int tilesOffset;
+};
+
 struct NavMeshTileHeader {
   dtTileRef tileRef;
   int dataSize;
 };
 
+size_t alignTileOffset(size_t offset) {
+  return (offset + NAVMESHSET_TILE_ALIGNMENT - 1) /
+         NAVMESHSET_TILE_ALIGNMENT * NAVMESHSET_TILE_ALIGNMENT;
+}
+
+// Writes zeros up to the next aligned offset
+void writeTilePadding(FILE* fp, size_t& offset) {
+  static const char zeros[NAVMESHSET_TILE_ALIGNMENT]{};
+  const size_t alignedOffset = alignTileOffset(offset);
+  fwrite(zeros, alignedOffset - offset, 1, fp);
+  offset = alignedOffset;
+}
+
 struct Triangle {
   std::vector<vec3f> v;
   Triangle() { v.resize(3); }
@@ -756,38 +1890,78 @@ float polyArea(const dtPoly* poly, const dtMeshTile* tile) {
 }
 }  // namespace
 
+std::pair<vec3f, vec3f> PathFinder::Impl::getTileRebuildBounds(
+    const vec3f& regionMin,
+    const vec3f& regionMax) const {
+  vec3f bmin = vec3f::Constant(std::numeric_limits<float>::max());
+  vec3f bmax = vec3f::Constant(std::numeric_limits<float>::lowest());
+  if (!tiling_) {
+    return std::make_pair(bmin, bmax);
+  }
+  tiling_->forEachTileOverlapping(
+      regionMin[0], regionMin[2], regionMax[0], regionMax[2],
+      [&](const int iTile) {
+        vec3f tbmin, tbmax;
+        tiling_->tileBounds(iTile % tiling_->numTilesX,
+                            iTile / tiling_->numTilesX, tbmin.data(),
+                            tbmax.data());
+        bmin = bmin.cwiseMin(tbmin);
+        bmax = bmax.cwiseMax(tbmax);
+      });
+  return std::make_pair(bmin, bmax);
+}
+
 // Some polygons have zero area for some reason.  When we navigate into a zero
 // area polygon, things crash.  So we find all zero area polygons and mark
 // them as disabled/not navigable.
 // Also compute the total NavMesh area for later query.
 void PathFinder::Impl::removeZeroAreaPolys() {
-  navMeshArea_ = 0;
-  // Iterate over all tiles
+  tileNavigableAreas_.assign(navMesh_->getMaxTiles(), 0.0f);
   for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
-    const dtMeshTile* tile =
-        const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
-    if (!tile)
-      continue;
-
-    // Iterate over all polygons in a tile
-    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
-      // Get the polygon reference from the tile and polygon id
-      dtPolyRef polyRef = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
-      const dtPoly* poly = nullptr;
-      const dtMeshTile* tmp = nullptr;
-      navMesh_->getTileAndPolyByRefUnsafe(polyRef, &tmp, &poly);
+    tileNavigableAreas_[iTile] = removeZeroAreaPolys(iTile);
+  }
+  navMeshArea_ = std::accumulate(tileNavigableAreas_.begin(),
+                                 tileNavigableAreas_.end(), 0.0f);
+}
 
-      CORRADE_INTERNAL_ASSERT(poly != nullptr);
-      CORRADE_INTERNAL_ASSERT(tmp != nullptr);
+void PathFinder::Impl::removeZeroAreaPolys(const std::vector<int>& tiles) {
+  if (tileNavigableAreas_.size() != size_t(navMesh_->getMaxTiles())) {
+    removeZeroAreaPolys();
+    return;
+  }
+  for (const int iTile : tiles) {
+    tileNavigableAreas_[iTile] = removeZeroAreaPolys(iTile);
+  }
+  navMeshArea_ = std::accumulate(tileNavigableAreas_.begin(),
+                                 tileNavigableAreas_.end(), 0.0f);
+}
 
-      float polygonArea = polyArea(poly, tile);
-      if (polygonArea < 1e-5) {
-        navMesh_->setPolyFlags(polyRef, POLYFLAGS_DISABLED);
-      } else if (poly->flags & POLYFLAGS_WALK) {
-        navMeshArea_ += polygonArea;
-      }
+float PathFinder::Impl::removeZeroAreaPolys(const int iTile) {
+  const dtMeshTile* tile =
+      const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
+  if (!tile || !tile->header)
+    return 0.0f;
+
+  float area = 0.0f;
+  // Iterate over all polygons in a tile
+  for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+    // Get the polygon reference from the tile and polygon id
+    dtPolyRef polyRef = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
+    const dtPoly* poly = nullptr;
+    const dtMeshTile* tmp = nullptr;
+    navMesh_->getTileAndPolyByRefUnsafe(polyRef, &tmp, &poly);
+
+    CORRADE_INTERNAL_ASSERT(poly != nullptr);
+    CORRADE_INTERNAL_ASSERT(tmp != nullptr);
+
+    float polygonArea = polyArea(poly, tile);
+    if (polygonArea < 1e-5) {
+      navMesh_->setPolyFlags(polyRef, POLYFLAGS_DISABLED);
+    } else if (poly->flags & POLYFLAGS_WALK) {
+      area += polygonArea;
     }
   }
+  return area;
 }
 
 bool PathFinder::Impl::loadNavMesh(const std::string& path) {
@@ -806,6 +1980,10 @@ bool PathFinder::Impl::loadNavMesh(const std::string& path) {
     fclose(fp);
     return false;
   }
+  if (header.version == NAVMESHSET_MAPPED_VERSION) {
+    fclose(fp);
+    return loadMappedNavMesh(path);
+  }
   if (header.version != NAVMESHSET_VERSION) {
     fclose(fp);
     return false;
@@ -822,35 +2000,135 @@ bool PathFinder::Impl::loadNavMesh(const std::string& path) {
   if (dtStatusFailed(status)) {
     fclose(fp);
     return false;
-  }
+  }
+
+  // Read tiles.
+  for (int i = 0; i < header.numTiles; ++i) {
+    NavMeshTileHeader tileHeader;
+    readLen = fread(&tileHeader, sizeof(tileHeader), 1, fp);
+    if (readLen != 1) {
+      fclose(fp);
+      return false;
+    }
+
+    if (!tileHeader.tileRef || !tileHeader.dataSize)
+      break;
+
+    unsigned char* data = static_cast<unsigned char*>(
+        dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM));
+    if (!data)
+      break;
+    memset(data, 0, tileHeader.dataSize);
+    readLen = fread(data, tileHeader.dataSize, 1, fp);
+    if (readLen != 1) {
+      dtFree(data);
+      fclose(fp);
+      return false;
+    }
+
+    mesh->addTile(data, tileHeader.dataSize, DT_TILE_FREE_DATA,
+                  tileHeader.tileRef, 0);
+    const dtMeshTile* tile = mesh->getTileByRef(tileHeader.tileRef);
+    if (i == 0) {
+      bmin = vec3f(tile->header->bmin);
+      bmax = vec3f(tile->header->bmax);
+    } else {
+      bmin = bmin.array().min(Eigen::Array3f{tile->header->bmin});
+      bmax = bmax.array().max(Eigen::Array3f{tile->header->bmax});
+    }
+  }
+
+  fclose(fp);
+
+  navMesh_.reset(mesh);
+  mappedNavMesh_.reset();
+  bounds_ = std::make_pair(bmin, bmax);
+
+  removeZeroAreaPolys();
+
+  return initNavQuery();
+}
+
+bool PathFinder::Impl::loadMappedNavMesh(const std::string& path) {
+  auto file = std::make_unique<core::MappedFile>(path);
+  unsigned char* data = file->data();
+  const size_t size = file->size();
+  if (!data ||
+      size < sizeof(NavMeshSetHeader) + sizeof(NavMeshSetMappedHeader))
+    return false;
+
+  NavMeshSetHeader header;
+  NavMeshSetMappedHeader mappedHeader;
+  memcpy(&header, data, sizeof(NavMeshSetHeader));
+  memcpy(&mappedHeader, data + sizeof(NavMeshSetHeader),
+         sizeof(NavMeshSetMappedHeader));
+
+  // Precomputed islands
+  size_t offset = sizeof(NavMeshSetHeader) + sizeof(NavMeshSetMappedHeader);
+  if (mappedHeader.numIslands < 0 || mappedHeader.numPolys < 0 ||
+      offset + mappedHeader.numIslands * sizeof(float) +
+              mappedHeader.numPolys * sizeof(uint32_t) >
+          size) {
+    LOG(ERROR) << "Corrupted navmesh file " << path;
+    return false;
+  }
+  std::vector<float> islandRadius(mappedHeader.numIslands);
+  std::vector<uint32_t> polyIslands(mappedHeader.numPolys);
+  memcpy(islandRadius.data(), data + offset,
+         islandRadius.size() * sizeof(float));
+  offset += islandRadius.size() * sizeof(float);
+  memcpy(polyIslands.data(), data + offset,
+         polyIslands.size() * sizeof(uint32_t));
+  for (const uint32_t islandId : polyIslands) {
+    if (islandId != impl::IslandSystem::NO_ISLAND &&
+        islandId >= islandRadius.size()) {
+      LOG(ERROR) << "Corrupted navmesh file " << path;
+      return false;
+    }
+  }
+
+  // The tiles start after the islands, and each has at least a header
+  const size_t islandsEnd = offset + polyIslands.size() * sizeof(uint32_t);
+  if (header.numTiles < 0 || mappedHeader.tilesOffset < 0 ||
+      size_t(mappedHeader.tilesOffset) < islandsEnd ||
+      size_t(mappedHeader.tilesOffset) > size ||
+      size_t(header.numTiles) >
+          (size - mappedHeader.tilesOffset) / sizeof(NavMeshTileHeader)) {
+    LOG(ERROR) << "Corrupted navmesh file " << path;
+    return false;
+  }
+
+  std::unique_ptr<dtNavMesh, NavMeshDeleter> mesh{dtAllocNavMesh()};
+  if (!mesh || dtStatusFailed(mesh->init(&header.params)))
+    return false;
 
-  // Read tiles.
+  // Hand the tiles to Detour in place, without copying. Detour must not free
+  // them as they are owned by the mapping.
+  vec3f bmin, bmax;
+  int numPolys = 0;
+  offset = mappedHeader.tilesOffset;
   for (int i = 0; i < header.numTiles; ++i) {
+    if (offset + sizeof(NavMeshTileHeader) > size) {
+      LOG(ERROR) << "Corrupted navmesh file " << path;
+      return false;
+    }
     NavMeshTileHeader tileHeader;
-    readLen = fread(&tileHeader, sizeof(tileHeader), 1, fp);
-    if (readLen != 1) {
-      fclose(fp);
+    memcpy(&tileHeader, data + offset, sizeof(NavMeshTileHeader));
+    const size_t dataOffset =
+        alignTileOffset(offset + sizeof(NavMeshTileHeader));
+    if (!tileHeader.tileRef || tileHeader.dataSize <= 0 ||
+        dataOffset > size || size_t(tileHeader.dataSize) > size - dataOffset) {
+      LOG(ERROR) << "Corrupted navmesh file " << path;
       return false;
     }
 
-    if (!tileHeader.tileRef || !tileHeader.dataSize)
-      break;
-
-    unsigned char* data = static_cast<unsigned char*>(
-        dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM));
-    if (!data)
-      break;
-    memset(data, 0, tileHeader.dataSize);
-    readLen = fread(data, tileHeader.dataSize, 1, fp);
-    if (readLen != 1) {
-      dtFree(data);
-      fclose(fp);
+    dtStatus status = mesh->addTile(data + dataOffset, tileHeader.dataSize, 0,
+                                    tileHeader.tileRef, 0);
+    if (dtStatusFailed(status))
       return false;
-    }
 
-    mesh->addTile(data, tileHeader.dataSize, DT_TILE_FREE_DATA,
-                  tileHeader.tileRef, 0);
     const dtMeshTile* tile = mesh->getTileByRef(tileHeader.tileRef);
+    numPolys += tile->header->polyCount;
     if (i == 0) {
       bmin = vec3f(tile->header->bmin);
       bmax = vec3f(tile->header->bmax);
@@ -858,16 +2136,28 @@ bool PathFinder::Impl::loadNavMesh(const std::string& path) {
       bmin = bmin.array().min(Eigen::Array3f{tile->header->bmin});
       bmax = bmax.array().max(Eigen::Array3f{tile->header->bmax});
     }
+
+    offset = alignTileOffset(dataOffset + tileHeader.dataSize);
   }
 
-  fclose(fp);
+  if (numPolys != mappedHeader.numPolys) {
+    LOG(ERROR) << "Corrupted navmesh file " << path;
+    return false;
+  }
 
-  navMesh_.reset(mesh);
-  bounds_ = std::make_pair(bmin, bmax);
+  // Zero area polygons were already disabled in the saved tiles, and their
+  // area is stored alongside
+  auto islandSystem = std::make_unique<impl::IslandSystem>(
+      mesh.get(), polyIslands, std::move(islandRadius));
 
-  removeZeroAreaPolys();
+  // The old navmesh has to go before the memory backing it
+  navMesh_ = std::move(mesh);
+  mappedNavMesh_ = std::move(file);
+  navMeshArea_ = mappedHeader.navMeshArea;
+  tileNavigableAreas_.clear();
+  bounds_ = std::make_pair(bmin, bmax);
 
-  return initNavQuery();
+  return initNavQuery(std::move(islandSystem));
 }
 
 bool PathFinder::Impl::saveNavMesh(const std::string& path) {
@@ -875,66 +2165,209 @@ bool PathFinder::Impl::saveNavMesh(const std::string& path) {
   if (!navMesh)
     return false;
 
-  FILE* fp = fopen(path.c_str(), "wb");
+  // Write to a temporary file first and then move it in place, the file at
+  // path may be the one currently mapped by this or another process and
+  // truncating it would invalidate the mapping
+  const std::string tmpPath = io::uniqueTemporaryFilename(path);
+  FILE* fp = fopen(tmpPath.c_str(), "wb");
   if (!fp)
     return false;
 
   // Store header.
   NavMeshSetHeader header;
   header.magic = NAVMESHSET_MAGIC;
-  header.version = NAVMESHSET_VERSION;
+  header.version = NAVMESHSET_MAPPED_VERSION;
   header.numTiles = 0;
-  for (int i = 0; i < navMesh->getMaxTiles(); ++i) {
-    const dtMeshTile* tile = navMesh->getTile(i);
-    if (!tile || !tile->header || !tile->dataSize)
-      continue;
-    header.numTiles++;
-  }
+  impl::forEachTile(navMesh,
+                    [&](int, const dtMeshTile*) { header.numTiles++; });
   memcpy(&header.params, navMesh->getParams(), sizeof(dtNavMeshParams));
   fwrite(&header, sizeof(NavMeshSetHeader), 1, fp);
 
-  // Store tiles.
-  for (int i = 0; i < navMesh->getMaxTiles(); ++i) {
-    const dtMeshTile* tile = navMesh->getTile(i);
-    if (!tile || !tile->header || !tile->dataSize)
-      continue;
+  // Store the precomputed islands and area so loading doesn't need to
+  // recompute them
+  const std::vector<uint32_t> polyIslands = islandSystem_->polyIslands();
+  const std::vector<float>& islandRadius = islandSystem_->islandRadii();
+  NavMeshSetMappedHeader mappedHeader;
+  mappedHeader.navMeshArea = navMeshArea_;
+  mappedHeader.numIslands = islandRadius.size();
+  mappedHeader.numPolys = polyIslands.size();
+  size_t offset = sizeof(NavMeshSetHeader) + sizeof(NavMeshSetMappedHeader) +
+                  islandRadius.size() * sizeof(float) +
+                  polyIslands.size() * sizeof(uint32_t);
+  mappedHeader.tilesOffset = alignTileOffset(offset);
+  fwrite(&mappedHeader, sizeof(NavMeshSetMappedHeader), 1, fp);
+  fwrite(islandRadius.data(), sizeof(float), islandRadius.size(), fp);
+  fwrite(polyIslands.data(), sizeof(uint32_t), polyIslands.size(), fp);
+  writeTilePadding(fp, offset);
 
+  // Store tiles.
+  impl::forEachTile(navMesh, [&](int, const dtMeshTile* tile) {
     NavMeshTileHeader tileHeader;
     tileHeader.tileRef = navMesh->getTileRef(tile);
     tileHeader.dataSize = tile->dataSize;
     fwrite(&tileHeader, sizeof(tileHeader), 1, fp);
+    offset += sizeof(tileHeader);
+    writeTilePadding(fp, offset);
 
     fwrite(tile->data, tile->dataSize, 1, fp);
-  }
+    offset += tile->dataSize;
+    writeTilePadding(fp, offset);
+  });
 
+  const bool written = !ferror(fp);
   fclose(fp);
+  if (!written || !io::replaceFile(tmpPath, path)) {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
 
   return true;
 }
 
 void PathFinder::Impl::seed(uint32_t newSeed) {
-  // TODO: this should be using core::Random instead, but passing function
-  // to navQuery_->findRandomPoint needs to be figured out first
-  srand(newSeed);
+  std::lock_guard<std::mutex> lock{samplingMutex_};
+  random_.seed(newSeed);
 }
 
-// Returns a random number [0..1]
-static float frand() {
-  return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+namespace {
+// Detour's findRandomPoint only takes a plain function pointer, so the
+// generator of the PathFinder doing the query is handed to frand() through
+// this instead
+thread_local core::Random* frandRandom = nullptr;
+
+// Returns a random number [0..1)
+float frand() {
+  return frandRandom->uniform_float_01();
 }
+}  // namespace
 
 vec3f PathFinder::Impl::getRandomNavigablePoint() {
   dtPolyRef ref;
   constexpr float inf = std::numeric_limits<float>::infinity();
   vec3f pt(inf, inf, inf);
+  std::lock_guard<std::mutex> lock{samplingMutex_};
+  frandRandom = &random_;
   dtStatus status =
       navQuery_->findRandomPoint(filter_.get(), frand, &ref, pt.data());
+  frandRandom = nullptr;
   if (!dtStatusSucceed(status)) {
     LOG(ERROR) << "Failed to getRandomNavigablePoint";
   }
   return pt;
 }
 
+void PathFinder::Impl::initSampling() {
+  if (samplingVersion_ == navMeshVersion_) {
+    return;
+  }
+  samplingVersion_ = navMeshVersion_;
+
+  // Group the walkable polygons by island
+  islandSampleOffset_.assign(islandSystem_->numIslands() + 1, 0);
+  for (uint32_t island = 0; island < islandSystem_->numIslands(); ++island) {
+    islandSampleOffset_[island + 1] =
+        islandSampleOffset_[island] + islandSystem_->islandNumPolys(island);
+  }
+  samplePolys_.resize(islandSampleOffset_.back());
+  std::vector<uint32_t> next(islandSampleOffset_.begin(),
+                             islandSampleOffset_.end() - 1);
+  impl::forEachTile(navMesh_.get(), [&](const int iTile,
+                                        const dtMeshTile* tile) {
+    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+      const dtPolyRef ref = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
+      const uint32_t island = islandSystem_->islandId(ref);
+      if (island != impl::IslandSystem::NO_ISLAND)
+        samplePolys_[next[island]++] = ref;
+    }
+  });
+
+  samplePolyAreaCdf_.resize(samplePolys_.size());
+  double area = 0;
+  for (size_t i = 0; i < samplePolys_.size(); ++i) {
+    const dtMeshTile* tile = nullptr;
+    const dtPoly* poly = nullptr;
+    navMesh_->getTileAndPolyByRefUnsafe(samplePolys_[i], &tile, &poly);
+    area += polyArea(poly, tile);
+    samplePolyAreaCdf_[i] = area;
+  }
+}
+
+Eigen::RowMatrixX3f PathFinder::Impl::getRandomNavigablePoints(
+    const int numPoints,
+    const int islandIndex) {
+  Eigen::RowMatrixX3f points(0, 3);
+  if (!isLoaded() || numPoints <= 0) {
+    return points;
+  }
+  // Held until all points are drawn, as other threads could otherwise
+  // rebuild the sampling state or draw from random_ in between
+  std::lock_guard<std::mutex> lock{samplingMutex_};
+  initSampling();
+
+  size_t begin = 0;
+  size_t end = samplePolys_.size();
+  if (islandIndex != ID_UNDEFINED) {
+    if (islandIndex < 0 ||
+        static_cast<uint32_t>(islandIndex) >= islandSystem_->numIslands()) {
+      LOG(ERROR) << "Invalid island index " << islandIndex;
+      return points;
+    }
+    begin = islandSampleOffset_[islandIndex];
+    end = islandSampleOffset_[islandIndex + 1];
+  }
+  if (begin == end) {
+    LOG(ERROR) << "No navigable polygons to sample from";
+    return points;
+  }
+  const float areaBegin = begin == 0 ? 0.0f : samplePolyAreaCdf_[begin - 1];
+  const float areaEnd = samplePolyAreaCdf_[end - 1];
+
+  // Draw all random numbers up front, so the points only depend on the seed
+  // and not on how they are distributed across threads
+  Eigen::RowMatrixX3f uniforms(numPoints, 3);
+  for (int i = 0; i < numPoints; ++i) {
+    for (int k = 0; k < 3; ++k) {
+      uniforms(i, k) = random_.uniform_float_01();
+    }
+  }
+
+  points.resize(numPoints, 3);
+  const bool success = forEachPointParallel(
+      numPoints, [&](const size_t i, dtNavMeshQuery* navQuery) {
+        // Pick a polygon with probability proportional to its area...
+        const float area = areaBegin + uniforms(i, 0) * (areaEnd - areaBegin);
+        const auto cdfBegin = samplePolyAreaCdf_.begin();
+        const size_t iPoly = std::min<size_t>(
+            std::upper_bound(cdfBegin + begin, cdfBegin + end, area) -
+                cdfBegin,
+            end - 1);
+        const dtPolyRef ref = samplePolys_[iPoly];
+        const dtMeshTile* tile = nullptr;
+        const dtPoly* poly = nullptr;
+        navMesh_->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
+
+        // ... and a point uniformly inside of it, same as
+        // dtNavMeshQuery::findRandomPoint
+        float verts[3 * DT_VERTS_PER_POLYGON];
+        float triAreas[DT_VERTS_PER_POLYGON];
+        for (int iVert = 0; iVert < poly->vertCount; ++iVert) {
+          dtVcopy(&verts[iVert * 3], &tile->verts[poly->verts[iVert] * 3]);
+        }
+        vec3f pt;
+        dtRandomPointInConvexPoly(verts, poly->vertCount, triAreas,
+                                  uniforms(i, 1), uniforms(i, 2), pt.data());
+        float height = pt[1];
+        if (dtStatusSucceed(navQuery->getPolyHeight(ref, pt.data(), &height))) {
+          pt[1] = height;
+        }
+        points.row(i) = pt.transpose();
+      });
+  if (!success) {
+    points.setConstant(std::numeric_limits<float>::infinity());
+  }
+  return points;
+}
+
 namespace {
 float pathLength(const std::vector<vec3f>& points) {
   CORRADE_INTERNAL_ASSERT(points.size() > 0);
@@ -950,12 +2383,13 @@ float pathLength(const std::vector<vec3f>& points) {
 }
 }  // namespace
 
-bool PathFinder::Impl::findPath(ShortestPath& path) {
+bool PathFinder::Impl::findPath(ShortestPath& path,
+                                dtNavMeshQuery* navQuery) {
   MultiGoalShortestPath tmp;
   tmp.requestedStart = path.requestedStart;
   tmp.setRequestedEnds({path.requestedEnd});
 
-  bool status = findPath(tmp);
+  bool status = findPath(tmp, navQuery);
 
   path.geodesicDistance = tmp.geodesicDistance;
   path.points = std::move(tmp.points);
@@ -968,7 +2402,8 @@ PathFinder::Impl::findPathInternal(const vec3f& start,
                                    const vec3f& pathStart,
                                    const vec3f& end,
                                    dtPolyRef endRef,
-                                   const vec3f& pathEnd) {
+                                   const vec3f& pathEnd,
+                                   dtNavMeshQuery* navQuery) {
   // check if trivial path (start is same as end) and early return
   if (pathStart.isApprox(pathEnd)) {
     return std::make_tuple(0.0f, std::vector<vec3f>{pathStart, pathEnd});
@@ -984,7 +2419,7 @@ PathFinder::Impl::findPathInternal(const vec3f& start,
 
   int numPolys = 0;
   dtStatus status =
-      navQuery_->findPath(startRef, endRef, pathStart.data(), pathEnd.data(),
+      navQuery->findPath(startRef, endRef, pathStart.data(), pathEnd.data(),
                           filter_.get(), polys, &numPolys, MAX_POLYS);
   if (status != DT_SUCCESS || numPolys == 0) {
     return Cr::Containers::NullOpt;
@@ -992,9 +2427,9 @@ PathFinder::Impl::findPathInternal(const vec3f& start,
 
   int numPoints = 0;
   std::vector<vec3f> points(MAX_POLYS);
-  status = navQuery_->findStraightPath(start.data(), end.data(), polys,
-                                       numPolys, points[0].data(), 0, 0,
-                                       &numPoints, MAX_POLYS);
+  status = navQuery->findStraightPath(start.data(), end.data(), polys,
+                                      numPolys, points[0].data(), 0, 0,
+                                      &numPoints, MAX_POLYS);
   if (status != DT_SUCCESS || numPoints == 0) {
     return Corrade::Containers::NullOpt;
   }
@@ -1008,29 +2443,39 @@ PathFinder::Impl::findPathInternal(const vec3f& start,
 
 bool PathFinder::Impl::findPathSetup(MultiGoalShortestPath& path,
                                      dtPolyRef& startRef,
-                                     vec3f& pathStart) {
+                                     vec3f& pathStart,
+                                     const dtNavMeshQuery* navQuery) {
   path.geodesicDistance = std::numeric_limits<float>::infinity();
   path.points.clear();
 
   // find nearest polys and path
   dtStatus status;
   std::tie(status, startRef, pathStart) =
-      projectToPoly(path.requestedStart, navQuery_.get(), filter_.get());
+      projectToPoly(path.requestedStart, navQuery, filter_.get());
 
   if (status != DT_SUCCESS || startRef == 0) {
     return false;
   }
 
+  return setupPathEnds(path, navQuery);
+}
+
+bool PathFinder::Impl::setupPathEnds(MultiGoalShortestPath& path,
+                                     const dtNavMeshQuery* navQuery) {
   if (path.pimpl_->endRefs.size() != 0)
     return true;
 
   for (const auto& rqEnd : path.getRequestedEnds()) {
+    dtStatus status;
     dtPolyRef endRef;
     vec3f pathEnd;
     std::tie(status, endRef, pathEnd) =
-        projectToPoly(rqEnd, navQuery_.get(), filter_.get());
+        projectToPoly(rqEnd, navQuery, filter_.get());
 
     if (status != DT_SUCCESS || endRef == 0) {
+      // Don't leave a partial set of ends behind for the next query
+      path.pimpl_->endRefs.clear();
+      path.pimpl_->pathEnds.clear();
       return false;
     }
 
@@ -1041,10 +2486,11 @@ bool PathFinder::Impl::findPathSetup(MultiGoalShortestPath& path,
   return true;
 }
 
-bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
+bool PathFinder::Impl::findPath(MultiGoalShortestPath& path,
+                                dtNavMeshQuery* navQuery) {
   dtPolyRef startRef;
   vec3f pathStart;
-  if (!findPathSetup(path, startRef, pathStart))
+  if (!findPathSetup(path, startRef, pathStart, navQuery))
     return false;
 
   if (path.pimpl_->requestedEnds.size() > 1) {
@@ -1055,7 +2501,7 @@ bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
     ShortestPath prevPath;
     prevPath.requestedStart = path.requestedStart;
     prevPath.requestedEnd = path.pimpl_->prevRequestedStart;
-    findPath(prevPath);
+    findPath(prevPath, navQuery);
     const float movedAmount = prevPath.geodesicDistance;
 
     for (int i = 0; i < path.pimpl_->requestedEnds.size(); ++i) {
@@ -1084,7 +2530,8 @@ bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
         findResult =
             findPathInternal(path.requestedStart, startRef, pathStart,
                              path.pimpl_->requestedEnds[i],
-                             path.pimpl_->endRefs[i], path.pimpl_->pathEnds[i]);
+                             path.pimpl_->endRefs[i], path.pimpl_->pathEnds[i],
+                             navQuery);
 
     if (findResult && std::get<0>(*findResult) < path.geodesicDistance) {
       path.pimpl_->minTheoreticalDist[i] = std::get<0>(*findResult);
@@ -1096,8 +2543,213 @@ bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
   return path.geodesicDistance < std::numeric_limits<float>::infinity();
 }
 
+void PathFinder::Impl::computeDistanceField(MultiGoalShortestPath& path) {
+  if (!navMeshGraph_) {
+    navMeshGraph_ = std::make_unique<impl::NavMeshGraph>(
+        navMesh_.get(), navQuery_.get(), filter_.get());
+  }
+
+  // Seed the field with every vertex that can see one of the ends
+  std::vector<std::tuple<uint32_t, float, uint32_t>> seeds;
+  for (uint32_t iEnd = 0; iEnd < path.pimpl_->endRefs.size(); ++iEnd) {
+    const dtPolyRef endRef = path.pimpl_->endRefs[iEnd];
+    const vec3f& pathEnd = path.pimpl_->pathEnds[iEnd];
+    navMeshGraph_->forEachPolyNode(endRef, [&](const uint32_t node) {
+      seeds.emplace_back(
+          node, (navMeshGraph_->nodePosition(node) - pathEnd).norm(), iEnd);
+    });
+    navMeshGraph_->forEachNeighbour(endRef, [&](const dtPolyRef neighbourRef) {
+      navMeshGraph_->forEachPolyNode(neighbourRef, [&](const uint32_t node) {
+        if (navMeshGraph_->isVisible(navQuery_.get(), endRef, pathEnd, node,
+                                     neighbourRef)) {
+          seeds.emplace_back(
+              node, (navMeshGraph_->nodePosition(node) - pathEnd).norm(),
+              iEnd);
+        }
+      });
+    });
+  }
+
+  navMeshGraph_->computeDistanceField(seeds, path.pimpl_->fieldDistances,
+                                      path.pimpl_->fieldGoals);
+  path.pimpl_->fieldNavMeshVersion = navMeshVersion_;
+}
+
+float PathFinder::Impl::distanceFromField(const MultiGoalShortestPath& path,
+                                          const dtPolyRef startRef,
+                                          const vec3f& pathStart,
+                                          const dtNavMeshQuery* navQuery,
+                                          uint32_t& bestEnd) const {
+  const std::vector<float>& fieldDistances = path.pimpl_->fieldDistances;
+  const std::vector<uint32_t>& fieldGoals = path.pimpl_->fieldGoals;
+
+  float bestDist = std::numeric_limits<float>::infinity();
+  bestEnd = impl::NavMeshGraph::NO_SOURCE;
+  const auto consider = [&](const float dist, const uint32_t iEnd) {
+    bestDist = dist;
+    bestEnd = iEnd;
+  };
+
+  // Ends inside the start polygon are directly visible
+  const auto& endRefs = path.pimpl_->endRefs;
+  const auto& pathEnds = path.pimpl_->pathEnds;
+  for (uint32_t iEnd = 0; iEnd < endRefs.size(); ++iEnd) {
+    const float dist = (pathEnds[iEnd] - pathStart).norm();
+    if (endRefs[iEnd] == startRef && dist < bestDist)
+      consider(dist, iEnd);
+  }
+
+  // Going through any vertex of the start polygon
+  navMeshGraph_->forEachPolyNode(startRef, [&](const uint32_t node) {
+    const float dist =
+        (navMeshGraph_->nodePosition(node) - pathStart).norm() +
+        fieldDistances[node];
+    if (dist < bestDist)
+      consider(dist, fieldGoals[node]);
+  });
+
+  // Refine by looking through the portals into the neighbouring polygons.
+  // Only candidates which would improve the estimate need a raycast
+  navMeshGraph_->forEachNeighbour(startRef, [&](const dtPolyRef neighbourRef) {
+    for (uint32_t iEnd = 0; iEnd < endRefs.size(); ++iEnd) {
+      const float dist = (pathEnds[iEnd] - pathStart).norm();
+      if (endRefs[iEnd] == neighbourRef && dist < bestDist &&
+          navMeshGraph_->isVisible(navQuery, startRef, pathStart,
+                                   pathEnds[iEnd]))
+        consider(dist, iEnd);
+    }
+
+    navMeshGraph_->forEachPolyNode(neighbourRef, [&](const uint32_t node) {
+      const float dist =
+          (navMeshGraph_->nodePosition(node) - pathStart).norm() +
+          fieldDistances[node];
+      if (dist < bestDist && navMeshGraph_->isVisible(navQuery, startRef,
+                                                      pathStart, node,
+                                                      neighbourRef))
+        consider(dist, fieldGoals[node]);
+    });
+  });
+
+  return bestDist;
+}
+
+bool PathFinder::Impl::findPathFromDistanceField(MultiGoalShortestPath& path,
+                                                 bool computePoints) {
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  dtPolyRef startRef;
+  vec3f pathStart;
+  if (!findPathSetup(path, startRef, pathStart, navQuery_.get()))
+    return false;
+
+  if (path.pimpl_->fieldNavMeshVersion != navMeshVersion_)
+    computeDistanceField(path);
+
+  uint32_t bestEnd;
+  const float bestDist =
+      distanceFromField(path, startRef, pathStart, navQuery_.get(), bestEnd);
+  if (bestEnd == impl::NavMeshGraph::NO_SOURCE)
+    return false;
+
+  path.geodesicDistance = bestDist;
+  if (computePoints) {
+    // A single search towards the end selected by the field
+    const auto& endRefs = path.pimpl_->endRefs;
+    const auto& pathEnds = path.pimpl_->pathEnds;
+    const Cr::Containers::Optional<std::tuple<float, std::vector<vec3f>>>
+        findResult = findPathInternal(
+            path.requestedStart, startRef, pathStart,
+            path.pimpl_->requestedEnds[bestEnd], endRefs[bestEnd],
+            pathEnds[bestEnd], navQuery_.get());
+    if (findResult) {
+      path.geodesicDistance = std::get<0>(*findResult);
+      path.points = std::move(std::get<1>(*findResult));
+    }
+  }
+
+  return true;
+}
+
+Eigen::VectorXf PathFinder::Impl::geodesicDistancesFromDistanceFields(
+    const std::vector<MultiGoalShortestPath::ptr>& fields,
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+    const std::vector<int>& fieldIds) {
+  Eigen::VectorXf distances = Eigen::VectorXf::Constant(
+      starts.rows(), std::numeric_limits<float>::infinity());
+  if (fieldIds.size() != size_t(starts.rows())) {
+    LOG(ERROR) << "PathFinder::geodesicDistancesFromDistanceFields : "
+                  "Expected one field id per start";
+    return distances;
+  }
+  if (!isLoaded()) {
+    return distances;
+  }
+
+  // The fields are shared between workers, so make sure all of them are set
+  // up before fanning out. The lock is held from the setup on, as it builds
+  // navMeshGraph_ and writes to the fields.
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  std::vector<uint8_t> fieldValid(fields.size(), 0);
+  for (size_t iField = 0; iField < fields.size(); ++iField) {
+    MultiGoalShortestPath& field = *fields[iField];
+    if (!setupPathEnds(field, navQuery_.get()))
+      continue;
+    if (field.pimpl_->fieldNavMeshVersion != navMeshVersion_)
+      computeDistanceField(field);
+    fieldValid[iField] = 1;
+  }
+
+  forEachPointParallelLocked(
+      starts.rows(), [&](const size_t i, dtNavMeshQuery* navQuery) {
+        const int iField = fieldIds[i];
+        if (iField < 0 || size_t(iField) >= fields.size() ||
+            !fieldValid[iField])
+          return;
+
+        dtStatus status;
+        dtPolyRef startRef;
+        vec3f pathStart;
+        std::tie(status, startRef, pathStart) = projectToPoly(
+            vec3f(starts.row(i).transpose()), navQuery, filter_.get());
+        if (status != DT_SUCCESS || startRef == 0)
+          return;
+
+        uint32_t bestEnd;
+        distances[i] = distanceFromField(*fields[iField], startRef, pathStart,
+                                         navQuery, bestEnd);
+      });
+  return distances;
+}
+
+template <typename PathT>
+std::vector<bool> PathFinder::Impl::findPaths(
+    const std::vector<PathT*>& paths) {
+  std::vector<bool> found(paths.size(), false);
+  if (paths.empty() || !isLoaded()) {
+    return found;
+  }
+
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  if (!prepareWorkerQueries()) {
+    return found;
+  }
+
+  // std::vector<bool> is bit-packed, so each worker writes to its own byte
+  // instead
+  std::vector<uint8_t> status(paths.size(), 0);
+  threadPool_->parallelFor(
+      paths.size(), [&](const size_t iPath, const size_t workerId) {
+        status[iPath] = findPath(*paths[iPath], workerQueries_[workerId].get());
+      });
+
+  std::copy(status.begin(), status.end(), found.begin());
+  return found;
+}
+
 template <typename T>
-T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
+T PathFinder::Impl::tryStep(const T& start,
+                            const T& end,
+                            bool allowSliding,
+                            dtNavMeshQuery* navQuery) {
   static const int MAX_POLYS = 256;
   dtPolyRef polys[MAX_POLYS];
 
@@ -1105,9 +2757,9 @@ T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
   dtPolyRef startRef, endRef;
   vec3f pathStart;
   std::tie(startStatus, startRef, pathStart) =
-      projectToPoly(start, navQuery_.get(), filter_.get());
+      projectToPoly(start, navQuery, filter_.get());
   std::tie(endStatus, endRef, std::ignore) =
-      projectToPoly(end, navQuery_.get(), filter_.get());
+      projectToPoly(end, navQuery, filter_.get());
 
   if (dtStatusFailed(startStatus) || dtStatusFailed(endStatus)) {
     return start;
@@ -1119,9 +2771,9 @@ T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
 
   vec3f endPoint;
   int numPolys;
-  navQuery_->moveAlongSurface(startRef, pathStart.data(), end.data(),
-                              filter_.get(), endPoint.data(), polys, &numPolys,
-                              MAX_POLYS, allowSliding);
+  navQuery->moveAlongSurface(startRef, pathStart.data(), end.data(),
+                             filter_.get(), endPoint.data(), polys, &numPolys,
+                             MAX_POLYS, allowSliding);
   // If there isn't any possible path between start and end, just return
   // start, that is cleanest
   if (numPolys == 0) {
@@ -1136,7 +2788,7 @@ T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
   // surface at the endPoint and set its height to that.
   // Note, this will never fail as endPoint is always within in the poly
   // polys[numPolys - 1]
-  navQuery_->getPolyHeight(polys[numPolys - 1], endPoint.data(), &endPoint[1]);
+  navQuery->getPolyHeight(polys[numPolys - 1], endPoint.data(), &endPoint[1]);
 
   // Hack to deal with infinitely thin walls in recast allowing you to
   // transition between two different connected components
@@ -1144,7 +2796,7 @@ T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
   // is in the same connected component as the startRef according to
   // findNearestPoly
   std::tie(std::ignore, endRef, std::ignore) =
-      projectToPoly(endPoint, navQuery_.get(), filter_.get());
+      projectToPoly(endPoint, navQuery, filter_.get());
   if (!this->islandSystem_->hasConnection(startRef, endRef)) {
     // There isn't a connection!  This happens when endPoint is on an edge
     // shared between two different connected components (aka infinitely thin
@@ -1172,11 +2824,11 @@ T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
 }
 
 template <typename T>
-T PathFinder::Impl::snapPoint(const T& pt) {
+T PathFinder::Impl::snapPoint(const T& pt, const dtNavMeshQuery* navQuery) {
   dtStatus status;
   vec3f projectedPt;
   std::tie(status, std::ignore, projectedPt) =
-      projectToPoly(pt, navQuery_.get(), filter_.get());
+      projectToPoly(pt, navQuery, filter_.get());
 
   if (dtStatusSucceed(status)) {
     return T{projectedPt};
@@ -1185,6 +2837,97 @@ T PathFinder::Impl::snapPoint(const T& pt) {
   }
 }
 
+namespace {
+// Number of points a worker claims at once in the batched point queries, so
+// the scheduling overhead is amortized over many cheap queries
+constexpr size_t POINT_QUERY_CHUNK_SIZE = 256;
+}  // namespace
+
+template <typename Fn>
+bool PathFinder::Impl::forEachPointParallel(const size_t numPoints, Fn&& fn) {
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  return forEachPointParallelLocked(numPoints, std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+bool PathFinder::Impl::forEachPointParallelLocked(const size_t numPoints,
+                                                  Fn&& fn) {
+  if (numPoints == 0) {
+    return true;
+  }
+  if (!isLoaded() || !prepareWorkerQueries()) {
+    return false;
+  }
+
+  const size_t numChunks =
+      (numPoints + POINT_QUERY_CHUNK_SIZE - 1) / POINT_QUERY_CHUNK_SIZE;
+  threadPool().parallelFor(
+      numChunks, [&](const size_t iChunk, const size_t workerId) {
+        dtNavMeshQuery* navQuery = workerQueries_[workerId].get();
+        const size_t end =
+            std::min(numPoints, (iChunk + 1) * POINT_QUERY_CHUNK_SIZE);
+        for (size_t i = iChunk * POINT_QUERY_CHUNK_SIZE; i < end; ++i) {
+          fn(i, navQuery);
+        }
+      });
+  return true;
+}
+
+Eigen::RowMatrixX3f PathFinder::Impl::snapPoints(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& points) {
+  Eigen::RowMatrixX3f snapped(points.rows(), 3);
+  const bool success = forEachPointParallel(
+      points.rows(), [&](const size_t i, dtNavMeshQuery* navQuery) {
+        const vec3f pt = points.row(i).transpose();
+        snapped.row(i) = snapPoint(pt, navQuery).transpose();
+      });
+  if (!success) {
+    snapped.setConstant(NAN);
+  }
+  return snapped;
+}
+
+Eigen::Matrix<bool, Eigen::Dynamic, 1> PathFinder::Impl::isNavigableBatch(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+    const float maxYDelta) {
+  // Eigen stores one byte per bool, so workers never share a word
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> navigable(points.rows());
+  const bool success = forEachPointParallel(
+      points.rows(), [&](const size_t i, dtNavMeshQuery* navQuery) {
+        const vec3f pt = points.row(i).transpose();
+        navigable[i] = isNavigable(pt, maxYDelta, navQuery);
+      });
+  if (!success) {
+    navigable.setConstant(false);
+  }
+  return navigable;
+}
+
+Eigen::RowMatrixX3f PathFinder::Impl::tryStepBatch(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& ends,
+    const bool allowSliding) {
+  if (starts.rows() != ends.rows()) {
+    throw std::invalid_argument(
+        "tryStepBatch: got " + std::to_string(starts.rows()) +
+        " starts but " + std::to_string(ends.rows()) + " ends");
+  }
+
+  Eigen::RowMatrixX3f stepped(starts.rows(), 3);
+  const bool success = forEachPointParallel(
+      starts.rows(), [&](const size_t i, dtNavMeshQuery* navQuery) {
+        const vec3f start = starts.row(i).transpose();
+        const vec3f end = ends.row(i).transpose();
+        stepped.row(i) =
+            tryStep(start, end, allowSliding, navQuery).transpose();
+      });
+  // Same as the single point version, which stays put if it can't move
+  if (!success) {
+    stepped = starts;
+  }
+  return stepped;
+}
+
 float PathFinder::Impl::islandRadius(const vec3f& pt) const {
   dtPolyRef ptRef;
   dtStatus status;
@@ -1197,6 +2940,35 @@ float PathFinder::Impl::islandRadius(const vec3f& pt) const {
   }
 }
 
+int PathFinder::Impl::islandId(const vec3f& pt) const {
+  dtPolyRef ptRef;
+  dtStatus status;
+  std::tie(status, ptRef, std::ignore) =
+      projectToPoly(pt, navQuery_.get(), filter_.get());
+  if (status != DT_SUCCESS || ptRef == 0)
+    return ID_UNDEFINED;
+
+  const uint32_t island = islandSystem_->islandId(ptRef);
+  return island == impl::IslandSystem::NO_ISLAND ? ID_UNDEFINED
+                                                 : static_cast<int>(island);
+}
+
+std::vector<NavMeshIsland> PathFinder::Impl::getIslands() const {
+  std::vector<NavMeshIsland> islands;
+  if (!islandSystem_)
+    return islands;
+
+  islands.reserve(islandSystem_->numIslands());
+  for (uint32_t iIsland = 0; iIsland < islandSystem_->numIslands(); ++iIsland) {
+    NavMeshIsland island;
+    island.id = iIsland;
+    island.radius = islandSystem_->islandRadii()[iIsland];
+    island.numPolygons = islandSystem_->islandNumPolys(iIsland);
+    islands.push_back(island);
+  }
+  return islands;
+}
+
 float PathFinder::Impl::distanceToClosestObstacle(
     const vec3f& pt,
     const float maxSearchRadius /*= 2.0*/) const {
@@ -1205,32 +2977,50 @@ float PathFinder::Impl::distanceToClosestObstacle(
 
 HitRecord PathFinder::Impl::closestObstacleSurfacePoint(
     const vec3f& pt,
-    const float maxSearchRadius /*= 2.0*/) const {
+    const float maxSearchRadius,
+    const dtNavMeshQuery* navQuery) const {
   dtPolyRef ptRef;
   dtStatus status;
   vec3f polyPt;
   std::tie(status, ptRef, polyPt) =
-      projectToPoly(pt, navQuery_.get(), filter_.get());
+      projectToPoly(pt, navQuery, filter_.get());
   if (status != DT_SUCCESS || ptRef == 0) {
     return {vec3f(0, 0, 0), vec3f(0, 0, 0),
             std::numeric_limits<float>::infinity()};
   } else {
     vec3f hitPos, hitNormal;
     float hitDist;
-    navQuery_->findDistanceToWall(ptRef, polyPt.data(), maxSearchRadius,
-                                  filter_.get(), &hitDist, hitPos.data(),
-                                  hitNormal.data());
+    navQuery->findDistanceToWall(ptRef, polyPt.data(), maxSearchRadius,
+                                 filter_.get(), &hitDist, hitPos.data(),
+                                 hitNormal.data());
     return {hitPos, hitNormal, hitDist};
   }
 }
 
+Eigen::VectorXf PathFinder::Impl::distancesToClosestObstacle(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+    const float maxSearchRadius) {
+  Eigen::VectorXf distances(points.rows());
+  const bool success = forEachPointParallel(
+      points.rows(), [&](const size_t i, dtNavMeshQuery* navQuery) {
+        const vec3f pt = points.row(i).transpose();
+        distances[i] =
+            closestObstacleSurfacePoint(pt, maxSearchRadius, navQuery).hitDist;
+      });
+  if (!success) {
+    distances.setConstant(std::numeric_limits<float>::infinity());
+  }
+  return distances;
+}
+
 bool PathFinder::Impl::isNavigable(const vec3f& pt,
-                                   const float maxYDelta /*= 0.5*/) const {
+                                   const float maxYDelta,
+                                   const dtNavMeshQuery* navQuery) const {
   dtPolyRef ptRef;
   dtStatus status;
   vec3f polyPt;
   std::tie(status, ptRef, polyPt) =
-      projectToPoly(pt, navQuery_.get(), filter_.get());
+      projectToPoly(pt, navQuery, filter_.get());
 
   if (status != DT_SUCCESS || ptRef == 0)
     return false;
@@ -1244,10 +3034,31 @@ bool PathFinder::Impl::isNavigable(const vec3f& pt,
 }
 
 typedef Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> MatrixXb;
+typedef Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    RowMatrixXb;
+
+namespace {
+// Number of rows of the top-down view a worker rasterizes at once
+constexpr int TOP_DOWN_VIEW_BAND_ROWS = 32;
+}  // namespace
 
 Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>
 PathFinder::Impl::getTopDownView(const float metersPerPixel,
                                  const float height) {
+  const std::pair<float, float> key{metersPerPixel, height};
+  if (topDownViewCacheVersion_ != navMeshVersion_ ||
+      topDownViewCacheKey_ != key) {
+    // Free the old view before rasterizing the new one
+    topDownViewCache_.resize(0, 0);
+    topDownViewCache_ = rasterizeTopDownView(metersPerPixel, height);
+    topDownViewCacheKey_ = key;
+    topDownViewCacheVersion_ = navMeshVersion_;
+  }
+  return topDownViewCache_;
+}
+
+MatrixXb PathFinder::Impl::rasterizeTopDownView(const float metersPerPixel,
+                                                const float height) {
   std::pair<vec3f, vec3f> mapBounds = bounds();
   vec3f bound1 = mapBounds.first;
   vec3f bound2 = mapBounds.second;
@@ -1258,58 +3069,172 @@ PathFinder::Impl::getTopDownView(const float metersPerPixel,
   int zResolution = zspan / metersPerPixel;
   float startx = fmin(bound1[0], bound2[0]);
   float startz = fmin(bound1[2], bound2[2]);
-  MatrixXb topdownMap(zResolution, xResolution);
-
-  float curz = startz;
-  float curx = startx;
-  for (int h = 0; h < zResolution; h++) {
-    for (int w = 0; w < xResolution; w++) {
-      vec3f point = vec3f(curx, height, curz);
-      topdownMap(h, w) = isNavigable(point, 0.5);
-      curx = curx + metersPerPixel;
+  if (!isLoaded() || xResolution == 0 || zResolution == 0) {
+    return MatrixXb::Zero(zResolution, xResolution);
+  }
+  // Row-major, so the rows of a band are contiguous and no two workers write
+  // to the same cache line except at the band edges
+  RowMatrixXb topdownMap = RowMatrixXb::Zero(zResolution, xResolution);
+
+  // A pixel is navigable if a walkable detail triangle covers it at most
+  // maxYDelta away from height, which is what isNavigable(point, 0.5) checks
+  // by snapping the point, but without a navmesh query per pixel
+  constexpr float maxYDelta = 0.5;
+  std::vector<vec3f> triVerts;
+  impl::forEachTile(navMesh_.get(), [&](const int iTile,
+                                        const dtMeshTile* tile) {
+    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+      const dtPoly* poly = &tile->polys[jPoly];
+      const dtPolyRef polyRef =
+          navMesh_->encodePolyId(tile->salt, iTile, jPoly);
+      if (poly->getType() == DT_POLYTYPE_OFFMESH_CONNECTION ||
+          !filter_->passFilter(polyRef, tile, poly))
+        continue;
+
+      for (const Triangle& tri : getPolygonTriangles(poly, tile)) {
+        const float minY =
+            std::min({tri.v[0][1], tri.v[1][1], tri.v[2][1]});
+        const float maxY =
+            std::max({tri.v[0][1], tri.v[1][1], tri.v[2][1]});
+        if (maxY >= height - maxYDelta && minY <= height + maxYDelta) {
+          triVerts.insert(triVerts.end(), tri.v.begin(), tri.v.end());
+        }
+      }
+    }
+  });
+
+  // Bucket the triangles by the bands of rows they cover, so every worker
+  // writes to its own rows only
+  const int numBands =
+      (zResolution + TOP_DOWN_VIEW_BAND_ROWS - 1) / TOP_DOWN_VIEW_BAND_ROWS;
+  std::vector<std::vector<uint32_t>> bandTris(numBands);
+  auto pixelRange = [&](const float lo, const float hi, const float start,
+                        const int resolution) {
+    const int first =
+        static_cast<int>(std::ceil((lo - start) / metersPerPixel));
+    const int last =
+        static_cast<int>(std::floor((hi - start) / metersPerPixel));
+    return std::make_pair(std::max(first, 0), std::min(last, resolution - 1));
+  };
+  for (uint32_t iTri = 0; iTri < triVerts.size() / 3; ++iTri) {
+    const vec3f* v = &triVerts[iTri * 3];
+    const std::pair<int, int> rows =
+        pixelRange(std::min({v[0][2], v[1][2], v[2][2]}),
+                   std::max({v[0][2], v[1][2], v[2][2]}), startz, zResolution);
+    if (rows.first > rows.second)
+      continue;
+    for (int iBand = rows.first / TOP_DOWN_VIEW_BAND_ROWS;
+         iBand <= rows.second / TOP_DOWN_VIEW_BAND_ROWS; ++iBand) {
+      bandTris[iBand].push_back(iTri);
     }
-    curz = curz + metersPerPixel;
-    curx = startx;
   }
 
-  return topdownMap;
+  std::lock_guard<std::mutex> lock{parallelMutex_};
+  threadPool().parallelFor(numBands, [&](const size_t iBand, size_t) {
+    const int bandBegin = iBand * TOP_DOWN_VIEW_BAND_ROWS;
+    const int bandEnd =
+        std::min(zResolution, bandBegin + TOP_DOWN_VIEW_BAND_ROWS);
+    for (const uint32_t iTri : bandTris[iBand]) {
+      const vec3f& a = triVerts[iTri * 3];
+      const vec3f& b = triVerts[iTri * 3 + 1];
+      const vec3f& c = triVerts[iTri * 3 + 2];
+
+      // Barycentric coordinates in the xz plane, skip triangles which are
+      // degenerate from the top
+      const float denom =
+          (b[2] - c[2]) * (a[0] - c[0]) + (c[0] - b[0]) * (a[2] - c[2]);
+      if (std::abs(denom) < 1e-12f)
+        continue;
+      constexpr float eps = 1e-5;
+
+      const std::pair<int, int> rows =
+          pixelRange(std::min({a[2], b[2], c[2]}),
+                     std::max({a[2], b[2], c[2]}), startz, zResolution);
+      const std::pair<int, int> cols =
+          pixelRange(std::min({a[0], b[0], c[0]}),
+                     std::max({a[0], b[0], c[0]}), startx, xResolution);
+      for (int h = std::max(rows.first, bandBegin);
+           h <= std::min(rows.second, bandEnd - 1); ++h) {
+        const float z = startz + h * metersPerPixel;
+        for (int w = cols.first; w <= cols.second; ++w) {
+          if (topdownMap(h, w))
+            continue;
+          const float x = startx + w * metersPerPixel;
+          const float l0 =
+              ((b[2] - c[2]) * (x - c[0]) + (c[0] - b[0]) * (z - c[2])) /
+              denom;
+          const float l1 =
+              ((c[2] - a[2]) * (x - c[0]) + (a[0] - c[0]) * (z - c[2])) /
+              denom;
+          const float l2 = 1.0f - l0 - l1;
+          if (l0 < -eps || l1 < -eps || l2 < -eps)
+            continue;
+          const float y = l0 * a[1] + l1 * b[1] + l2 * c[1];
+          topdownMap(h, w) = std::abs(y - height) <= maxYDelta;
+        }
+      }
+    }
+  });
+
+  return MatrixXb{topdownMap};
 }
 
-const assets::MeshData::ptr PathFinder::Impl::getNavMeshData() {
-  if (meshData_ == nullptr && isLoaded()) {
-    meshData_ = assets::MeshData::create();
-    std::vector<esp::vec3f>& vbo = meshData_->vbo;
-    std::vector<uint32_t>& ibo = meshData_->ibo;
+assets::MeshData::ptr PathFinder::Impl::triangulateTiles(
+    const std::vector<bool>& tileChanged) {
+  // Meshes which were already handed out are never modified
+  assets::MeshData::ptr meshData = assets::MeshData::create();
+  std::vector<esp::vec3f>& vbo = meshData->vbo;
+  std::vector<uint32_t>& ibo = meshData->ibo;
+  std::vector<uint32_t> tileOffset(navMesh_->getMaxTiles() + 1, 0);
 
-    // Iterate over all tiles
-    for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
-      const dtMeshTile* tile =
-          const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
-      if (!tile)
-        continue;
+  // Iterate over all tiles
+  for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+    tileOffset[iTile] = vbo.size();
+    if (!tileChanged[iTile]) {
+      vbo.insert(vbo.end(),
+                 meshData_->vbo.begin() + meshDataTileOffset_[iTile],
+                 meshData_->vbo.begin() + meshDataTileOffset_[iTile + 1]);
+      continue;
+    }
 
-      // Iterate over all polygons in a tile
-      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
-        // Get the polygon reference from the tile and polygon id
-        dtPolyRef polyRef = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
-        const dtPoly* poly = nullptr;
-        const dtMeshTile* tmp = nullptr;
-        navMesh_->getTileAndPolyByRefUnsafe(polyRef, &tmp, &poly);
+    const dtMeshTile* tile =
+        const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
+    if (!tile || !tile->header)
+      continue;
+
+    // Iterate over all polygons in a tile
+    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+      // Get the polygon reference from the tile and polygon id
+      dtPolyRef polyRef = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
+      const dtPoly* poly = nullptr;
+      const dtMeshTile* tmp = nullptr;
+      navMesh_->getTileAndPolyByRefUnsafe(polyRef, &tmp, &poly);
 
-        CORRADE_INTERNAL_ASSERT(poly != nullptr);
-        CORRADE_INTERNAL_ASSERT(tmp != nullptr);
+      CORRADE_INTERNAL_ASSERT(poly != nullptr);
+      CORRADE_INTERNAL_ASSERT(tmp != nullptr);
 
-        std::vector<Triangle> triangles = getPolygonTriangles(poly, tile);
+      std::vector<Triangle> triangles = getPolygonTriangles(poly, tile);
 
-        for (auto& tri : triangles) {
-          for (int k = 0; k < 3; ++k) {
-            vbo.push_back(tri.v[k]);
-            ibo.push_back(vbo.size() - 1);
-          }
+      for (auto& tri : triangles) {
+        for (int k = 0; k < 3; ++k) {
+          vbo.push_back(tri.v[k]);
         }
       }
     }
   }
+  tileOffset.back() = vbo.size();
+
+  ibo.resize(vbo.size());
+  std::iota(ibo.begin(), ibo.end(), 0);
+  meshDataTileOffset_ = std::move(tileOffset);
+  return meshData;
+}
+
+const assets::MeshData::ptr PathFinder::Impl::getNavMeshData() {
+  if (meshData_ == nullptr && isLoaded()) {
+    meshData_ = triangulateTiles(
+        std::vector<bool>(navMesh_->getMaxTiles(), true));
+  }
   return meshData_;
 }
 
@@ -1329,10 +3254,28 @@ bool PathFinder::build(const NavMeshSettings& bs,
   return pimpl_->build(bs, mesh);
 }
 
+bool PathFinder::rebuildTiles(const esp::assets::MeshData& mesh,
+                              const vec3f& regionMin,
+                              const vec3f& regionMax) {
+  return pimpl_->rebuildTiles(mesh, regionMin, regionMax);
+}
+
+std::pair<vec3f, vec3f> PathFinder::getTileRebuildBounds(
+    const vec3f& regionMin,
+    const vec3f& regionMax) const {
+  return pimpl_->getTileRebuildBounds(regionMin, regionMax);
+}
+
 vec3f PathFinder::getRandomNavigablePoint() {
   return pimpl_->getRandomNavigablePoint();
 }
 
+Eigen::RowMatrixX3f PathFinder::getRandomNavigablePoints(
+    const int numPoints,
+    const int islandIndex) {
+  return pimpl_->getRandomNavigablePoints(numPoints, islandIndex);
+}
+
 bool PathFinder::findPath(ShortestPath& path) {
   return pimpl_->findPath(path);
 }
@@ -1341,6 +3284,68 @@ bool PathFinder::findPath(MultiGoalShortestPath& path) {
   return pimpl_->findPath(path);
 }
 
+namespace {
+template <typename PathT>
+std::vector<PathT*> pathPointers(std::vector<PathT>& paths) {
+  std::vector<PathT*> pointers;
+  pointers.reserve(paths.size());
+  for (auto& path : paths) {
+    pointers.push_back(&path);
+  }
+  return pointers;
+}
+
+template <typename PathT>
+std::vector<PathT*> pathPointers(
+    const std::vector<std::shared_ptr<PathT>>& paths) {
+  std::vector<PathT*> pointers;
+  pointers.reserve(paths.size());
+  for (const auto& path : paths) {
+    pointers.push_back(path.get());
+  }
+  return pointers;
+}
+}  // namespace
+
+std::vector<bool> PathFinder::findPaths(std::vector<ShortestPath>& paths) {
+  return pimpl_->findPaths(pathPointers(paths));
+}
+
+std::vector<bool> PathFinder::findPaths(
+    std::vector<MultiGoalShortestPath>& paths) {
+  return pimpl_->findPaths(pathPointers(paths));
+}
+
+std::vector<bool> PathFinder::findPaths(
+    const std::vector<ShortestPath::ptr>& paths) {
+  return pimpl_->findPaths(pathPointers(paths));
+}
+
+std::vector<bool> PathFinder::findPaths(
+    const std::vector<MultiGoalShortestPath::ptr>& paths) {
+  return pimpl_->findPaths(pathPointers(paths));
+}
+
+bool PathFinder::findPathFromDistanceField(MultiGoalShortestPath& path,
+                                           bool computePoints) {
+  return pimpl_->findPathFromDistanceField(path, computePoints);
+}
+
+Eigen::VectorXf PathFinder::geodesicDistancesFromDistanceFields(
+    const std::vector<MultiGoalShortestPath::ptr>& fields,
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+    const std::vector<int>& fieldIds) {
+  return pimpl_->geodesicDistancesFromDistanceFields(fields, starts, fieldIds);
+}
+
+void PathFinder::setNumThreads(size_t numThreads) {
+  pimpl_->setNumThreads(numThreads);
+}
+
+size_t PathFinder::getNumThreads() const {
+  return pimpl_->getNumThreads();
+}
+
 template vec3f PathFinder::tryStep<vec3f>(const vec3f&, const vec3f&);
 template Mn::Vector3 PathFinder::tryStep<Mn::Vector3>(const Mn::Vector3&,
                                                       const Mn::Vector3&);
@@ -1388,6 +3393,14 @@ float PathFinder::islandRadius(const vec3f& pt) const {
   return pimpl_->islandRadius(pt);
 }
 
+int PathFinder::islandId(const vec3f& pt) const {
+  return pimpl_->islandId(pt);
+}
+
+std::vector<NavMeshIsland> PathFinder::getIslands() const {
+  return pimpl_->getIslands();
+}
+
 float PathFinder::distanceToClosestObstacle(const vec3f& pt,
                                             const float maxSearchRadius) const {
   return pimpl_->distanceToClosestObstacle(pt, maxSearchRadius);
@@ -1399,8 +3412,37 @@ HitRecord PathFinder::closestObstacleSurfacePoint(
   return pimpl_->closestObstacleSurfacePoint(pt, maxSearchRadius);
 }
 
+Eigen::VectorXf PathFinder::distancesToClosestObstacle(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+    const float maxSearchRadius) {
+  return pimpl_->distancesToClosestObstacle(points, maxSearchRadius);
+}
+
+Eigen::RowMatrixX3f PathFinder::snapPoints(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& points) {
+  return pimpl_->snapPoints(points);
+}
+
+Eigen::Matrix<bool, Eigen::Dynamic, 1> PathFinder::isNavigableBatch(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+    const float maxYDelta) {
+  return pimpl_->isNavigableBatch(points, maxYDelta);
+}
+
+Eigen::RowMatrixX3f PathFinder::tryStepBatch(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& ends) {
+  return pimpl_->tryStepBatch(starts, ends, /*allowSliding=*/true);
+}
+
+Eigen::RowMatrixX3f PathFinder::tryStepNoSlidingBatch(
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+    const Eigen::Ref<const Eigen::RowMatrixX3f>& ends) {
+  return pimpl_->tryStepBatch(starts, ends, /*allowSliding=*/false);
+}
+
 bool PathFinder::isNavigable(const vec3f& pt, const float maxYDelta) const {
-  return pimpl_->isNavigable(pt);
+  return pimpl_->isNavigable(pt, maxYDelta);
 }
 
 float PathFinder::getNavigableArea() const {
@@ -100,6 +100,19 @@ struct MultiGoalShortestPath {
   ESP_SMART_POINTERS_WITH_UNIQUE_PIMPL(MultiGoalShortestPath);
 };
 
+/**
+ * @brief A connected component of the navigation mesh. See @ref
+ * PathFinder.getIslands
+ */
+struct NavMeshIsland {
+  //! Index of the island, as returned by @ref PathFinder.islandId
+  int id;
+  //! Max distance of the island's vertices from their centroid
+  float radius;
+  //! Number of navigation mesh polygons belonging to the island
+  int numPolygons;
+};
+
 struct NavMeshSettings {
   //! Cell size in world units
   float cellSize;
@@ -134,6 +147,12 @@ struct NavMeshSettings {
   bool filterLedgeSpans;
   bool filterWalkableLowHeightSpans;
 
+  //! Tile size in cells. 0 builds the navmesh as a single tile, otherwise the
+  //! bounds are split into tiles of tileSize x tileSize cells which are built
+  //! concurrently, see PathFinder::setNumThreads(), and can be rebuilt
+  //! individually with PathFinder::rebuildTiles()
+  int tileSize;
+
   void setDefaults() {
     cellSize = 0.05f;
     cellHeight = 0.2f;
@@ -151,6 +170,7 @@ struct NavMeshSettings {
     filterLowHangingObstacles = true;
     filterLedgeSpans = true;
     filterWalkableLowHeightSpans = true;
+    tileSize = 0;
   }
 
   NavMeshSettings() { setDefaults(); }
@@ -179,6 +199,40 @@ class PathFinder {
              const float* bmax);
   bool build(const NavMeshSettings& bs, const esp::assets::MeshData& mesh);
 
+  /**
+   * @brief Rebuilds only the tiles of the navmesh which are affected by a
+   * change of the scene geometry in a region, e.g. an object being added or
+   * moved.
+   *
+   * Requires the navmesh to have been built by this instance with @ref
+   * NavMeshSettings::tileSize > 0, the settings of that build are reused. Only
+   * the triangles close to the affected tiles are rasterized.
+   *
+   * Geometry is clipped to the vertical bounds of the initial build, which
+   * leave @ref NavMeshSettings::agentHeight of headroom above it.
+   *
+   * @param mesh The updated scene geometry, at least all triangles within
+   * @ref getTileRebuildBounds of the region
+   * @param regionMin The minimum corner of the changed region. For an object
+   * which moved, this should cover both its old and new bounds.
+   * @param regionMax The maximum corner of the changed region
+   * @return Whether the tiles were rebuilt successfully
+   */
+  bool rebuildTiles(const esp::assets::MeshData& mesh,
+                    const vec3f& regionMin,
+                    const vec3f& regionMax);
+
+  /**
+   * @brief The bounds of the geometry @ref rebuildTiles reads when rebuilding
+   * the tiles overlapping a region. Triangles outside of them can be left out
+   * of the mesh passed to it.
+   *
+   * @return The union of the padded bounds of the affected tiles, empty (min
+   * greater than max) if there are none or the navmesh is not tiled
+   */
+  std::pair<vec3f, vec3f> getTileRebuildBounds(const vec3f& regionMin,
+                                               const vec3f& regionMax) const;
+
   /**
    * @brief Returns a random navigable point
    *
@@ -190,6 +244,23 @@ class PathFinder {
    */
   vec3f getRandomNavigablePoint();
 
+  /**
+   * @brief Returns random navigable points, distributed uniformly by area
+   * over the navmesh or one of its islands
+   *
+   * The random numbers are all drawn up front, so the result only depends on
+   * the @ref seed and not on the number of threads the points are computed
+   * on, see @ref setNumThreads.
+   *
+   * @param[in] numPoints The number of points to sample
+   * @param[in] islandIndex The island to sample from, see @ref getIslands,
+   * or @ref ID_UNDEFINED to sample from the whole navmesh
+   *
+   * @return The points, one per row. Empty if there is nothing to sample from.
+   */
+  Eigen::RowMatrixX3f getRandomNavigablePoints(int numPoints,
+                                               int islandIndex = ID_UNDEFINED);
+
   /**
    * @brief Finds the shortest path between two points on the navigation mesh
    *
@@ -217,6 +288,103 @@ class PathFinder {
    */
   bool findPath(MultiGoalShortestPath& path);
 
+  /**
+   * @brief Same as @ref findPath(MultiGoalShortestPath&), but uses a geodesic
+   * distance field to the requested ends instead of searching for a path to
+   * each of them.
+   *
+   * The field is computed with a single multi-source Dijkstra from all
+   * requested ends over the graph of navmesh polygon vertices the first time
+   * this is called and cached in @p path until the requested ends or the
+   * navmesh change. Subsequent queries only look at the vertices of the
+   * polygon containing @ref MultiGoalShortestPath.requestedStart and its
+   * neighbours, so they do not depend on the number of ends nor on the size
+   * of the navmesh.
+   *
+   * @param[inout] path The @ref MultiGoalShortestPath structure contain the
+   * start point and list of possible end points.
+   * @param[in] computePoints Whether or not to also compute @ref
+   * MultiGoalShortestPath.points. This runs a single path search to the end
+   * selected by the distance field.
+   *
+   * @return Whether or not a path exists between @ref
+   * MultiGoalShortestPath.requestedStart and any @ref
+   * MultiGoalShortestPath.requestedEnds
+   *
+   * @note Without @p computePoints, @ref MultiGoalShortestPath.geodesicDistance
+   * is an upper bound on the exact geodesic distance which is tight except for
+   * straight lines crossing many polygons.
+   */
+  bool findPathFromDistanceField(MultiGoalShortestPath& path,
+                                 bool computePoints = false);
+
+  /**
+   * @brief Batched geodesic distance queries against the distance fields of
+   * @ref findPathFromDistanceField.
+   *
+   * The i-th row of @p starts is evaluated against `fields[fieldIds[i]]`, so
+   * many starts heading towards the same ends share a single field. Missing
+   * or stale fields are computed first, then the starts are distributed
+   * across @ref getNumThreads threads.
+   *
+   * @param[inout] fields The paths holding the requested ends and their
+   * fields. Their @ref MultiGoalShortestPath.requestedStart is ignored.
+   * @param[in] starts The start points, one per row
+   * @param[in] fieldIds The index into @p fields of each start
+   *
+   * @return The geodesic distance from each start, inf if there is no path
+   */
+  Eigen::VectorXf geodesicDistancesFromDistanceFields(
+      const std::vector<MultiGoalShortestPath::ptr>& fields,
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+      const std::vector<int>& fieldIds);
+
+  /**
+   * @brief Batched version of @ref findPath(ShortestPath&). The queries are
+   * distributed across a pool of worker threads, each of which owns its own
+   * navigation mesh query object.
+   *
+   * @param[inout] paths The @ref ShortestPath structures to populate
+   *
+   * @return For each path, whether or not a path exists between @ref
+   * ShortestPath.requestedStart and @ref ShortestPath.requestedEnd
+   */
+  std::vector<bool> findPaths(std::vector<ShortestPath>& paths);
+
+  /**
+   * @brief Batched version of @ref findPath(MultiGoalShortestPath&). See @ref
+   * findPaths(std::vector<ShortestPath>&).
+   */
+  std::vector<bool> findPaths(std::vector<MultiGoalShortestPath>& paths);
+
+  /**
+   * @brief Same as @ref findPaths(std::vector<ShortestPath>&) but operates on
+   * shared instances, as handed out by the python bindings.
+   */
+  std::vector<bool> findPaths(const std::vector<ShortestPath::ptr>& paths);
+
+  /**
+   * @brief Same as @ref findPaths(std::vector<MultiGoalShortestPath>&) but
+   * operates on shared instances, as handed out by the python bindings.
+   */
+  std::vector<bool> findPaths(
+      const std::vector<MultiGoalShortestPath::ptr>& paths);
+
+  /**
+   * @brief Sets the number of threads used by the batched queries such as
+   * @ref findPaths or @ref snapPoints and by tiled navmesh builds, see
+   * @ref NavMeshSettings::tileSize
+   *
+   * @param[in] numThreads The number of threads, including the calling
+   * thread. 0 uses the number of hardware threads, which is also the default.
+   */
+  void setNumThreads(size_t numThreads);
+
+  /**
+   * @return The number of threads used by the batched queries.
+   */
+  size_t getNumThreads() const;
+
   /**
    * @brief Attempts to move from @ref start to @ref end and returns the
    * navigable point closest to @ref end that is feasibly reachable from @ref
@@ -247,6 +415,53 @@ class PathFinder {
   template <typename T>
   T snapPoint(const T& pt);
 
+  /**
+   * @brief Batched version of @ref snapPoint. The points are distributed
+   * across @ref getNumThreads threads.
+   *
+   * @param[in] points The points to snap, one per row
+   *
+   * @return The snapped points, one per row, NaN for points which could not
+   * be snapped
+   */
+  Eigen::RowMatrixX3f snapPoints(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& points);
+
+  /**
+   * @brief Batched version of @ref isNavigable. The points are distributed
+   * across @ref getNumThreads threads.
+   *
+   * @param[in] points The points to check, one per row
+   * @param[in] maxYDelta The maximum y displacement
+   *
+   * @return Whether or not each point is navigable
+   */
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> isNavigableBatch(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+      const float maxYDelta = 0.5);
+
+  /**
+   * @brief Batched version of @ref tryStep, taking the i-th step from the
+   * i-th row of @p starts to the i-th row of @p ends. The steps are
+   * distributed across @ref getNumThreads threads.
+   *
+   * Throws @c std::invalid_argument if @p starts and @p ends do not have the
+   * same number of rows.
+   *
+   * @return The found end locations, one per row
+   */
+  Eigen::RowMatrixX3f tryStepBatch(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& ends);
+
+  /**
+   * @brief Same as @ref tryStepBatch but does not allow for sliding along
+   * walls
+   */
+  Eigen::RowMatrixX3f tryStepNoSlidingBatch(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& starts,
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& ends);
+
   /**
    * @brief Loads a navigation meshed saved by @ref saveNavMesh
    *
@@ -254,6 +469,11 @@ class PathFinder {
    * ``.navmesh``
    *
    * @return Whether or not the navmesh was successfully loaded
+   *
+   * Navigation meshes saved by the current version are memory mapped and used
+   * in place, together with their precomputed islands and navigable area, so
+   * loading is near-instant and the pages are shared between processes
+   * loading the same file. Files saved by older versions are still read.
    */
   bool loadNavMesh(const std::string& path);
 
@@ -263,6 +483,14 @@ class PathFinder {
    * @param[in] path The name of the file, generally has extension ``.navmesh``
    *
    * @return Whether or not the navmesh was successfully saved
+   *
+   * @note The file is written next to @p path and then renamed over it, so it
+   * is safe to overwrite a file which is currently loaded.
+   *
+   * @note Navmeshes are always saved in the memory-mappable format (version
+   * 2 of the ``MSET`` format), which stores the islands alongside the tiles.
+   * Older versions of habitat-sim and other tools reading the version 1
+   * layout cannot load these files.
    */
   bool saveNavMesh(const std::string& path);
 
@@ -276,7 +504,10 @@ class PathFinder {
    *
    * @param[in] newSeed The random seed
    *
-   * @note This just seeds the global c @ref rand function.
+   * @note Every pathfinder has its own random generator, so this does not
+   * affect other pathfinders. It starts from the same fixed seed in every
+   * pathfinder, so the random points of an unseeded pathfinder are
+   * reproducible.
    */
   void seed(uint32_t newSeed);
 
@@ -289,6 +520,22 @@ class PathFinder {
    */
   float islandRadius(const vec3f& pt) const;
 
+  /**
+   * @brief returns the index of the connected component @ref pt belongs to.
+   *
+   * @param[in] pt The point to specify the connected component
+   *
+   * @return Index of the connected component, or @ref ID_UNDEFINED if @ref pt
+   * is not on the navigation mesh
+   */
+  int islandId(const vec3f& pt) const;
+
+  /**
+   * @return All connected components of the navigation mesh, indexed by their
+   * @ref NavMeshIsland.id
+   */
+  std::vector<NavMeshIsland> getIslands() const;
+
   /**
    * @brief Finds the distance to the closest non-navigable location
    *
@@ -309,6 +556,19 @@ class PathFinder {
       const vec3f& pt,
       const float maxSearchRadius = 2.0) const;
 
+  /**
+   * @brief Batched version of @ref distanceToClosestObstacle. The points are
+   * distributed across @ref getNumThreads threads.
+   *
+   * @param[in] points The points to begin searching from, one per row
+   * @param[in] maxSearchRadius The radius to search in
+   *
+   * @return The distance to the closest obstacle of each point
+   */
+  Eigen::VectorXf distancesToClosestObstacle(
+      const Eigen::Ref<const Eigen::RowMatrixX3f>& points,
+      const float maxSearchRadius = 2.0);
+
   /**
    * @brief Query whether or not a given location is navigable
    *
@@ -334,6 +594,15 @@ class PathFinder {
    */
   std::pair<vec3f, vec3f> bounds() const;
 
+  /**
+   * @brief Returns a top-down occupancy grid of the navmesh, true for
+   * navigable cells. Rasterized from the navmesh triangles at most 0.5 away
+   * from @p height and cached per (metersPerPixel, height) until the navmesh
+   * changes.
+   *
+   * @param[in] metersPerPixel The size of a cell
+   * @param[in] height The height of the slice through the navmesh
+   */
   Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> getTopDownView(
       const float metersPerPixel,
       const float height);
@@ -1,7 +1,10 @@
+#include <thread>
+
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Tester.h>
 
+#include <esp/assets/MeshData.h>
 #include <esp/nav/PathFinder.h>
 
 #include <Corrade/Utility/Directory.h>
@@ -33,6 +36,16 @@ struct PathFinderTest : Cr::TestSuite::Tester {
   void bounds();
   void tryStepNoSliding();
   void multiGoalPath();
+  void findPathsBatch();
+  void findPathsBatchConcurrent();
+  void distanceField();
+  void distanceFieldBatch();
+  void saveLoadMapped();
+  void islands();
+  void buildTiled();
+  void rebuildTiles();
+  void topDownView();
+  void randomNavigablePoints();
 
   void benchmarkSingleGoal();
   void benchmarkMultiGoal();
@@ -42,7 +55,14 @@ struct PathFinderTest : Cr::TestSuite::Tester {
 
 PathFinderTest::PathFinderTest() {
   addTests({&PathFinderTest::bounds, &PathFinderTest::tryStepNoSliding,
-            &PathFinderTest::multiGoalPath, &PathFinderTest::testCaching});
+            &PathFinderTest::multiGoalPath, &PathFinderTest::findPathsBatch,
+            &PathFinderTest::findPathsBatchConcurrent,
+            &PathFinderTest::distanceField, &PathFinderTest::distanceFieldBatch,
+            &PathFinderTest::saveLoadMapped, &PathFinderTest::islands,
+            &PathFinderTest::buildTiled, &PathFinderTest::rebuildTiles,
+            &PathFinderTest::topDownView,
+            &PathFinderTest::randomNavigablePoints,
+            &PathFinderTest::testCaching});
 
   addBenchmarks({&PathFinderTest::benchmarkSingleGoal}, 1000);
   addInstancedBenchmarks({&PathFinderTest::benchmarkMultiGoal}, 100,
@@ -125,6 +145,478 @@ void PathFinderTest::multiGoalPath() {
   }
 }
 
+void PathFinderTest::findPathsBatch() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+  pathFinder.setNumThreads(4);
+  CORRADE_COMPARE(pathFinder.getNumThreads(), 4);
+
+  std::vector<esp::nav::ShortestPath> paths(500);
+  std::vector<esp::nav::MultiGoalShortestPath> multiPaths(50);
+  for (auto& path : paths) {
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+  }
+  for (auto& multiPath : multiPaths) {
+    multiPath.requestedStart = pathFinder.getRandomNavigablePoint();
+    std::vector<esp::vec3f> rqEnds;
+    for (int i = 0; i < 10; ++i) {
+      rqEnds.emplace_back(pathFinder.getRandomNavigablePoint());
+    }
+    multiPath.setRequestedEnds(rqEnds);
+  }
+
+  const std::vector<bool> found = pathFinder.findPaths(paths);
+  const std::vector<bool> multiFound = pathFinder.findPaths(multiPaths);
+  CORRADE_COMPARE(found.size(), paths.size());
+  CORRADE_COMPARE(multiFound.size(), multiPaths.size());
+
+  // The batched results must match the serial ones exactly
+  for (int i = 0; i < paths.size(); ++i) {
+    CORRADE_ITERATION(i);
+    esp::nav::ShortestPath serialPath;
+    serialPath.requestedStart = paths[i].requestedStart;
+    serialPath.requestedEnd = paths[i].requestedEnd;
+    CORRADE_COMPARE(found[i], pathFinder.findPath(serialPath));
+    CORRADE_COMPARE(paths[i].geodesicDistance, serialPath.geodesicDistance);
+    CORRADE_COMPARE(paths[i].points.size(), serialPath.points.size());
+  }
+  for (int i = 0; i < multiPaths.size(); ++i) {
+    CORRADE_ITERATION(i);
+    esp::nav::MultiGoalShortestPath serialPath;
+    serialPath.requestedStart = multiPaths[i].requestedStart;
+    serialPath.setRequestedEnds(multiPaths[i].getRequestedEnds());
+    CORRADE_COMPARE(multiFound[i], pathFinder.findPath(serialPath));
+    CORRADE_COMPARE(multiPaths[i].geodesicDistance,
+                    serialPath.geodesicDistance);
+  }
+}
+
+void PathFinderTest::findPathsBatchConcurrent() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+  pathFinder.setNumThreads(2);
+
+  std::vector<esp::nav::ShortestPath> paths(200);
+  for (auto& path : paths) {
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+  }
+  std::vector<esp::nav::ShortestPath> expected = paths;
+  const std::vector<bool> expectedFound = pathFinder.findPaths(expected);
+  // The worker queries are created again by whichever batch comes first
+  pathFinder.setNumThreads(3);
+
+  // Batches from several threads at once, as with the GIL released
+  constexpr int numCallers = 4;
+  std::vector<std::vector<esp::nav::ShortestPath>> callerPaths(numCallers,
+                                                               paths);
+  std::vector<std::vector<bool>> callerFound(numCallers);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < numCallers; ++i) {
+    callers.emplace_back([&, i]() {
+      callerFound[i] = pathFinder.findPaths(callerPaths[i]);
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+
+  for (int i = 0; i < numCallers; ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_VERIFY(callerFound[i] == expectedFound);
+    for (size_t j = 0; j < paths.size(); ++j) {
+      CORRADE_COMPARE(callerPaths[i][j].geodesicDistance,
+                      expected[j].geodesicDistance);
+    }
+  }
+}
+
+void PathFinderTest::distanceField() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  esp::nav::MultiGoalShortestPath fieldPath;
+  {
+    std::vector<esp::vec3f> rqEnds;
+    for (int i = 0; i < 25; ++i) {
+      rqEnds.emplace_back(pathFinder.getRandomNavigablePoint());
+    }
+    fieldPath.setRequestedEnds(rqEnds);
+  }
+
+  for (int i = 0; i < 200; ++i) {
+    CORRADE_ITERATION(i);
+
+    esp::nav::MultiGoalShortestPath exactPath;
+    exactPath.requestedStart = pathFinder.getRandomNavigablePoint();
+    exactPath.setRequestedEnds(fieldPath.getRequestedEnds());
+    const bool found = pathFinder.findPath(exactPath);
+
+    fieldPath.requestedStart = exactPath.requestedStart;
+    CORRADE_COMPARE(pathFinder.findPathFromDistanceField(fieldPath), found);
+    if (!found)
+      continue;
+
+    // The field is an upper bound and should be close to the exact value
+    CORRADE_COMPARE_AS(fieldPath.geodesicDistance,
+                       exactPath.geodesicDistance - 1e-3f,
+                       Cr::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(fieldPath.geodesicDistance,
+                       exactPath.geodesicDistance * 1.05f + 0.1f,
+                       Cr::TestSuite::Compare::LessOrEqual);
+    CORRADE_VERIFY(fieldPath.points.empty());
+
+    CORRADE_VERIFY(pathFinder.findPathFromDistanceField(fieldPath, true));
+    CORRADE_VERIFY(!fieldPath.points.empty());
+    CORRADE_COMPARE_AS(fieldPath.geodesicDistance,
+                       exactPath.geodesicDistance * 1.05f + 0.1f,
+                       Cr::TestSuite::Compare::LessOrEqual);
+  }
+}
+
+void PathFinderTest::distanceFieldBatch() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  std::vector<esp::nav::MultiGoalShortestPath::ptr> fields;
+  for (int i = 0; i < 3; ++i) {
+    fields.emplace_back(esp::nav::MultiGoalShortestPath::create());
+    fields.back()->setRequestedEnds({pathFinder.getRandomNavigablePoint()});
+  }
+
+  constexpr int numStarts = 300;
+  Eigen::RowMatrixX3f starts(numStarts, 3);
+  std::vector<int> fieldIds(numStarts);
+  for (int i = 0; i < numStarts; ++i) {
+    starts.row(i) = pathFinder.getRandomNavigablePoint().transpose();
+    fieldIds[i] = i % fields.size();
+  }
+  // Off the navmesh
+  starts.row(0) = esp::vec3f{1e5f, 1e5f, 1e5f}.transpose();
+
+  const Eigen::VectorXf distances =
+      pathFinder.geodesicDistancesFromDistanceFields(fields, starts, fieldIds);
+  CORRADE_COMPARE(distances.size(), numStarts);
+  CORRADE_COMPARE(distances[0], std::numeric_limits<float>::infinity());
+
+  for (int i = 0; i < numStarts; ++i) {
+    CORRADE_ITERATION(i);
+    esp::nav::MultiGoalShortestPath& field = *fields[fieldIds[i]];
+    field.requestedStart = starts.row(i).transpose();
+    pathFinder.findPathFromDistanceField(field);
+    CORRADE_COMPARE(distances[i], field.geodesicDistance);
+  }
+
+  const Eigen::VectorXf obstacleDistances =
+      pathFinder.distancesToClosestObstacle(starts, 1.0f);
+  for (int i = 1; i < numStarts; ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_COMPARE(obstacleDistances[i], pathFinder.distanceToClosestObstacle(
+                                              starts.row(i).transpose(), 1.0f));
+  }
+}
+
+void PathFinderTest::saveLoadMapped() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  const std::string savedNavMesh = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "PathFinderTest-skokloster.navmesh");
+  CORRADE_VERIFY(pathFinder.saveNavMesh(savedNavMesh));
+
+  esp::nav::PathFinder mappedPathFinder;
+  CORRADE_VERIFY(mappedPathFinder.loadNavMesh(savedNavMesh));
+  CORRADE_VERIFY(mappedPathFinder.isLoaded());
+
+  CORRADE_COMPARE(Mn::Vector3{mappedPathFinder.bounds().first},
+                  Mn::Vector3{pathFinder.bounds().first});
+  CORRADE_COMPARE(Mn::Vector3{mappedPathFinder.bounds().second},
+                  Mn::Vector3{pathFinder.bounds().second});
+  CORRADE_COMPARE(mappedPathFinder.getNavigableArea(),
+                  pathFinder.getNavigableArea());
+
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+    esp::nav::ShortestPath path;
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+    esp::nav::ShortestPath mappedPath = path;
+
+    CORRADE_COMPARE(mappedPathFinder.findPath(mappedPath),
+                    pathFinder.findPath(path));
+    CORRADE_COMPARE(mappedPath.geodesicDistance, path.geodesicDistance);
+    CORRADE_COMPARE(mappedPathFinder.islandRadius(path.requestedStart),
+                    pathFinder.islandRadius(path.requestedStart));
+  }
+
+  // Saving the mapped navmesh again round-trips
+  CORRADE_VERIFY(mappedPathFinder.saveNavMesh(savedNavMesh));
+  CORRADE_VERIFY(mappedPathFinder.loadNavMesh(savedNavMesh));
+  CORRADE_COMPARE(mappedPathFinder.getNavigableArea(),
+                  pathFinder.getNavigableArea());
+
+  CORRADE_VERIFY(Cr::Utility::Directory::rm(savedNavMesh));
+}
+
+void PathFinderTest::islands() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  const std::vector<esp::nav::NavMeshIsland> islands = pathFinder.getIslands();
+  CORRADE_VERIFY(!islands.empty());
+  for (int i = 0; i < islands.size(); ++i) {
+    CORRADE_COMPARE(islands[i].id, i);
+    CORRADE_COMPARE_AS(islands[i].numPolygons, 0,
+                       Cr::TestSuite::Compare::Greater);
+  }
+
+  CORRADE_COMPARE(pathFinder.islandId({1e2, 1e2, 1e2}), esp::ID_UNDEFINED);
+
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+    esp::nav::ShortestPath path;
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+
+    const int startIsland = pathFinder.islandId(path.requestedStart);
+    const int endIsland = pathFinder.islandId(path.requestedEnd);
+    CORRADE_VERIFY(startIsland >= 0 && startIsland < islands.size());
+    CORRADE_VERIFY(endIsland >= 0 && endIsland < islands.size());
+    CORRADE_COMPARE(pathFinder.islandRadius(path.requestedStart),
+                    islands[startIsland].radius);
+    CORRADE_COMPARE(pathFinder.findPath(path), startIsland == endIsland);
+  }
+}
+
+void PathFinderTest::buildTiled() {
+  esp::nav::PathFinder loaded;
+  loaded.loadNavMesh(skokloster);
+  CORRADE_VERIFY(loaded.isLoaded());
+  loaded.seed(0);
+  // Rebuild from the navmesh triangles themselves so the test doesn't depend
+  // on the scene mesh
+  std::shared_ptr<esp::assets::MeshData> mesh = loaded.getNavMeshData();
+
+  esp::nav::NavMeshSettings settings;
+  esp::nav::PathFinder single;
+  CORRADE_VERIFY(single.build(settings, *mesh));
+
+  settings.tileSize = 64;
+  esp::nav::PathFinder tiled;
+  tiled.setNumThreads(4);
+  CORRADE_VERIFY(tiled.build(settings, *mesh));
+  CORRADE_VERIFY(tiled.isLoaded());
+
+  // Tiling splits polygons along tile edges, but covers the same surface
+  CORRADE_COMPARE_AS(
+      std::abs(tiled.getNavigableArea() - single.getNavigableArea()),
+      0.02f * single.getNavigableArea(), Cr::TestSuite::Compare::LessOrEqual);
+
+  // Paths have to cross tile borders seamlessly
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+    esp::nav::ShortestPath singlePath;
+    singlePath.requestedStart = single.getRandomNavigablePoint();
+    singlePath.requestedEnd = single.getRandomNavigablePoint();
+    if (!single.findPath(singlePath) ||
+        !tiled.isNavigable(singlePath.requestedStart) ||
+        !tiled.isNavigable(singlePath.requestedEnd)) {
+      continue;
+    }
+
+    esp::nav::ShortestPath tiledPath;
+    tiledPath.requestedStart = singlePath.requestedStart;
+    tiledPath.requestedEnd = singlePath.requestedEnd;
+    CORRADE_VERIFY(tiled.findPath(tiledPath));
+    CORRADE_COMPARE_AS(
+        std::abs(tiledPath.geodesicDistance - singlePath.geodesicDistance),
+        0.1f + 0.05f * singlePath.geodesicDistance,
+        Cr::TestSuite::Compare::LessOrEqual);
+  }
+}
+
+void PathFinderTest::rebuildTiles() {
+  esp::nav::PathFinder loaded;
+  loaded.loadNavMesh(skokloster);
+  CORRADE_VERIFY(loaded.isLoaded());
+  loaded.seed(0);
+  std::shared_ptr<esp::assets::MeshData> mesh = loaded.getNavMeshData();
+
+  esp::nav::NavMeshSettings settings;
+  settings.tileSize = 64;
+  esp::nav::PathFinder pathFinder;
+  CORRADE_VERIFY(pathFinder.build(settings, *mesh));
+  const float originalArea = pathFinder.getNavigableArea();
+  // Triangulated before the update so it gets patched
+  CORRADE_VERIFY(pathFinder.getNavMeshData());
+
+  // Put a 1x1m box, too tall to climb, on a navigable point. It stays within
+  // the vertical bounds of the initial build so a full rebuild quantizes
+  // heights the same way.
+  const esp::vec3f center = pathFinder.getRandomNavigablePoint();
+  const esp::vec3f boxMin = center + esp::vec3f{-0.5f, 0.0f, -0.5f};
+  const esp::vec3f boxMax = center + esp::vec3f{0.5f, 1.0f, 0.5f};
+  esp::assets::MeshData withBox = *mesh;
+  const uint32_t firstVert = withBox.vbo.size();
+  for (int i = 0; i < 8; ++i) {
+    withBox.vbo.emplace_back(i & 1 ? boxMax[0] : boxMin[0],
+                             i & 2 ? boxMax[1] : boxMin[1],
+                             i & 4 ? boxMax[2] : boxMin[2]);
+  }
+  for (uint32_t index : {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6,
+                         0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7,
+                         0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5}) {
+    withBox.ibo.push_back(firstVert + index);
+  }
+
+  // Only the triangles around the rebuilt tiles are needed
+  const std::pair<esp::vec3f, esp::vec3f> tileBounds =
+      pathFinder.getTileRebuildBounds(boxMin, boxMax);
+  CORRADE_VERIFY((tileBounds.first.array() <= boxMin.array()).all());
+  CORRADE_VERIFY((tileBounds.second.array() >= boxMax.array()).all());
+  esp::assets::MeshData nearBox;
+  nearBox.vbo = withBox.vbo;
+  for (size_t i = 0; i + 2 < withBox.ibo.size(); i += 3) {
+    const esp::vec3f& a = withBox.vbo[withBox.ibo[i]];
+    const esp::vec3f& b = withBox.vbo[withBox.ibo[i + 1]];
+    const esp::vec3f& c = withBox.vbo[withBox.ibo[i + 2]];
+    if ((a.cwiseMax(b).cwiseMax(c).array() >= tileBounds.first.array())
+            .all() &&
+        (a.cwiseMin(b).cwiseMin(c).array() <= tileBounds.second.array())
+            .all()) {
+      nearBox.ibo.insert(nearBox.ibo.end(), withBox.ibo.begin() + i,
+                         withBox.ibo.begin() + i + 3);
+    }
+  }
+  CORRADE_COMPARE_AS(nearBox.ibo.size(), withBox.ibo.size(),
+                     Cr::TestSuite::Compare::Less);
+
+  CORRADE_VERIFY(pathFinder.rebuildTiles(nearBox, boxMin, boxMax));
+  CORRADE_VERIFY(!pathFinder.isNavigable(center));
+  CORRADE_COMPARE_AS(pathFinder.getNavigableArea(), originalArea,
+                     Cr::TestSuite::Compare::Less);
+
+  // Same result as building everything from scratch
+  esp::nav::PathFinder rebuilt;
+  CORRADE_VERIFY(rebuilt.build(settings, withBox));
+  CORRADE_COMPARE(pathFinder.getNavigableArea(), rebuilt.getNavigableArea());
+  CORRADE_COMPARE(pathFinder.getIslands().size(), rebuilt.getIslands().size());
+  CORRADE_COMPARE(pathFinder.getNavMeshData()->vbo.size(),
+                  rebuilt.getNavMeshData()->vbo.size());
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+    const esp::vec3f start = rebuilt.getRandomNavigablePoint();
+    const esp::vec3f end = rebuilt.getRandomNavigablePoint();
+    CORRADE_COMPARE(pathFinder.islandId(start) == pathFinder.islandId(end),
+                    rebuilt.islandId(start) == rebuilt.islandId(end));
+  }
+
+  // Removing the box restores the original navmesh
+  CORRADE_VERIFY(pathFinder.rebuildTiles(*mesh, boxMin, boxMax));
+  CORRADE_VERIFY(pathFinder.isNavigable(center));
+  CORRADE_COMPARE(pathFinder.getNavigableArea(), originalArea);
+}
+
+void PathFinderTest::topDownView() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+
+  const float metersPerPixel = 0.1f;
+  const float height = pathFinder.bounds().first[1];
+  const Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> view =
+      pathFinder.getTopDownView(metersPerPixel, height);
+  CORRADE_VERIFY(view.count() > 0);
+
+  // Same as snapping every single pixel, up to cells on the navmesh border
+  const esp::vec3f start = pathFinder.bounds().first;
+  int mismatches = 0;
+  for (int h = 0; h < view.rows(); ++h) {
+    for (int w = 0; w < view.cols(); ++w) {
+      const esp::vec3f point{start[0] + w * metersPerPixel, height,
+                             start[2] + h * metersPerPixel};
+      mismatches += view(h, w) != pathFinder.isNavigable(point, 0.5);
+    }
+  }
+  CORRADE_COMPARE_AS(mismatches, static_cast<int>(view.size() / 100),
+                     Cr::TestSuite::Compare::LessOrEqual);
+
+  // Cached
+  CORRADE_VERIFY(pathFinder.getTopDownView(metersPerPixel, height) == view);
+  // Only the most recent view is kept, the first one is rasterized again
+  const Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> coarse =
+      pathFinder.getTopDownView(2 * metersPerPixel, height);
+  CORRADE_COMPARE_AS(coarse.rows(), view.rows(),
+                     Cr::TestSuite::Compare::Less);
+  CORRADE_VERIFY(pathFinder.getTopDownView(metersPerPixel, height) == view);
+}
+
+void PathFinderTest::randomNavigablePoints() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+
+  // Every pathfinder has its own stream, with the same fixed initial seed
+  esp::nav::PathFinder other;
+  other.loadNavMesh(skokloster);
+  CORRADE_COMPARE(Mn::Vector3{pathFinder.getRandomNavigablePoint()},
+                  Mn::Vector3{other.getRandomNavigablePoint()});
+  pathFinder.seed(3);
+  other.seed(3);
+  const esp::vec3f first = pathFinder.getRandomNavigablePoint();
+  other.getRandomNavigablePoint();
+  CORRADE_COMPARE(Mn::Vector3{pathFinder.getRandomNavigablePoint()},
+                  Mn::Vector3{other.getRandomNavigablePoint()});
+  other.seed(3);
+  CORRADE_COMPARE(Mn::Vector3{other.getRandomNavigablePoint()},
+                  Mn::Vector3{first});
+
+  // Independent of the number of threads
+  pathFinder.setNumThreads(1);
+  pathFinder.seed(0);
+  const Eigen::RowMatrixX3f points = pathFinder.getRandomNavigablePoints(1000);
+  CORRADE_COMPARE(points.rows(), 1000);
+  pathFinder.setNumThreads(4);
+  pathFinder.seed(0);
+  CORRADE_VERIFY(pathFinder.getRandomNavigablePoints(1000) == points);
+
+  for (int i = 0; i < points.rows(); ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_VERIFY(pathFinder.isNavigable(points.row(i).transpose()));
+  }
+
+  // Restricted to an island
+  const std::vector<esp::nav::NavMeshIsland> islands = pathFinder.getIslands();
+  CORRADE_COMPARE_AS(islands.size(), std::size_t{1},
+                     Cr::TestSuite::Compare::Greater);
+  const int island = islands.back().id;
+  const Eigen::RowMatrixX3f islandPoints =
+      pathFinder.getRandomNavigablePoints(100, island);
+  CORRADE_COMPARE(islandPoints.rows(), 100);
+  for (int i = 0; i < islandPoints.rows(); ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_COMPARE(pathFinder.islandId(islandPoints.row(i).transpose()),
+                    island);
+  }
+
+  const int invalidIsland = islands.size();
+  CORRADE_COMPARE(
+      pathFinder.getRandomNavigablePoints(10, invalidIsland).rows(), 0);
+}
+
 void PathFinderTest::testCaching() {
   esp::nav::PathFinder pathFinder;
   pathFinder.loadNavMesh(skokloster);
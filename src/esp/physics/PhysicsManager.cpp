@@ -6,6 +6,8 @@
 #include "esp/assets/CollisionMeshData.h"
 
 #include <Magnum/Math/Range.h>
+#include <algorithm>
+#include <chrono>
 
 namespace esp {
 namespace physics {
@@ -15,6 +17,8 @@ bool PhysicsManager::initPhysics(scene::SceneNode* node) {
 
   // Copy over relevant configuration
   fixedTimeStep_ = physicsManagerAttributes_->getTimestep();
+  maxSubsteps_ = physicsManagerAttributes_->getMaxSubsteps();
+  substepInterpolation_ = physicsManagerAttributes_->getSubstepInterpolation();
 
   //! Create new scene node and set up any physics-related variables
   // Overridden by specific physics-library-based class
@@ -132,6 +136,11 @@ void PhysicsManager::removeObject(const int physObjectID,
   assertIDValidity(physObjectID);
   scene::SceneNode* objectNode = &existingObjects_.at(physObjectID)->node();
   scene::SceneNode* visualNode = existingObjects_.at(physObjectID)->visualNode_;
+  RigidObject* object = existingObjects_.at(physObjectID).get();
+  if (object->isVelocityControlTracked()) {
+    velControlledObjects_.erase(std::find(velControlledObjects_.begin(),
+                                          velControlledObjects_.end(), object));
+  }
   existingObjects_.erase(physObjectID);
   deallocateObjectID(physObjectID);
   if (deleteObjectNode) {
@@ -202,6 +211,7 @@ void PhysicsManager::stepPhysics(double dt) {
   if (!initialized_) {
     return;
   }
+  const auto start = std::chrono::steady_clock::now();
 
   // ==== Physics stepforward ======
   // NOTE: simulator step goes here in derived classes...
@@ -210,22 +220,114 @@ void PhysicsManager::stepPhysics(double dt) {
     dt = fixedTimeStep_;
   }
 
+  updateVelControlledObjects();
+
   // handle in-between step times? Ideally dt is a multiple of
   // sceneMetaData_.timestep
-  double targetTime = worldTime_ + dt;
-  while (worldTime_ < targetTime) {
+  int numSubsteps = 0;
+  if (substepInterpolation_) {
+    // there is nothing to interpolate here, the time is rounded up instead
+    double targetTime = worldTime_ + dt;
+    for (double time = worldTime_; time < targetTime; time += fixedTimeStep_) {
+      ++numSubsteps;
+    }
+    if (maxSubsteps_ > 0 && numSubsteps > maxSubsteps_) {
+      stepStats_.numDroppedSubsteps += numSubsteps - maxSubsteps_;
+      numSubsteps = maxSubsteps_;
+    }
+  } else {
+    numSubsteps = takeSubsteps(dt);
+  }
+
+  for (int i = 0; i < numSubsteps; ++i) {
     // per fixed-step operations can be added here
 
     // kinematic velocity control intergration
-    for (auto& object : existingObjects_) {
-      VelocityControl::ptr velControl = object.second->getVelocityControl();
-      if (velControl->controllingAngVel || velControl->controllingLinVel) {
-        object.second->setRigidState(velControl->integrateTransform(
-            fixedTimeStep_, object.second->getRigidState()));
+    for (RigidObject* object : velControlledObjects_) {
+      if (object->isVelocityControlActive()) {
+        object->setRigidState(
+            object->getVelocityControlRef().integrateTransform(
+                fixedTimeStep_, object->getRigidState()));
       }
     }
     worldTime_ += fixedTimeStep_;
   }
+
+  recordStep(numSubsteps, std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+}
+
+int PhysicsManager::takeSubsteps(double dt) {
+  pendingTime_ += dt;
+  int numSubsteps = 0;
+  if (pendingTime_ >= fixedTimeStep_) {
+    numSubsteps = static_cast<int>(pendingTime_ / fixedTimeStep_);
+    pendingTime_ -= numSubsteps * fixedTimeStep_;
+  }
+  if (maxSubsteps_ > 0 && numSubsteps > maxSubsteps_) {
+    stepStats_.numDroppedSubsteps += numSubsteps - maxSubsteps_;
+    numSubsteps = maxSubsteps_;
+  }
+  return numSubsteps;
+}
+
+void PhysicsManager::recordStep(int numSubsteps, double duration) {
+  ++stepStats_.numSteps;
+  stepStats_.numSubsteps += numSubsteps;
+  stepStats_.lastNumSubsteps = numSubsteps;
+  stepStats_.lastStepDuration = duration;
+  stepStats_.maxStepDuration = std::max(stepStats_.maxStepDuration, duration);
+  stepStats_.totalStepDuration += duration;
+}
+
+void PhysicsManager::saveState(PhysicsState& state) {
+  state.worldTime = worldTime_;
+  state.pendingTime = pendingTime_;
+  state.objects.resize(existingObjects_.size());
+  size_t iObject = 0;
+  for (auto& objectItr : existingObjects_) {
+    RigidObject& object = *objectItr.second;
+    RigidObjectState& objectState = state.objects[iObject++];
+    objectState.objectId = objectItr.first;
+    objectState.motionType = object.getMotionType();
+    objectState.rotation = object.node().rotation();
+    objectState.translation = object.node().translation();
+    objectState.linearVelocity = object.getLinearVelocity();
+    objectState.angularVelocity = object.getAngularVelocity();
+    objectState.activationState = object.getActivationState();
+    objectState.deactivationTime = object.getDeactivationTime();
+  }
+}
+
+bool PhysicsManager::restoreState(const PhysicsState& state) {
+  bool success = true;
+  for (const RigidObjectState& objectState : state.objects) {
+    auto objectItr = existingObjects_.find(objectState.objectId);
+    if (objectItr == existingObjects_.end()) {
+      LOG(ERROR) << "PhysicsManager::restoreState : Object "
+                 << objectState.objectId
+                 << " no longer exists, skipping its state.";
+      success = false;
+      continue;
+    }
+    RigidObject& object = *objectItr->second;
+    // the motion type first, as static objects can not be moved
+    if (object.getMotionType() != objectState.motionType) {
+      object.setMotionType(objectState.motionType);
+    }
+    object.setRigidState(
+        core::RigidState(objectState.rotation, objectState.translation));
+    object.setLinearVelocity(objectState.linearVelocity);
+    object.setAngularVelocity(objectState.angularVelocity);
+    // last, as setting velocities activates the object
+    object.setActivationState(objectState.activationState,
+                              objectState.deactivationTime);
+  }
+  worldTime_ = state.worldTime;
+  pendingTime_ = state.pendingTime;
+  resetContactEvents();
+  return success;
 }
 
 //! Profile function. In BulletPhysics stationary objects are
@@ -410,7 +512,26 @@ Magnum::Vector3 PhysicsManager::getAngularVelocity(
 VelocityControl::ptr PhysicsManager::getVelocityControl(
     const int physObjectID) {
   assertIDValidity(physObjectID);
-  return existingObjects_.at(physObjectID)->getVelocityControl();
+  // the caller may activate the control from now on
+  RigidObject* object = existingObjects_.at(physObjectID).get();
+  if (!object->isVelocityControlTracked()) {
+    object->setVelocityControlTracked(true);
+    velControlledObjects_.push_back(object);
+  }
+  return object->getVelocityControl();
+}
+
+void PhysicsManager::updateVelControlledObjects() {
+  size_t numKept = 0;
+  for (RigidObject* object : velControlledObjects_) {
+    if (object->isVelocityControlActive() ||
+        object->isVelocityControlShared()) {
+      velControlledObjects_[numKept++] = object;
+    } else {
+      object->setVelocityControlTracked(false);
+    }
+  }
+  velControlledObjects_.resize(numKept);
 }
 
 //============ Object Setter functions =============
@@ -65,6 +65,144 @@ struct RaycastResults {
   ESP_SMART_POINTERS(RaycastResults)
 };
 
+/**
+ * @brief Holds the hits of a batch of ray casts as flat arrays with one row
+ * per hit, see @ref PhysicsManager::castRays.
+ *
+ * The hits of ray i are rows [hitOffsets[i], hitOffsets[i + 1]), sorted by
+ * distance.
+ */
+struct BatchedRaycastResults {
+  //! Offset of the first hit of each ray, followed by the total number of hits
+  Eigen::VectorXi hitOffsets;
+  //! The id of the object hit. Stage hits are -1.
+  Eigen::VectorXi objectIds;
+  //! The impact points in world space, one per row.
+  Eigen::RowMatrixX3f points;
+  //! The collision object normals at the points of impact, one per row.
+  Eigen::RowMatrixX3f normals;
+  //! Distance along the ray direction from the ray origin (in units of ray
+  //! length).
+  Eigen::VectorXd rayDistances;
+
+  int numRays() const {
+    return hitOffsets.size() > 0 ? hitOffsets.size() - 1 : 0;
+  }
+
+  int numHits(int rayIndex) const {
+    return hitOffsets[rayIndex + 1] - hitOffsets[rayIndex];
+  }
+
+  ESP_SMART_POINTERS(BatchedRaycastResults)
+};
+
+//! The kind of change of contact between two objects during a step.
+enum class ContactEventType : int {
+  //! The objects started touching.
+  BEGIN = 0,
+  //! The objects were touching before the step and still are.
+  PERSIST = 1,
+  //! The objects stopped touching. Objects which started and stopped touching
+  //! within the substeps of a single step are reported as @ref BEGIN during
+  //! that step and as END during the next one.
+  END = 2,
+};
+
+/**
+ * @brief The contact events of the last step as flat arrays with one row per
+ * pair of touching (or formerly touching) objects, see @ref
+ * PhysicsManager::getContactEvents.
+ *
+ * Pairs are sorted by object ids, with objectIdsA[i] < objectIdsB[i]. Stage
+ * contacts use the id -1.
+ */
+struct ContactEvents {
+  //! The @ref ContactEventType of each pair.
+  Eigen::VectorXi types;
+  //! The smaller object id of each pair.
+  Eigen::VectorXi objectIdsA;
+  //! The larger object id of each pair.
+  Eigen::VectorXi objectIdsB;
+  //! The world space contact point with the largest impulse of each pair.
+  //! For @ref ContactEventType::END, the last known contact point.
+  Eigen::RowMatrixX3f points;
+  //! The total impulse applied between the objects over the substeps of the
+  //! step, 0 for @ref ContactEventType::END of objects which did not touch
+  //! during the step.
+  Eigen::VectorXf impulses;
+
+  int size() const { return types.size(); }
+
+  ESP_SMART_POINTERS(ContactEvents)
+};
+
+/**
+ * @brief Counters of the work done by @ref PhysicsManager::stepPhysics, to
+ * monitor and bound the cost of stepping. See @ref
+ * PhysicsManager::getStepStats.
+ */
+struct PhysicsStepStats {
+  //! The number of steps.
+  int numSteps = 0;
+  //! The total number of fixed substeps simulated.
+  int numSubsteps = 0;
+  //! The number of fixed substeps simulated by the last step.
+  int lastNumSubsteps = 0;
+  //! The total number of fixed substeps dropped because a step exceeded the
+  //! maximum number of substeps.
+  int numDroppedSubsteps = 0;
+  //! The wall clock duration of the last step, in seconds.
+  double lastStepDuration = 0.0;
+  //! The longest wall clock duration of a step, in seconds.
+  double maxStepDuration = 0.0;
+  //! The total wall clock duration of all steps, in seconds.
+  double totalStepDuration = 0.0;
+
+  ESP_SMART_POINTERS(PhysicsStepStats)
+};
+
+/**
+ * @brief Snapshot of the dynamic state of one object, see @ref PhysicsState.
+ */
+struct RigidObjectState {
+  //! The id of the object.
+  int objectId;
+  //! The @ref MotionType of the object.
+  MotionType motionType;
+  //! The orientation of the object.
+  Magnum::Quaternion rotation;
+  //! The position of the object.
+  Magnum::Vector3 translation;
+  //! The linear velocity of the object.
+  Magnum::Vector3 linearVelocity;
+  //! The angular velocity of the object.
+  Magnum::Vector3 angularVelocity;
+  //! The implementation specific activation state of the object.
+  int activationState;
+  //! The time the object has been at rest.
+  float deactivationTime;
+};
+
+/**
+ * @brief Snapshot of the dynamic state of all objects of a physical world,
+ * see @ref PhysicsManager::saveState.
+ */
+struct PhysicsState {
+  //! The simulated time of the world.
+  double worldTime = 0.0;
+  //! The time requested but not simulated yet, see @ref
+  //! PhysicsManager::stepPhysics. With substep interpolation, the time the
+  //! poses are interpolated over.
+  double pendingTime = 0.0;
+  //! The seed of the random number generator of the constraint solver, if
+  //! the implementation has one.
+  unsigned long solverSeed = 0;
+  //! The states of the objects, in the order of their ids.
+  std::vector<RigidObjectState> objects;
+
+  ESP_SMART_POINTERS(PhysicsState)
+};
+
 // TODO: repurpose to manage multiple physical worlds. Currently represents
 // exactly one world.
 
@@ -149,6 +287,34 @@ class PhysicsManager {
     worldTime_ = 0.0;
   }
 
+  /**
+   * @brief Take a snapshot of the dynamic state of the world: the world time
+   * and the time not simulated yet, the state of the solver, and the
+   * transformations, velocities, motion types and activation states of all
+   * objects. See @ref restoreState.
+   * @param state The snapshot, its storage is reused.
+   */
+  virtual void saveState(PhysicsState& state);
+
+  /**
+   * @brief Restore the world to a snapshot taken by @ref saveState.
+   *
+   * The objects are modified in place, without reconstructing them unless
+   * their @ref MotionType changed. Objects added since the snapshot are left
+   * untouched. Applied forces and velocity controls are not part of the
+   * snapshot. The contact events are reset, see @ref resetContactEvents.
+   *
+   * The contact caches of the implementation, such as the contact points
+   * Bullet keeps between steps to warm start its solver, are not part of the
+   * snapshot either. A restored world replays the saved trajectory exactly
+   * until objects touch, and approximately from then on.
+   *
+   * @param state The snapshot.
+   * @return false if some objects of the snapshot were removed in the meantime,
+   * true otherwise.
+   */
+  virtual bool restoreState(const PhysicsState& state);
+
   /** @brief Stores references to a set of drawable elements. */
   using DrawableGroup = gfx::DrawableGroup;
 
@@ -254,11 +420,22 @@ class PhysicsManager {
   //============ Simulator functions =============
 
   /** @brief Step the physical world forward in time. Time may only advance in
-   * increments of @ref fixedTimeStep_.
+   * increments of @ref fixedTimeStep_, at most @ref maxSubsteps_ of them.
    * @param dt The desired amount of time to advance the physical world.
    */
   virtual void stepPhysics(double dt = 0.0);
 
+  /**
+   * @brief Counters of the substeps and wall clock time spent stepping since
+   * initialization or @ref resetStepStats.
+   */
+  const PhysicsStepStats& getStepStats() const { return stepStats_; }
+
+  /**
+   * @brief Reset the counters of @ref getStepStats.
+   */
+  void resetStepStats() { stepStats_ = PhysicsStepStats(); }
+
   // =========== Global Setter functions ===========
 
   /** @brief Set the @ref fixedTimeStep_ of the physical world. See @ref
@@ -913,8 +1090,74 @@ class PhysicsManager {
     return results;
   }
 
+  /**
+   * @brief Cast a batch of rays into the collision world.
+   *
+   * Note: not implemented here in default PhysicsManager as there are no
+   * collision objects without a simulation implementation.
+   *
+   * @param rays The rays to cast. Need not be unit length, but returned hit
+   * distances will be in units of ray length.
+   * @param maxDistance The maximum distance along the ray directions to
+   * search. In units of ray length.
+   * @param closestOnly Whether to only report the closest hit of each ray.
+   * @return The hits of all rays, sorted by distance for each ray.
+   */
+  virtual BatchedRaycastResults castRays(
+      const std::vector<esp::geo::Ray>& rays,
+      CORRADE_UNUSED double maxDistance = 100.0,
+      CORRADE_UNUSED bool closestOnly = false) {
+    BatchedRaycastResults results;
+    results.hitOffsets = Eigen::VectorXi::Zero(rays.size() + 1);
+    return results;
+  }
+
+  /**
+   * @brief Set the number of threads @ref castRays distributes its rays
+   * across, including the calling thread. 0 uses the number of hardware
+   * threads.
+   */
+  void setNumRaycastThreads(size_t numThreads) {
+    numRaycastThreads_ = numThreads;
+  }
+
+  /**
+   * @brief The number of threads set with @ref setNumRaycastThreads.
+   */
+  size_t getNumRaycastThreads() const { return numRaycastThreads_; }
+
   virtual int getNumActiveContactPoints() { return -1; }
 
+  /**
+   * @brief The contact events of the last @ref stepPhysics: which pairs of
+   * objects started touching, kept touching or stopped touching.
+   *
+   * Collected once per step from the collision detection results, so querying
+   * the contacts of many objects does not cost any further collision
+   * detection, unlike @ref contactTest. The contacts of every substep of the
+   * step are considered. Empty unless enabled with
+   * @ref setContactEventsEnabled, and without a simulation implementation.
+   */
+  const ContactEvents& getContactEvents() const { return contactEvents_; }
+
+  /**
+   * @brief Enable or disable collecting the contact events of each step, see
+   * @ref getContactEvents. Disabled by default, as walking the contacts each
+   * substep has a cost. Disabling clears the events.
+   */
+  void setContactEventsEnabled(bool enabled) {
+    contactEventsEnabled_ = enabled;
+    if (!enabled) {
+      resetContactEvents();
+    }
+  }
+
+  /**
+   * @brief Whether the contact events are collected, see
+   * @ref setContactEventsEnabled.
+   */
+  bool getContactEventsEnabled() const { return contactEventsEnabled_; }
+
  protected:
   /** @brief Check that a given object ID is valid (i.e. it refers to an
    * existing object). Terminate the program and report an error if not. This
@@ -926,6 +1169,32 @@ class PhysicsManager {
     CHECK(existingObjects_.count(physObjectID) > 0);
   };
 
+  /** @brief Drop the objects from @ref velControlledObjects_ whose velocity
+   * control is inactive and can not be activated anymore, since it is not
+   * referenced outside of the object. Called once per step.
+   */
+  void updateVelControlledObjects();
+
+  /** @brief Add time to @ref pendingTime_ and take the whole fixed substeps
+   * out of it, within the @ref maxSubsteps_ budget. Time over budget is
+   * dropped.
+   * @param dt The time requested from @ref stepPhysics.
+   * @return The number of substeps to simulate.
+   */
+  int takeSubsteps(double dt);
+
+  /** @brief Update @ref stepStats_ after a step.
+   * @param numSubsteps The number of substeps simulated.
+   * @param duration The wall clock duration of the step, in seconds.
+   */
+  void recordStep(int numSubsteps, double duration);
+
+  /** @brief Forget the contacts of the previous steps, e.g. after the world
+   * state was replaced, so the next step reports every contact as
+   * @ref ContactEventType::BEGIN.
+   */
+  virtual void resetContactEvents() { contactEvents_ = ContactEvents{}; }
+
   /** @brief Check if a particular mesh can be used as a collision mesh for a
    * particular physics implemenation. Always True for base @ref PhysicsManager
    * class, since the mesh has already been successfully loaded by @ref
@@ -1020,6 +1289,13 @@ class PhysicsManager {
    */
   std::map<int, physics::RigidObject::uptr> existingObjects_;
 
+  /** @brief Dense list of the objects in @ref existingObjects_ whose @ref
+   * VelocityControl may be active, i.e. which have been handed out by @ref
+   * getVelocityControl since they were last found inactive. Velocity control
+   * is only applied to these, so stepping does not scale with the number of
+   * uncontrolled objects. See @ref updateVelControlledObjects. */
+  std::vector<physics::RigidObject*> velControlledObjects_;
+
   /** @brief A counter of unique object ID's allocated thus far. Used to
    * allocate new IDs when  @ref recycledObjectIDs_ is empty without needing to
    * check @ref existingObjects_ explicitly.*/
@@ -1046,6 +1322,33 @@ class PhysicsManager {
    * simulated with @ref stepPhysics up to this point. */
   double worldTime_ = 0.0;
 
+  /** @brief The maximum number of fixed substeps of a single @ref stepPhysics,
+   * 0 for no limit. Time beyond it is dropped. */
+  int maxSubsteps_ = 10000;
+
+  /** @brief Whether dynamics implementations may interpolate poses over the
+   * time left after the last substep, rather than carrying it over to the
+   * next step in @ref pendingTime_. */
+  bool substepInterpolation_ = true;
+
+  /** @brief The time requested from @ref stepPhysics which was not simulated
+   * yet, as it is less than a fixed substep. See @ref takeSubsteps. */
+  double pendingTime_ = 0.0;
+
+  /** @brief See @ref getStepStats. */
+  PhysicsStepStats stepStats_;
+
+  /** @brief The number of threads used by @ref castRays, 0 for the number of
+   * hardware threads. */
+  size_t numRaycastThreads_ = 0;
+
+  /** @brief The contact events of the last step, see @ref getContactEvents.
+   */
+  ContactEvents contactEvents_;
+
+  /** @brief See @ref setContactEventsEnabled. */
+  bool contactEventsEnabled_ = false;
+
   ESP_SMART_POINTERS(PhysicsManager)
 };
 
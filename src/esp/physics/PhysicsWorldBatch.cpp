@@ -0,0 +1,84 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "PhysicsWorldBatch.h"
+
+#include <stdexcept>
+
+namespace esp {
+namespace physics {
+
+int PhysicsWorldBatch::addWorld(const PhysicsManager::ptr& world) {
+  CHECK(world != nullptr);
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (const auto& added : worlds_) {
+    if (added.lock() == world) {
+      throw std::invalid_argument(
+          "PhysicsWorldBatch::addWorld: the world is already part of the "
+          "batch");
+    }
+  }
+  worlds_.emplace_back(world);
+  return worlds_.size() - 1;
+}
+
+void PhysicsWorldBatch::clear() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  worlds_.clear();
+}
+
+size_t PhysicsWorldBatch::getNumWorlds() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return worlds_.size();
+}
+
+PhysicsManager::ptr PhysicsWorldBatch::getWorld(int index) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  CHECK(index >= 0 && index < static_cast<int>(worlds_.size()));
+  return worlds_[index].lock();
+}
+
+void PhysicsWorldBatch::setNumThreads(size_t numThreads) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (numThreads == numThreads_) {
+    return;
+  }
+  numThreads_ = numThreads;
+  threadPool_.reset();
+}
+
+size_t PhysicsWorldBatch::getNumThreads() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (threadPool_) {
+    return threadPool_->numThreads();
+  }
+  return numThreads_ > 0 ? numThreads_
+                         : core::ThreadPool::hardwareConcurrency();
+}
+
+Eigen::VectorXd PhysicsWorldBatch::stepPhysics(double dt) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  // keep the worlds alive while stepping
+  std::vector<PhysicsManager::ptr> worlds;
+  worlds.reserve(worlds_.size());
+  for (const auto& world : worlds_) {
+    worlds.emplace_back(world.lock());
+  }
+
+  if (!threadPool_) {
+    threadPool_ = std::make_unique<core::ThreadPool>(numThreads_);
+  }
+  Eigen::VectorXd worldTimes =
+      Eigen::VectorXd::Constant(worlds.size(), NO_TIME);
+  threadPool_->parallelFor(worlds.size(), [&](size_t i, size_t) {
+    if (worlds[i]) {
+      worlds[i]->stepPhysics(dt);
+      worldTimes[i] = worlds[i]->getWorldTime();
+    }
+  });
+  return worldTimes;
+}
+
+}  // namespace physics
+}  // namespace esp
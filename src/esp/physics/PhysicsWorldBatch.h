@@ -0,0 +1,120 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_PHYSICS_PHYSICSWORLDBATCH_H_
+#define ESP_PHYSICS_PHYSICSWORLDBATCH_H_
+
+/** @file
+ * @brief Class @ref esp::physics::PhysicsWorldBatch
+ */
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "esp/core/ThreadPool.h"
+#include "esp/core/esp.h"
+#include "esp/physics/PhysicsManager.h"
+
+namespace esp {
+namespace physics {
+
+/**
+ * @brief A set of independent physical worlds, e.g. those of several @ref
+ * esp::sim::Simulator instances, which are stepped concurrently.
+ *
+ * Each world is stepped by a single thread, and idle threads claim the next
+ * world which has not been stepped yet, so worlds of uneven cost keep all
+ * threads busy.
+ *
+ * Worlds are referenced weakly: a world which is destroyed, e.g. when its
+ * simulator is closed or reconfigured, is skipped rather than kept alive
+ * beyond the resources it depends on. This relies on the simulator holding
+ * the only lasting strong reference, so worlds are not exposed to Python.
+ *
+ * The batch itself may be used from several threads, as its Python binding
+ * steps the worlds without holding the GIL.
+ */
+class PhysicsWorldBatch {
+ public:
+  /**
+   * @brief Constructor.
+   * @param numThreads The number of threads stepping worlds, including the
+   * calling thread. 0 uses the number of hardware threads.
+   */
+  explicit PhysicsWorldBatch(size_t numThreads = 0)
+      : numThreads_{numThreads} {}
+
+  /**
+   * @brief Add a world to the batch.
+   * @param world The world. Throws @c std::invalid_argument if it is
+   * already part of the batch, as it would then be stepped by two threads at
+   * once.
+   * @return The index of the world in the batch.
+   */
+  int addWorld(const PhysicsManager::ptr& world);
+
+  /**
+   * @brief Remove all worlds from the batch.
+   */
+  void clear();
+
+  /**
+   * @brief The number of worlds added to the batch, including destroyed
+   * ones.
+   */
+  size_t getNumWorlds() const;
+
+  /**
+   * @brief Get a world of the batch.
+   * @param index The index of the world, see @ref addWorld.
+   * @return The world, or nullptr if it was destroyed.
+   */
+  PhysicsManager::ptr getWorld(int index) const;
+
+  /**
+   * @brief Whether a world of the batch is still alive.
+   * @param index The index of the world, see @ref addWorld.
+   */
+  bool hasWorld(int index) const { return getWorld(index) != nullptr; }
+
+  /**
+   * @brief Set the number of threads stepping worlds, including the calling
+   * thread. 0 uses the number of hardware threads.
+   */
+  void setNumThreads(size_t numThreads);
+
+  /**
+   * @brief The number of threads stepping worlds.
+   */
+  size_t getNumThreads() const;
+
+  /**
+   * @brief Step every world forward in time, see @ref
+   * PhysicsManager::stepPhysics. Blocks until all worlds have been stepped.
+   *
+   * The worlds must not be accessed by other threads during the call.
+   *
+   * @param dt The amount of time to advance every world.
+   * @return The world time of each world after stepping, @ref NO_TIME for
+   * destroyed worlds.
+   */
+  Eigen::VectorXd stepPhysics(double dt = 1.0 / 60.0);
+
+ private:
+  //! Guards all the members below, and is held for the whole of a step
+  mutable std::mutex mutex_;
+
+  std::vector<std::weak_ptr<PhysicsManager>> worlds_;
+
+  size_t numThreads_;
+  std::unique_ptr<core::ThreadPool> threadPool_ = nullptr;
+
+  ESP_SMART_POINTERS(PhysicsWorldBatch)
+};
+
+}  // namespace physics
+}  // namespace esp
+
+#endif  // ESP_PHYSICS_PHYSICSWORLDBATCH_H_
@@ -155,6 +155,29 @@ class RigidBase : public Magnum::SceneGraph::AbstractFeature3D {
    */
   virtual void setActive() {}
 
+  /**
+   * @brief Get the implementation specific activation (sleeping) state of the
+   * object, see @ref setActivationState.
+   */
+  virtual int getActivationState() const { return 0; }
+
+  /**
+   * @brief Get the time the object has been at rest, used by derived dynamics
+   * implementations to put it to sleep. See @ref setActivationState.
+   */
+  virtual float getDeactivationTime() const { return 0; }
+
+  /**
+   * @brief Restore the activation state of the object, e.g. from a @ref
+   * PhysicsState.
+   * @param activationState The activation state, see @ref
+   * getActivationState.
+   * @param deactivationTime The time the object has been at rest, see @ref
+   * getDeactivationTime.
+   */
+  virtual void setActivationState(CORRADE_UNUSED int activationState,
+                                  CORRADE_UNUSED float deactivationTime) {}
+
   /**
    * @brief Get the @ref MotionType of the object. See @ref setMotionType.
    * @return The object's current @ref MotionType.
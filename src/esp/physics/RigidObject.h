@@ -170,6 +170,41 @@ class RigidObject : public RigidBase {
    */
   VelocityControl::ptr getVelocityControl() { return velControl_; };
 
+  /**
+   * @brief Retrieves the VelocityControl struct for this object without
+   * sharing its ownership, for use by the @ref PhysicsManager while stepping.
+   */
+  VelocityControl& getVelocityControlRef() { return *velControl_; }
+
+  /**
+   * @brief Whether the velocity control currently controls the linear or
+   * angular velocity of this object.
+   */
+  bool isVelocityControlActive() const {
+    return velControl_->controllingLinVel || velControl_->controllingAngVel;
+  }
+
+  /**
+   * @brief Whether the velocity control is referenced outside of this object,
+   * e.g. by a user of @ref getVelocityControl who may activate it at any time.
+   */
+  bool isVelocityControlShared() const { return velControl_.use_count() > 1; }
+
+  /**
+   * @brief Whether the @ref PhysicsManager applies the velocity control of
+   * this object while stepping, see @ref setVelocityControlTracked.
+   */
+  bool isVelocityControlTracked() const { return velControlTracked_; }
+
+  /**
+   * @brief Set whether the object is in the list of objects the @ref
+   * PhysicsManager applies velocity control to. For use by the @ref
+   * PhysicsManager, so membership is checked in constant time.
+   */
+  void setVelocityControlTracked(bool tracked) {
+    velControlTracked_ = tracked;
+  }
+
  protected:
   /**
    * @brief Convenience variable: specifies a constant control velocity (linear
@@ -177,6 +212,9 @@ class RigidObject : public RigidBase {
    */
   VelocityControl::ptr velControl_;
 
+  //! See @ref isVelocityControlTracked
+  bool velControlTracked_ = false;
+
  public:
   ESP_SMART_POINTERS(RigidObject)
 };  // class RigidObject
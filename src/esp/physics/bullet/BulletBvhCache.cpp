@@ -0,0 +1,206 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "BulletBvhCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <Corrade/Utility/Directory.h>
+
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
+
+#include "esp/io/io.h"
+
+namespace Cr = Corrade;
+
+namespace esp {
+namespace physics {
+
+namespace {
+
+const int BVHCACHE_MAGIC = 'B' << 24 | 'V' << 16 | 'H' << 8 | 'C';  //'BVHC';
+const int BVHCACHE_VERSION = 1;
+
+// Bullet requires in-place serialized BVHs to be 16 byte aligned
+const size_t BVHCACHE_ALIGNMENT = 16;
+
+struct BvhCacheHeader {
+  int magic;
+  int version;
+  // Layout of the serialized btQuantizedBvh, which depends on the platform
+  // and Bullet build
+  uint32_t scalarSize;
+  uint32_t pointerSize;
+  uint32_t bvhSize;
+  uint32_t numBvhs;
+};
+
+struct BvhCacheEntry {
+  uint64_t meshHash;
+  uint64_t offset;
+  uint64_t size;
+};
+
+size_t alignOffset(size_t offset) {
+  return (offset + BVHCACHE_ALIGNMENT - 1) & ~(BVHCACHE_ALIGNMENT - 1);
+}
+
+BvhCacheHeader makeHeader(uint32_t numBvhs) {
+  BvhCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = BVHCACHE_MAGIC;
+  header.version = BVHCACHE_VERSION;
+  header.scalarSize = sizeof(btScalar);
+  header.pointerSize = sizeof(void*);
+  header.bvhSize = sizeof(btQuantizedBvh);
+  header.numBvhs = numBvhs;
+  return header;
+}
+
+// 64-bit FNV-1a
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+}  // namespace
+
+BulletBvhCache::BulletBvhCache(const std::string& filename) {
+  if (!Cr::Utility::Directory::exists(filename)) {
+    return;
+  }
+  auto file = std::make_unique<core::MappedFile>(filename);
+  unsigned char* data = file->data();
+  const size_t size = file->size();
+  if (!data || size < sizeof(BvhCacheHeader)) {
+    return;
+  }
+
+  BvhCacheHeader header;
+  memcpy(&header, data, sizeof(header));
+  const BvhCacheHeader expected = makeHeader(header.numBvhs);
+  if (memcmp(&header, &expected, sizeof(header)) != 0) {
+    LOG(INFO) << "BulletBvhCache : ignoring " << filename
+              << ", it was written by another version or platform.";
+    return;
+  }
+  const size_t entriesEnd =
+      sizeof(BvhCacheHeader) + header.numBvhs * sizeof(BvhCacheEntry);
+  if (size < entriesEnd) {
+    LOG(WARNING) << "BulletBvhCache : ignoring truncated " << filename;
+    return;
+  }
+
+  std::map<uint64_t, btOptimizedBvh*> bvhs;
+  for (uint32_t iBvh = 0; iBvh < header.numBvhs; ++iBvh) {
+    BvhCacheEntry entry;
+    memcpy(&entry,
+           data + sizeof(BvhCacheHeader) + iBvh * sizeof(BvhCacheEntry),
+           sizeof(entry));
+    // deSerializeInPlace reads the btQuantizedBvh before checking the size
+    if (entry.offset > size || entry.size > size - entry.offset ||
+        entry.size < sizeof(btQuantizedBvh) ||
+        reinterpret_cast<uintptr_t>(data + entry.offset) %
+                BVHCACHE_ALIGNMENT !=
+            0) {
+      LOG(WARNING) << "BulletBvhCache : ignoring corrupted " << filename;
+      return;
+    }
+    // Fixes up the pointers of the BVH in the (copy-on-write) mapping,
+    // leaving the node arrays untouched
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(
+        data + entry.offset, entry.size, false);
+    if (bvh == nullptr) {
+      LOG(WARNING) << "BulletBvhCache : ignoring corrupted " << filename;
+      return;
+    }
+    bvhs.emplace(entry.meshHash, bvh);
+  }
+
+  file_ = std::move(file);
+  bvhs_ = std::move(bvhs);
+}
+
+std::string BulletBvhCache::getCacheFilename(
+    const std::string& collisionAssetHandle) {
+  // keep the extension, so stage.glb and stage.ply get different caches
+  return collisionAssetHandle + ".bvh";
+}
+
+uint64_t BulletBvhCache::hashMesh(const assets::CollisionMeshData& mesh,
+                                  const btVector3& scaling) {
+  uint64_t hash = 14695981039346656037ull;
+  const float scale[3]{float(scaling.x()), float(scaling.y()),
+                       float(scaling.z())};
+  hash = hashBytes(hash, scale, sizeof(scale));
+  const uint64_t numVertices = mesh.positions.size();
+  const uint64_t numIndices = mesh.indices.size();
+  hash = hashBytes(hash, &numVertices, sizeof(numVertices));
+  hash = hashBytes(hash, &numIndices, sizeof(numIndices));
+  hash = hashBytes(hash, mesh.positions.data(),
+                   numVertices * sizeof(Magnum::Vector3));
+  hash = hashBytes(hash, mesh.indices.data(),
+                   numIndices * sizeof(Magnum::UnsignedInt));
+  return hash;
+}
+
+btOptimizedBvh* BulletBvhCache::find(uint64_t meshHash) const {
+  auto found = bvhs_.find(meshHash);
+  return found != bvhs_.end() ? found->second : nullptr;
+}
+
+bool BulletBvhCache::save(
+    const std::string& filename,
+    const std::vector<std::pair<uint64_t, const btOptimizedBvh*>>& bvhs) {
+  std::vector<BvhCacheEntry> entries(bvhs.size());
+  size_t offset = alignOffset(sizeof(BvhCacheHeader) +
+                              bvhs.size() * sizeof(BvhCacheEntry));
+  for (size_t iBvh = 0; iBvh < bvhs.size(); ++iBvh) {
+    entries[iBvh].meshHash = bvhs[iBvh].first;
+    entries[iBvh].offset = offset;
+    entries[iBvh].size = bvhs[iBvh].second->calculateSerializeBufferSize();
+    offset = alignOffset(offset + entries[iBvh].size);
+  }
+
+  // Write to a temporary file first and then move it in place, the file may
+  // be the one currently mapped by this or another process
+  const std::string tmpFilename = io::uniqueTemporaryFilename(filename);
+  FILE* fp = fopen(tmpFilename.c_str(), "wb");
+  if (!fp)
+    return false;
+
+  const BvhCacheHeader header = makeHeader(bvhs.size());
+  bool written = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                 fwrite(entries.data(), sizeof(BvhCacheEntry), entries.size(),
+                        fp) == entries.size();
+  size_t writtenBytes =
+      sizeof(BvhCacheHeader) + entries.size() * sizeof(BvhCacheEntry);
+  for (size_t iBvh = 0; iBvh < bvhs.size() && written; ++iBvh) {
+    // serializeInPlace needs an aligned buffer
+    void* buffer = btAlignedAlloc(entries[iBvh].size, BVHCACHE_ALIGNMENT);
+    const char padding[BVHCACHE_ALIGNMENT]{};
+    written =
+        bvhs[iBvh].second->serializeInPlace(buffer, entries[iBvh].size,
+                                            false) &&
+        fwrite(padding, 1, entries[iBvh].offset - writtenBytes, fp) ==
+            entries[iBvh].offset - writtenBytes &&
+        fwrite(buffer, 1, entries[iBvh].size, fp) == entries[iBvh].size;
+    btAlignedFree(buffer);
+    writtenBytes = entries[iBvh].offset + entries[iBvh].size;
+  }
+  written = fclose(fp) == 0 && written;
+
+  if (!written || !io::replaceFile(tmpFilename, filename)) {
+    std::remove(tmpFilename.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace physics
+}  // namespace esp
@@ -0,0 +1,102 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_PHYSICS_BULLET_BULLETBVHCACHE_H_
+#define ESP_PHYSICS_BULLET_BULLETBVHCACHE_H_
+
+/** @file
+ * @brief Class @ref esp::physics::BulletBvhCache
+ */
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "esp/assets/CollisionMeshData.h"
+#include "esp/core/MappedFile.h"
+#include "esp/core/esp.h"
+
+class btOptimizedBvh;
+
+namespace esp {
+namespace physics {
+
+/**
+ * @brief Persistent cache of the quantized BVHs of static triangle mesh
+ * collision shapes, stored in a file next to the stage collision asset.
+ *
+ * Building a @ref btBvhTriangleMeshShape over a large stage is by far the
+ * most expensive part of loading its collision geometry. The BVHs are keyed
+ * by a hash of the mesh geometry and scaling they were built for, so a stale
+ * or foreign entry is never used. The cache file is memory mapped and the
+ * BVHs are deserialized in place, without copying the node arrays.
+ *
+ * The serialized BVHs are specific to the platform and Bullet build which
+ * wrote them; a cache from a different one is ignored and rewritten.
+ */
+class BulletBvhCache {
+ public:
+  /**
+   * @brief Map the cache file, if present and valid.
+   * @param filename The cache file.
+   */
+  explicit BulletBvhCache(const std::string& filename);
+
+  /**
+   * @brief The name of the cache file for a stage collision asset, the
+   * asset filename with .bvh appended.
+   */
+  static std::string getCacheFilename(const std::string& collisionAssetHandle);
+
+  /**
+   * @brief Hash the geometry a BVH is built over.
+   * @param mesh The triangle mesh.
+   * @param scaling The local scaling of the triangle mesh shape.
+   */
+  static uint64_t hashMesh(const assets::CollisionMeshData& mesh,
+                           const btVector3& scaling);
+
+  /**
+   * @brief Get the cached BVH of a mesh.
+   *
+   * The BVH lives in the mapped cache file and is not owned by the caller, it
+   * must not outlive this cache. See @ref
+   * btBvhTriangleMeshShape::setOptimizedBvh.
+   *
+   * @param meshHash The hash of the mesh, see @ref hashMesh.
+   * @return The BVH, or nullptr if not cached.
+   */
+  btOptimizedBvh* find(uint64_t meshHash) const;
+
+  /**
+   * @brief The number of cached BVHs.
+   */
+  size_t size() const { return bvhs_.size(); }
+
+  /**
+   * @brief Write a cache file.
+   * @param filename The cache file.
+   * @param bvhs The BVHs to store, with the hashes of their meshes.
+   * @return Whether the file was written.
+   */
+  static bool save(
+      const std::string& filename,
+      const std::vector<std::pair<uint64_t, const btOptimizedBvh*>>& bvhs);
+
+ private:
+  core::MappedFile::uptr file_ = nullptr;
+
+  std::map<uint64_t, btOptimizedBvh*> bvhs_;
+
+  ESP_SMART_POINTERS(BulletBvhCache)
+};
+
+}  // namespace physics
+}  // namespace esp
+
+#endif  // ESP_PHYSICS_BULLET_BULLETBVHCACHE_H_
@@ -0,0 +1,114 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "BulletCollisionShapeCache.h"
+
+#include <Magnum/BulletIntegration/Integration.h>
+
+#include "BulletCollision/CollisionShapes/btConvexHullShape.h"
+#include "esp/assets/ResourceManager.h"
+
+namespace esp {
+namespace physics {
+
+namespace {
+// Keep only the points which are vertices of the hull. Collision queries on
+// a btConvexHullShape are linear in its number of points, and collision meshes
+// typically have far more vertices than their hull.
+void simplifyConvexShape(btConvexHullShape& shape) {
+  if (shape.getNumPoints() == 0) {
+    return;
+  }
+  const std::vector<btVector3> points(
+      shape.getUnscaledPoints(),
+      shape.getUnscaledPoints() + shape.getNumPoints());
+  shape.optimizeConvexHull();
+  // Degenerate (e.g. collinear) point sets have no hull, keep them as is
+  if (shape.getNumPoints() == 0) {
+    for (const btVector3& point : points) {
+      shape.addPoint(point, false);
+    }
+  }
+}
+}  // namespace
+
+const BulletCollisionShapeCache::ConvexShapes&
+BulletCollisionShapeCache::getConvexShapes(
+    const assets::ResourceManager& resMgr,
+    const std::string& collisionAssetHandle,
+    const bool join,
+    const Magnum::Vector3& scaling) {
+  const Key key{collisionAssetHandle, join, scaling.x(), scaling.y(),
+                scaling.z()};
+  auto cached = convexShapes_.find(key);
+  if (cached != convexShapes_.end()) {
+    return cached->second;
+  }
+
+  const std::vector<assets::CollisionMeshData>& meshGroup =
+      resMgr.getCollisionMesh(collisionAssetHandle);
+  const assets::MeshMetaData& metaData =
+      resMgr.getMeshMetaData(collisionAssetHandle);
+
+  ConvexShapes shapes;
+  constructConvexShapesFromMeshes(Magnum::Matrix4{}, meshGroup, metaData.root,
+                                  join, shapes);
+  for (auto& shape : shapes) {
+    simplifyConvexShape(*shape);
+    shape->setLocalScaling(btVector3(scaling));
+    // Remove local convex margin in favor of margin on the containing
+    // compound
+    shape->setMargin(0.0);
+    shape->recalcLocalAabb();
+  }
+
+  return convexShapes_.emplace(key, std::move(shapes)).first->second;
+}
+
+std::shared_ptr<btConvexHullShape> BulletCollisionShapeCache::cloneConvexShape(
+    const btConvexHullShape& shape) {
+  auto clone = std::make_shared<btConvexHullShape>(
+      &shape.getUnscaledPoints()->getX(), shape.getNumPoints(),
+      sizeof(btVector3));
+  clone->setLocalScaling(shape.getLocalScaling());
+  clone->setMargin(shape.getMargin());
+  clone->recalcLocalAabb();
+  return clone;
+}
+
+// recursively create the convex mesh shapes in a flat manner by accumulating
+// transformations down the tree
+void BulletCollisionShapeCache::constructConvexShapesFromMeshes(
+    const Magnum::Matrix4& transformFromParentToWorld,
+    const std::vector<assets::CollisionMeshData>& meshGroup,
+    const assets::MeshTransformNode& node,
+    const bool join,
+    ConvexShapes& shapes) {
+  Magnum::Matrix4 transformFromLocalToWorld =
+      transformFromParentToWorld * node.transformFromLocalToParent;
+  if (node.meshIDLocal != ID_UNDEFINED) {
+    const assets::CollisionMeshData& mesh = meshGroup[node.meshIDLocal];
+
+    // when joining, add all points to a single convex instead of compounding
+    // (more stable)
+    if (!join || shapes.empty()) {
+      shapes.emplace_back(std::make_shared<btConvexHullShape>());
+    }
+
+    // transform points into object space, including any scale/shear in
+    // transformFromLocalToWorld.
+    for (auto& v : mesh.positions) {
+      shapes.back()->addPoint(
+          btVector3(transformFromLocalToWorld.transformPoint(v)), false);
+    }
+  }
+
+  for (auto& child : node.children) {
+    constructConvexShapesFromMeshes(transformFromLocalToWorld, meshGroup,
+                                    child, join, shapes);
+  }
+}  // constructConvexShapesFromMeshes
+
+}  // namespace physics
+}  // namespace esp
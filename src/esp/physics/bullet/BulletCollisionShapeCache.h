@@ -0,0 +1,117 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_PHYSICS_BULLET_BULLETCOLLISIONSHAPECACHE_H_
+#define ESP_PHYSICS_BULLET_BULLETCOLLISIONSHAPECACHE_H_
+
+/** @file
+ * @brief Class @ref esp::physics::BulletCollisionShapeCache
+ */
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Matrix4.h>
+#include <btBulletDynamicsCommon.h>
+
+#include "esp/assets/CollisionMeshData.h"
+#include "esp/assets/MeshMetaData.h"
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+class ResourceManager;
+}
+namespace physics {
+
+/**
+ * @brief Convex collision shapes built from collision mesh assets, shared
+ * between all @ref BulletRigidObject instances of the same asset.
+ *
+ * Shapes are keyed by collision asset handle, whether the sub-meshes are
+ * joined into a single convex and the scaling applied to them. Each set of
+ * hulls is built and reduced to its hull vertices once, then referenced as
+ * children of the per-instance @ref btCompoundShape. As @ref
+ * btCompoundShape::setLocalScaling scales its children in place, the scaling
+ * is baked into the shared hulls instead.
+ *
+ * Owned by @ref BulletPhysicsManager.
+ */
+class BulletCollisionShapeCache {
+ public:
+  typedef std::vector<std::shared_ptr<btConvexHullShape>> ConvexShapes;
+
+  /**
+   * @brief Get the convex shapes of a collision mesh asset, building them on
+   * first use.
+   *
+   * The shapes have zero margin, the margin is expected to be set on the
+   * containing compound. They must not be modified by their users, see @ref
+   * cloneConvexShape.
+   *
+   * @param resMgr The resource manager holding the collision asset.
+   * @param collisionAssetHandle The handle of the collision mesh asset.
+   * @param join Whether or not to join sub-meshes into a single convex shape,
+   * rather than creating individual convexes.
+   * @param scaling The local scaling of the shapes.
+   * @return The shared convex shapes, in object-local space.
+   */
+  const ConvexShapes& getConvexShapes(const assets::ResourceManager& resMgr,
+                                      const std::string& collisionAssetHandle,
+                                      bool join,
+                                      const Magnum::Vector3& scaling);
+
+  /**
+   * @brief Make an unshared copy of a convex shape, with the same points,
+   * scaling and margin.
+   */
+  static std::shared_ptr<btConvexHullShape> cloneConvexShape(
+      const btConvexHullShape& shape);
+
+  /**
+   * @brief The number of distinct (asset, join, scaling) entries built so
+   * far.
+   */
+  size_t size() const { return convexShapes_.size(); }
+
+  /**
+   * @brief Drop all cached shapes. Shapes still referenced by objects are
+   * kept alive by them.
+   */
+  void clear() { convexShapes_.clear(); }
+
+ private:
+  typedef std::tuple<std::string, bool, float, float, float> Key;
+
+  /**
+   * @brief Recursively construct convex hulls from the meshes of a @ref
+   * MeshTransformNode tree. Points are transformed to object-local space by
+   * accumulating transformations down the tree.
+   * @param transformFromParentToWorld The cumulative parent-to-world
+   * transformation matrix constructed by composition down the @ref
+   * MeshTransformNode tree to the current node.
+   * @param meshGroup Access structure for collision mesh data.
+   * @param node The current @ref MeshTransformNode in the recursion.
+   * @param join Whether or not to add all points to a single convex shape.
+   * @param shapes The constructed shapes.
+   */
+  static void constructConvexShapesFromMeshes(
+      const Magnum::Matrix4& transformFromParentToWorld,
+      const std::vector<assets::CollisionMeshData>& meshGroup,
+      const assets::MeshTransformNode& node,
+      bool join,
+      ConvexShapes& shapes);
+
+  std::map<Key, ConvexShapes> convexShapes_;
+
+  ESP_SMART_POINTERS(BulletCollisionShapeCache)
+};
+
+}  // namespace physics
+}  // namespace esp
+
+#endif  // ESP_PHYSICS_BULLET_BULLETCOLLISIONSHAPECACHE_H_
@@ -5,6 +5,12 @@
 //#include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 //#include "BulletCollision/Gimpact/btGImpactShape.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+
 #include "BulletPhysicsManager.h"
 #include "BulletRigidObject.h"
 #include "esp/assets/ResourceManager.h"
@@ -12,9 +18,68 @@
 namespace esp {
 namespace physics {
 
+namespace {
+// Exposes the time Bullet keeps between steps and interpolates the poses
+// over, which btDiscreteDynamicsWorld has no accessors for
+class BulletWorld : public btMultiBodyDynamicsWorld {
+ public:
+  using btMultiBodyDynamicsWorld::btMultiBodyDynamicsWorld;
+
+  btScalar getLocalTime() const { return m_localTime; }
+  void setLocalTime(btScalar localTime) { m_localTime = localTime; }
+};
+
+// Number of rays claimed at once by a worker of castRays
+const size_t RAYCAST_BATCH_SIZE = 64;
+
+// Tests a ray against the collision objects whose broadphase AABB it
+// overlaps. btCollisionWorld::rayTest traverses the broadphase with a stack
+// stored in the broadphase itself, while btDbvt::rayTest only reads the tree,
+// so rays can be cast from several threads at once.
+struct ConcurrentRayTester : public btDbvt::ICollide {
+  ConcurrentRayTester(const btVector3& from,
+                      const btVector3& to,
+                      btCollisionWorld::RayResultCallback& callback)
+      : from_(from), to_(to), callback_(callback) {
+    fromTransform_.setIdentity();
+    fromTransform_.setOrigin(from);
+    toTransform_.setIdentity();
+    toTransform_.setOrigin(to);
+  }
+
+  void rayTest(const btDbvtBroadphase& broadphase) {
+    // dynamic and static proxies are kept in separate trees
+    for (const btDbvt& tree : broadphase.m_sets) {
+      btDbvt::rayTest(tree.m_root, from_, to_, *this);
+    }
+  }
+
+  void Process(const btDbvtNode* leaf) override {
+    // a closest hit at the ray origin cannot be improved upon
+    if (callback_.m_closestHitFraction == btScalar(0)) {
+      return;
+    }
+    btBroadphaseProxy* proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+    if (!callback_.needsCollision(proxy)) {
+      return;
+    }
+    btCollisionObject* object =
+        static_cast<btCollisionObject*>(proxy->m_clientObject);
+    btCollisionWorld::rayTestSingle(fromTransform_, toTransform_, object,
+                                    object->getCollisionShape(),
+                                    object->getWorldTransform(), callback_);
+  }
+
+  btVector3 from_, to_;
+  btTransform fromTransform_, toTransform_;
+  btCollisionWorld::RayResultCallback& callback_;
+};
+}  // namespace
+
 BulletPhysicsManager::~BulletPhysicsManager() {
   LOG(INFO) << "Deconstructing BulletPhysicsManager";
 
+  velControlledObjects_.clear();
   existingObjects_.clear();
   staticStageObject_.reset(nullptr);
 }
@@ -25,13 +90,18 @@ bool BulletPhysicsManager::initPhysicsFinalize() {
   //! We can potentially use other collision checking algorithms, by
   //! uncommenting the line below
   // btGImpactCollisionAlgorithm::registerAlgorithm(&bDispatcher_);
-  bWorld_ = std::make_shared<btMultiBodyDynamicsWorld>(
-      &bDispatcher_, &bBroadphase_, &bSolver_, &bCollisionConfig_);
+  bWorld_ = std::make_shared<BulletWorld>(&bDispatcher_, &bBroadphase_,
+                                          &bSolver_, &bCollisionConfig_);
+  // only used when the solver randomizes its constraint order, fixed so runs
+  // can be reproduced
+  bSolver_.setRandSeed(physicsManagerAttributes_->getSolverSeed());
 
   debugDrawer_.setMode(
       Magnum::BulletIntegration::DebugDraw::Mode::DrawWireframe |
       Magnum::BulletIntegration::DebugDraw::Mode::DrawConstraints);
   bWorld_->setDebugDrawer(&debugDrawer_);
+  // collects the contact events after every substep
+  bWorld_->setInternalTickCallback(&contactTickCallback, this);
 
   // currently GLB meshes are y-up
   bWorld_->setGravity(btVector3(physicsManagerAttributes_->getVec3("gravity")));
@@ -58,7 +128,8 @@ bool BulletPhysicsManager::makeAndAddRigidObject(int newObjectID,
                                                  const std::string& handle,
                                                  scene::SceneNode* objectNode) {
   auto ptr = physics::BulletRigidObject::create_unique(
-      objectNode, newObjectID, bWorld_, collisionObjToObjIds_);
+      objectNode, newObjectID, bWorld_, collisionObjToObjIds_,
+      collisionShapeCache_);
   bool objSuccess = ptr->initialize(resourceManager_, handle);
   if (objSuccess) {
     existingObjects_.emplace(newObjectID, std::move(ptr));
@@ -119,48 +190,259 @@ void BulletPhysicsManager::stepPhysics(double dt) {
   if (!initialized_) {
     return;
   }
+  const auto start = std::chrono::steady_clock::now();
   if (dt <= 0) {
     dt = fixedTimeStep_;
   }
 
   // set specified control velocities
-  for (auto& objectItr : existingObjects_) {
-    VelocityControl::ptr velControl = objectItr.second->getVelocityControl();
-    if (objectItr.second->getMotionType() == MotionType::KINEMATIC) {
-      // kinematic velocity control intergration
-      if (velControl->controllingAngVel || velControl->controllingLinVel) {
-        objectItr.second->setRigidState(velControl->integrateTransform(
-            dt, objectItr.second->getRigidState()));
-        objectItr.second->setActive();
-      }
-    } else if (objectItr.second->getMotionType() == MotionType::DYNAMIC) {
-      if (velControl->controllingLinVel) {
-        if (velControl->linVelIsLocal) {
-          setLinearVelocity(objectItr.first,
-                            objectItr.second->node().rotation().transformVector(
-                                velControl->linVel));
+  updateVelControlledObjects();
+  for (RigidObject* object : velControlledObjects_) {
+    if (!object->isVelocityControlActive()) {
+      continue;
+    }
+    VelocityControl& velControl = object->getVelocityControlRef();
+    if (object->getMotionType() == MotionType::DYNAMIC) {
+      if (velControl.controllingLinVel) {
+        if (velControl.linVelIsLocal) {
+          object->setLinearVelocity(
+              object->node().rotation().transformVector(velControl.linVel));
         } else {
-          setLinearVelocity(objectItr.first, velControl->linVel);
+          object->setLinearVelocity(velControl.linVel);
         }
       }
-      if (velControl->controllingAngVel) {
-        if (velControl->angVelIsLocal) {
-          setAngularVelocity(
-              objectItr.first,
-              objectItr.second->node().rotation().transformVector(
-                  velControl->angVel));
+      if (velControl.controllingAngVel) {
+        if (velControl.angVelIsLocal) {
+          object->setAngularVelocity(
+              object->node().rotation().transformVector(velControl.angVel));
         } else {
-          setAngularVelocity(objectItr.first, velControl->angVel);
+          object->setAngularVelocity(velControl.angVel);
         }
       }
     }
   }
 
+  // the substeps this step takes, computed up front so kinematic objects
+  // move before stepping, and by the time actually simulated
+  int numSubStepsTaken = 0;
+  int numSubStepsDropped = 0;
+  const int maxSubSteps =
+      maxSubsteps_ > 0 ? maxSubsteps_ : std::numeric_limits<int>::max();
+  if (substepInterpolation_) {
+    // same arithmetic as btDiscreteDynamicsWorld::stepSimulation, which keeps
+    // the leftover time itself and drops the substeps over budget
+    const btScalar fixedTimeStep = fixedTimeStep_;
+    const btScalar localTime =
+        static_cast<BulletWorld&>(*bWorld_).getLocalTime() + btScalar(dt);
+    const int numSubSteps =
+        localTime >= fixedTimeStep ? int(localTime / fixedTimeStep) : 0;
+    numSubStepsTaken = std::min(numSubSteps, maxSubSteps);
+    numSubStepsDropped = numSubSteps - numSubStepsTaken;
+  } else {
+    // Deterministic mode: whole fixed substeps only, the leftover time is
+    // carried over to the next step and poses are never interpolated
+    numSubStepsTaken = takeSubsteps(dt);
+  }
+  const double simulatedTime = numSubStepsTaken * fixedTimeStep_;
+
+  // kinematic velocity control intergration
+  for (RigidObject* object : velControlledObjects_) {
+    if (object->isVelocityControlActive() &&
+        object->getMotionType() == MotionType::KINEMATIC) {
+      object->setRigidState(object->getVelocityControlRef().integrateTransform(
+          simulatedTime, object->getRigidState()));
+      object->setActive();
+    }
+  }
+
+  if (contactEventsEnabled_) {
+    // the pairs of the last step, collected anew by the substeps
+    std::swap(contactPairs_, prevContactPairs_);
+    contactPairs_.clear();
+  }
+
   // ==== Physics stepforward ======
   // NOTE: worldTime_ will always be a multiple of sceneMetaData_.timestep
-  int numSubStepsTaken =
-      bWorld_->stepSimulation(dt, /*maxSubSteps*/ 10000, fixedTimeStep_);
-  worldTime_ += numSubStepsTaken * fixedTimeStep_;
+  if (substepInterpolation_) {
+    bWorld_->stepSimulation(dt, maxSubSteps, fixedTimeStep_);
+    stepStats_.numDroppedSubsteps += numSubStepsDropped;
+  } else {
+    for (int i = 0; i < numSubStepsTaken; ++i) {
+      bWorld_->stepSimulation(fixedTimeStep_, 0);
+    }
+  }
+  worldTime_ += simulatedTime;
+
+  if (contactEventsEnabled_) {
+    updateContactEvents(numSubStepsTaken);
+  }
+
+  recordStep(numSubStepsTaken, std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
+}
+
+void BulletPhysicsManager::saveState(PhysicsState& state) {
+  PhysicsManager::saveState(state);
+  if (!initialized_) {
+    return;
+  }
+  if (substepInterpolation_) {
+    state.pendingTime = static_cast<BulletWorld&>(*bWorld_).getLocalTime();
+  }
+  state.solverSeed = bSolver_.getRandSeed();
+}
+
+bool BulletPhysicsManager::restoreState(const PhysicsState& state) {
+  const bool success = PhysicsManager::restoreState(state);
+  if (initialized_) {
+    if (substepInterpolation_) {
+      static_cast<BulletWorld&>(*bWorld_).setLocalTime(state.pendingTime);
+    }
+    bSolver_.setRandSeed(state.solverSeed);
+  }
+  return success;
+}
+
+void BulletPhysicsManager::contactTickCallback(btDynamicsWorld* world,
+                                               btScalar) {
+  auto* manager = static_cast<BulletPhysicsManager*>(world->getWorldUserInfo());
+  if (manager->contactEventsEnabled_) {
+    manager->collectContactPairs();
+  }
+}
+
+void BulletPhysicsManager::collectContactPairs() {
+  // the pairs of the previous substeps may have separated since
+  const size_t numPrevPairs = contactPairs_.size();
+  for (ContactPair& pair : contactPairs_) {
+    pair.touching = false;
+  }
+
+  // same walk over the manifolds as getNumActiveContactPoints
+  auto* dispatcher = bWorld_->getDispatcher();
+  for (int i = 0; i < dispatcher->getNumManifolds(); i++) {
+    auto* manifold = dispatcher->getManifoldByIndexInternal(i);
+    if (manifold->getNumContacts() == 0) {
+      continue;
+    }
+    auto objectId0 = collisionObjToObjIds_->find(
+        static_cast<const btCollisionObject*>(manifold->getBody0()));
+    auto objectId1 = collisionObjToObjIds_->find(
+        static_cast<const btCollisionObject*>(manifold->getBody1()));
+    // default to -1 for "scene collision"
+    int id0 = objectId0 != collisionObjToObjIds_->end() ? objectId0->second
+                                                        : -1;
+    int id1 = objectId1 != collisionObjToObjIds_->end() ? objectId1->second
+                                                        : -1;
+    if (id0 == id1) {
+      continue;
+    }
+
+    ContactPair pair{std::minmax(id0, id1), {}, -1, 0, true};
+    for (int j = 0; j < manifold->getNumContacts(); j++) {
+      const btManifoldPoint& point = manifold->getContactPoint(j);
+      const float impulse = point.getAppliedImpulse();
+      pair.impulse += impulse;
+      if (impulse > pair.pointImpulse) {
+        pair.pointImpulse = impulse;
+        pair.point = Magnum::Vector3{
+            (point.getPositionWorldOnA() + point.getPositionWorldOnB()) / 2};
+      }
+    }
+    contactPairs_.push_back(pair);
+  }
+  if (contactPairs_.size() == numPrevPairs) {
+    return;
+  }
+
+  // merge the manifolds of the same objects, e.g. of compound children, and
+  // the pairs of the previous substeps
+  std::sort(contactPairs_.begin(), contactPairs_.end(),
+            [](const ContactPair& a, const ContactPair& b) {
+              return a.objectIds < b.objectIds;
+            });
+  size_t numPairs = 0;
+  for (const ContactPair& pair : contactPairs_) {
+    if (numPairs > 0 &&
+        contactPairs_[numPairs - 1].objectIds == pair.objectIds) {
+      ContactPair& merged = contactPairs_[numPairs - 1];
+      merged.impulse += pair.impulse;
+      merged.touching = merged.touching || pair.touching;
+      if (pair.pointImpulse > merged.pointImpulse) {
+        merged.pointImpulse = pair.pointImpulse;
+        merged.point = pair.point;
+      }
+    } else {
+      contactPairs_[numPairs++] = pair;
+    }
+  }
+  contactPairs_.resize(numPairs);
+}
+
+void BulletPhysicsManager::updateContactEvents(int numSubsteps) {
+  if (numSubsteps == 0) {
+    // nothing was simulated, the manifolds still hold the contacts of the
+    // last substep, but no impulse was applied since
+    collectContactPairs();
+    for (ContactPair& pair : contactPairs_) {
+      pair.impulse = 0;
+    }
+  }
+
+  // diff against the previous step, both are sorted. Pairs which touched
+  // during the step but not after its last substep end now if they were
+  // touching before, otherwise they begin now and end during the next step.
+  contactEventBuffer_.clear();
+  auto current = contactPairs_.begin();
+  auto prev = prevContactPairs_.begin();
+  while (current != contactPairs_.end() || prev != prevContactPairs_.end()) {
+    if (prev == prevContactPairs_.end() ||
+        (current != contactPairs_.end() &&
+         current->objectIds < prev->objectIds)) {
+      contactEventBuffer_.push_back({ContactEventType::BEGIN, *current++});
+    } else if (current == contactPairs_.end() ||
+               prev->objectIds < current->objectIds) {
+      ContactPair ended = *prev++;
+      ended.impulse = 0;
+      contactEventBuffer_.push_back({ContactEventType::END, ended});
+    } else {
+      contactEventBuffer_.push_back({current->touching
+                                         ? ContactEventType::PERSIST
+                                         : ContactEventType::END,
+                                     *current++});
+      ++prev;
+    }
+  }
+
+  // the pairs which did not end are diffed against by the next step
+  contactPairs_.clear();
+  const int numEvents = contactEventBuffer_.size();
+  contactEvents_.types.resize(numEvents);
+  contactEvents_.objectIdsA.resize(numEvents);
+  contactEvents_.objectIdsB.resize(numEvents);
+  contactEvents_.points.resize(numEvents, 3);
+  contactEvents_.impulses.resize(numEvents);
+  for (int i = 0; i < numEvents; ++i) {
+    const ContactEvent& event = contactEventBuffer_[i];
+    const ContactPair& pair = event.pair;
+    contactEvents_.types[i] = static_cast<int>(event.type);
+    contactEvents_.objectIdsA[i] = pair.objectIds.first;
+    contactEvents_.objectIdsB[i] = pair.objectIds.second;
+    contactEvents_.points.row(i) << pair.point.x(), pair.point.y(),
+        pair.point.z();
+    contactEvents_.impulses[i] = pair.impulse;
+    if (event.type != ContactEventType::END) {
+      contactPairs_.push_back(pair);
+    }
+  }
+}
+
+void BulletPhysicsManager::resetContactEvents() {
+  PhysicsManager::resetContactEvents();
+  contactPairs_.clear();
+  prevContactPairs_.clear();
+  contactEventBuffer_.clear();
 }
 
 void BulletPhysicsManager::setMargin(const int physObjectID,
@@ -257,6 +539,126 @@ RaycastResults BulletPhysicsManager::castRay(const esp::geo::Ray& ray,
   return results;
 }
 
+BatchedRaycastResults BulletPhysicsManager::castRays(
+    const std::vector<esp::geo::Ray>& rays,
+    double maxDistance,
+    bool closestOnly) {
+  const size_t numRays = rays.size();
+  // Bindings call this with the GIL released, the pool must not be replaced
+  // while another caller uses it
+  std::lock_guard<std::mutex> lock{raycastMutex_};
+  const size_t numThreads = numRaycastThreads_ > 0
+                                ? numRaycastThreads_
+                                : core::ThreadPool::hardwareConcurrency();
+  if (!raycastThreadPool_ || raycastThreadPool_->numThreads() != numThreads) {
+    raycastThreadPool_ = std::make_unique<core::ThreadPool>(numThreads);
+  }
+
+  // hits of every ray, or only its closest hit to avoid collecting all of
+  // them
+  std::vector<std::vector<RayHitInfo>> allHits(closestOnly ? 0 : numRays);
+  std::vector<RayHitInfo> closestHits(closestOnly ? numRays : 0);
+  std::vector<char> hasClosestHit(closestOnly ? numRays : 0, 0);
+
+  const auto makeHit = [&](const btCollisionObject* object,
+                           const btVector3& point, const btVector3& normal,
+                           btScalar hitFraction, double rayLength) {
+    RayHitInfo hit;
+    hit.normal = Magnum::Vector3{normal};
+    hit.point = Magnum::Vector3{point};
+    hit.rayDistance = (hitFraction * maxDistance) / rayLength;
+    // default to -1 for "scene collision" if we don't know which object was
+    // involved
+    auto objectId = collisionObjToObjIds_->find(object);
+    hit.objectId =
+        objectId != collisionObjToObjIds_->end() ? objectId->second : -1;
+    return hit;
+  };
+
+  std::atomic<bool> hasZeroLengthRay{false};
+  const size_t numBatches =
+      (numRays + RAYCAST_BATCH_SIZE - 1) / RAYCAST_BATCH_SIZE;
+  raycastThreadPool_->parallelFor(numBatches, [&](size_t batch, size_t) {
+    const size_t end = std::min(numRays, (batch + 1) * RAYCAST_BATCH_SIZE);
+    for (size_t i = batch * RAYCAST_BATCH_SIZE; i < end; ++i) {
+      const esp::geo::Ray& ray = rays[i];
+      const double rayLength = ray.direction.length();
+      if (rayLength == 0) {
+        hasZeroLengthRay = true;
+        continue;
+      }
+      btVector3 from(ray.origin);
+      btVector3 to(ray.origin + ray.direction * maxDistance);
+
+      if (closestOnly) {
+        btCollisionWorld::ClosestRayResultCallback closest(from, to);
+        ConcurrentRayTester(from, to, closest).rayTest(bBroadphase_);
+        if (closest.hasHit()) {
+          hasClosestHit[i] = 1;
+          closestHits[i] = makeHit(
+              closest.m_collisionObject, closest.m_hitPointWorld,
+              closest.m_hitNormalWorld, closest.m_closestHitFraction,
+              rayLength);
+        }
+      } else {
+        btCollisionWorld::AllHitsRayResultCallback all(from, to);
+        ConcurrentRayTester(from, to, all).rayTest(bBroadphase_);
+        std::vector<RayHitInfo>& hits = allHits[i];
+        hits.reserve(all.m_hitPointWorld.size());
+        for (int j = 0; j < all.m_hitPointWorld.size(); ++j) {
+          hits.push_back(makeHit(all.m_collisionObjects[j],
+                                 all.m_hitPointWorld[j],
+                                 all.m_hitNormalWorld[j],
+                                 all.m_hitFractions[j], rayLength));
+        }
+        std::sort(hits.begin(), hits.end(),
+                  [](const RayHitInfo& A, const RayHitInfo& B) {
+                    return A.rayDistance < B.rayDistance;
+                  });
+      }
+    }
+  });
+  if (hasZeroLengthRay) {
+    LOG(ERROR) << "BulletPhysicsManager::castRays : Cannot cast rays with zero "
+                  "length, they have no hits.";
+  }
+
+  // flatten the hits
+  BatchedRaycastResults results;
+  results.hitOffsets.resize(numRays + 1);
+  int numHits = 0;
+  for (size_t i = 0; i < numRays; ++i) {
+    results.hitOffsets[i] = numHits;
+    numHits += closestOnly ? int(hasClosestHit[i]) : int(allHits[i].size());
+  }
+  results.hitOffsets[numRays] = numHits;
+
+  results.objectIds.resize(numHits);
+  results.points.resize(numHits, 3);
+  results.normals.resize(numHits, 3);
+  results.rayDistances.resize(numHits);
+  const auto storeHit = [&results](int row, const RayHitInfo& hit) {
+    results.objectIds[row] = hit.objectId;
+    results.points.row(row) << hit.point.x(), hit.point.y(), hit.point.z();
+    results.normals.row(row) << hit.normal.x(), hit.normal.y(),
+        hit.normal.z();
+    results.rayDistances[row] = hit.rayDistance;
+  };
+  for (size_t i = 0; i < numRays; ++i) {
+    int row = results.hitOffsets[i];
+    if (closestOnly) {
+      if (hasClosestHit[i]) {
+        storeHit(row, closestHits[i]);
+      }
+    } else {
+      for (const RayHitInfo& hit : allHits[i]) {
+        storeHit(row++, hit);
+      }
+    }
+  }
+  return results;
+}
+
 int BulletPhysicsManager::getNumActiveContactPoints() {
   int pointCount = 0;
   auto* dispatcher = bWorld_->getDispatcher();
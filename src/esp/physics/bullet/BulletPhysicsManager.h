@@ -9,6 +9,8 @@
  * @brief Class @ref esp::physics::BulletPhysicsManager
  */
 
+#include <mutex>
+
 /* Bullet Physics Integration */
 #include <Magnum/BulletIntegration/DebugDraw.h>
 #include <Magnum/BulletIntegration/Integration.h>
@@ -18,8 +20,10 @@
 #include "BulletDynamics/Featherstone/btMultiBodyConstraintSolver.h"
 #include "BulletDynamics/Featherstone/btMultiBodyDynamicsWorld.h"
 
+#include "BulletCollisionShapeCache.h"
 #include "BulletRigidObject.h"
 #include "BulletRigidStage.h"
+#include "esp/core/ThreadPool.h"
 #include "esp/physics/PhysicsManager.h"
 #include "esp/physics/bullet/BulletRigidObject.h"
 
@@ -56,6 +60,7 @@ class BulletPhysicsManager : public PhysicsManager {
       : PhysicsManager(_resourceManager, _physicsManagerAttributes) {
     collisionObjToObjIds_ =
         std::make_shared<std::map<const btCollisionObject*, int>>();
+    collisionShapeCache_ = BulletCollisionShapeCache::create();
   };
 
   /** @brief Destructor which destructs necessary Bullet physics structures.*/
@@ -64,12 +69,24 @@ class BulletPhysicsManager : public PhysicsManager {
   //============ Simulator functions =============
 
   /** @brief Step the physical world forward in time. Time may only advance in
-   * increments of @ref fixedTimeStep_. See @ref
+   * increments of @ref fixedTimeStep_, at most @ref maxSubsteps_ of them.
+   * Kinematic objects under velocity control move before stepping, by the
+   * time the substeps will simulate. See @ref
    * btMultiBodyDynamicsWorld::stepSimulation.
    * @param dt The desired amount of time to advance the physical world.
    */
   void stepPhysics(double dt) override;
 
+  /** @brief Also saves the time Bullet interpolates the poses over, and the
+   * seed of the solver. See @ref PhysicsManager::saveState.
+   */
+  void saveState(PhysicsState& state) override;
+
+  /** @brief Also restores the time Bullet interpolates the poses over, and
+   * the seed of the solver. See @ref PhysicsManager::restoreState.
+   */
+  bool restoreState(const PhysicsState& state) override;
+
   /** @brief Set the gravity of the physical world.
    * @param gravity The desired gravity force of the physical world.
    */
@@ -184,6 +201,26 @@ class BulletPhysicsManager : public PhysicsManager {
   virtual RaycastResults castRay(const esp::geo::Ray& ray,
                                  double maxDistance = 100.0) override;
 
+  /**
+   * @brief Cast a batch of rays into the collision world.
+   *
+   * The rays are distributed across @ref getNumRaycastThreads threads. Each
+   * ray traverses the broadphase trees on its own stack, so unlike @ref
+   * btCollisionWorld::rayTest rays can be cast concurrently. The collision
+   * world must not be modified during the call.
+   *
+   * @param rays The rays to cast. Need not be unit length, but returned hit
+   * distances will be in units of ray length.
+   * @param maxDistance The maximum distance along the ray directions to
+   * search. In units of ray length.
+   * @param closestOnly Whether to only report the closest hit of each ray,
+   * which avoids collecting every hit along the ray.
+   * @return The hits of all rays, sorted by distance for each ray.
+   */
+  BatchedRaycastResults castRays(const std::vector<esp::geo::Ray>& rays,
+                                 double maxDistance = 100.0,
+                                 bool closestOnly = false) override;
+
   // The number of contact points that were active during the last step. An
   // object resting on another object will involve several active contact
   // points. Once both objects are asleep, the contact points are inactive. This
@@ -191,6 +228,15 @@ class BulletPhysicsManager : public PhysicsManager {
   // in the current scene.
   int getNumActiveContactPoints() override;
 
+  /**
+   * @brief The number of distinct convex collision shape sets shared between
+   * objects, one per collision asset, join mode and scaling in use. See @ref
+   * BulletCollisionShapeCache.
+   */
+  size_t getNumCachedCollisionShapes() const {
+    return collisionShapeCache_->size();
+  }
+
  protected:
   //============ Initialization =============
   /**
@@ -241,6 +287,44 @@ class BulletPhysicsManager : public PhysicsManager {
   std::shared_ptr<std::map<const btCollisionObject*, int>>
       collisionObjToObjIds_;
 
+  //! Convex collision shapes shared by all objects built from the same
+  //! collision asset
+  BulletCollisionShapeCache::ptr collisionShapeCache_;
+
+  //! Workers of @ref castRays, created on first use
+  std::unique_ptr<core::ThreadPool> raycastThreadPool_ = nullptr;
+  //! Held by @ref castRays while it creates and uses raycastThreadPool_
+  std::mutex raycastMutex_;
+
+  //! A pair of objects in contact, see @ref updateContactEvents
+  struct ContactPair {
+    //! The object ids, smaller first
+    std::pair<int, int> objectIds;
+    //! The contact point with the largest impulse
+    Magnum::Vector3 point;
+    //! The impulse at @ref point
+    float pointImpulse;
+    //! The total impulse between the objects
+    float impulse;
+    //! Whether the objects still touch after the latest substep
+    bool touching;
+  };
+
+  //! The pairs of objects in contact during the current or last step and
+  //! the ones reported as touching by the step before, sorted by object ids
+  std::vector<ContactPair> contactPairs_, prevContactPairs_;
+
+  //! A change of contact, see @ref updateContactEvents
+  struct ContactEvent {
+    ContactEventType type;
+    ContactPair pair;
+  };
+
+  //! The events of the last step, kept to reuse its storage
+  std::vector<ContactEvent> contactEventBuffer_;
+
+  void resetContactEvents() override;
+
  private:
   /** @brief Check if a particular mesh can be used as a collision mesh for
    * Bullet.
@@ -251,6 +335,25 @@ class BulletPhysicsManager : public PhysicsManager {
    */
   bool isMeshPrimitiveValid(const assets::CollisionMeshData& meshData) override;
 
+  /**
+   * @brief Merge the contact manifolds of the dispatcher into
+   * @ref contactPairs_, called after each substep. Objects are in contact
+   * while their manifolds hold points, i.e. within the contact breaking
+   * threshold of each other.
+   */
+  void collectContactPairs();
+
+  /** @brief Bullet internal tick callback calling @ref collectContactPairs
+   * of the manager set as world user info. */
+  static void contactTickCallback(btDynamicsWorld* world, btScalar timeStep);
+
+  /**
+   * @brief Fill @ref contactEvents_ from the pairs collected during a step
+   * by diffing them against the pairs of the step before.
+   * @param numSubsteps The number of substeps simulated by the step.
+   */
+  void updateContactEvents(int numSubsteps);
+
   ESP_SMART_POINTERS(BulletPhysicsManager)
 
 };  // end class BulletPhysicsManager
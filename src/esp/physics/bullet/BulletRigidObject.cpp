@@ -34,10 +34,12 @@ BulletRigidObject::BulletRigidObject(
     int objectId,
     std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
     std::shared_ptr<std::map<const btCollisionObject*, int> >
-        collisionObjToObjIds)
+        collisionObjToObjIds,
+    std::shared_ptr<BulletCollisionShapeCache> collisionShapeCache)
     : BulletBase(bWorld, collisionObjToObjIds),
       RigidObject(rigidBodyNode, objectId),
-      MotionState(*rigidBodyNode) {}
+      MotionState(*rigidBodyNode),
+      collisionShapeCache_(collisionShapeCache) {}
 
 BulletRigidObject::~BulletRigidObject() {
   if (!isActive()) {
@@ -93,33 +95,35 @@ bool BulletRigidObject::initialization_LibSpecific(
     bObjectShape_->addChildShape(btTransform::getIdentity(),
                                  bGenericShapes_.back().get());
     bObjectShape_->recalculateLocalAabb();
-  } else {
+    bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
+  } else if (!usingBBCollisionShape_) {
     // mesh collider
-    const std::vector<assets::CollisionMeshData>& meshGroup =
-        resMgr.getCollisionMesh(collisionAssetHandle);
-    const assets::MeshMetaData& metaData =
-        resMgr.getMeshMetaData(collisionAssetHandle);
-
-    if (!usingBBCollisionShape_) {
-      constructBulletCompoundFromMeshes(Magnum::Matrix4{}, meshGroup,
-                                        metaData.root, joinCollisionMeshes);
-
-      // add the final object after joining meshes
-      if (joinCollisionMeshes) {
-        bObjectConvexShapes_.back()->setLocalScaling(
-            btVector3(tmpAttr->getCollisionAssetSize()));
-        bObjectConvexShapes_.back()->setMargin(0.0);
-        bObjectConvexShapes_.back()->recalcLocalAabb();
-        bObjectShape_->addChildShape(btTransform::getIdentity(),
-                                     bObjectConvexShapes_.back().get());
-      }
+    // The convex shapes are shared with every other object built from the
+    // same collision asset. btCompoundShape::setLocalScaling would rescale
+    // them in place, so the scaling is baked into the shared shapes instead.
+    Magnum::Vector3 scaling = tmpAttr->getScale();
+    if (joinCollisionMeshes) {
+      scaling *= tmpAttr->getCollisionAssetSize();
+    }
+    // Preprocessed collision hulls already reflect joinCollisionMeshes, each
+    // of them is kept as a separate convex
+    const std::string collisionMeshHandle =
+        resMgr.getObjectCollisionMeshHandle(*tmpAttr);
+    const bool joinShapes =
+        joinCollisionMeshes && collisionMeshHandle == collisionAssetHandle;
+    bObjectConvexShapes_ = collisionShapeCache_->getConvexShapes(
+        resMgr, collisionMeshHandle, joinShapes, scaling);
+    for (auto& convexShape : bObjectConvexShapes_) {
+      //! Add to compound shape stucture
+      bObjectShape_->addChildShape(btTransform::getIdentity(),
+                                   convexShape.get());
     }
+  } else {
+    bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
   }  // if using prim collider else use mesh collider
 
   //! Set properties
   bObjectShape_->setMargin(margin);
-
-  bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
   bObjectShape_->recalculateLocalAabb();
   // create the bObjectRigidBody_
   constructAndAddRigidBody(objectMotionType_);
@@ -201,61 +205,6 @@ BulletRigidObject::buildPrimitiveCollisionObject(int primTypeVal,
   return obj;
 }  // buildPrimitiveCollisionObject
 
-// recursively create the convex mesh shapes and add them to the compound in a
-// flat manner by accumulating transformations down the tree
-void BulletRigidObject::constructBulletCompoundFromMeshes(
-    const Magnum::Matrix4& transformFromParentToWorld,
-    const std::vector<assets::CollisionMeshData>& meshGroup,
-    const assets::MeshTransformNode& node,
-    bool join) {
-  Magnum::Matrix4 transformFromLocalToWorld =
-      transformFromParentToWorld * node.transformFromLocalToParent;
-  if (node.meshIDLocal != ID_UNDEFINED) {
-    // This node has a mesh, so add it to the compound
-
-    const assets::CollisionMeshData& mesh = meshGroup[node.meshIDLocal];
-
-    if (join) {
-      // add all points to a single convex instead of compounding (more
-      // stable)
-      if (bObjectConvexShapes_.empty()) {
-        // create the convex if it does not exist
-        bObjectConvexShapes_.emplace_back(
-            std::make_unique<btConvexHullShape>());
-      }
-
-      // add points
-      for (auto& v : mesh.positions) {
-        bObjectConvexShapes_.back()->addPoint(
-            btVector3(transformFromLocalToWorld.transformPoint(v)), false);
-      }
-
-    } else {
-      bObjectConvexShapes_.emplace_back(std::make_unique<btConvexHullShape>());
-      // transform points into world space, including any scale/shear in
-      // transformFromLocalToWorld.
-      for (auto& v : mesh.positions) {
-        bObjectConvexShapes_.back()->addPoint(
-            btVector3(transformFromLocalToWorld.transformPoint(v)), false);
-      }
-      // bObjectConvexShapes_.back()->optimizeConvexHull();
-      // bObjectConvexShapes_.back()->initializePolyhedralFeatures();
-      // Remove local convex margin in favor of margin on the containing
-      // compound
-      bObjectConvexShapes_.back()->setMargin(0.0);
-      bObjectConvexShapes_.back()->recalcLocalAabb();
-      //! Add to compound shape stucture
-      bObjectShape_->addChildShape(btTransform::getIdentity(),
-                                   bObjectConvexShapes_.back().get());
-    }
-  }
-
-  for (auto& child : node.children) {
-    constructBulletCompoundFromMeshes(transformFromLocalToWorld, meshGroup,
-                                      child, join);
-  }
-}  // constructBulletCompoundFromMeshes
-
 void BulletRigidObject::setCollisionFromBB() {
   btVector3 dim(node().getCumulativeBB().size() / 2.0);
 
@@ -280,6 +229,30 @@ void BulletRigidObject::setCollisionFromBB() {
   }
 }  // setCollisionFromBB
 
+void BulletRigidObject::setMargin(const double margin) {
+  for (std::size_t i = 0; i < bObjectConvexShapes_.size(); i++) {
+    if (bObjectConvexShapes_[i].use_count() > 1) {
+      // copy on write, the shape is shared with other objects and the cache
+      auto uniqueShape =
+          BulletCollisionShapeCache::cloneConvexShape(*bObjectConvexShapes_[i]);
+      for (int iChild = 0; iChild < bObjectShape_->getNumChildShapes();
+           ++iChild) {
+        if (bObjectShape_->getChildShape(iChild) ==
+            bObjectConvexShapes_[i].get()) {
+          const btTransform childTransform =
+              bObjectShape_->getChildTransform(iChild);
+          bObjectShape_->removeChildShapeByIndex(iChild);
+          bObjectShape_->addChildShape(childTransform, uniqueShape.get());
+          break;
+        }
+      }
+      bObjectConvexShapes_[i] = std::move(uniqueShape);
+    }
+    bObjectConvexShapes_[i]->setMargin(margin);
+  }
+  bObjectShape_->setMargin(margin);
+}  // setMargin
+
 bool BulletRigidObject::setMotionType(MotionType mt) {
   if (mt == MotionType::UNDEFINED) {
     return false;
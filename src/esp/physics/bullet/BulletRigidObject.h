@@ -22,6 +22,7 @@
 
 #include "esp/physics/RigidObject.h"
 #include "esp/physics/bullet/BulletBase.h"
+#include "esp/physics/bullet/BulletCollisionShapeCache.h"
 
 namespace esp {
 namespace physics {
@@ -42,12 +43,16 @@ class BulletRigidObject : public BulletBase,
    * @brief Constructor for a @ref BulletRigidObject.
    * @param rigidBodyNode The @ref scene::SceneNode this feature will be
    * attached to.
+   * @param collisionShapeCache The convex shapes shared with other objects
+   * built from the same collision asset.
    */
-  BulletRigidObject(scene::SceneNode* rigidBodyNode,
-                    int objectId,
-                    std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
-                    std::shared_ptr<std::map<const btCollisionObject*, int>>
-                        collisionObjToObjIds);
+  BulletRigidObject(
+      scene::SceneNode* rigidBodyNode,
+      int objectId,
+      std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
+      std::shared_ptr<std::map<const btCollisionObject*, int>>
+          collisionObjToObjIds,
+      std::shared_ptr<BulletCollisionShapeCache> collisionShapeCache);
 
   /**
    * @brief Destructor cleans up simulation structures for the object.
@@ -73,25 +78,6 @@ class BulletRigidObject : public BulletBase,
       double halfLength);
   // const assets::AbstractPrimitiveAttributes& primAttributes);
 
-  /**
-   * @brief Recursively construct a @ref btCompoundShape for collision from
-   * loaded mesh assets. A @ref btConvexHullShape is constructed for each
-   * sub-component, transformed to object-local space and added to the compound
-   * in a flat manner for efficiency.
-   * @param transformFromParentToWorld The cumulative parent-to-world
-   * transformation matrix constructed by composition down the @ref
-   * MeshTransformNode tree to the current node.
-   * @param meshGroup Access structure for collision mesh data.
-   * @param node The current @ref MeshTransformNode in the recursion.
-   * @param join Whether or not to join sub-meshes into a single con convex
-   * shape, rather than creating individual convexes under the compound.
-   */
-  void constructBulletCompoundFromMeshes(
-      const Magnum::Matrix4& transformFromParentToWorld,
-      const std::vector<assets::CollisionMeshData>& meshGroup,
-      const assets::MeshTransformNode& node,
-      bool join);
-
   /**
    * @brief Check whether object is being actively simulated, or sleeping.
    * See @ref btCollisionObject::isActive.
@@ -105,6 +91,32 @@ class BulletRigidObject : public BulletBase,
    */
   void setActive() override { bObjectRigidBody_->activate(true); }
 
+  /**
+   * @brief Get the activation state of the object. See @ref
+   * btCollisionObject::getActivationState.
+   */
+  int getActivationState() const override {
+    return bObjectRigidBody_->getActivationState();
+  }
+
+  /**
+   * @brief Get the time the object has been at rest. See @ref
+   * btCollisionObject::getDeactivationTime.
+   */
+  float getDeactivationTime() const override {
+    return bObjectRigidBody_->getDeactivationTime();
+  }
+
+  /**
+   * @brief Restore the activation state of the object. See @ref
+   * btCollisionObject::forceActivationState.
+   */
+  void setActivationState(int activationState,
+                          float deactivationTime) override {
+    bObjectRigidBody_->forceActivationState(activationState);
+    bObjectRigidBody_->setDeactivationTime(deactivationTime);
+  }
+
   /**
    * @brief Set the @ref MotionType of the object. The object can be set to @ref
    * MotionType::STATIC, @ref MotionType::KINEMATIC or @ref MotionType::DYNAMIC.
@@ -380,15 +392,11 @@ class BulletRigidObject : public BulletBase,
   }
 
   /** @brief Set the scalar collision margin of an object. See @ref
-   * btCompoundShape::setMargin.
+   * btCompoundShape::setMargin. Convex shapes shared with other objects are
+   * copied first so the change only affects this object.
    * @param margin The new scalar collision margin of the object.
    */
-  void setMargin(const double margin) override {
-    for (std::size_t i = 0; i < bObjectConvexShapes_.size(); i++) {
-      bObjectConvexShapes_[i]->setMargin(margin);
-    }
-    bObjectShape_->setMargin(margin);
-  }
+  void setMargin(const double margin) override;
 
   /** @brief Sets the object's collision shape to its bounding box.
    * Since the bounding hierarchy is not constructed when the object is
@@ -456,8 +464,13 @@ class BulletRigidObject : public BulletBase,
   //! If true, the object's bounding box will be used for collision once
   //! computed
   bool usingBBCollisionShape_ = false;
-  //! Object data: Composite convex collision shape
-  std::vector<std::unique_ptr<btConvexHullShape>> bObjectConvexShapes_;
+  //! Object data: Composite convex collision shape. Shared with other
+  //! objects built from the same collision asset, see @ref
+  //! BulletCollisionShapeCache.
+  BulletCollisionShapeCache::ConvexShapes bObjectConvexShapes_;
+
+  //! Where @ref bObjectConvexShapes_ come from
+  std::shared_ptr<BulletCollisionShapeCache> collisionShapeCache_;
 
   //! list of @ref btCollisionShape for storing arbitrary collision shapes
   //! referenced within the @ref bObjectShape_.
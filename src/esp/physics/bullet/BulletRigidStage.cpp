@@ -8,6 +8,7 @@
 #include "BulletCollision/CollisionShapes/btCompoundShape.h"
 #include "BulletCollision/CollisionShapes/btConvexHullShape.h"
 #include "BulletCollision/CollisionShapes/btConvexTriangleMeshShape.h"
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
 #include "BulletCollision/Gimpact/btGImpactShape.h"
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "BulletRigidStage.h"
@@ -40,7 +41,29 @@ bool BulletRigidStage::initialization_LibSpecific(
   const assets::MeshMetaData& metaData =
       resMgr.getMeshMetaData(collisionAssetHandle);
 
+  const std::string bvhCacheFilename =
+      BulletBvhCache::getCacheFilename(collisionAssetHandle);
+  bvhCache_ = std::make_unique<BulletBvhCache>(bvhCacheFilename);
+
   constructBulletSceneFromMeshes(Magnum::Matrix4{}, meshGroup, metaData.root);
+
+  // rewrite the cache if any BVH had to be built
+  bool builtBvh = false;
+  for (auto& shape : bStageShapes_) {
+    builtBvh = builtBvh || shape->getOwnsBvh();
+  }
+  if (builtBvh) {
+    std::vector<std::pair<uint64_t, const btOptimizedBvh*>> bvhs;
+    for (size_t iShape = 0; iShape < bStageShapes_.size(); ++iShape) {
+      bvhs.emplace_back(bStageMeshHashes_[iShape],
+                        bStageShapes_[iShape]->getOptimizedBvh());
+    }
+    if (!BulletBvhCache::save(bvhCacheFilename, bvhs)) {
+      LOG(WARNING) << "BulletRigidStage::initialization_LibSpecific : "
+                      "Unable to write BVH cache "
+                   << bvhCacheFilename;
+    }
+  }
   for (auto& object : bStaticCollisionObjects_) {
     object->setFriction(initializationAttributes_->getFrictionCoefficient());
     object->setRestitution(
@@ -90,16 +113,25 @@ void BulletRigidStage::constructBulletSceneFromMeshes(
     //! Embed 3D mesh into bullet shape
     //! btBvhTriangleMeshShape is the most generic/slow choice
     //! which allows concavity if the object is static
+    //! The BVH depends on the scaling but not on the margin, so it is built
+    //! (or taken from the cache) once the scaling is known.
     std::unique_ptr<btBvhTriangleMeshShape> meshShape =
         std::make_unique<btBvhTriangleMeshShape>(indexedVertexArray.get(),
-                                                 true);
+                                                 true, /*buildBvh*/ false);
     meshShape->setMargin(initializationAttributes_->getMargin());
-    meshShape->setLocalScaling(
-        btVector3{transformFromLocalToWorld
-                      .scaling()});  // scale is a property of the shape
-
-    // re-build the bvh after setting margin
-    meshShape->buildOptimizedBvh();
+    // scale is a property of the shape
+    const btVector3 scaling{transformFromLocalToWorld.scaling()};
+    const uint64_t meshHash = BulletBvhCache::hashMesh(mesh, scaling);
+    btOptimizedBvh* cachedBvh = bvhCache_ ? bvhCache_->find(meshHash) : nullptr;
+    if (cachedBvh) {
+      meshShape->setOptimizedBvh(cachedBvh, scaling);
+    } else {
+      // only builds the bvh if the scaling changes
+      meshShape->setLocalScaling(scaling);
+      if (!meshShape->getOptimizedBvh()) {
+        meshShape->buildOptimizedBvh();
+      }
+    }
     // mass == 0 to indicate static. See isStaticObject assert below. See also
     // examples/MultiThreadedDemo/CommonRigidBodyMTBase.h
     btVector3 localInertia(0, 0, 0);
@@ -112,6 +144,7 @@ void BulletRigidStage::constructBulletSceneFromMeshes(
         std::make_unique<btRigidBody>(cInfo);
     ASSERT(sceneCollisionObject->isStaticObject());
     bStageArrays_.emplace_back(std::move(indexedVertexArray));
+    bStageMeshHashes_.push_back(meshHash);
     bStageShapes_.emplace_back(std::move(meshShape));
     bStaticCollisionObjects_.emplace_back(std::move(sceneCollisionObject));
   }
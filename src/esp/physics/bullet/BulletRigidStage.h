@@ -7,6 +7,7 @@
 
 #include "esp/physics/RigidStage.h"
 #include "esp/physics/bullet/BulletBase.h"
+#include "esp/physics/bullet/BulletBvhCache.h"
 
 /** @file
  * @brief Class @ref esp::physics::BulletRigidStage
@@ -50,6 +51,9 @@ class BulletRigidStage : public BulletBase, public RigidStage {
    * MeshTransformNode tree to the current node.
    * @param meshGroup Access structure for collision mesh data.
    * @param node The current @ref MeshTransformNode in the recursion.
+   *
+   * The BVH of each mesh shape is taken from @ref bvhCache_ when cached,
+   * and built otherwise.
    */
   void constructBulletSceneFromMeshes(
       const Magnum::Matrix4& transformFromParentToWorld,
@@ -96,6 +100,13 @@ class BulletRigidStage : public BulletBase, public RigidStage {
   //! Stage data: Bullet triangular mesh vertices
   std::vector<std::unique_ptr<btTriangleIndexVertexArray>> bStageArrays_;
 
+  //! Stage data: serialized BVHs of the mesh shapes. Declared before the
+  //! shapes, which may reference its BVHs, so that it outlives them.
+  std::unique_ptr<BulletBvhCache> bvhCache_ = nullptr;
+
+  //! Stage data: BVH cache key of each mesh shape
+  std::vector<uint64_t> bStageMeshHashes_;
+
   //! Stage data: Bullet triangular mesh shape
   std::vector<std::unique_ptr<btBvhTriangleMeshShape>> bStageShapes_;
 
@@ -131,7 +131,30 @@ bool PinholeCamera::drawObservation(sim::Simulator& sim) {
   return true;
 }
 
-void PinholeCamera::readObservation(Observation& obs) {
+bool PinholeCamera::queueObservationReadback() {
+  if (!hasRenderTarget()) {
+    return false;
+  }
+
+  if (spec_->sensorType == SensorType::SEMANTIC) {
+    renderTarget().queueReadFrameObjectId();
+  } else if (spec_->sensorType == SensorType::DEPTH) {
+    renderTarget().queueReadFrameDepth();
+  } else {
+    renderTarget().queueReadFrameRgba();
+  }
+  return true;
+}
+
+bool PinholeCamera::retrieveObservation(Observation& obs) {
+  if (!hasRenderTarget() || renderTarget().numQueuedReads() == 0) {
+    return false;
+  }
+
+  return renderTarget().retrieveQueuedFrame(observationView(obs));
+}
+
+Magnum::MutableImageView2D PinholeCamera::observationView(Observation& obs) {
   // Make sure we have memory
   if (buffer_ == nullptr) {
     // TODO: check if our sensor was resized and resize our buffer if needed
@@ -141,21 +164,34 @@ void PinholeCamera::readObservation(Observation& obs) {
   }
   obs.buffer = buffer_;
 
+  Magnum::PixelFormat format = Magnum::PixelFormat::RGBA8Unorm;
+  if (spec_->sensorType == SensorType::SEMANTIC) {
+    format = Magnum::PixelFormat::R32UI;
+  } else if (spec_->sensorType == SensorType::DEPTH) {
+    format = Magnum::PixelFormat::R32F;
+  }
+  return Magnum::MutableImageView2D{format, renderTarget().framebufferSize(),
+                                    obs.buffer->data};
+}
+
+bool PinholeCamera::readObservation(Observation& obs) {
+  if (!hasRenderTarget()) {
+    return false;
+  }
+
+  Magnum::MutableImageView2D view = observationView(obs);
+
   // TODO: have different classes for the different types of sensors
   // TODO: do we need to flip axis?
   if (spec_->sensorType == SensorType::SEMANTIC) {
-    renderTarget().readFrameObjectId(Magnum::MutableImageView2D{
-        Magnum::PixelFormat::R32UI, renderTarget().framebufferSize(),
-        obs.buffer->data});
+    renderTarget().readFrameObjectId(view);
   } else if (spec_->sensorType == SensorType::DEPTH) {
-    renderTarget().readFrameDepth(Magnum::MutableImageView2D{
-        Magnum::PixelFormat::R32F, renderTarget().framebufferSize(),
-        obs.buffer->data});
+    renderTarget().readFrameDepth(view);
   } else {
-    renderTarget().readFrameRgba(Magnum::MutableImageView2D{
-        Magnum::PixelFormat::RGBA8Unorm, renderTarget().framebufferSize(),
-        obs.buffer->data});
+    renderTarget().readFrameRgba(view);
   }
+
+  return true;
 }
 
 bool PinholeCamera::displayObservation(sim::Simulator& sim) {
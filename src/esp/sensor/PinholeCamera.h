@@ -5,6 +5,8 @@
 #ifndef ESP_SENSOR_PINHOLECAMERA_H_
 #define ESP_SENSOR_PINHOLECAMERA_H_
 
+#include <Magnum/ImageView.h>
+
 #include "VisualSensor.h"
 #include "esp/core/esp.h"
 
@@ -62,6 +64,17 @@ class PinholeCamera : public VisualSensor {
    */
   virtual bool drawObservation(sim::Simulator& sim) override;
 
+  /**
+   * @brief Read the observation that was rendered by the simulator
+   * @param[in,out] obs Instance of Observation class in which the observation
+   *                    will be stored
+   */
+  virtual bool readObservation(Observation& obs) override;
+
+  virtual bool queueObservationReadback() override;
+
+  virtual bool retrieveObservation(Observation& obs) override;
+
  protected:
   // projection parameters
   int width_ = 640;      // canvas width
@@ -73,11 +86,11 @@ class PinholeCamera : public VisualSensor {
   ESP_SMART_POINTERS(PinholeCamera)
 
   /**
-   * @brief Read the observation that was rendered by the simulator
-   * @param[in,out] obs Instance of Observation class in which the observation
-   *                    will be stored
+   * @brief Point an observation at the sensor's buffer, allocating it on
+   * first use
+   * @return A view of the buffer in the pixel format of the sensor type
    */
-  void readObservation(Observation& obs);
+  Magnum::MutableImageView2D observationView(Observation& obs);
 };
 
 }  // namespace sensor
@@ -108,6 +108,35 @@ class VisualSensor : public Sensor {
     return false;
   }
 
+  /**
+   * @brief Read the observation last drawn to the frame buffer, e.g. by @ref
+   * drawObservation or @ref gfx::Renderer::drawSensors
+   * @return true if success, otherwise false (e.g., frame buffer is not set)
+   * @param[in,out] obs Instance of Observation class in which the observation
+   *                    will be stored
+   */
+  virtual bool readObservation(CORRADE_UNUSED Observation& obs) {
+    return false;
+  }
+
+  /**
+   * @brief Queue an asynchronous readback of the observation last drawn by
+   * @ref drawObservation, see @ref gfx::RenderTarget::queueReadFrameRgba
+   * @return true if success, otherwise false (e.g., frame buffer is not set)
+   */
+  virtual bool queueObservationReadback() { return false; }
+
+  /**
+   * @brief Retrieve the oldest observation queued by @ref
+   * queueObservationReadback, waiting for the GPU if needed
+   * @return true if success, otherwise false (e.g., nothing was queued)
+   * @param[in,out] obs Instance of Observation class in which the observation
+   *                    will be stored
+   */
+  virtual bool retrieveObservation(CORRADE_UNUSED Observation& obs) {
+    return false;
+  }
+
  protected:
   std::unique_ptr<gfx::RenderTarget> tgt_;
 
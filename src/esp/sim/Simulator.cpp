@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
@@ -13,6 +14,7 @@
 #include <Magnum/GL/Context.h>
 
 #include "esp/core/esp.h"
+#include "esp/geo/geo.h"
 #include "esp/gfx/Drawable.h"
 #include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/Renderer.h"
@@ -48,6 +50,7 @@ Simulator::~Simulator() {
 }
 
 void Simulator::close() {
+  navMeshGeometryCache_.clear();
   pathfinder_ = nullptr;
   navMeshVisPrimID_ = esp::ID_UNDEFINED;
   navMeshVisNode_ = nullptr;
@@ -73,6 +76,7 @@ void Simulator::close() {
 }
 
 void Simulator::reconfigure(const SimulatorConfiguration& cfg) {
+  navMeshGeometryCache_.clear();
   // set dataset upon creation or reconfigure
   if (!metadataMediator_) {
     metadataMediator_ =
@@ -566,6 +570,19 @@ esp::physics::RaycastResults Simulator::castRay(const esp::geo::Ray& ray,
   return esp::physics::RaycastResults();
 }
 
+esp::physics::BatchedRaycastResults Simulator::castRays(
+    const std::vector<esp::geo::Ray>& rays,
+    float maxDistance,
+    bool closestOnly,
+    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->castRays(rays, maxDistance, closestOnly);
+  }
+  esp::physics::BatchedRaycastResults results;
+  results.hitOffsets = Eigen::VectorXi::Zero(rays.size() + 1);
+  return results;
+}
+
 void Simulator::setObjectBBDraw(bool drawBB,
                                 const int objectID,
                                 const int sceneID) {
@@ -591,6 +608,53 @@ double Simulator::stepWorld(const double dt) {
   return getWorldTime();
 }
 
+physics::PhysicsState::ptr Simulator::savePhysicsState(const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    auto state = physics::PhysicsState::create();
+    physicsManager_->saveState(*state);
+    return state;
+  }
+  return nullptr;
+}
+
+bool Simulator::restorePhysicsState(const physics::PhysicsState& state,
+                                    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->restoreState(state);
+  }
+  return false;
+}
+
+const physics::ContactEvents& Simulator::getContactEvents(const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->getContactEvents();
+  }
+  static const physics::ContactEvents noContactEvents;
+  return noContactEvents;
+}
+
+void Simulator::setContactEventsEnabled(const bool enabled,
+                                        const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    physicsManager_->setContactEventsEnabled(enabled);
+  }
+}
+
+const physics::PhysicsStepStats& Simulator::getPhysicsStepStats(
+    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->getStepStats();
+  }
+  static const physics::PhysicsStepStats noStepStats;
+  return noStepStats;
+}
+
+void Simulator::resetPhysicsStepStats(const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    physicsManager_->resetStepStats();
+  }
+}
+
 // get the simulated world time (0 if no physics enabled)
 double Simulator::getWorldTime() {
   if (physicsManager_ != nullptr) {
@@ -612,22 +676,87 @@ Magnum::Vector3 Simulator::getGravity(const int sceneID) const {
   return Magnum::Vector3();
 }
 
-bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
-                                 const nav::NavMeshSettings& navMeshSettings,
-                                 bool includeStaticObjects) {
-  CORRADE_ASSERT(config_.createRenderer,
-                 "Simulator::recomputeNavMesh: "
-                 "SimulatorConfiguration::createRenderer is "
-                 "false. Scene geometry is required to recompute navmesh. No "
-                 "geometry is "
-                 "loaded without renderer initialization.",
-                 false);
+namespace {
+// Appends the triangles of mesh, transformed by transform, to joinedMesh.
+// If bounds is given, triangles entirely outside of them are skipped.
+void appendNavMeshGeometry(assets::MeshData& joinedMesh,
+                           const assets::MeshData& mesh,
+                           const Eigen::Transform<float, 3, Eigen::Affine>&
+                               transform,
+                           const Magnum::Range3D* bounds) {
+  const int prevNumVerts = joinedMesh.vbo.size();
+  if (!bounds) {
+    joinedMesh.ibo.reserve(joinedMesh.ibo.size() + mesh.ibo.size());
+    for (const uint32_t index : mesh.ibo) {
+      joinedMesh.ibo.push_back(index + prevNumVerts);
+    }
+    joinedMesh.vbo.reserve(joinedMesh.vbo.size() + mesh.vbo.size());
+    for (const vec3f& vert : mesh.vbo) {
+      joinedMesh.vbo.push_back(transform * vert);
+    }
+    return;
+  }
 
+  const vec3f bmin = Magnum::EigenIntegration::cast<vec3f>(bounds->min());
+  const vec3f bmax = Magnum::EigenIntegration::cast<vec3f>(bounds->max());
+  std::vector<vec3f> verts;
+  verts.reserve(mesh.vbo.size());
+  for (const vec3f& vert : mesh.vbo) {
+    verts.push_back(transform * vert);
+  }
+  // Only copy the vertices referenced by a kept triangle
+  std::vector<int> remap(verts.size(), ID_UNDEFINED);
+  for (size_t ix = 0; ix + 2 < mesh.ibo.size(); ix += 3) {
+    const vec3f& a = verts[mesh.ibo[ix]];
+    const vec3f& b = verts[mesh.ibo[ix + 1]];
+    const vec3f& c = verts[mesh.ibo[ix + 2]];
+    if ((a.cwiseMax(b).cwiseMax(c).array() < bmin.array()).any() ||
+        (a.cwiseMin(b).cwiseMin(c).array() > bmax.array()).any()) {
+      continue;
+    }
+    for (size_t j = ix; j < ix + 3; ++j) {
+      int& index = remap[mesh.ibo[j]];
+      if (index == ID_UNDEFINED) {
+        index = joinedMesh.vbo.size();
+        joinedMesh.vbo.push_back(verts[mesh.ibo[j]]);
+      }
+      joinedMesh.ibo.push_back(index);
+    }
+  }
+}
+}  // namespace
+
+const Simulator::NavMeshGeometry& Simulator::getNavMeshGeometry(
+    const std::string& meshHandle) {
+  auto it = navMeshGeometryCache_.find(meshHandle);
+  if (it == navMeshGeometryCache_.end()) {
+    NavMeshGeometry geometry;
+    geometry.mesh = resourceManager_->createJoinedCollisionMesh(meshHandle);
+    if (!geometry.mesh->vbo.empty()) {
+      vec3f bmin = geometry.mesh->vbo[0];
+      vec3f bmax = bmin;
+      for (const vec3f& vert : geometry.mesh->vbo) {
+        bmin = bmin.cwiseMin(vert);
+        bmax = bmax.cwiseMax(vert);
+      }
+      geometry.bounds = Magnum::Range3D{Magnum::Vector3{bmin},
+                                        Magnum::Vector3{bmax}};
+    }
+    it = navMeshGeometryCache_.emplace(meshHandle, std::move(geometry)).first;
+  }
+  return it->second;
+}
+
+assets::MeshData::uptr Simulator::joinNavMeshGeometry(
+    bool includeStaticObjects,
+    const Magnum::Range3D* bounds) {
   assets::MeshData::uptr joinedMesh = assets::MeshData::create_unique();
   auto stageInitAttrs = physicsManager_->getStageInitAttributes();
   if (stageInitAttrs != nullptr) {
-    joinedMesh = resourceManager_->createJoinedCollisionMesh(
-        stageInitAttrs->getRenderAssetHandle());
+    appendNavMeshGeometry(
+        *joinedMesh,
+        *getNavMeshGeometry(stageInitAttrs->getRenderAssetHandle()).mesh,
+        Eigen::Transform<float, 3, Eigen::Affine>::Identity(), bounds);
   }
 
   // add STATIC collision objects
@@ -635,42 +764,37 @@ bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
     for (auto objectID : physicsManager_->getExistingObjectIDs()) {
       if (physicsManager_->getObjectMotionType(objectID) ==
           physics::MotionType::STATIC) {
-        auto objectTransform = Magnum::EigenIntegration::cast<
-            Eigen::Transform<float, 3, Eigen::Affine> >(
-            physicsManager_->getObjectVisualSceneNode(objectID)
-                .absoluteTransformationMatrix());
         const metadata::attributes::ObjectAttributes::cptr
             initializationTemplate =
                 physicsManager_->getObjectInitAttributes(objectID);
-        objectTransform.scale(Magnum::EigenIntegration::cast<vec3f>(
-            initializationTemplate->getScale()));
+        const Magnum::Matrix4 transform =
+            physicsManager_->getObjectVisualSceneNode(objectID)
+                .absoluteTransformationMatrix() *
+            Magnum::Matrix4::scaling(initializationTemplate->getScale());
         std::string meshHandle =
             initializationTemplate->getCollisionAssetHandle();
         if (meshHandle.empty()) {
           meshHandle = initializationTemplate->getRenderAssetHandle();
         }
-        assets::MeshData::uptr joinedObjectMesh =
-            resourceManager_->createJoinedCollisionMesh(meshHandle);
-        int prevNumIndices = joinedMesh->ibo.size();
-        int prevNumVerts = joinedMesh->vbo.size();
-        joinedMesh->ibo.resize(prevNumIndices + joinedObjectMesh->ibo.size());
-        for (size_t ix = 0; ix < joinedObjectMesh->ibo.size(); ++ix) {
-          joinedMesh->ibo[ix + prevNumIndices] =
-              joinedObjectMesh->ibo[ix] + prevNumVerts;
-        }
-        joinedMesh->vbo.reserve(joinedObjectMesh->vbo.size() + prevNumVerts);
-        for (auto& vert : joinedObjectMesh->vbo) {
-          joinedMesh->vbo.push_back(objectTransform * vert);
+        const NavMeshGeometry& geometry = getNavMeshGeometry(meshHandle);
+        if (bounds &&
+            !Magnum::Math::intersects(
+                *bounds, geo::getTransformedBB(geometry.bounds, transform))) {
+          continue;
         }
+        appendNavMeshGeometry(*joinedMesh, *geometry.mesh,
+                              Magnum::EigenIntegration::cast<
+                                  Eigen::Transform<float, 3, Eigen::Affine> >(
+                                  transform),
+                              bounds);
       }
     }
   }
 
-  if (!pathfinder.build(navMeshSettings, *joinedMesh)) {
-    LOG(ERROR) << "Failed to build navmesh";
-    return false;
-  }
+  return joinedMesh;
+}
 
+void Simulator::refreshNavMeshVisualization(const nav::PathFinder& pathfinder) {
   if (&pathfinder == pathfinder_.get()) {
     if (isNavMeshVisualizationActive()) {
       // if updating pathfinder_ instance, refresh the visualization.
@@ -678,11 +802,67 @@ bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
       setNavMeshVisualization(true);
     }
   }
+}
+
+bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
+                                 const nav::NavMeshSettings& navMeshSettings,
+                                 bool includeStaticObjects) {
+  CORRADE_ASSERT(config_.createRenderer,
+                 "Simulator::recomputeNavMesh: "
+                 "SimulatorConfiguration::createRenderer is "
+                 "false. Scene geometry is required to recompute navmesh. No "
+                 "geometry is "
+                 "loaded without renderer initialization.",
+                 false);
+
+  assets::MeshData::uptr joinedMesh = joinNavMeshGeometry(includeStaticObjects);
+
+  if (!pathfinder.build(navMeshSettings, *joinedMesh)) {
+    LOG(ERROR) << "Failed to build navmesh";
+    return false;
+  }
+
+  refreshNavMeshVisualization(pathfinder);
 
   LOG(INFO) << "reconstruct navmesh successful";
   return true;
 }
 
+bool Simulator::updateNavMesh(nav::PathFinder& pathfinder,
+                              const Magnum::Range3D& region,
+                              bool includeStaticObjects) {
+  CORRADE_ASSERT(config_.createRenderer,
+                 "Simulator::updateNavMesh: "
+                 "SimulatorConfiguration::createRenderer is "
+                 "false. Scene geometry is required to update navmesh. No "
+                 "geometry is "
+                 "loaded without renderer initialization.",
+                 false);
+
+  const vec3f regionMin = Magnum::EigenIntegration::cast<vec3f>(region.min());
+  const vec3f regionMax = Magnum::EigenIntegration::cast<vec3f>(region.max());
+  // Only the geometry around the rebuilt tiles is rasterized
+  const std::pair<vec3f, vec3f> tileBounds =
+      pathfinder.getTileRebuildBounds(regionMin, regionMax);
+  if ((tileBounds.first.array() > tileBounds.second.array()).any()) {
+    // No tile to rebuild, or an untiled navmesh to report
+    return pathfinder.rebuildTiles(assets::MeshData{}, regionMin, regionMax);
+  }
+  const Magnum::Range3D bounds{Magnum::Vector3{tileBounds.first},
+                               Magnum::Vector3{tileBounds.second}};
+  assets::MeshData::uptr joinedMesh =
+      joinNavMeshGeometry(includeStaticObjects, &bounds);
+
+  if (!pathfinder.rebuildTiles(*joinedMesh, regionMin, regionMax)) {
+    LOG(ERROR) << "Failed to update navmesh";
+    return false;
+  }
+
+  refreshNavMeshVisualization(pathfinder);
+
+  return true;
+}
+
 bool Simulator::setNavMeshVisualization(bool visualize) {
   // clean-up the NavMesh visualization if necessary
   if (!visualize && navMeshVisNode_ != nullptr) {
@@ -822,6 +1002,46 @@ bool Simulator::drawObservation(const int agentId,
   return false;
 }
 
+int Simulator::drawAgentObservations(const int agentId) {
+  agent::Agent::ptr ag = getAgent(agentId);
+  if (ag == nullptr) {
+    return 0;
+  }
+
+  gfx::RenderCamera::Flags flags;
+  if (isFrustumCullingEnabled())
+    flags |= gfx::RenderCamera::Flag::FrustumCulling;
+
+  int numDrawn = 0;
+  std::vector<sensor::VisualSensor*> sharedSensors;
+  for (const auto& s : ag->getSensorSuite().getSensors()) {
+    if (!s.second->isVisualSensor()) {
+      continue;
+    }
+    auto* visualSensor = static_cast<sensor::VisualSensor*>(s.second.get());
+    if (!visualSensor->hasRenderTarget()) {
+      continue;
+    }
+    // semantic sensors with a separate semantic scene graph need their own
+    // passes
+    if (visualSensor->specification()->sensorType ==
+            sensor::SensorType::SEMANTIC &&
+        &getActiveSemanticSceneGraph() != &getActiveSceneGraph()) {
+      if (visualSensor->drawObservation(*this)) {
+        ++numDrawn;
+      }
+    } else {
+      sharedSensors.push_back(visualSensor);
+    }
+  }
+
+  if (!sharedSensors.empty()) {
+    renderer_->drawSensors(sharedSensors, getActiveSceneGraph(), flags);
+    numDrawn += sharedSensors.size();
+  }
+  return numDrawn;
+}
+
 bool Simulator::getAgentObservation(const int agentId,
                                     const std::string& sensorId,
                                     sensor::Observation& observation) {
@@ -841,13 +1061,72 @@ int Simulator::getAgentObservations(
   observations.clear();
   agent::Agent::ptr ag = getAgent(agentId);
   if (ag != nullptr) {
+    drawAgentObservations(agentId);
     const std::map<std::string, sensor::Sensor::ptr>& sensors =
         ag->getSensorSuite().getSensors();
     for (std::pair<std::string, sensor::Sensor::ptr> s : sensors) {
+      sensor::Observation obs;
+      const bool observed =
+          s.second->isVisualSensor()
+              ? static_cast<sensor::VisualSensor&>(*s.second).readObservation(
+                    obs)
+              : s.second->getObservation(*this, obs);
+      if (observed) {
+        observations[s.first] = obs;
+      }
+    }
+  }
+  return observations.size();
+}
+
+int Simulator::getAgentObservationsAsync(
+    const int agentId,
+    std::map<std::string, sensor::Observation>& observations,
+    const bool previousFrame) {
+  observations.clear();
+  agent::Agent::ptr ag = getAgent(agentId);
+  if (ag == nullptr) {
+    return 0;
+  }
+  const std::map<std::string, sensor::Sensor::ptr>& sensors =
+      ag->getSensorSuite().getSensors();
+
+  // the frame of a sensor which is kept in flight until the next call
+  const size_t numKeptReads = previousFrame ? 1 : 0;
+  drawAgentObservations(agentId);
+  std::vector<std::pair<std::string, sensor::VisualSensor*>> queuedSensors;
+  for (const auto& s : sensors) {
+    if (!s.second->isVisualSensor()) {
       sensor::Observation obs;
       if (s.second->getObservation(*this, obs)) {
         observations[s.first] = obs;
       }
+      continue;
+    }
+    auto* visualSensor = static_cast<sensor::VisualSensor*>(s.second.get());
+    if (!visualSensor->queueObservationReadback()) {
+      continue;
+    }
+    // nothing was in flight yet, keep a copy of this frame for the next call
+    if (visualSensor->renderTarget().numQueuedReads() == numKeptReads) {
+      visualSensor->queueObservationReadback();
+    }
+    queuedSensors.emplace_back(s.first, visualSensor);
+  }
+
+  for (const auto& s : queuedSensors) {
+    sensor::Observation obs;
+    // older reads, e.g. left by a previous call with previousFrame, are
+    // overwritten by the newer ones
+    bool retrieved = false;
+    while (s.second->renderTarget().numQueuedReads() > numKeptReads) {
+      retrieved = s.second->retrieveObservation(obs);
+      if (!retrieved) {
+        break;
+      }
+    }
+    if (retrieved) {
+      observations[s.first] = obs;
     }
   }
   return observations.size();
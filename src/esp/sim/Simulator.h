@@ -5,6 +5,8 @@
 #ifndef ESP_SIM_SIMULATOR_H_
 #define ESP_SIM_SIMULATOR_H_
 
+#include <map>
+
 #include <Corrade/Utility/Assert.h>
 #include "esp/agent/Agent.h"
 #include "esp/assets/ResourceManager.h"
@@ -534,6 +536,28 @@ class Simulator {
                                        float maxDistance = 100.0,
                                        int sceneID = 0);
 
+  /**
+   * @brief Raycast a batch of rays into the collision world of a scene. See
+   * @ref esp::physics::PhysicsManager::castRays.
+   *
+   * Note: A default @ref physics::PhysicsManager has no collision world, so
+   * physics must be enabled for this feature.
+   *
+   * @param rays The rays to cast. Need not be unit length, but returned hit
+   * distances will be in units of ray length.
+   * @param maxDistance The maximum distance along the ray directions to
+   * search. In units of ray length.
+   * @param closestOnly Whether to only report the closest hit of each ray.
+   * @param sceneID !! Not used currently !! Specifies which physical scene of
+   * the object.
+   * @return The hits of all rays, sorted by distance for each ray.
+   */
+  esp::physics::BatchedRaycastResults castRays(
+      const std::vector<esp::geo::Ray>& rays,
+      float maxDistance = 100.0,
+      bool closestOnly = false,
+      int sceneID = 0);
+
   /**
    * @brief the physical world has a notion of time which passes during
    * animation/simulation/action/etc... Step the physical world forward in time
@@ -556,6 +580,25 @@ class Simulator {
    */
   double getWorldTime();
 
+  /**
+   * @brief Take a snapshot of the dynamic state of the physical world, e.g. to
+   * reset an episode or branch rollouts from it. See @ref
+   * esp::physics::PhysicsManager::saveState.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   * @return The snapshot, or nullptr if physics is not initialized.
+   */
+  physics::PhysicsState::ptr savePhysicsState(int sceneID = 0);
+
+  /**
+   * @brief Restore the physical world to a snapshot taken by @ref
+   * savePhysicsState. See @ref esp::physics::PhysicsManager::restoreState.
+   * @param state The snapshot.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   * @return Whether the state of every object of the snapshot was restored.
+   */
+  bool restorePhysicsState(const physics::PhysicsState& state,
+                           int sceneID = 0);
+
   /**
    * @brief Set the gravity in a physical scene.
    */
@@ -579,6 +622,22 @@ class Simulator {
                         const nav::NavMeshSettings& navMeshSettings,
                         bool includeStaticObjects = false);
 
+  /**
+   * @brief Update the navmesh of the referenced @ref nav::PathFinder after
+   * the scene changed within a region, only rebuilding the navmesh tiles
+   * which overlap it. The navmesh must have been computed with @ref
+   * recomputeNavMesh and a @ref nav::NavMeshSettings::tileSize > 0.
+   * @param pathfinder The pathfinder object whose navmesh will be updated.
+   * @param region The region which changed, e.g. the union of the old and new
+   * bounds of a moved object.
+   * @param includeStaticObjects Should match the value passed to @ref
+   * recomputeNavMesh.
+   * @return Whether or not the navmesh update succeeded.
+   */
+  bool updateNavMesh(nav::PathFinder& pathfinder,
+                     const Magnum::Range3D& region,
+                     bool includeStaticObjects = false);
+
   /**
    * @brief Set visualization of the current NavMesh @ref pathfinder_ on or off.
    *
@@ -631,6 +690,15 @@ class Simulator {
    */
   bool drawObservation(int agentId, const std::string& sensorId);
 
+  /**
+   * @brief Draw the observations of all visual sensors of an agent to their
+   * frame buffers. Sensors rendering the active scene graph share their
+   * render passes, see @ref gfx::Renderer::drawSensors.
+   * @param agentId Id of the agent whose sensors are drawn
+   * @return The number of sensors drawn
+   */
+  int drawAgentObservations(int agentId);
+
   bool getAgentObservation(int agentId,
                            const std::string& sensorId,
                            sensor::Observation& observation);
@@ -638,6 +706,24 @@ class Simulator {
       int agentId,
       std::map<std::string, sensor::Observation>& observations);
 
+  /**
+   * @brief Draw the observations of all sensors of an agent, see @ref
+   * drawAgentObservations, and read them back asynchronously, so the
+   * readbacks of the sensors overlap instead of stalling once per sensor.
+   *
+   * @param agentId Id of the agent for which the observations are returned
+   * @param observations The observations, by sensor id
+   * @param previousFrame Whether to return the observations drawn by the
+   * previous call rather than wait for the ones just drawn, so the CPU work
+   * done until the next call overlaps rendering. The first call returns the
+   * observations it draws.
+   * @return The number of observations
+   */
+  int getAgentObservationsAsync(
+      int agentId,
+      std::map<std::string, sensor::Observation>& observations,
+      bool previousFrame = false);
+
   bool getAgentObservationSpace(int agentId,
                                 const std::string& sensorId,
                                 sensor::ObservationSpace& space);
@@ -648,6 +734,18 @@ class Simulator {
   nav::PathFinder::ptr getPathFinder();
   void setPathFinder(nav::PathFinder::ptr pf);
 
+  /**
+   * @brief The physical world of the simulator, e.g. to step it together with
+   * the worlds of other simulators in a @ref physics::PhysicsWorldBatch.
+   *
+   * The world depends on resources of the simulator which @ref close and
+   * @ref reconfigure destroy, so it must not be kept alive past them. Hold it
+   * through a std::weak_ptr.
+   */
+  physics::PhysicsManager::ptr getPhysicsManager() const {
+    return physicsManager_;
+  }
+
   /**
    * @brief Enable or disable frustum culling (enabled by default)
    * @param val true = enable, false = disable
@@ -706,6 +804,33 @@ class Simulator {
     return physicsManager_->getNumActiveContactPoints();
   }
 
+  /**
+   * @brief The contact events of the last step of the physical world. See
+   * @ref esp::physics::PhysicsManager::getContactEvents.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   */
+  const physics::ContactEvents& getContactEvents(int sceneID = 0);
+
+  /**
+   * @brief Enable or disable collecting the contact events of the physical
+   * world. See @ref esp::physics::PhysicsManager::setContactEventsEnabled.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   */
+  void setContactEventsEnabled(bool enabled, int sceneID = 0);
+
+  /**
+   * @brief The substep and wall clock time counters of the physical world.
+   * See @ref esp::physics::PhysicsManager::getStepStats.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   */
+  const physics::PhysicsStepStats& getPhysicsStepStats(int sceneID = 0);
+
+  /**
+   * @brief Reset the counters of @ref getPhysicsStepStats.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   */
+  void resetPhysicsStepStats(int sceneID = 0);
+
   /**
    * @brief Set this simulator's MetadataMediator
    */
@@ -727,6 +852,25 @@ class Simulator {
     return isValidScene(sceneID) && physicsManager_ != nullptr;
   }
 
+  //! join the collision meshes of the stage and, optionally, of all STATIC
+  //! objects into the geometry a navmesh is built from. If bounds is given,
+  //! only the triangles overlapping them are joined.
+  assets::MeshData::uptr joinNavMeshGeometry(
+      bool includeStaticObjects,
+      const Magnum::Range3D* bounds = nullptr);
+
+  //! A joined collision mesh in its local frame with its bounds
+  struct NavMeshGeometry {
+    assets::MeshData::uptr mesh;
+    Magnum::Range3D bounds;
+  };
+
+  //! get the joined collision mesh of an asset, joining it on first use
+  const NavMeshGeometry& getNavMeshGeometry(const std::string& meshHandle);
+
+  //! refresh the navmesh visualization if it shows pathfinder's navmesh
+  void refreshNavMeshVisualization(const nav::PathFinder& pathfinder);
+
   gfx::WindowlessContext::uptr context_ = nullptr;
   std::shared_ptr<gfx::Renderer> renderer_ = nullptr;
   // CANNOT make the specification of resourceManager_ above the context_!
@@ -753,6 +897,9 @@ class Simulator {
 
   std::vector<agent::Agent::ptr> agents_;
   nav::PathFinder::ptr pathfinder_;
+  //! Collision meshes joined for navmesh builds by asset handle, so navmesh
+  //! updates don't join the whole scene again. Cleared on reconfigure.
+  std::map<std::string, NavMeshGeometry> navMeshGeometryCache_;
   // state indicating frustum culling is enabled or not
   //
   // TODO:
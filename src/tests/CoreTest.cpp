@@ -3,8 +3,11 @@
 // LICENSE file in the root directory of this source tree.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
 
 #include "esp/core/Configuration.h"
+#include "esp/core/ThreadPool.h"
 #include "esp/core/esp.h"
 
 using namespace esp::core;
@@ -18,3 +21,40 @@ TEST(CoreTest, ConfigurationTest) {
   EXPECT_EQ(cfg.get<int>("myInt"), 10);
   EXPECT_EQ(cfg.get<std::string>("myString"), "test");
 }
+
+TEST(CoreTest, ThreadPoolTest) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.numThreads(), 4);
+
+  std::vector<int> counts(1000, 0);
+  std::atomic<bool> workerIdInRange{true};
+  for (int iRun = 0; iRun < 10; ++iRun) {
+    pool.parallelFor(counts.size(), [&](size_t i, size_t workerId) {
+      ++counts[i];
+      if (workerId >= pool.numThreads()) {
+        workerIdInRange = false;
+      }
+    });
+  }
+  // Every index is visited exactly once per run
+  for (int count : counts) {
+    EXPECT_EQ(count, 10);
+  }
+  EXPECT_TRUE(workerIdInRange);
+
+  // An exception thrown by a job is rethrown in the caller, and the pool
+  // remains usable afterwards
+  EXPECT_THROW(pool.parallelFor(counts.size(),
+                                [](size_t i, size_t) {
+                                  if (i == 500) {
+                                    throw std::runtime_error("job failed");
+                                  }
+                                }),
+               std::runtime_error);
+  std::atomic<size_t> numJobs{0};
+  pool.parallelFor(counts.size(), [&](size_t, size_t) { ++numJobs; });
+  EXPECT_EQ(numJobs, counts.size());
+
+  // An empty batch is a no-op
+  pool.parallelFor(0, [](size_t, size_t) { FAIL(); });
+}
@@ -3,6 +3,7 @@
 // LICENSE file in the root directory of this source tree.
 //
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
@@ -11,10 +12,14 @@
 #include <Magnum/Math/Frustum.h>
 #include <Magnum/Math/Intersection.h>
 #include <Magnum/Math/Range.h>
+#include <Magnum/SceneGraph/Drawable.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
 #include <string>
 
 #include "esp/assets/ResourceManager.h"
+#include "esp/gfx/CullingBvh.h"
 #include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/RenderTarget.h"
 #include "esp/gfx/WindowlessContext.h"
@@ -33,17 +38,27 @@ namespace Test {
 // on GCC and Clang, the following namespace causes useful warnings to be
 // printed when you have accidentally unused variables or functions in the test
 namespace {
+// a drawable drawing nothing, only its node matters for culling
+struct EmptyDrawable : Mn::SceneGraph::Drawable3D {
+  using Mn::SceneGraph::Drawable3D::Drawable3D;
+  void draw(const Mn::Matrix4&, Mn::SceneGraph::Camera3D&) override {}
+};
+
 struct CullingTest : Cr::TestSuite::Tester {
   explicit CullingTest();
   // tests
   void computeAbsoluteAABB();
   void frustumCulling();
+  void cullingBvh();
+  void cullingBvhLevels();
 };
 
 CullingTest::CullingTest() {
   // clang-format off
   addTests({&CullingTest::computeAbsoluteAABB,
-            &CullingTest::frustumCulling});
+            &CullingTest::frustumCulling,
+            &CullingTest::cullingBvh,
+            &CullingTest::cullingBvhLevels});
   // clang-format on
 }
 
@@ -272,6 +287,155 @@ void CullingTest::frustumCulling() {
   target->renderExit();
   CORRADE_COMPARE(numVisibleObjects, numVisibleObjectsGroundTruth);
 }
+
+void CullingTest::cullingBvh() {
+  // must create a GL context which will be used in the resource manager
+  esp::gfx::WindowlessContext::uptr context_ =
+      esp::gfx::WindowlessContext::create_unique(0);
+
+  // must declare these in this order due to avoid deallocation errors
+  auto MM = MetadataMediator::create();
+  ResourceManager resourceManager(MM);
+  SceneManager sceneManager;
+  auto stageAttributesMgr = MM->getStageAttributesManager();
+  std::string stageFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/5boxes.glb");
+  auto stageAttributes = stageAttributesMgr->createObject(stageFile, true);
+
+  int sceneID = sceneManager.initSceneGraph();
+  auto& sceneGraph = sceneManager.getSceneGraph(sceneID);
+  auto& drawables = sceneGraph.getDrawables();
+  std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+  CORRADE_VERIFY(resourceManager.loadStage(stageAttributes, nullptr,
+                                           &sceneManager, tempIDs, false));
+
+  const esp::gfx::CullingBvh& bvh = drawables.getCullingBvh();
+  CORRADE_COMPARE(bvh.getNumDrawables(), drawables.size());
+  CORRADE_COMPARE(bvh.getNumStaticDrawables(), 5);
+
+  esp::gfx::RenderCamera& renderCamera = sceneGraph.getDefaultRenderCamera();
+  renderCamera.setProjectionMatrix(800, 600, 0.01f, 100.0f, 39.6f);
+
+  // circle around the boxes, so that different subsets of them are visible
+  for (int i = 0; i < 8; ++i) {
+    CORRADE_ITERATION(i);
+    const Mn::Rad angle = Mn::Deg(45.0f * i);
+    const Mn::Vector3 eye{10.0f * Mn::Math::cos(angle), 2.0f,
+                          10.0f * Mn::Math::sin(angle)};
+    renderCamera.node().setTransformation(Mn::Matrix4::lookAt(
+        eye, {0.0f, -2.0f, 2.0f}, Mn::Vector3::yAxis()));
+
+    // the hierarchy keeps the drawables culled one by one
+    std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
+                          Mn::Matrix4>>
+        drawableTransforms = renderCamera.drawableTransformations(drawables);
+    size_t numVisibles = renderCamera.cull(drawableTransforms);
+    std::set<const Mn::SceneGraph::Drawable3D*> expected;
+    for (size_t j = 0; j < numVisibles; ++j) {
+      expected.insert(&drawableTransforms[j].first.get());
+    }
+
+    std::vector<size_t> visible;
+    bvh.cull(renderCamera.frustum(), visible);
+    CORRADE_VERIFY(std::is_sorted(visible.begin(), visible.end()));
+    std::set<const Mn::SceneGraph::Drawable3D*> actual;
+    for (size_t index : visible) {
+      actual.insert(&drawables[index]);
+    }
+    CORRADE_COMPARE(actual.size(), expected.size());
+    CORRADE_VERIFY(actual == expected);
+  }
+}
+
+void CullingTest::cullingBvhLevels() {
+  // a grid of 8 x 8 x 4 unit boxes, 2 apart, so that the hierarchy has
+  // several levels, and a dynamic drawable without an AABB
+  esp::scene::SceneGraph sceneGraph;
+  Mn::SceneGraph::DrawableGroup3D drawables;
+  std::vector<Mn::Range3D> aabbs;
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        esp::scene::SceneNode& node = sceneGraph.getRootNode().createChild();
+        const Mn::Vector3 center{2.0f * i + 1.0f, 2.0f * j + 1.0f,
+                                 2.0f * k + 1.0f};
+        aabbs.push_back(Mn::Range3D::fromCenter(center, Mn::Vector3{0.5f}));
+        node.setAbsoluteAABB(aabbs.back());
+        new EmptyDrawable{node, &drawables};
+      }
+    }
+  }
+  new EmptyDrawable{sceneGraph.getRootNode().createChild(), &drawables};
+  const size_t dynamicIndex = aabbs.size();
+
+  esp::gfx::CullingBvh bvh;
+  bvh.build(drawables);
+  CORRADE_COMPARE(bvh.getNumDrawables(), aabbs.size() + 1);
+  CORRADE_COMPARE(bvh.getNumStaticDrawables(), aabbs.size());
+
+  // the indices of the boxes matching a predicate, and the dynamic drawable
+  auto expectedVisible = [&](auto&& isVisible) {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < aabbs.size(); ++i) {
+      if (isVisible(aabbs[i])) {
+        expected.push_back(i);
+      }
+    }
+    expected.push_back(dynamicIndex);
+    return expected;
+  };
+
+  // the frustum of the points between min and max
+  auto boxFrustum = [](const Mn::Vector3& min, const Mn::Vector3& max) {
+    return Mn::Frustum{{1.0f, 0.0f, 0.0f, -min.x()},
+                       {-1.0f, 0.0f, 0.0f, max.x()},
+                       {0.0f, 1.0f, 0.0f, -min.y()},
+                       {0.0f, -1.0f, 0.0f, max.y()},
+                       {0.0f, 0.0f, 1.0f, -min.z()},
+                       {0.0f, 0.0f, -1.0f, max.z()}};
+  };
+
+  std::vector<size_t> visible;
+  // contains all of the boxes with x < 8, the first subtree of the root, and
+  // none of the others: the first subtree is accepted as a whole, the second
+  // one is rejected as a whole
+  bvh.cull(boxFrustum({0.0f, -1.0f, -1.0f}, {8.0f, 17.0f, 9.0f}), visible);
+  CORRADE_COMPARE(visible.size(), aabbs.size() / 2 + 1);
+  CORRADE_COMPARE_AS(visible, expectedVisible([](const Mn::Range3D& aabb) {
+                       return aabb.max().x() < 8.0f;
+                     }),
+                     Cr::TestSuite::Compare::Container);
+
+  // contains everything
+  bvh.cull(boxFrustum({-1.0f, -1.0f, -1.0f}, {17.0f, 17.0f, 9.0f}), visible);
+  CORRADE_COMPARE(visible.size(), aabbs.size() + 1);
+
+  // contains none of the boxes, only the dynamic drawable is kept
+  bvh.cull(boxFrustum({-20.0f, -1.0f, -1.0f}, {-18.0f, 17.0f, 9.0f}), visible);
+  CORRADE_COMPARE_AS(visible, std::vector<size_t>{dynamicIndex},
+                     Cr::TestSuite::Compare::Container);
+
+  // perspective views cutting through the grid, against testing each box
+  for (int i = 0; i < 8; ++i) {
+    CORRADE_ITERATION(i);
+    const Mn::Rad angle = Mn::Deg(45.0f * i);
+    const Mn::Vector3 eye{8.0f + 6.0f * Mn::Math::cos(angle), 8.0f + 2.0f * i,
+                          4.0f + 6.0f * Mn::Math::sin(angle)};
+    const Mn::Matrix4 viewProjection =
+        Mn::Matrix4::perspectiveProjection(Mn::Deg(60.0f), 4.0f / 3.0f, 0.1f,
+                                           20.0f) *
+        Mn::Matrix4::lookAt(eye, {8.0f, 8.0f, 4.0f}, Mn::Vector3::yAxis())
+            .inverted();
+    const Mn::Frustum frustum = Mn::Frustum::fromMatrix(viewProjection);
+    bvh.cull(frustum, visible);
+    CORRADE_COMPARE_AS(visible,
+                       expectedVisible([&](const Mn::Range3D& aabb) {
+                         return Mn::Math::Intersection::rangeFrustum(aabb,
+                                                                     frustum);
+                       }),
+                       Cr::TestSuite::Compare::Container);
+  }
+}
 }  // namespace
 }  // namespace Test
 
@@ -2,14 +2,19 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
+#include <Magnum/DebugTools/CompareImage.h>
 #include <Magnum/GL/Mesh.h>
+#include <Magnum/Image.h>
 #include <Magnum/MeshTools/Compile.h>
+#include <Magnum/PixelFormat.h>
 #include <Magnum/Primitives/Cube.h>
 #include <Magnum/Shaders/Flat.h>
 #include <Magnum/Trade/MeshData.h>
 #include "esp/assets/ResourceManager.h"
+#include "esp/gfx/DepthUnprojection.h"
 #include "esp/gfx/GenericDrawable.h"
 #include "esp/gfx/RenderTarget.h"
 #include "esp/gfx/WindowlessContext.h"
@@ -41,6 +46,7 @@ struct DrawableTest : Cr::TestSuite::Tester {
   explicit DrawableTest();
   // tests
   void addRemoveDrawables();
+  void drawStateSorting();
 
  protected:
   esp::gfx::WindowlessContext::uptr context_ =
@@ -57,7 +63,8 @@ DrawableTest::DrawableTest() {
   auto MM = MetadataMediator::create();
   resourceManager_ = std::make_unique<ResourceManagerExtended>(MM);
   //clang-format off
-  addTests({&DrawableTest::addRemoveDrawables});
+  addTests({&DrawableTest::addRemoveDrawables,
+            &DrawableTest::drawStateSorting});
   // flang-format on
   auto stageAttributesMgr = MM->getStageAttributesManager();
   std::string stageFile =
@@ -152,6 +159,92 @@ void DrawableTest::addRemoveDrawables() {
   CORRADE_VERIFY(!drawableGroup_->hasDrawable(dr->getDrawableId()));
 }
 
+void DrawableTest::drawStateSorting() {
+  Mn::GL::Mesh box = Mn::MeshTools::compile(Mn::Primitives::cubeSolid());
+  auto& sceneGraph = sceneManager_.getSceneGraph(sceneID_);
+  esp::gfx::DrawableGroup* group =
+      sceneGraph.createDrawableGroup("drawStateSorting");
+  CORRADE_VERIFY(group);
+
+  // two materials in alternating order, both drawn with the same shader
+  esp::gfx::Drawable::Flags meshAttributeFlags{};
+  const char* materialKeys[]{
+      esp::assets::ResourceManager::DEFAULT_MATERIAL_KEY,
+      esp::assets::ResourceManager::WHITE_MATERIAL_KEY,
+      esp::assets::ResourceManager::DEFAULT_MATERIAL_KEY,
+      esp::assets::ResourceManager::WHITE_MATERIAL_KEY};
+  for (int i = 0; i < 4; ++i) {
+    esp::scene::SceneNode& node = sceneGraph.getRootNode().createChild();
+    node.translate({3.0f * i - 4.5f, 0.0f, -10.0f});
+    node.addFeature<esp::gfx::GenericDrawable>(
+        box, meshAttributeFlags, resourceManager_->getShaderManager(),
+        esp::assets::ResourceManager::NO_LIGHT_KEY, materialKeys[i], group);
+  }
+
+  esp::gfx::RenderCamera& renderCamera = sceneGraph.getDefaultRenderCamera();
+  const Mn::Vector2i frameBufferSize{64, 64};
+  renderCamera.setProjectionMatrix(frameBufferSize.x(), frameBufferSize.y(),
+                                   0.01f, 100.0f, 90.0f);
+  esp::gfx::RenderTarget::uptr target = esp::gfx::RenderTarget::create_unique(
+      frameBufferSize, esp::gfx::calculateDepthUnprojection(
+                           renderCamera.projectionMatrix()));
+  auto readFrame = [&]() {
+    const std::size_t size = 4 * frameBufferSize.product();
+    Mn::Image2D image{
+        Mn::PixelFormat::RGBA8Unorm, frameBufferSize,
+        Cr::Containers::Array<char>{Cr::Containers::NoInit, size}};
+    target->readFrameRgba(image);
+    return image;
+  };
+
+  // drawn as part of the group, the drawables are sorted and only the first
+  // drawable of each material binds it
+  target->renderEnter();
+  group->prepareForDraw(renderCamera);
+  esp::gfx::RenderCamera::DrawableTransforms drawableTransforms =
+      renderCamera.drawableTransformations(*group);
+  CORRADE_COMPARE(renderCamera.draw(drawableTransforms, {}, group), 4u);
+  target->renderExit();
+  Mn::Image2D sorted = readFrame();
+  auto material = [&](size_t i) {
+    return static_cast<esp::gfx::Drawable&>(drawableTransforms[i].first.get())
+        .getMaterial();
+  };
+  CORRADE_VERIFY(material(0) == material(1));
+  CORRADE_VERIFY(material(1) != material(2));
+  CORRADE_VERIFY(material(2) == material(3));
+  CORRADE_COMPARE(group->getDrawStatistics().shaderBinds, 1u);
+  CORRADE_COMPARE(group->getDrawStatistics().shaderBindsAvoided, 3u);
+  CORRADE_COMPARE(group->getDrawStatistics().materialBinds, 2u);
+  CORRADE_COMPARE(group->getDrawStatistics().materialBindsAvoided, 2u);
+
+  // drawn on their own, all the state is bound
+  target->renderEnter();
+  group->prepareForDraw(renderCamera);
+  drawableTransforms = renderCamera.drawableTransformations(*group);
+  CORRADE_COMPARE(renderCamera.draw(drawableTransforms), 4u);
+  target->renderExit();
+  Mn::Image2D unsorted = readFrame();
+  CORRADE_COMPARE(group->getDrawStatistics().shaderBinds, 4u);
+  CORRADE_COMPARE(group->getDrawStatistics().shaderBindsAvoided, 0u);
+  CORRADE_COMPARE(group->getDrawStatistics().materialBinds, 4u);
+  CORRADE_COMPARE(group->getDrawStatistics().materialBindsAvoided, 0u);
+
+  // skipping the redundant binds does not change the image
+  CORRADE_COMPARE_WITH(sorted, unsorted,
+                       (Mn::DebugTools::CompareImage{0.0f, 0.0f}));
+
+  // drawing the group without flags sorts it as well
+  target->renderEnter();
+  group->prepareForDraw(renderCamera);
+  CORRADE_COMPARE(renderCamera.draw(*group), 4u);
+  target->renderExit();
+  CORRADE_COMPARE(group->getDrawStatistics().shaderBindsAvoided, 3u);
+  CORRADE_COMPARE(group->getDrawStatistics().materialBindsAvoided, 2u);
+  CORRADE_COMPARE_WITH(readFrame(), unsorted,
+                       (Mn::DebugTools::CompareImage{0.0f, 0.0f}));
+}
+
 }  // namespace
 }  // namespace Test
 
@@ -2,8 +2,11 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 #include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
 
 #include "esp/assets/MeshData.h"
 #include "esp/core/esp.h"
@@ -167,3 +170,76 @@ TEST(NavTest, PathFinderTestMeshData) {
   ASSERT_EQ(meshData->vbo.size(), 63);
   ASSERT_EQ(meshData->ibo.size(), 63);
 }
+
+TEST(NavTest, PathFinderTestDistanceFieldOwnership) {
+  PathFinder castle;
+  castle.loadNavMesh(Cr::Utility::Directory::join(
+      SCENE_DATASETS, "habitat-test-scenes/skokloster-castle.navmesh"));
+  PathFinder room;
+  room.loadNavMesh(Cr::Utility::Directory::join(
+      SCENE_DATASETS, "habitat-test-scenes/van-gogh-room.navmesh"));
+  room.seed(0);
+  const std::vector<vec3f> ends{room.getRandomNavigablePoint(),
+                                room.getRandomNavigablePoint()};
+  const vec3f start = room.getRandomNavigablePoint();
+
+  MultiGoalShortestPath expected;
+  expected.setRequestedEnds(ends);
+  expected.requestedStart = start;
+  ASSERT_TRUE(room.findPathFromDistanceField(expected));
+
+  // A field cached on another PathFinder's navmesh must not be reused, even
+  // though both PathFinders loaded exactly one navmesh
+  MultiGoalShortestPath path;
+  path.setRequestedEnds(ends);
+  path.requestedStart = start;
+  castle.findPathFromDistanceField(path);
+  path.requestedStart = start;
+  ASSERT_TRUE(room.findPathFromDistanceField(path));
+  EXPECT_EQ(path.geodesicDistance, expected.geodesicDistance);
+}
+
+TEST(NavTest, PathFinderTestTruncatedNavMesh) {
+  PathFinder pf;
+  ASSERT_TRUE(pf.loadNavMesh(Cr::Utility::Directory::join(
+      SCENE_DATASETS, "habitat-test-scenes/skokloster-castle.navmesh")));
+  const std::string filename = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "NavTestTruncated.navmesh");
+  ASSERT_TRUE(pf.saveNavMesh(filename));
+  Cr::Containers::Array<char> data = Cr::Utility::Directory::read(filename);
+
+  // Truncations anywhere in the set headers, anywhere in the first tile
+  // header, at evenly spaced points through the rest of the file and of its
+  // last byte only are rejected instead of read past the end of the file.
+  // The 40 bytes of NavMeshSetHeader are followed by NavMeshSetMappedHeader,
+  // which ends with the offset of the first tile header.
+  const size_t setHeadersSize = 40 + 16;
+  ASSERT_GT(data.size(), setHeadersSize);
+  int tilesOffset = 0;
+  std::memcpy(&tilesOffset, data.data() + setHeadersSize - sizeof(int),
+              sizeof(int));
+  ASSERT_GE(tilesOffset, int(setHeadersSize));
+  ASSERT_LT(size_t(tilesOffset) + 32, data.size());
+  std::vector<size_t> sizes;
+  for (size_t size = 0; size <= setHeadersSize; ++size) {
+    sizes.push_back(size);
+  }
+  for (size_t size = tilesOffset; size <= size_t(tilesOffset) + 32; ++size) {
+    sizes.push_back(size);
+  }
+  for (size_t i = 1; i < 64; ++i) {
+    sizes.push_back(data.size() * i / 64);
+  }
+  sizes.push_back(data.size() - 1);
+  for (const size_t size : sizes) {
+    SCOPED_TRACE(size);
+    ASSERT_TRUE(Cr::Utility::Directory::write(filename, data.prefix(size)));
+    PathFinder truncated;
+    EXPECT_FALSE(truncated.loadNavMesh(filename));
+  }
+
+  ASSERT_TRUE(Cr::Utility::Directory::write(filename, data));
+  PathFinder loaded;
+  EXPECT_TRUE(loaded.loadNavMesh(filename));
+  Cr::Utility::Directory::rm(filename);
+}
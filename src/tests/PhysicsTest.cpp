@@ -2,8 +2,11 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
 #include <gtest/gtest.h>
+#include <cstring>
 #include <string>
 
 #include "esp/sim/Simulator.h"
@@ -13,6 +16,7 @@
 
 #include "esp/physics/PhysicsManager.h"
 #ifdef ESP_BUILD_WITH_BULLET
+#include "esp/physics/bullet/BulletBvhCache.h"
 #include "esp/physics/bullet/BulletPhysicsManager.h"
 #endif
 
@@ -47,13 +51,17 @@ class PhysicsManagerTest : public testing::Test {
         metadataMediator_->getPhysicsAttributesManager();
   };
 
-  void initStage(const std::string stageFile) {
+  void initStage(const std::string stageFile,
+                 esp::metadata::attributes::PhysicsManagerAttributes::ptr
+                     physicsManagerAttributes = nullptr) {
     auto& sceneGraph = sceneManager_.getSceneGraph(sceneID_);
     auto& rootNode = sceneGraph.getRootNode();
 
     // construct appropriate physics attributes based on config file
-    auto physicsManagerAttributes =
-        physicsAttributesManager_->createObject(physicsConfigFile, true);
+    if (physicsManagerAttributes == nullptr) {
+      physicsManagerAttributes =
+          physicsAttributesManager_->createObject(physicsConfigFile, true);
+    }
     auto stageAttributesMgr = metadataMediator_->getStageAttributesManager();
     if (physicsManagerAttributes != nullptr) {
       stageAttributesMgr->setCurrPhysicsManagerAttributesHandle(
@@ -345,6 +353,224 @@ TEST_F(PhysicsManagerTest, BulletCompoundShapeMargins) {
     ASSERT_EQ(AabbOb2, objectGroundTruth);
   }
 }
+
+TEST_F(PhysicsManagerTest, BulletSharedCollisionShapes) {
+  // test that instances of the same object share their collision shapes
+  // without affecting each other
+  LOG(INFO) << "Starting physics test: BulletSharedCollisionShapes";
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initStage(stageFile);
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.0);
+
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+    objectAttributesManager->registerObject(ObjectAttributes, objectFile);
+
+    ObjectAttributes::ptr objectTemplate =
+        objectAttributesManager->getObjectCopyByHandle(objectFile);
+
+    auto* drawables = &sceneManager_.getSceneGraph(sceneID_).getDrawables();
+    esp::physics::BulletPhysicsManager* bPhysManager =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get());
+
+    // many instances at the same scale build the shapes only once
+    std::vector<int> objectIds;
+    for (int i = 0; i < 10; ++i) {
+      objectIds.push_back(physicsManager_->addObject(objectFile, drawables));
+    }
+    ASSERT_EQ(bPhysManager->getNumCachedCollisionShapes(), 1u);
+
+    // a different scale gets its own shapes
+    objectTemplate->setScale({2.0, 2.0, 2.0});
+    objectAttributesManager->registerObject(objectTemplate);
+    int scaledObjectId = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_EQ(bPhysManager->getNumCachedCollisionShapes(), 2u);
+
+    const Magnum::Range3D unitBounds({-1.0, -1.0, -1.0}, {1.0, 1.0, 1.0});
+    const Magnum::Range3D scaledBounds({-2.0, -2.0, -2.0}, {2.0, 2.0, 2.0});
+    for (int objectId : objectIds) {
+      ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId), unitBounds);
+    }
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(scaledObjectId),
+              scaledBounds);
+
+    // changing the margin of one instance leaves the others alone
+    bPhysManager->setMargin(objectIds[0], 0.1);
+    ASSERT_NEAR(bPhysManager->getMargin(objectIds[0]), 0.1, 1e-6);
+    for (size_t i = 1; i < objectIds.size(); ++i) {
+      ASSERT_EQ(bPhysManager->getMargin(objectIds[i]), 0.0);
+      ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectIds[i]),
+                unitBounds);
+    }
+  }
+}
+
+TEST_F(PhysicsManagerTest, BulletStageBvhCache) {
+  // a stage loaded with the BVHs from the cache file behaves like one which
+  // built them
+  LOG(INFO) << "Starting physics test: BulletStageBvhCache";
+
+  const std::string stageFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "bvhCacheSimpleRoom.glb");
+  ASSERT_TRUE(Cr::Utility::Directory::copy(
+      Cr::Utility::Directory::join(dataDir,
+                                   "test_assets/scenes/simple_room.glb"),
+      stageFile));
+  const std::string cacheFile =
+      esp::physics::BulletBvhCache::getCacheFilename(stageFile);
+  Cr::Utility::Directory::rm(cacheFile);
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  std::vector<esp::geo::Ray> rays;
+  for (int i = -10; i <= 10; ++i) {
+    for (int j = -10; j <= 10; ++j) {
+      rays.emplace_back(Magnum::Vector3{i * 0.5f, 5.0f, j * 0.5f},
+                        Magnum::Vector3{0.1f * i, -1.0f, 0.1f * j});
+    }
+  }
+
+  std::vector<esp::physics::RaycastResults> results[2];
+  std::vector<bool> contacts[2];
+  for (int load = 0; load < 2; ++load) {
+    if (load == 1) {
+      // a fresh ResourceManager and physics world, reading the cache
+      ASSERT_TRUE(Cr::Utility::Directory::exists(cacheFile));
+      ASSERT_GT(esp::physics::BulletBvhCache{cacheFile}.size(), 0u);
+      physicsManager_ = nullptr;
+      resourceManager_ = std::make_unique<ResourceManager>(metadataMediator_);
+    }
+    initStage(stageFile);
+    if (physicsManager_->getPhysicsSimulationLibrary() !=
+        PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+      Cr::Utility::Directory::rm(stageFile);
+      return;
+    }
+
+    for (const esp::geo::Ray& ray : rays) {
+      results[load].push_back(physicsManager_->castRay(ray));
+    }
+
+    // a box just above and just below every surface hit from above
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.0);
+    metadataMediator_->getObjectAttributesManager()->registerObject(
+        ObjectAttributes, objectFile);
+    const int objectId = physicsManager_->addObject(objectFile, nullptr);
+    for (const esp::physics::RaycastResults& result : results[load]) {
+      if (result.hits.empty()) {
+        continue;
+      }
+      for (const float offset : {0.9f, 1.1f}) {
+        physicsManager_->setTranslation(
+            objectId, result.hits[0].point + Magnum::Vector3{0, offset, 0});
+        contacts[load].push_back(physicsManager_->contactTest(objectId));
+      }
+    }
+  }
+
+  ASSERT_EQ(results[0].size(), results[1].size());
+  for (size_t i = 0; i < results[0].size(); ++i) {
+    ASSERT_EQ(results[0][i].hits.size(), results[1][i].hits.size());
+    for (size_t j = 0; j < results[0][i].hits.size(); ++j) {
+      const esp::physics::RayHitInfo& built = results[0][i].hits[j];
+      const esp::physics::RayHitInfo& cached = results[1][i].hits[j];
+      ASSERT_EQ(built.objectId, cached.objectId);
+      ASSERT_EQ(built.point, cached.point);
+      ASSERT_EQ(built.normal, cached.normal);
+      ASSERT_EQ(built.rayDistance, cached.rayDistance);
+    }
+  }
+  ASSERT_FALSE(contacts[0].empty());
+  ASSERT_EQ(contacts[0], contacts[1]);
+
+  // an entry too small to hold a BVH is rejected before it is read. The
+  // 24 byte file header is followed by the entries, each ending with its
+  // 8 byte size.
+  Cr::Containers::Array<char> data = Cr::Utility::Directory::read(cacheFile);
+  ASSERT_GE(data.size(), 48u);
+  const uint64_t tooSmall = 8;
+  std::memcpy(data.data() + 40, &tooSmall, sizeof(tooSmall));
+  ASSERT_TRUE(Cr::Utility::Directory::write(cacheFile, data));
+  ASSERT_EQ(esp::physics::BulletBvhCache{cacheFile}.size(), 0u);
+
+  Cr::Utility::Directory::rm(cacheFile);
+  Cr::Utility::Directory::rm(stageFile);
+}
+
+TEST_F(PhysicsManagerTest, BulletCollisionHullCache) {
+  // preprocessed collision hulls are written next to the collision asset and
+  // picked up by a later ResourceManager, even without the asset
+  LOG(INFO) << "Starting physics test: BulletCollisionHullCache";
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/nested_box.glb");
+  const std::string collisionName = "hullCacheNestedBox.glb";
+  const std::string collisionFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), collisionName);
+  ASSERT_TRUE(Cr::Utility::Directory::copy(objectFile, collisionFile));
+
+  initStage(stageFile);
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setCollisionAssetHandle(collisionFile);
+    ObjectAttributes->setCollisionHullMaxVertices(8);
+    ObjectAttributes->setMargin(0.0);
+    metadataMediator_->getObjectAttributesManager()->registerObject(
+        ObjectAttributes, objectFile);
+
+    auto* drawables = &sceneManager_.getSceneGraph(sceneID_).getDrawables();
+    const int objectId = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_NE(objectId, esp::ID_UNDEFINED);
+    const Magnum::Range3D aabb =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get())
+            ->getCollisionShapeAabb(objectId);
+
+    // the cache is named after the full asset filename
+    std::vector<std::string> cacheFiles;
+    for (const std::string& file :
+         Cr::Utility::Directory::list(Cr::Utility::Directory::tmp())) {
+      if (Cr::Utility::String::beginsWith(file,
+                                          collisionName + ".collision_")) {
+        cacheFiles.push_back(
+            Cr::Utility::Directory::join(Cr::Utility::Directory::tmp(), file));
+      }
+    }
+    ASSERT_EQ(cacheFiles.size(), 1u);
+
+    // a fresh ResourceManager uses the cache without the collision asset
+    Cr::Utility::Directory::rm(collisionFile);
+    physicsManager_ = nullptr;
+    resourceManager_ = std::make_unique<ResourceManager>(metadataMediator_);
+    initStage(stageFile);
+    const int cachedObjectId =
+        physicsManager_->addObject(objectFile, drawables);
+    ASSERT_NE(cachedObjectId, esp::ID_UNDEFINED);
+    ASSERT_EQ(
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get())
+            ->getCollisionShapeAabb(cachedObjectId),
+        aabb);
+
+    Cr::Utility::Directory::rm(cacheFiles[0]);
+  }
+  Cr::Utility::Directory::rm(collisionFile);
+}
 #endif
 
 TEST_F(PhysicsManagerTest, ConfigurableScaling) {
@@ -558,6 +784,28 @@ TEST_F(PhysicsManagerTest, TestVelocityControl) {
       physicsManager_->getRotation(objectId), qLocalGroundTruth);
 
   ASSERT_LE(float(angleErrorLocal), errorEps);
+
+  // a released control is applied until it is deactivated, and can be
+  // activated again after getting it anew
+  velControl->linVel = Magnum::Vector3{0.0, 0.0, -1.0};
+  velControl.reset();
+  physicsManager_->stepPhysics(physicsManager_->getTimestep());
+  ASSERT_GT((physicsManager_->getTranslation(objectId) - posLocalGroundTruth)
+                .length(),
+            errorEps);
+
+  Magnum::Vector3 posReleased = physicsManager_->getTranslation(objectId);
+  velControl = physicsManager_->getVelocityControl(objectId);
+  velControl->controllingLinVel = false;
+  velControl->controllingAngVel = false;
+  velControl.reset();
+  physicsManager_->stepPhysics(physicsManager_->getTimestep());
+  ASSERT_EQ(physicsManager_->getTranslation(objectId), posReleased);
+
+  velControl = physicsManager_->getVelocityControl(objectId);
+  velControl->controllingLinVel = true;
+  physicsManager_->stepPhysics(physicsManager_->getTimestep());
+  ASSERT_NE(physicsManager_->getTranslation(objectId), posReleased);
 }
 
 TEST_F(PhysicsManagerTest, TestSceneNodeAttachment) {
@@ -831,3 +1079,356 @@ TEST_F(PhysicsManagerTest, TestRemoveSleepingSupport) {
     ASSERT_GT(physicsManager_->getNumActiveContactPoints(), 0);
   }
 }
+
+TEST_F(PhysicsManagerTest, TestSaveRestoreState) {
+  // test that restoring a snapshot reproduces the same rollout
+  LOG(INFO) << "Starting physics test: TestSaveRestoreState";
+
+  std::string stageFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/scenes/simple_room.glb");
+
+  initStage(stageFile);
+  auto& drawables = sceneManager_.getSceneGraph(sceneID_).getDrawables();
+
+  if (physicsManager_->getPhysicsSimulationLibrary() !=
+      PhysicsManager::PhysicsSimulationLibrary::NONE) {
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+
+    std::string cubeHandle =
+        objectAttributesManager->getObjectHandlesBySubstring("cubeSolid")[0];
+
+    // drop a few cubes on top of each other
+    Mn::Vector3 stackBase(0.21964, 1.5, -0.0897472);
+    std::vector<int> cubeIds;
+    for (int i = 0; i < 3; ++i) {
+      cubeIds.push_back(physicsManager_->addObject(cubeHandle, &drawables));
+      physicsManager_->setTranslation(
+          cubeIds.back(), (Mn::Vector3(0.03, 0.3, 0) * i) + stackBase);
+    }
+    physicsManager_->stepPhysics(0.25);
+
+    esp::physics::PhysicsState state;
+    physicsManager_->saveState(state);
+    ASSERT_EQ(state.objects.size(), cubeIds.size());
+    ASSERT_EQ(state.worldTime, physicsManager_->getWorldTime());
+
+    // roll out, then restore and roll out again
+    std::vector<Mn::Vector3> firstRollout;
+    physicsManager_->stepPhysics(1.0);
+    for (auto id : cubeIds) {
+      firstRollout.push_back(physicsManager_->getTranslation(id));
+    }
+
+    ASSERT_TRUE(physicsManager_->restoreState(state));
+    ASSERT_EQ(physicsManager_->getWorldTime(), state.worldTime);
+    for (size_t i = 0; i < cubeIds.size(); ++i) {
+      ASSERT_EQ(physicsManager_->getTranslation(cubeIds[i]),
+                state.objects[i].translation);
+      ASSERT_EQ(physicsManager_->getLinearVelocity(cubeIds[i]),
+                state.objects[i].linearVelocity);
+    }
+
+    // the contact points Bullet caches between steps to warm start its
+    // solver are not part of the snapshot, so once the cubes touch the
+    // rollouts only match approximately, see TestSaveRestoreStateFreeFall
+    physicsManager_->stepPhysics(1.0);
+    for (size_t i = 0; i < cubeIds.size(); ++i) {
+      ASSERT_LE(
+          (physicsManager_->getTranslation(cubeIds[i]) - firstRollout[i])
+              .length(),
+          1e-3);
+    }
+
+    // removed objects can not be restored
+    physicsManager_->removeObject(cubeIds.back());
+    ASSERT_FALSE(physicsManager_->restoreState(state));
+  }
+}
+
+TEST_F(PhysicsManagerTest, TestSaveRestoreStateFreeFall) {
+  // test that a restored world replays the saved trajectory exactly, including
+  // the time left over between steps, as long as nothing touches
+  LOG(INFO) << "Starting physics test: TestSaveRestoreStateFreeFall";
+
+  std::string stageFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/scenes/simple_room.glb");
+
+  initStage(stageFile);
+  auto& drawables = sceneManager_.getSceneGraph(sceneID_).getDrawables();
+
+  if (physicsManager_->getPhysicsSimulationLibrary() !=
+      PhysicsManager::PhysicsSimulationLibrary::NONE) {
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+
+    std::string cubeHandle =
+        objectAttributesManager->getObjectHandlesBySubstring("cubeSolid")[0];
+    const int cubeId = physicsManager_->addObject(cubeHandle, &drawables);
+    physicsManager_->setTranslation(cubeId, Mn::Vector3(0.2, 100.0, 0.0));
+    physicsManager_->setAngularVelocity(cubeId, Mn::Vector3(1.0, 2.0, 3.0));
+
+    // not a multiple of the fixed time step, so time is left over
+    const double dt = 0.7 * physicsManager_->getTimestep();
+    for (int i = 0; i < 13; ++i) {
+      physicsManager_->stepPhysics(dt);
+    }
+    esp::physics::PhysicsState state;
+    physicsManager_->saveState(state);
+    ASSERT_GT(state.pendingTime, 0.0);
+
+    auto rollout = [&]() {
+      std::vector<Mn::Vector3> translations;
+      std::vector<Mn::Quaternion> rotations;
+      for (int i = 0; i < 30; ++i) {
+        physicsManager_->stepPhysics(dt);
+        translations.push_back(physicsManager_->getTranslation(cubeId));
+        rotations.push_back(physicsManager_->getRotation(cubeId));
+      }
+      return std::make_pair(translations, rotations);
+    };
+    const auto firstRollout = rollout();
+    const double firstWorldTime = physicsManager_->getWorldTime();
+    ASSERT_GT(firstRollout.first.front().y(), firstRollout.first.back().y());
+
+    ASSERT_TRUE(physicsManager_->restoreState(state));
+    const auto secondRollout = rollout();
+    ASSERT_EQ(physicsManager_->getWorldTime(), firstWorldTime);
+    for (size_t i = 0; i < firstRollout.first.size(); ++i) {
+      ASSERT_EQ(secondRollout.first[i], firstRollout.first[i]);
+      ASSERT_EQ(secondRollout.second[i], firstRollout.second[i]);
+    }
+  }
+}
+
+TEST_F(PhysicsManagerTest, TestContactEvents) {
+  // test that contact events track a cube landing on the table
+  LOG(INFO) << "Starting physics test: TestContactEvents";
+
+  std::string stageFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/scenes/simple_room.glb");
+
+  initStage(stageFile);
+  auto& drawables = sceneManager_.getSceneGraph(sceneID_).getDrawables();
+
+  if (physicsManager_->getPhysicsSimulationLibrary() !=
+      PhysicsManager::PhysicsSimulationLibrary::NONE) {
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+
+    std::string cubeHandle =
+        objectAttributesManager->getObjectHandlesBySubstring("cubeSolid")[0];
+    int cubeId = physicsManager_->addObject(cubeHandle, &drawables);
+    physicsManager_->setTranslation(cubeId,
+                                    Mn::Vector3(0.21964, 1.5, -0.0897472));
+    ASSERT_FALSE(physicsManager_->getContactEventsEnabled());
+    physicsManager_->setContactEventsEnabled(true);
+
+    // falling
+    physicsManager_->stepPhysics(1.0 / 60.0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 0);
+    esp::physics::PhysicsState fallingState;
+    physicsManager_->saveState(fallingState);
+
+    // landing on the table
+    using esp::physics::ContactEventType;
+    int numBegin = 0;
+    while (physicsManager_->getWorldTime() < 2.0 && numBegin == 0) {
+      physicsManager_->stepPhysics(1.0 / 60.0);
+      const esp::physics::ContactEvents& events =
+          physicsManager_->getContactEvents();
+      for (int i = 0; i < events.size(); ++i) {
+        ASSERT_EQ(events.objectIdsA[i], -1);
+        ASSERT_EQ(events.objectIdsB[i], cubeId);
+        ASSERT_EQ(events.types[i], int(ContactEventType::BEGIN));
+        ++numBegin;
+      }
+    }
+    ASSERT_EQ(numBegin, 1);
+
+    // resting
+    physicsManager_->stepPhysics(1.0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 1);
+    ASSERT_EQ(physicsManager_->getContactEvents().types[0],
+              int(ContactEventType::PERSIST));
+    ASSERT_GT(physicsManager_->getContactEvents().impulses[0], 0);
+
+    // back in the air, the contact is forgotten rather than ended
+    ASSERT_TRUE(physicsManager_->restoreState(fallingState));
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 0);
+    physicsManager_->stepPhysics(1.0 / 60.0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 0);
+    while (physicsManager_->getContactEvents().size() == 0 &&
+           physicsManager_->getWorldTime() < 4.0) {
+      physicsManager_->stepPhysics(1.0 / 60.0);
+    }
+    ASSERT_EQ(physicsManager_->getContactEvents().types[0],
+              int(ContactEventType::BEGIN));
+    physicsManager_->stepPhysics(1.0);
+
+    // removed
+    physicsManager_->removeObject(cubeId);
+    physicsManager_->stepPhysics(1.0 / 60.0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 1);
+    ASSERT_EQ(physicsManager_->getContactEvents().types[0],
+              int(ContactEventType::END));
+    ASSERT_EQ(physicsManager_->getContactEvents().objectIdsB[0], cubeId);
+  }
+}
+
+TEST_F(PhysicsManagerTest, TestContactEventsWithinStep) {
+  // test that a bounce starting and ending within the substeps of a single
+  // step is reported
+  LOG(INFO) << "Starting physics test: TestContactEventsWithinStep";
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+
+  initStage(stageFile);
+  auto& drawables = sceneManager_.getSceneGraph(sceneID_).getDrawables();
+
+  if (physicsManager_->getPhysicsSimulationLibrary() !=
+      PhysicsManager::PhysicsSimulationLibrary::NONE) {
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+
+    std::string cubeHandle =
+        objectAttributesManager->getObjectHandlesBySubstring("cubeSolid")[0];
+    int cubeId = physicsManager_->addObject(cubeHandle, &drawables);
+    physicsManager_->setTranslation(cubeId, Mn::Vector3(0, 2.0, 0));
+    physicsManager_->setContactEventsEnabled(true);
+
+    // resting on the plane
+    physicsManager_->stepPhysics(2.0);
+    using esp::physics::ContactEventType;
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 1);
+    const Mn::Vector3 restingTranslation =
+        physicsManager_->getTranslation(cubeId);
+
+    // lifted off
+    physicsManager_->setTranslation(
+        cubeId, restingTranslation + Mn::Vector3(0, 0.5, 0));
+    // wakes the cube up
+    physicsManager_->setLinearVelocity(cubeId, Mn::Vector3{});
+    physicsManager_->stepPhysics(1.0 / 60.0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 1);
+    ASSERT_EQ(physicsManager_->getContactEvents().types[0],
+              int(ContactEventType::END));
+
+    // thrown down, bouncing back up within the same step
+    physicsManager_->setStageRestitutionCoefficient(1.0);
+    physicsManager_->setRestitutionCoefficient(cubeId, 1.0);
+    physicsManager_->setLinearVelocity(cubeId, Mn::Vector3(0, -5.0, 0));
+    physicsManager_->stepPhysics(0.25);
+    ASSERT_GT(physicsManager_->getTranslation(cubeId).y(),
+              restingTranslation.y());
+    ASSERT_GT(physicsManager_->getLinearVelocity(cubeId).y(), 0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 1);
+    ASSERT_EQ(physicsManager_->getContactEvents().types[0],
+              int(ContactEventType::BEGIN));
+    ASSERT_EQ(physicsManager_->getContactEvents().objectIdsA[0], -1);
+    ASSERT_EQ(physicsManager_->getContactEvents().objectIdsB[0], cubeId);
+    ASSERT_GT(physicsManager_->getContactEvents().impulses[0], 0);
+
+    // and ended by the next step
+    physicsManager_->stepPhysics(1.0 / 60.0);
+    ASSERT_EQ(physicsManager_->getContactEvents().size(), 1);
+    ASSERT_EQ(physicsManager_->getContactEvents().types[0],
+              int(ContactEventType::END));
+    ASSERT_EQ(physicsManager_->getContactEvents().impulses[0], 0);
+  }
+}
+
+TEST_F(PhysicsManagerTest, TestFixedSubsteps) {
+  // test that the deterministic mode carries over partial substeps and that
+  // the substep budget drops the excess time
+  LOG(INFO) << "Starting physics test: TestFixedSubsteps";
+
+  std::string stageFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/scenes/simple_room.glb");
+
+  auto physicsManagerAttributes =
+      physicsAttributesManager_->createObject(physicsConfigFile, true);
+  physicsManagerAttributes->setSubstepInterpolation(false);
+  physicsManagerAttributes->setMaxSubsteps(4);
+  initStage(stageFile, physicsManagerAttributes);
+
+  const double fixedTimeStep = physicsManager_->getTimestep();
+  physicsManager_->stepPhysics(0.5 * fixedTimeStep);
+  ASSERT_EQ(physicsManager_->getStepStats().lastNumSubsteps, 0);
+  ASSERT_EQ(physicsManager_->getWorldTime(), 0.0);
+
+  physicsManager_->stepPhysics(0.5 * fixedTimeStep);
+  ASSERT_EQ(physicsManager_->getStepStats().lastNumSubsteps, 1);
+
+  physicsManager_->stepPhysics(10 * fixedTimeStep);
+  const esp::physics::PhysicsStepStats& stats =
+      physicsManager_->getStepStats();
+  ASSERT_EQ(stats.numSteps, 3);
+  ASSERT_EQ(stats.numSubsteps, 5);
+  ASSERT_EQ(stats.lastNumSubsteps, 4);
+  ASSERT_EQ(stats.numDroppedSubsteps, 6);
+  ASSERT_GE(stats.totalStepDuration, stats.maxStepDuration);
+  ASSERT_NEAR(physicsManager_->getWorldTime(), 5 * fixedTimeStep, 1e-9);
+
+  physicsManager_->resetStepStats();
+  ASSERT_EQ(physicsManager_->getStepStats().numSteps, 0);
+}
+
+TEST_F(PhysicsManagerTest, TestInterpolatedSubsteps) {
+  // test that the substep budget also holds when Bullet interpolates, and
+  // that time and kinematic objects only advance by the substeps taken
+  LOG(INFO) << "Starting physics test: TestInterpolatedSubsteps";
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+
+  auto physicsManagerAttributes =
+      physicsAttributesManager_->createObject(physicsConfigFile, true);
+  physicsManagerAttributes->setSubstepInterpolation(true);
+  physicsManagerAttributes->setMaxSubsteps(4);
+  initStage(stageFile, physicsManagerAttributes);
+  auto& drawables = sceneManager_.getSceneGraph(sceneID_).getDrawables();
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+    std::string cubeHandle =
+        objectAttributesManager->getObjectHandlesBySubstring("cubeSolid")[0];
+    int cubeId = physicsManager_->addObject(cubeHandle, &drawables);
+    physicsManager_->setObjectMotionType(cubeId,
+                                         esp::physics::MotionType::KINEMATIC);
+    physicsManager_->setTranslation(cubeId, Mn::Vector3{0, 5.0, 0});
+    esp::physics::VelocityControl::ptr velControl =
+        physicsManager_->getVelocityControl(cubeId);
+    velControl->controllingLinVel = true;
+    velControl->linVel = Mn::Vector3{1.0, 0, 0};
+
+    // 10 substeps worth of time, 6 over budget
+    const double fixedTimeStep = physicsManager_->getTimestep();
+    physicsManager_->stepPhysics(10.5 * fixedTimeStep);
+    const esp::physics::PhysicsStepStats& stats =
+        physicsManager_->getStepStats();
+    ASSERT_EQ(stats.lastNumSubsteps, 4);
+    ASSERT_EQ(stats.numSubsteps, 4);
+    ASSERT_EQ(stats.numDroppedSubsteps, 6);
+    ASSERT_NEAR(physicsManager_->getWorldTime(), 4 * fixedTimeStep, 1e-9);
+    ASSERT_NEAR(physicsManager_->getTranslation(cubeId).x(),
+                4 * fixedTimeStep, 1e-5);
+
+    // the leftover half substep is kept by Bullet
+    physicsManager_->stepPhysics(0.25 * fixedTimeStep);
+    ASSERT_EQ(stats.lastNumSubsteps, 0);
+    ASSERT_NEAR(physicsManager_->getWorldTime(), 4 * fixedTimeStep, 1e-9);
+    ASSERT_NEAR(physicsManager_->getTranslation(cubeId).x(),
+                4 * fixedTimeStep, 1e-5);
+
+    physicsManager_->stepPhysics(0.5 * fixedTimeStep);
+    ASSERT_EQ(stats.lastNumSubsteps, 1);
+    ASSERT_EQ(stats.numDroppedSubsteps, 6);
+    ASSERT_NEAR(physicsManager_->getWorldTime(), 5 * fixedTimeStep, 1e-9);
+    ASSERT_NEAR(physicsManager_->getTranslation(cubeId).x(),
+                5 * fixedTimeStep, 1e-5);
+  }
+}
@@ -2,13 +2,20 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/EigenIntegration/Integration.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Range.h>
+#include <Magnum/PixelFormat.h>
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 
+#include "esp/assets/CollisionMeshPreprocessor.h"
 #include "esp/assets/ResourceManager.h"
 #include "esp/gfx/Renderer.h"
 #include "esp/gfx/WindowlessContext.h"
@@ -84,3 +91,245 @@ TEST(ResourceManagerTest, createJoinedCollisionMesh) {
     ASSERT_EQ(indexGroundTruth[iix], joinedBox->ibo[iix]);
   }
 }
+
+TEST(ResourceManagerTest, loaderThreads) {
+  esp::gfx::WindowlessContext::uptr context_ =
+      esp::gfx::WindowlessContext::create_unique(0);
+
+  std::shared_ptr<esp::gfx::Renderer> renderer_ = esp::gfx::Renderer::create();
+
+  std::string boxFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/transform_box.glb");
+
+  // the asset must load the same regardless of the number of loader threads
+  std::vector<esp::assets::MeshData::uptr> joinedBoxes;
+  for (size_t numThreads : {1, 4}) {
+    // must declare these in this order due to avoid deallocation errors
+    auto MM = MetadataMediator::create();
+    ResourceManager resourceManager(MM);
+    resourceManager.setNumLoaderThreads(numThreads);
+    ASSERT_EQ(resourceManager.getNumLoaderThreads(), numThreads);
+    SceneManager sceneManager_;
+    auto stageAttributes =
+        MM->getStageAttributesManager()->createObject(boxFile, true);
+
+    int sceneID = sceneManager_.initSceneGraph();
+    std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+    ASSERT_TRUE(resourceManager.loadStage(stageAttributes, nullptr,
+                                          &sceneManager_, tempIDs, false));
+
+    const esp::assets::MeshMetaData& metaData =
+        resourceManager.getMeshMetaData(boxFile);
+    ASSERT_EQ(metaData.meshIndex.second - metaData.meshIndex.first + 1, 6);
+    joinedBoxes.emplace_back(
+        resourceManager.createJoinedCollisionMesh(boxFile));
+  }
+
+  ASSERT_EQ(joinedBoxes[0]->vbo, joinedBoxes[1]->vbo);
+  ASSERT_EQ(joinedBoxes[0]->ibo, joinedBoxes[1]->ibo);
+}
+
+namespace {
+class ResourceManagerExtended : public ResourceManager {
+ public:
+  explicit ResourceManagerExtended(MetadataMediator::ptr& _metadataMediator)
+      : ResourceManager(_metadataMediator) {}
+  const std::vector<std::shared_ptr<Mn::GL::Texture2D>>& getTextures() const {
+    return textures_;
+  }
+};
+}  // namespace
+
+TEST(ResourceManagerTest, loaderThreadsTextures) {
+  esp::gfx::WindowlessContext::uptr context_ =
+      esp::gfx::WindowlessContext::create_unique(0);
+
+  std::shared_ptr<esp::gfx::Renderer> renderer_ = esp::gfx::Renderer::create();
+
+  // five textures, decoded in several batches on several importers
+  std::string quadFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/textured_quad.gltf");
+
+  // the first level of every texture, as decoded by a single thread
+  std::vector<Mn::Vector2i> expectedSizes;
+  std::vector<std::vector<char>> expectedPixels;
+  for (size_t numThreads : {1, 2, 4}) {
+    SCOPED_TRACE(numThreads);
+    // must declare these in this order due to avoid deallocation errors
+    auto MM = MetadataMediator::create();
+    ResourceManagerExtended resourceManager(MM);
+    ASSERT_EQ(resourceManager.getNumLoaderThreads(),
+              ResourceManager::DEFAULT_NUM_LOADER_THREADS);
+    resourceManager.setNumLoaderThreads(numThreads);
+    SceneManager sceneManager_;
+    auto stageAttributes =
+        MM->getStageAttributesManager()->createObject(quadFile, true);
+
+    int sceneID = sceneManager_.initSceneGraph();
+    std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+    ASSERT_TRUE(resourceManager.loadStage(stageAttributes, nullptr,
+                                          &sceneManager_, tempIDs, false));
+
+    const esp::assets::MeshMetaData& metaData =
+        resourceManager.getMeshMetaData(quadFile);
+    ASSERT_EQ(metaData.textureIndex.second - metaData.textureIndex.first + 1,
+              5);
+    ASSERT_EQ(metaData.meshIndex.second - metaData.meshIndex.first + 1, 1);
+
+    // failed decodes would leave null textures
+    const auto& textures = resourceManager.getTextures();
+    for (int i = metaData.textureIndex.first; i <= metaData.textureIndex.second;
+         ++i) {
+      ASSERT_NE(textures[i], nullptr);
+#ifndef MAGNUM_TARGET_GLES
+      Mn::Image2D image = textures[i]->image(0, {Mn::PixelFormat::RGBA8Unorm});
+      std::vector<char> pixels(image.data().begin(), image.data().end());
+      if (numThreads == 1) {
+        expectedSizes.push_back(image.size());
+        expectedPixels.push_back(std::move(pixels));
+      } else {
+        const size_t iTexture = i - metaData.textureIndex.first;
+        ASSERT_EQ(image.size(), expectedSizes[iTexture]);
+        ASSERT_EQ(pixels, expectedPixels[iTexture]);
+      }
+#endif
+    }
+  }
+}
+
+namespace {
+// append the 12 triangles of an axis-aligned box to a triangle soup
+void addBoxTriangles(const Magnum::Vector3& min,
+                     const Magnum::Vector3& max,
+                     std::vector<Magnum::Vector3>& triangles) {
+  auto corner = [&](int i) {
+    return Magnum::Vector3{(i & 1) ? max.x() : min.x(),
+                           (i & 2) ? max.y() : min.y(),
+                           (i & 4) ? max.z() : min.z()};
+  };
+  const int faces[6][4]{{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4},
+                        {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+  for (const auto& face : faces) {
+    for (int i : {0, 1, 2, 0, 2, 3}) {
+      triangles.push_back(corner(face[i]));
+    }
+  }
+}
+}  // namespace
+
+TEST(ResourceManagerTest, collisionMeshPreprocessor) {
+  using esp::assets::CollisionMeshPreprocessor;
+
+  // a dense sphere is reduced to a bounded set of its own points, spread over
+  // all of it
+  std::vector<Magnum::Vector3> sphere;
+  for (int i = 0; i <= 40; ++i) {
+    for (int j = 0; j < 40; ++j) {
+      const float theta = Magnum::Constants::pi() * i / 40;
+      const float phi = 2 * Magnum::Constants::pi() * j / 40;
+      sphere.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta),
+                          std::sin(theta) * std::sin(phi));
+    }
+  }
+  std::vector<Magnum::Vector3> reduced =
+      CollisionMeshPreprocessor::reduceHullVertices(sphere, 32);
+  ASSERT_LE(reduced.size(), 32u);
+  ASSERT_GE(reduced.size(), 16u);
+  float maxY = 0, minY = 0;
+  for (const Magnum::Vector3& point : reduced) {
+    ASSERT_NEAR(point.length(), 1.0, 1e-5);
+    maxY = std::max(maxY, point.y());
+    minY = std::min(minY, point.y());
+  }
+  ASSERT_GT(maxY, 0.9);
+  ASSERT_LT(minY, -0.9);
+
+  // a convex box is kept whole, two boxes apart are split between them
+  std::vector<Magnum::Vector3> box;
+  addBoxTriangles({-1, -1, -1}, {1, 1, 1}, box);
+  ASSERT_EQ(CollisionMeshPreprocessor::decompose(box, 8, 0.1).size(), 1u);
+
+  std::vector<Magnum::Vector3> twoBoxes;
+  addBoxTriangles({-3, -1, -1}, {-1, 1, 1}, twoBoxes);
+  addBoxTriangles({1, -1, -1}, {3, 1, 1}, twoBoxes);
+  std::vector<std::vector<Magnum::Vector3>> parts =
+      CollisionMeshPreprocessor::decompose(twoBoxes, 8, 0.1);
+  ASSERT_GE(parts.size(), 2u);
+  for (const auto& part : parts) {
+    ASSERT_FALSE(part.empty());
+    const bool left = part.front().x() < 0;
+    for (const Magnum::Vector3& v : part) {
+      ASSERT_EQ(v.x() < 0, left);
+    }
+  }
+
+  // hulls survive a round trip through the cache file
+  const std::string cacheFilename = CollisionMeshPreprocessor::getCacheFilename(
+      Cr::Utility::Directory::join(Cr::Utility::Directory::tmp(),
+                                   "collisionMeshPreprocessor.glb"),
+      {});
+  ASSERT_TRUE(CollisionMeshPreprocessor::isCacheFilename(cacheFilename));
+  const CollisionMeshPreprocessor::Hulls hulls{reduced, {{0.0f, 1.0f, 2.0f}}};
+  ASSERT_TRUE(CollisionMeshPreprocessor::saveHulls(
+      cacheFilename, "collisionMeshPreprocessor.glb", hulls));
+  CollisionMeshPreprocessor::Hulls loaded;
+  ASSERT_TRUE(CollisionMeshPreprocessor::loadHulls(cacheFilename, loaded));
+  ASSERT_EQ(loaded, hulls);
+  Cr::Utility::Directory::rm(cacheFilename);
+
+  // assets differing only in their extension get their own caches
+  ASSERT_NE(CollisionMeshPreprocessor::getCacheFilename("chair.glb", {}),
+            CollisionMeshPreprocessor::getCacheFilename("chair.obj", {}));
+
+  // a cache is stale once the contents of its source change, even if the
+  // size stays the same
+  const std::string sourceFilename = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "collisionMeshPreprocessorSource.obj");
+  const std::string sourceCacheFilename =
+      CollisionMeshPreprocessor::getCacheFilename(sourceFilename, {});
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(sourceFilename, "abcd"));
+  ASSERT_TRUE(CollisionMeshPreprocessor::saveHulls(sourceCacheFilename,
+                                                   sourceFilename, hulls));
+  ASSERT_TRUE(
+      CollisionMeshPreprocessor::loadHulls(sourceCacheFilename, loaded));
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(sourceFilename, "abce"));
+  ASSERT_FALSE(
+      CollisionMeshPreprocessor::loadHulls(sourceCacheFilename, loaded));
+
+  // a cache renamed to another asset is rejected
+  const std::string otherCacheFilename =
+      CollisionMeshPreprocessor::getCacheFilename(
+          Cr::Utility::Directory::join(Cr::Utility::Directory::tmp(),
+                                       "collisionMeshPreprocessorOther.obj"),
+          {});
+  ASSERT_TRUE(CollisionMeshPreprocessor::saveHulls(otherCacheFilename,
+                                                   sourceFilename, hulls));
+  ASSERT_FALSE(
+      CollisionMeshPreprocessor::loadHulls(otherCacheFilename, loaded));
+
+  // counts larger than the file are rejected without allocating them
+  ASSERT_TRUE(CollisionMeshPreprocessor::saveHulls(sourceCacheFilename,
+                                                   sourceFilename, hulls));
+  Cr::Containers::Array<char> data =
+      Cr::Utility::Directory::read(sourceCacheFilename);
+  // numHulls follows magic, version, source size, hash and name length
+  const size_t numHullsOffset = 28;
+  const uint32_t hugeCount = 0x7fffffff;
+  std::memcpy(data.data() + numHullsOffset, &hugeCount, sizeof(hugeCount));
+  ASSERT_TRUE(Cr::Utility::Directory::write(sourceCacheFilename, data));
+  ASSERT_FALSE(
+      CollisionMeshPreprocessor::loadHulls(sourceCacheFilename, loaded));
+  // the same for the number of points of the last hull
+  const size_t numPointsOffset = data.size() - sizeof(uint32_t) -
+                                 hulls[1].size() * sizeof(Magnum::Vector3);
+  const uint32_t numHulls = hulls.size();
+  std::memcpy(data.data() + numHullsOffset, &numHulls, sizeof(numHulls));
+  std::memcpy(data.data() + numPointsOffset, &hugeCount, sizeof(hugeCount));
+  ASSERT_TRUE(Cr::Utility::Directory::write(sourceCacheFilename, data));
+  ASSERT_FALSE(
+      CollisionMeshPreprocessor::loadHulls(sourceCacheFilename, loaded));
+
+  Cr::Utility::Directory::rm(sourceCacheFilename);
+  Cr::Utility::Directory::rm(otherCacheFilename);
+  Cr::Utility::Directory::rm(sourceFilename);
+}
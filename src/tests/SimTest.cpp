@@ -10,9 +10,11 @@
 #include <Magnum/ImageView.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/PixelFormat.h>
+#include <stdexcept>
 #include <string>
 
 #include "esp/assets/ResourceManager.h"
+#include "esp/gfx/BatchRenderer.h"
 #include "esp/physics/RigidObject.h"
 #include "esp/sim/Simulator.h"
 
@@ -90,6 +92,9 @@ struct SimTest : Cr::TestSuite::Tester {
   void reconfigure();
   void reset();
   void getSceneRGBAObservation();
+  void getAgentObservationsAsync();
+  void drawAgentObservations();
+  void batchRenderer();
   void getSceneWithLightingRGBAObservation();
   void getDefaultLightingRGBAObservation();
   void getCustomLightingRGBAObservation();
@@ -115,6 +120,9 @@ SimTest::SimTest() {
             &SimTest::reconfigure,
             &SimTest::reset,
             &SimTest::getSceneRGBAObservation,
+            &SimTest::getAgentObservationsAsync,
+            &SimTest::drawAgentObservations,
+            &SimTest::batchRenderer,
             &SimTest::getSceneWithLightingRGBAObservation,
             &SimTest::getDefaultLightingRGBAObservation,
             &SimTest::getCustomLightingRGBAObservation,
@@ -228,6 +236,205 @@ void SimTest::getSceneRGBAObservation() {
                                     maxThreshold, 0.75f);
 }
 
+void SimTest::getAgentObservationsAsync() {
+  auto simulator = getSimulator(vangogh);
+
+  auto colorSpec = SensorSpec::create();
+  colorSpec->uuid = "color";
+  colorSpec->sensorSubtype = "pinhole";
+  colorSpec->sensorType = SensorType::COLOR;
+  colorSpec->position = {1.0f, 1.5f, 1.0f};
+  colorSpec->resolution = {128, 128};
+  auto depthSpec = SensorSpec::create();
+  *depthSpec = *colorSpec;
+  depthSpec->uuid = "depth";
+  depthSpec->sensorType = SensorType::DEPTH;
+
+  AgentConfiguration agentConfig{};
+  agentConfig.sensorSpecifications = {colorSpec, depthSpec};
+  Agent::ptr agent = simulator->addAgent(agentConfig);
+  agent->setInitialState(AgentState{});
+
+  AgentState movedState{};
+  movedState.position = {0.5f, 0.0f, -0.5f};
+
+  // copy the synchronous observations, as sensors reuse their buffers
+  std::map<std::string, Observation> observations;
+  using Frame = std::map<std::string, std::vector<uint8_t>>;
+  auto readFrame = [&]() {
+    Frame frame;
+    for (const auto& obs : observations) {
+      const auto& data = obs.second.buffer->data;
+      frame[obs.first] = std::vector<uint8_t>(data.begin(), data.end());
+    }
+    return frame;
+  };
+  CORRADE_COMPARE(simulator->getAgentObservations(0, observations), 2);
+  const Frame initialFrame = readFrame();
+  agent->setState(movedState);
+  CORRADE_COMPARE(simulator->getAgentObservations(0, observations), 2);
+  const Frame movedFrame = readFrame();
+  CORRADE_VERIFY(initialFrame.at("color") != movedFrame.at("color"));
+
+  // the agent moves between the calls, with previousFrame each call but the
+  // first one returns the pose of the call before
+  struct {
+    bool moved;
+    bool previousFrame;
+    const Frame& expected;
+  } calls[]{
+      {false, false, initialFrame}, {false, true, initialFrame},
+      {true, true, initialFrame},   {false, true, movedFrame},
+      {true, true, initialFrame},   {true, false, movedFrame},
+  };
+  for (size_t i = 0; i != Cr::Containers::arraySize(calls); ++i) {
+    CORRADE_ITERATION(i);
+    if (calls[i].moved) {
+      agent->setState(movedState);
+    } else {
+      agent->setState(AgentState{});
+    }
+    CORRADE_COMPARE(simulator->getAgentObservationsAsync(
+                        0, observations, calls[i].previousFrame),
+                    2);
+    CORRADE_VERIFY(readFrame() == calls[i].expected);
+  }
+}
+
+void SimTest::drawAgentObservations() {
+  auto simulator = getSimulator(vangogh);
+
+  auto colorSpec = SensorSpec::create();
+  colorSpec->uuid = "color";
+  colorSpec->sensorSubtype = "pinhole";
+  colorSpec->sensorType = SensorType::COLOR;
+  colorSpec->position = {1.0f, 1.5f, 1.0f};
+  colorSpec->resolution = {128, 128};
+  auto depthSpec = SensorSpec::create();
+  *depthSpec = *colorSpec;
+  depthSpec->uuid = "depth";
+  depthSpec->sensorType = SensorType::DEPTH;
+  auto sideColorSpec = SensorSpec::create();
+  *sideColorSpec = *colorSpec;
+  sideColorSpec->uuid = "side_color";
+  sideColorSpec->position = {-1.0f, 1.5f, 1.0f};
+
+  AgentConfiguration agentConfig{};
+  agentConfig.sensorSpecifications = {colorSpec, depthSpec, sideColorSpec};
+  Agent::ptr agent = simulator->addAgent(agentConfig);
+  agent->setInitialState(AgentState{});
+
+  CORRADE_COMPARE(simulator->drawAgentObservations(0), 3);
+
+  // copy the observations of the shared passes, as sensors reuse their
+  // buffers
+  std::map<std::string, Observation> observations;
+  CORRADE_COMPARE(simulator->getAgentObservations(0, observations), 3);
+  std::map<std::string, std::vector<uint8_t>> shared;
+  for (const auto& obs : observations) {
+    const auto& data = obs.second.buffer->data;
+    shared[obs.first] = std::vector<uint8_t>(data.begin(), data.end());
+  }
+
+  // the shared passes match the sensors drawn one by one
+  for (const auto& s : shared) {
+    CORRADE_ITERATION(s.first);
+    Observation obs;
+    CORRADE_VERIFY(simulator->getAgentObservation(0, s.first, obs));
+    const bool depth = s.first == "depth";
+    const Mn::PixelFormat format =
+        depth ? Mn::PixelFormat::R32F : Mn::PixelFormat::RGBA8Unorm;
+    const auto& data = obs.buffer->data;
+    const Mn::ImageView2D expected{
+        format, {128, 128}, {s.second.data(), s.second.size()}};
+    const Mn::ImageView2D actual{
+        format, {128, 128}, {data.data(), data.size()}};
+    CORRADE_COMPARE_WITH(
+        actual, expected,
+        (Mn::DebugTools::CompareImage{maxThreshold, depth ? 0.01f : 0.75f}));
+  }
+}
+
+void SimTest::batchRenderer() {
+  // the simulators share the GL context of the first one
+  std::vector<Simulator::uptr> simulators;
+  simulators.emplace_back(getSimulator(vangogh));
+  simulators.emplace_back(getSimulator(vangogh));
+  simulators.emplace_back(getSimulator(vangogh));
+
+  const Mn::Vector2i tileSize{96, 64};
+  esp::gfx::BatchRenderer batchRenderer{tileSize, int(simulators.size())};
+  CORRADE_COMPARE(batchRenderer.atlasSize(), (Mn::Vector2i{192, 128}));
+
+  std::vector<esp::sensor::VisualSensor*> sensors;
+  for (size_t i = 0; i < simulators.size(); ++i) {
+    auto colorSpec = SensorSpec::create();
+    colorSpec->uuid = "color";
+    colorSpec->sensorSubtype = "pinhole";
+    colorSpec->sensorType = SensorType::COLOR;
+    colorSpec->position = {1.0f - i, 1.5f, 1.0f};
+    colorSpec->resolution = {tileSize.y(), tileSize.x()};
+
+    AgentConfiguration agentConfig{};
+    agentConfig.sensorSpecifications = {colorSpec};
+    Agent::ptr agent = simulators[i]->addAgent(agentConfig);
+    agent->setInitialState(AgentState{});
+    sensors.push_back(static_cast<esp::sensor::VisualSensor*>(
+        agent->getSensorSuite().get("color").get()));
+  }
+
+  batchRenderer.renderEnter();
+  for (size_t i = 0; i < simulators.size(); ++i) {
+    CORRADE_VERIFY(batchRenderer.draw(int(i), *sensors[i],
+                                      simulators[i]->getActiveSceneGraph()));
+  }
+  batchRenderer.renderExit();
+
+  std::vector<uint8_t> batch(tileSize.product() * 4 * simulators.size());
+  batchRenderer.readFrameRgba(Mn::MutableImageView3D{
+      Mn::PixelFormat::RGBA8Unorm,
+      {tileSize, int(simulators.size())},
+      {batch.data(), batch.size()}});
+
+  // each tile matches the observation drawn by its own simulator
+  const size_t tileLength = batch.size() / simulators.size();
+  for (size_t i = 0; i < simulators.size(); ++i) {
+    CORRADE_ITERATION(i);
+    Observation obs;
+    CORRADE_VERIFY(simulators[i]->getAgentObservation(0, "color", obs));
+    const auto& data = obs.buffer->data;
+    CORRADE_VERIFY(std::vector<uint8_t>(data.begin(), data.end()) ==
+                   std::vector<uint8_t>(batch.begin() + i * tileLength,
+                                        batch.begin() + (i + 1) * tileLength));
+  }
+
+  // a view missing a tile is rejected instead of written out of bounds
+  bool threw = false;
+  try {
+    batchRenderer.readFrameRgba(Mn::MutableImageView3D{
+        Mn::PixelFormat::RGBA8Unorm,
+        {tileSize, int(simulators.size()) - 1},
+        {batch.data(), batch.size() - tileLength}});
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  CORRADE_VERIFY(threw);
+
+  // a sensor of a different resolution is rejected
+  auto wideSpec = SensorSpec::create();
+  wideSpec->uuid = "wide";
+  wideSpec->sensorSubtype = "pinhole";
+  wideSpec->resolution = {tileSize.y(), 2 * tileSize.x()};
+  AgentConfiguration agentConfig{};
+  agentConfig.sensorSpecifications = {wideSpec};
+  Agent::ptr agent = simulators[0]->addAgent(agentConfig);
+  CORRADE_VERIFY(!batchRenderer.draw(
+      0,
+      static_cast<esp::sensor::VisualSensor&>(
+          *agent->getSensorSuite().get("wide")),
+      simulators[0]->getActiveSceneGraph()));
+}
+
 void SimTest::getSceneWithLightingRGBAObservation() {
   Corrade::Utility::Debug()
       << "Starting Test : getSceneWithLightingRGBAObservation ";
@@ -180,3 +180,43 @@ def test_greedy_follower(test_navmesh, move_filter_fn, action_noise, pbar):
 
     if not test_all:
         assert test_spl / NUM_TESTS >= ACCEPTABLE_SPLS[(move_filter_fn, action_noise)]
+
+
+@pytest.mark.parametrize("test_navmesh", test_navmeshes)
+def test_greedy_follower_batch(test_navmesh):
+    if not osp.exists(test_navmesh):
+        pytest.skip(f"{test_navmesh} not found")
+
+    pathfinder = habitat_sim.PathFinder()
+    pathfinder.load_nav_mesh(test_navmesh)
+    assert pathfinder.is_loaded
+    pathfinder.seed(0)
+
+    scene_graph = habitat_sim.SceneGraph()
+    agent = habitat_sim.Agent(scene_graph.get_root_node().create_child())
+    agent.controls.move_filter_fn = pathfinder.try_step
+
+    follower = habitat_sim.GreedyGeodesicFollower(
+        pathfinder, agent, use_distance_field=True
+    )
+
+    starts = []
+    goals = []
+    for _ in range(16):
+        state = habitat_sim.AgentState()
+        state.position = pathfinder.get_random_navigable_point()
+        starts.append(state)
+        goals.append(pathfinder.get_random_navigable_point())
+
+    batch_paths = follower.find_paths(starts, goals)
+    assert len(batch_paths) == len(starts)
+
+    # Lockstep batching must not change the trajectories
+    for state, goal_pos, batch_path in zip(starts, goals, batch_paths):
+        agent.state = state
+        try:
+            path = follower.find_path(goal_pos)
+        except habitat_sim.errors.GreedyFollowerError:
+            path = None
+
+        assert batch_path == path
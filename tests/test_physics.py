@@ -412,3 +412,89 @@ def test_raycast():
             )
             assert abs(raycast_results.hits[0].ray_distance - 2.8935) < 0.001
             assert raycast_results.hits[0].object_id == 0
+
+            # batched raycasts match individual ones, with enough rays to
+            # span several batches of 64
+            test_ray_2 = habitat_sim.geo.Ray()
+            test_ray_2.direction = mn.Vector3(0, 1.0, 0)
+            rays = [test_ray_1, test_ray_2, test_ray_1]
+            for i in range(200):
+                angle = mn.Rad(2.0 * np.pi * i / 200)
+                ray = habitat_sim.geo.Ray()
+                ray.origin = mn.Vector3(0, 0.1 * (i % 5), 0)
+                ray.direction = mn.Vector3(
+                    mn.math.cos(angle), 0.2 * ((i % 7) - 3), mn.math.sin(angle)
+                )
+                rays.append(ray)
+            batch_results = sim.cast_rays(rays)
+            assert batch_results.num_rays == len(rays)
+            assert batch_results.hit_offsets[-1] > 64
+            for ray_index, ray in enumerate(rays):
+                single_results = sim.cast_ray(ray)
+                begin = batch_results.hit_offsets[ray_index]
+                assert batch_results.num_hits(ray_index) == len(
+                    single_results.hits
+                )
+                for hit_index, hit in enumerate(single_results.hits):
+                    row = begin + hit_index
+                    assert batch_results.object_ids[row] == hit.object_id
+                    assert np.allclose(batch_results.points[row], hit.point)
+                    assert np.allclose(batch_results.normals[row], hit.normal)
+                    assert np.isclose(
+                        batch_results.ray_distances[row], hit.ray_distance
+                    )
+
+            closest_results = sim.cast_rays(rays, closest_only=True)
+            assert closest_results.num_hits(0) == 1
+            assert closest_results.object_ids[0] == cube_obj_id
+            assert np.allclose(
+                closest_results.points[0], batch_results.points[0], atol=1e-5
+            )
+
+
+@pytest.mark.skipif(
+    not osp.exists("data/scene_datasets/habitat-test-scenes/apartment_1.glb"),
+    reason="Requires the habitat-test-scenes",
+)
+def test_physics_world_batch():
+    cfg_settings = examples.settings.default_sim_settings.copy()
+    cfg_settings["scene"] = "data/scene_datasets/habitat-test-scenes/apartment_1.glb"
+    cfg_settings["enable_physics"] = True
+
+    hab_cfg = examples.settings.make_cfg(cfg_settings)
+    batch = habitat_sim.physics.PhysicsWorldBatch(num_threads=2)
+    with habitat_sim.Simulator(hab_cfg) as sim:
+        assert batch.add_world(sim) == 0
+        assert batch.num_worlds == 1
+        # a world in the batch twice would be stepped by two threads at once
+        with pytest.raises(ValueError):
+            batch.add_world(sim)
+        assert batch.num_worlds == 1
+
+        start_time = sim.get_world_time()
+        world_times = batch.step_physics(0.1)
+        assert len(world_times) == 1
+        assert world_times[0] == sim.get_world_time()
+        if (
+            sim.get_physics_simulation_library()
+            != habitat_sim.physics.PhysicsSimulationLibrary.NONE
+        ):
+            assert world_times[0] > start_time
+
+    # closed simulators are skipped
+    assert not batch.has_world(0)
+    assert batch.step_physics(0.1)[0] == 0
+
+    # closing one simulator of a batch leaves the others stepping
+    batch.clear()
+    with habitat_sim.Simulator(hab_cfg) as sim_a:
+        sim_b = habitat_sim.Simulator(hab_cfg)
+        assert batch.add_world(sim_a) == 0
+        assert batch.add_world(sim_b) == 1
+        batch.step_physics(0.1)
+        sim_b.close()
+        assert batch.has_world(0)
+        assert not batch.has_world(1)
+        world_times = batch.step_physics(0.1)
+        assert world_times[0] == sim_a.get_world_time()
+        assert world_times[1] == 0
@@ -248,3 +248,45 @@ def test_rgb_noise(scene, model_name, make_cfg_settings):
         ) > 1.5e-2 * np.linalg.norm(
             gt.astype(np.float)
         ), "Incorrect color_sensor output"
+
+
+@pytest.mark.gfxtest
+def test_previous_frame_observations(make_cfg_settings):
+    scene = _test_scenes[-1]
+    if not osp.exists(scene):
+        pytest.skip("Skipping {}".format(scene))
+
+    make_cfg_settings["scene"] = scene
+    make_cfg_settings["color_sensor"] = True
+    make_cfg_settings["depth_sensor"] = True
+    make_cfg_settings["semantic_sensor"] = False
+
+    with habitat_sim.Simulator(make_cfg(make_cfg_settings)) as sim:
+        agent = sim.get_agent(0)
+        initial_state = agent.get_state()
+        initial_obs = sim.get_sensor_observations()
+        agent.act("move_forward")
+        moved_state = agent.get_state()
+        moved_obs = sim.get_sensor_observations()
+        assert not np.array_equal(
+            initial_obs["color_sensor"], moved_obs["color_sensor"]
+        )
+
+        # each call but the first returns the pose of the call before
+        for state, expected in [
+            (initial_state, initial_obs),
+            (moved_state, initial_obs),
+            (initial_state, moved_obs),
+            (moved_state, initial_obs),
+        ]:
+            agent.set_state(state)
+            obs = sim.get_sensor_observations(previous_frame=True)
+            for sensor_uuid in ["color_sensor", "depth_sensor"]:
+                assert np.array_equal(obs[sensor_uuid], expected[sensor_uuid])
+
+        # and a synchronous call drops the frame left in flight
+        agent.set_state(initial_state)
+        assert np.array_equal(
+            sim.get_sensor_observations()["color_sensor"],
+            initial_obs["color_sensor"],
+        )
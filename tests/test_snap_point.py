@@ -1,6 +1,7 @@
 import math
 
 import hypothesis
+import numpy as np
 import pytest
 from hypothesis import strategies as st
 
@@ -31,3 +32,28 @@ def test_snap_point(nudge, test_data):
     hypothesis.assume(not math.isnan(proj_pt[0]))
 
     assert pf.is_navigable(proj_pt), "{} -> {} not navigable!".format(pt, proj_pt)
+
+
+def test_batched_point_queries(test_data):
+    pf, start_pt = test_data
+    rng = np.random.RandomState(0)
+    pts = (start_pt + rng.uniform(-5, 5, size=(1000, 3))).astype(np.float32)
+
+    snapped = pf.snap_points(pts)
+    navigable = pf.is_navigable_batch(pts)
+    stepped = pf.try_step_batch(np.repeat([start_pt], len(pts), axis=0), pts)
+    assert snapped.shape == pts.shape
+    assert navigable.shape == (len(pts),)
+    assert stepped.shape == pts.shape
+
+    for i, pt in enumerate(pts):
+        single = pf.snap_point(pt)
+        if math.isnan(single[0]):
+            assert np.isnan(snapped[i]).all()
+        else:
+            assert np.allclose(snapped[i], single)
+        assert navigable[i] == pf.is_navigable(pt)
+        assert np.allclose(stepped[i], pf.try_step(start_pt, pt))
+
+    with pytest.raises(ValueError):
+        pf.try_step_batch(np.repeat([start_pt], len(pts) - 1, axis=0), pts)